@@ -0,0 +1,63 @@
+/**
+ * @file   AlignedMemory.h
+ * @author Furkan Gemici
+ * @date   December, 2024
+ * @brief  Helpers for allocating cache-line aligned buffers.
+ *
+ * Sensor and map buffers are swept linearly and fed to SIMD kernels, so they
+ * are allocated on cache-line boundaries. These helpers wrap the platform
+ * specific aligned allocation functions.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+#ifdef _WIN32
+#include <malloc.h>
+#else
+#include <stdlib.h>
+#endif
+
+/*! Alignment (in bytes) used for all sensor and map buffers. */
+const std::size_t CACHE_LINE_SIZE = 64;
+
+//! Allocates an aligned, uninitialized array
+/*!
+ * @param count Number of elements to allocate.
+ * @param alignment Alignment in bytes (power of two).
+ * @return Pointer to the allocated memory. Must be released with alignedFree().
+ * @throw std::bad_alloc If the allocation fails.
+ */
+template <typename T>
+T* alignedAllocate(std::size_t count, std::size_t alignment = CACHE_LINE_SIZE) {
+    std::size_t bytes = count * sizeof(T);
+    if (bytes == 0) {
+        bytes = alignment;
+    }
+    bytes = (bytes + alignment - 1) / alignment * alignment;
+#ifdef _WIN32
+    void* memory = _aligned_malloc(bytes, alignment);
+#else
+    void* memory = nullptr;
+    if (posix_memalign(&memory, alignment, bytes) != 0) {
+        memory = nullptr;
+    }
+#endif
+    if (!memory) {
+        throw std::bad_alloc();
+    }
+    return static_cast<T*>(memory);
+}
+
+//! Releases memory obtained from alignedAllocate()
+/*!
+ * @param memory Pointer returned by alignedAllocate(), or nullptr.
+ */
+inline void alignedFree(void* memory) {
+#ifdef _WIN32
+    _aligned_free(memory);
+#else
+    free(memory);
+#endif
+}
@@ -0,0 +1,52 @@
+/**
+ * @file   Checksum.cpp
+ * @author Furkan Gemici
+ * @date   December, 2024
+ * @brief  Implementation of the CRC-32 checksum.
+ */
+
+#include "Checksum.h"
+
+namespace {
+    /**
+     * @brief CRC-32 lookup tables for slicing-by-8, built once.
+     *
+     * values[0] is the classic byte table; values[k] advances a byte that is
+     * followed by k more bytes, so eight bytes are folded in per step.
+     */
+    struct CrcTable {
+        unsigned int values[8][256];
+
+        CrcTable() {
+            for (unsigned int i = 0; i < 256; ++i) {
+                unsigned int c = i;
+                for (int k = 0; k < 8; ++k) {
+                    c = (c & 1) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+                }
+                values[0][i] = c;
+            }
+            for (unsigned int i = 0; i < 256; ++i) {
+                for (int k = 1; k < 8; ++k) {
+                    values[k][i] = values[0][values[k - 1][i] & 0xFF] ^ (values[k - 1][i] >> 8);
+                }
+            }
+        }
+    };
+}
+
+unsigned int crc32(const unsigned char* data, size_t size, unsigned int crc) {
+    static const CrcTable table;
+    const unsigned int (*t)[256] = table.values;
+    unsigned int c = crc ^ 0xFFFFFFFFu;
+    while (size >= 8) {
+        const unsigned int low = c ^ (data[0] | (data[1] << 8) | (data[2] << 16) | (static_cast<unsigned int>(data[3]) << 24));
+        c = t[7][low & 0xFF] ^ t[6][(low >> 8) & 0xFF] ^ t[5][(low >> 16) & 0xFF] ^ t[4][low >> 24] ^
+            t[3][data[4]] ^ t[2][data[5]] ^ t[1][data[6]] ^ t[0][data[7]];
+        data += 8;
+        size -= 8;
+    }
+    while (size-- > 0) {
+        c = t[0][(c ^ *data++) & 0xFF] ^ (c >> 8);
+    }
+    return c ^ 0xFFFFFFFFu;
+}
@@ -0,0 +1,19 @@
+/**
+ * @file   Checksum.h
+ * @author Furkan Gemici
+ * @date   December, 2024
+ * @brief  CRC-32 checksum shared by the binary file formats.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+//! Computes or continues a CRC-32 (IEEE 802.3, as used by zip and PNG)
+/*!
+ * @param data Bytes to checksum.
+ * @param size Number of bytes.
+ * @param crc Checksum of the preceding bytes, to checksum a buffer in pieces (0 to start).
+ * @return CRC-32 of all bytes so far.
+ */
+unsigned int crc32(const unsigned char* data, size_t size, unsigned int crc = 0);
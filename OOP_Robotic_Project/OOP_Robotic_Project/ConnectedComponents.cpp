@@ -0,0 +1,282 @@
+#include "ConnectedComponents.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <stdexcept>
+
+/**
+ * @file   ConnectedComponents.cpp
+ * @author Emirhan Kalkan
+ * @date   December, 2024
+ * @brief  Implementation of the ConnectedComponents class.
+ */
+
+const int ConnectedComponents::NO_COMPONENT;
+const int ConnectedComponents::TILE_SIZE;
+
+/**
+ * @brief Labels a map.
+ */
+ConnectedComponents::ConnectedComponents(const Map& map, int connectivity, bool labelOccupied)
+    : map(map), connectivity(connectivity), labelOccupied(labelOccupied), sizeX(-1), sizeY(-1), syncedVersion(0) {
+    if (connectivity != 4 && connectivity != 8) {
+        throw std::invalid_argument("Connectivity must be 4 or 8.");
+    }
+    update();
+}
+
+/**
+ * @brief Destructor. Stops the threads.
+ */
+ConnectedComponents::~ConnectedComponents() {
+}
+
+/**
+ * @brief Returns the root of a cell, halving the path on the way.
+ */
+int ConnectedComponents::find(int index) {
+    while (parent[index] != index) {
+        parent[index] = parent[parent[index]];
+        index = parent[index];
+    }
+    return index;
+}
+
+/**
+ * @brief Merges the sets of two cells under the smaller root.
+ */
+void ConnectedComponents::unite(int a, int b) {
+    a = find(a);
+    b = find(b);
+    if (a < b) {
+        parent[b] = a;
+    }
+    else if (b < a) {
+        parent[a] = b;
+    }
+}
+
+/**
+ * @brief First pass over a tile: links each cell to its visited neighbours in the tile.
+ *
+ * The neighbours are tested in the decision-tree order of Wu, Otoo and
+ * Suzuki (2005): a cell joins one neighbour's set, and two sets are merged
+ * only when the neighbours are not already known to be connected. Every
+ * cell links to a smaller index, so a final raster sweep over the tile
+ * points each cell straight at its root. Only cells of the tile are
+ * touched, so tiles can be labelled concurrently.
+ */
+void ConnectedComponents::labelTile(int x0, int y0, int x1, int y1) {
+    for (int y = y0; y < y1; ++y) {
+        const MapCell* row = map.getRow(y);
+        const MapCell* above = y > y0 ? map.getRow(y - 1) : nullptr;
+        const int rowStart = y * sizeX;
+        for (int x = x0; x < x1; ++x) {
+            const int index = rowStart + x;
+            if (!isTarget(row[x])) {
+                labels[index] = NO_COMPONENT;
+                continue;
+            }
+            labels[index] = index;
+            const bool west = x > x0 && isTarget(row[x - 1]);
+            const bool north = above && isTarget(above[x]);
+            const bool northWest = above && x > x0 && isTarget(above[x - 1]);
+            const int up = index - sizeX;
+            if (connectivity == 4) {
+                if (north) {
+                    if (west && !northWest) {
+                        unite(up, index - 1);
+                    }
+                    parent[index] = up;
+                }
+                else {
+                    parent[index] = west ? index - 1 : index;
+                }
+                continue;
+            }
+            const bool northEast = above && x + 1 < x1 && isTarget(above[x + 1]);
+            if (north) {
+                parent[index] = up;
+            }
+            else if (northEast) {
+                if (northWest) {
+                    unite(up + 1, up - 1);
+                }
+                else if (west) {
+                    unite(up + 1, index - 1);
+                }
+                parent[index] = up + 1;
+            }
+            else if (northWest) {
+                parent[index] = up - 1;
+            }
+            else {
+                parent[index] = west ? index - 1 : index;
+            }
+        }
+    }
+    for (int y = y0; y < y1; ++y) {
+        for (int index = y * sizeX + x0; index < y * sizeX + x1; ++index) {
+            if (labels[index] != NO_COMPONENT) {
+                parent[index] = parent[parent[index]];
+            }
+        }
+    }
+}
+
+/**
+ * @brief Merges the sets of the neighbouring cells on both sides of every tile seam.
+ *
+ * Seams hold about 2 / TILE_SIZE of the cells, so they are merged serially.
+ */
+void ConnectedComponents::mergeSeams() {
+    for (int y = TILE_SIZE; y < sizeY; y += TILE_SIZE) {
+        const MapCell* row = map.getRow(y);
+        const MapCell* above = map.getRow(y - 1);
+        for (int x = 0; x < sizeX; ++x) {
+            if (!isTarget(row[x])) {
+                continue;
+            }
+            const int index = y * sizeX + x;
+            if (isTarget(above[x])) {
+                unite(index, index - sizeX);
+            }
+            if (connectivity == 8) {
+                if (x > 0 && isTarget(above[x - 1])) {
+                    unite(index, index - sizeX - 1);
+                }
+                if (x + 1 < sizeX && isTarget(above[x + 1])) {
+                    unite(index, index - sizeX + 1);
+                }
+            }
+        }
+    }
+    for (int x = TILE_SIZE; x < sizeX; x += TILE_SIZE) {
+        for (int y = 0; y < sizeY; ++y) {
+            if (!isTarget(map.cellAt(x, y))) {
+                continue;
+            }
+            const int index = y * sizeX + x;
+            if (isTarget(map.cellAt(x - 1, y))) {
+                unite(index, index - 1);
+            }
+            if (connectivity == 8) {
+                if (y > 0 && isTarget(map.cellAt(x - 1, y - 1))) {
+                    unite(index, index - sizeX - 1);
+                }
+                if (y + 1 < sizeY && isTarget(map.cellAt(x - 1, y + 1))) {
+                    unite(index, index + sizeX - 1);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Runs a function on every tile, in parallel if a thread pool is set.
+ */
+template <typename Function>
+void ConnectedComponents::forEachTile(const Function& function) {
+    const int tilesX = (sizeX + TILE_SIZE - 1) / TILE_SIZE;
+    const int tilesY = (sizeY + TILE_SIZE - 1) / TILE_SIZE;
+    auto runTile = [&](int tile) {
+        const int x0 = tile % tilesX * TILE_SIZE;
+        const int y0 = tile / tilesX * TILE_SIZE;
+        function(x0, y0, std::min(sizeX, x0 + TILE_SIZE), std::min(sizeY, y0 + TILE_SIZE));
+    };
+    if (!pool || tilesX * tilesY < 2) {
+        for (int tile = 0; tile < tilesX * tilesY; ++tile) {
+            runTile(tile);
+        }
+        return;
+    }
+    pool->run(tilesX * tilesY, runTile);
+}
+
+/**
+ * @brief Relabels the map if it changed since the last update.
+ *
+ * Every cell's parent has a smaller index, so after the seams are merged a
+ * raster sweep resolves a cell from its parent's final label in one step,
+ * numbering the roots as it meets them.
+ */
+void ConnectedComponents::update() {
+    if (map.getNumberX() == sizeX && map.getNumberY() == sizeY && map.getVersion() == syncedVersion) {
+        return;
+    }
+    sizeX = map.getNumberX();
+    sizeY = map.getNumberY();
+    syncedVersion = map.getVersion();
+    const size_t cellCount = static_cast<size_t>(sizeX) * sizeY;
+    labels.resize(cellCount);
+    parent.resize(cellCount);
+    sizes.clear();
+
+    forEachTile([this](int x0, int y0, int x1, int y1) { labelTile(x0, y0, x1, y1); });
+    mergeSeams();
+    for (size_t index = 0; index < cellCount; ++index) {
+        if (labels[index] == NO_COMPONENT) {
+            continue;
+        }
+        const int up = parent[index];
+        if (up == static_cast<int>(index)) {
+            labels[index] = static_cast<int>(sizes.size());
+            sizes.push_back(0);
+        }
+        else {
+            labels[index] = labels[up];
+        }
+        ++sizes[labels[index]];
+    }
+}
+
+/**
+ * @brief Sets the number of threads used to label tiles.
+ */
+void ConnectedComponents::setThreadCount(int threads) {
+    if (threads <= 1) {
+        pool.reset();
+    }
+    else if (getThreadCount() != threads) {
+        pool.reset(new ThreadPool(threads));
+    }
+}
+
+int ConnectedComponents::getThreadCount() const {
+    return pool ? pool->getThreadCount() : 1;
+}
+
+/**
+ * @brief Returns the component of a cell.
+ */
+int ConnectedComponents::getLabel(int x, int y) const {
+    if (x < 0 || x >= sizeX || y < 0 || y >= sizeY) {
+        return NO_COMPONENT;
+    }
+    return labels[static_cast<size_t>(y) * sizeX + x];
+}
+
+const std::vector<int>& ConnectedComponents::getLabels() const {
+    return labels;
+}
+
+int ConnectedComponents::getComponentCount() const {
+    return static_cast<int>(sizes.size());
+}
+
+/**
+ * @brief Returns the number of cells of a component, or 0 for an invalid id.
+ */
+int ConnectedComponents::getComponentSize(int component) const {
+    if (component < 0 || component >= getComponentCount()) {
+        return 0;
+    }
+    return sizes[component];
+}
+
+/**
+ * @brief Checks whether two cells belong to the same component.
+ */
+bool ConnectedComponents::isConnected(int x0, int y0, int x1, int y1) const {
+    const int label = getLabel(x0, y0);
+    return label != NO_COMPONENT && label == getLabel(x1, y1);
+}
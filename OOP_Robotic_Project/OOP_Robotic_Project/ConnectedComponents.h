@@ -0,0 +1,146 @@
+#ifndef CONNECTEDCOMPONENTS_H
+#define CONNECTEDCOMPONENTS_H
+
+#include "Map.h"
+#include <memory>
+#include <vector>
+
+class ThreadPool;
+
+/**
+ * @file   ConnectedComponents.h
+ * @author Emirhan Kalkan
+ * @date   December, 2024
+ * @brief  Header file for the ConnectedComponents class.
+ *
+ * This file defines the ConnectedComponents class, which labels the
+ * connected regions of free (or occupied) cells of a Map.
+ */
+
+ /**
+  * @class ConnectedComponents
+  * @brief Connected-component labels of the free (or occupied) cells of a map.
+  *
+  * Labelling is the two-pass union-find algorithm run on square tiles of
+  * TILE_SIZE cells. Each tile is labelled on its own, in parallel when
+  * setThreadCount() is above 1: every cell is linked to its already visited
+  * neighbours inside the tile, and equivalences are kept in a union-find
+  * forest over the cell indices. The tile seams, about 2 / TILE_SIZE of the
+  * cells, are then merged, and a final raster pass resolves and numbers the
+  * components.
+  *
+  * A root is always the smallest cell index of its set, so components are
+  * numbered 0, 1, ... in the raster order of their first cell, and labels do
+  * not depend on the thread count.
+  *
+  * update() relabels the map when its version changed since the last update.
+  */
+class ConnectedComponents {
+private:
+    const Map& map;                       /**< The map being labelled. */
+    int connectivity;                     /**< 4 or 8. */
+    bool labelOccupied;                   /**< Label occupied cells instead of free cells. */
+    int sizeX, sizeY;                     /**< Map size at the last update. */
+    unsigned long long syncedVersion;     /**< Map version the labels reflect. */
+    std::vector<int> labels;              /**< Row-major component ids, or NO_COMPONENT. */
+    std::vector<int> parent;              /**< Union-find forest over the cell indices. */
+    std::vector<int> sizes;               /**< Number of cells of each component. */
+    std::unique_ptr<ThreadPool> pool;     /**< Threads labelling tiles, or null for serial labelling. */
+
+    /**
+     * @brief Checks whether a map cell is one of the labelled cells.
+     */
+    bool isTarget(MapCell value) const { return (value != 0) == labelOccupied; }
+
+    /**
+     * @brief Returns the root of a cell, halving the path on the way.
+     */
+    int find(int index);
+
+    /**
+     * @brief Merges the sets of two cells under the smaller root.
+     */
+    void unite(int a, int b);
+
+    /**
+     * @brief First pass over a tile: links each cell to its visited neighbours in the tile.
+     */
+    void labelTile(int x0, int y0, int x1, int y1);
+
+    /**
+     * @brief Merges the sets of the neighbouring cells on both sides of every tile seam.
+     */
+    void mergeSeams();
+
+    /**
+     * @brief Runs a function on every tile, in parallel if a thread pool is set.
+     */
+    template <typename Function>
+    void forEachTile(const Function& function);
+
+public:
+    static const int NO_COMPONENT = -1;   /**< Label of cells that are not labelled. */
+    static const int TILE_SIZE = 64;      /**< Cells along a tile side. */
+
+    /**
+     * @brief Labels a map.
+     *
+     * @param map The map. It must outlive the labeller.
+     * @param connectivity 4 (edge neighbours) or 8 (edge and corner neighbours).
+     * @param labelOccupied Label the occupied (non-zero) cells instead of the free (zero) cells.
+     * @throw std::invalid_argument If the connectivity is not 4 or 8.
+     */
+    explicit ConnectedComponents(const Map& map, int connectivity = 4, bool labelOccupied = false);
+
+    /**
+     * @brief Destructor. Stops the threads.
+     */
+    ~ConnectedComponents();
+
+    ConnectedComponents(const ConnectedComponents&) = delete;
+    ConnectedComponents& operator=(const ConnectedComponents&) = delete;
+
+    /**
+     * @brief Relabels the map if it changed since the last update.
+     */
+    void update();
+
+    /**
+     * @brief Sets the number of threads used to label tiles.
+     */
+    void setThreadCount(int threads);
+
+    /**
+     * @brief Returns the number of threads used to label tiles.
+     */
+    int getThreadCount() const;
+
+    /**
+     * @brief Returns the component of a cell.
+     *
+     * @return The component id, or NO_COMPONENT for unlabelled cells and cells outside the map.
+     */
+    int getLabel(int x, int y) const;
+
+    /**
+     * @brief Returns the row-major component ids of all cells.
+     */
+    const std::vector<int>& getLabels() const;
+
+    /**
+     * @brief Returns the number of components.
+     */
+    int getComponentCount() const;
+
+    /**
+     * @brief Returns the number of cells of a component, or 0 for an invalid id.
+     */
+    int getComponentSize(int component) const;
+
+    /**
+     * @brief Checks whether two cells belong to the same component.
+     */
+    bool isConnected(int x0, int y0, int x1, int y1) const;
+};
+
+#endif // CONNECTEDCOMPONENTS_H
@@ -0,0 +1,112 @@
+/**
+ * @file   Costmap.cpp
+ * @author Emirhan Kalkan
+ * @date   December, 2024
+ * @brief  Implementation of the Costmap class.
+ */
+#include "Costmap.h"
+#include <cmath>
+#include <stdexcept>
+
+const MapCell Costmap::LETHAL_COST;
+const MapCell Costmap::INSCRIBED_COST;
+const MapCell Costmap::FREE_COST;
+
+/**
+ * @brief Builds the costmap of a map.
+ *
+ * The cost of every squared distance up to the inflation radius is computed
+ * once, so a cost update is a table lookup.
+ */
+Costmap::Costmap(const Map& map, double robotRadius, double inflationRadius, double scaling)
+    : map(map), field(map, inflationRadius > 0.0 ? inflationRadius + 1e-9 : 1e-9), costs(0, 0) {
+    if (robotRadius < 0.0 || inflationRadius < robotRadius || scaling < 0.0) {
+        throw std::invalid_argument("Invalid costmap parameters.");
+    }
+    const int maxSquared = static_cast<int>(std::floor(inflationRadius * inflationRadius + 1e-9));
+    costTable.resize(maxSquared + 1);
+    for (int squared = 0; squared <= maxSquared; ++squared) {
+        const double distance = std::sqrt(static_cast<double>(squared));
+        if (squared == 0) {
+            costTable[squared] = LETHAL_COST;
+        }
+        else if (distance <= robotRadius) {
+            costTable[squared] = INSCRIBED_COST;
+        }
+        else {
+            const double cost = (INSCRIBED_COST - 1) * std::exp(-scaling * (distance - robotRadius));
+            costTable[squared] = static_cast<MapCell>(cost < 1.0 ? 1 : std::lround(cost));
+        }
+    }
+    recomputeAll();
+}
+
+/**
+ * @brief Recomputes the costs of all cells.
+ */
+void Costmap::recomputeAll() {
+    if (costs.getNumberX() != map.getNumberX() || costs.getNumberY() != map.getNumberY()) {
+        costs.setGridSize(map.getNumberX(), map.getNumberY());
+    }
+    for (int y = 0; y < costs.getNumberY(); ++y) {
+        MapCell* row = costs.getRow(y);
+        for (int x = 0; x < costs.getNumberX(); ++x) {
+            row[x] = costOf(field.getSquaredDistance(x, y));
+        }
+    }
+    costs.markDirty(0, 0, costs.getNumberX() - 1, costs.getNumberY() - 1);
+}
+
+/**
+ * @brief Brings the costs up to date with the map.
+ *
+ * The distance field reports the cells whose distance changed; only their
+ * costs are looked up again, and only real cost changes mark the cost grid.
+ */
+void Costmap::update() {
+    field.update();
+    if (field.wasRebuilt()) {
+        recomputeAll();
+        return;
+    }
+    const int sizeX = costs.getNumberX();
+    for (int index : field.getChangedCells()) {
+        const int x = index % sizeX;
+        const int y = index / sizeX;
+        const MapCell cost = costOf(field.getSquaredDistance(x, y));
+        MapCell& cell = costs.cellAt(x, y);
+        if (cell != cost) {
+            cell = cost;
+            costs.markDirty(x, y);
+        }
+    }
+}
+
+/**
+ * @brief Returns the cost of a cell.
+ */
+int Costmap::getCost(int x, int y) const {
+    return costs.getGrid(x, y);
+}
+
+/**
+ * @brief Checks whether the robot centred on a cell is clear of obstacles.
+ */
+bool Costmap::isFree(int x, int y) const {
+    const int cost = costs.getGrid(x, y);
+    return cost >= 0 && cost < INSCRIBED_COST;
+}
+
+/**
+ * @brief Returns the cost grid.
+ */
+const Map& Costmap::getCosts() const {
+    return costs;
+}
+
+/**
+ * @brief Returns the distance field the costs are derived from.
+ */
+const DistanceField& Costmap::getDistanceField() const {
+    return field;
+}
@@ -0,0 +1,109 @@
+#ifndef COSTMAP_H
+#define COSTMAP_H
+
+#include "DistanceField.h"
+#include <vector>
+
+/**
+ * @file   Costmap.h
+ * @author Emirhan Kalkan
+ * @date   December, 2024
+ * @brief  Header file for the Costmap class.
+ *
+ * This file defines the Costmap class, which inflates the obstacles of a Map
+ * by the robot radius and a decaying cost band.
+ */
+
+ /**
+  * @class Costmap
+  * @brief Obstacle costs that account for the robot footprint, kept up to date incrementally.
+  *
+  * The cost of a cell is a function of its distance d to the nearest obstacle:
+  * - LETHAL_COST on obstacles,
+  * - INSCRIBED_COST within the robot radius (the robot centred there would touch an obstacle),
+  * - 252 * exp(-scaling * (d - robotRadius)) up to the inflation radius (at least 1),
+  * - FREE_COST beyond.
+  *
+  * A planner or safety check tests a robot position with a single lookup
+  * instead of sweeping the footprint. Costs are stored one byte per cell in a
+  * Map, so they have the same aligned rows and change tracking as the
+  * occupancy grid. Distances come from a DistanceField bounded to the
+  * inflation radius, and update() only recomputes the cells whose distance
+  * changed, i.e. the neighbourhood of the cells that flipped.
+  */
+class Costmap {
+private:
+    const Map& map;                      /**< The occupancy map. */
+    DistanceField field;                 /**< Distances to the nearest obstacle, up to the inflation radius. */
+    Map costs;                           /**< Cost of each cell. */
+    std::vector<MapCell> costTable;      /**< Cost for each squared distance up to the inflation radius. */
+
+    /**
+     * @brief Returns the cost of a squared distance.
+     */
+    MapCell costOf(int squared) const {
+        return squared < static_cast<int>(costTable.size()) ? costTable[squared] : FREE_COST;
+    }
+
+    /**
+     * @brief Recomputes the costs of all cells.
+     */
+    void recomputeAll();
+
+public:
+    static const MapCell LETHAL_COST = 254;      /**< Cost of an obstacle cell. */
+    static const MapCell INSCRIBED_COST = 253;   /**< Cost of a cell within the robot radius of an obstacle. */
+    static const MapCell FREE_COST = 0;          /**< Cost of a cell beyond the inflation radius. */
+
+    /**
+     * @brief Builds the costmap of a map.
+     *
+     * @param map The occupancy map (non-zero cells are obstacles). It must outlive the costmap.
+     * @param robotRadius Robot radius in cells.
+     * @param inflationRadius Distance in cells up to which costs decay (at least the robot radius).
+     * @param scaling Decay rate of the cost band per cell.
+     * @throw std::invalid_argument If a radius is negative, the inflation radius
+     *        is smaller than the robot radius, or the scaling is negative.
+     */
+    Costmap(const Map& map, double robotRadius, double inflationRadius, double scaling = 1.0);
+
+    /**
+     * @brief Brings the costs up to date with the map.
+     *
+     * Only cells whose obstacle distance changed are recomputed.
+     */
+    void update();
+
+    /**
+     * @brief Returns the cost of a cell.
+     *
+     * @param x The x-coordinate of the cell.
+     * @param y The y-coordinate of the cell.
+     * @return The cost (0-254), or -1 if the cell is outside the map.
+     */
+    int getCost(int x, int y) const;
+
+    /**
+     * @brief Returns the cost of a cell without bounds checking.
+     */
+    MapCell costAt(int x, int y) const { return costs.cellAt(x, y); }
+
+    /**
+     * @brief Checks whether the robot centred on a cell is clear of obstacles.
+     *
+     * @return `false` within the robot radius of an obstacle or outside the map.
+     */
+    bool isFree(int x, int y) const;
+
+    /**
+     * @brief Returns the cost grid, e.g. for row sweeps or its change tracking.
+     */
+    const Map& getCosts() const;
+
+    /**
+     * @brief Returns the distance field the costs are derived from.
+     */
+    const DistanceField& getDistanceField() const;
+};
+
+#endif // COSTMAP_H
@@ -0,0 +1,239 @@
+/**
+ * @file   DistanceField.cpp
+ * @author Emirhan Kalkan
+ * @date   December, 2024
+ * @brief  Implementation of the DistanceField class.
+ *
+ * This file contains the dynamic brushfire update (raise and lower
+ * wavefronts) and the clearance queries of DistanceField.
+ */
+#include "DistanceField.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+/**
+ * @brief Builds the field over a map.
+ */
+DistanceField::DistanceField(const Map& map, double maxDistance)
+    : map(map), sizeX(-1), sizeY(-1), maxSquared(NO_OBSTACLE - 1), syncedVersion(0), rebuilt(false) {
+    if (maxDistance > 0.0 && maxDistance < 46340.0) {
+        maxSquared = static_cast<int>(maxDistance * maxDistance);
+    }
+    update();
+}
+
+/**
+ * @brief Makes a cell an obstacle and queues its lower wavefront.
+ */
+void DistanceField::setObstacle(int index) {
+    Cell& cell = cells[index];
+    cell.obstacle = index;
+    cell.squared = 0;
+    cell.raise = false;
+    push(0, index);
+    changedCells.push_back(index);
+}
+
+/**
+ * @brief Clears an obstacle cell and queues its raise wavefront.
+ */
+void DistanceField::removeObstacle(int index) {
+    Cell& cell = cells[index];
+    cell.obstacle = -1;
+    cell.squared = NO_OBSTACLE;
+    cell.raise = true;
+    push(0, index);
+    changedCells.push_back(index);
+}
+
+/**
+ * @brief Compares a block of map cells with the field obstacles and applies the differences.
+ */
+void DistanceField::syncCells(int x0, int y0, int x1, int y1) {
+    for (int y = y0; y <= y1; ++y) {
+        const MapCell* row = map.getRow(y);
+        const int rowStart = y * sizeX;
+        for (int x = x0; x <= x1; ++x) {
+            const bool occupied = row[x] != 0;
+            if (occupied != isObstacle(rowStart + x)) {
+                if (occupied) {
+                    setObstacle(rowStart + x);
+                }
+                else {
+                    removeObstacle(rowStart + x);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Brings the field up to date with the map.
+ */
+void DistanceField::update() {
+    const bool resized = map.getNumberX() != sizeX || map.getNumberY() != sizeY;
+    changedCells.clear();
+    rebuilt = resized;
+    if (resized) {
+        sizeX = map.getNumberX();
+        sizeY = map.getNumberY();
+        Cell empty = { -1, NO_OBSTACLE, false };
+        cells.assign(static_cast<size_t>(sizeX) * sizeY, empty);
+        open = std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry> >();
+    }
+
+    const int tilesX = (sizeX + Map::DIRTY_TILE_SIZE - 1) >> Map::DIRTY_TILE_SHIFT;
+    const int tilesY = (sizeY + Map::DIRTY_TILE_SIZE - 1) >> Map::DIRTY_TILE_SHIFT;
+    for (int ty = 0; ty < tilesY; ++ty) {
+        for (int tx = 0; tx < tilesX; ++tx) {
+            if (resized || map.getTileVersion(tx, ty) > syncedVersion) {
+                const int x0 = tx << Map::DIRTY_TILE_SHIFT;
+                const int y0 = ty << Map::DIRTY_TILE_SHIFT;
+                syncCells(x0, y0, std::min(x0 + Map::DIRTY_TILE_SIZE, sizeX) - 1,
+                    std::min(y0 + Map::DIRTY_TILE_SIZE, sizeY) - 1);
+            }
+        }
+    }
+    syncedVersion = map.getVersion();
+    propagate();
+    if (rebuilt) {
+        changedCells.clear();
+    }
+}
+
+/**
+ * @brief Runs the raise and lower wavefronts until the queue is empty.
+ *
+ * A raise visit invalidates the neighbours whose obstacle has gone and
+ * re-queues the others, so their lower wavefront refills the cleared area.
+ * A lower visit offers the cell's obstacle to its neighbours and queues those
+ * that get closer. Queue entries made stale by a later, shorter distance are
+ * skipped.
+ */
+void DistanceField::propagate() {
+    while (!open.empty()) {
+        const QueueEntry entry = open.top();
+        open.pop();
+        const int index = static_cast<int>(entry & 0xFFFFFFFFu);
+        const int squared = static_cast<int>(entry >> 32);
+        Cell& cell = cells[index];
+        const int x = index % sizeX;
+        const int y = index / sizeX;
+        const int nx0 = std::max(x - 1, 0);
+        const int nx1 = std::min(x + 1, sizeX - 1);
+        const int ny0 = std::max(y - 1, 0);
+        const int ny1 = std::min(y + 1, sizeY - 1);
+
+        if (cell.raise) {
+            for (int ny = ny0; ny <= ny1; ++ny) {
+                for (int nx = nx0; nx <= nx1; ++nx) {
+                    const int neighbourIndex = ny * sizeX + nx;
+                    Cell& neighbour = cells[neighbourIndex];
+                    if (neighbour.obstacle < 0 || neighbour.raise) {
+                        continue;
+                    }
+                    push(neighbour.squared, neighbourIndex);
+                    if (!isObstacle(neighbour.obstacle)) {
+                        neighbour.obstacle = -1;
+                        neighbour.squared = NO_OBSTACLE;
+                        neighbour.raise = true;
+                        changedCells.push_back(neighbourIndex);
+                    }
+                }
+            }
+            cell.raise = false;
+        }
+        else if (cell.obstacle >= 0 && squared == cell.squared && isObstacle(cell.obstacle)) {
+            const int obstacleX = cell.obstacle % sizeX;
+            const int obstacleY = cell.obstacle / sizeX;
+            for (int ny = ny0; ny <= ny1; ++ny) {
+                for (int nx = nx0; nx <= nx1; ++nx) {
+                    const int neighbourIndex = ny * sizeX + nx;
+                    Cell& neighbour = cells[neighbourIndex];
+                    if (neighbour.raise) {
+                        continue;
+                    }
+                    const int dx = nx - obstacleX;
+                    const int dy = ny - obstacleY;
+                    const int newSquared = dx * dx + dy * dy;
+                    if (newSquared > maxSquared) {
+                        continue;
+                    }
+                    bool overwrite = newSquared < neighbour.squared;
+                    if (!overwrite && newSquared == neighbour.squared) {
+                        overwrite = neighbour.obstacle < 0 || !isObstacle(neighbour.obstacle);
+                    }
+                    if (overwrite) {
+                        if (neighbour.squared != newSquared) {
+                            changedCells.push_back(neighbourIndex);
+                        }
+                        neighbour.squared = newSquared;
+                        neighbour.obstacle = cell.obstacle;
+                        push(newSquared, neighbourIndex);
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Returns the distance from a cell to its nearest obstacle.
+ */
+double DistanceField::getDistance(int x, int y) const {
+    if (x < 0 || x >= sizeX || y < 0 || y >= sizeY) {
+        return -1.0;
+    }
+    const int squared = getSquaredDistance(x, y);
+    if (squared == NO_OBSTACLE) {
+        return std::numeric_limits<double>::infinity();
+    }
+    return std::sqrt(static_cast<double>(squared));
+}
+
+/**
+ * @brief Returns the nearest obstacle of a cell.
+ */
+bool DistanceField::getNearestObstacle(int x, int y, int& obstacleX, int& obstacleY) const {
+    if (x < 0 || x >= sizeX || y < 0 || y >= sizeY) {
+        return false;
+    }
+    const int obstacle = cells[static_cast<size_t>(y) * sizeX + x].obstacle;
+    if (obstacle < 0) {
+        return false;
+    }
+    obstacleX = obstacle % sizeX;
+    obstacleY = obstacle / sizeX;
+    return true;
+}
+
+/**
+ * @brief Returns the direction in which the distance grows fastest.
+ */
+bool DistanceField::getGradient(int x, int y, double& gradientX, double& gradientY) const {
+    gradientX = 0.0;
+    gradientY = 0.0;
+    int obstacleX, obstacleY;
+    if (!getNearestObstacle(x, y, obstacleX, obstacleY) || (obstacleX == x && obstacleY == y)) {
+        return false;
+    }
+    const double distance = std::sqrt(static_cast<double>(getSquaredDistance(x, y)));
+    gradientX = (x - obstacleX) / distance;
+    gradientY = (y - obstacleY) / distance;
+    return true;
+}
+
+/**
+ * @brief Returns the cells whose distance changed in the last update().
+ */
+const std::vector<int>& DistanceField::getChangedCells() const {
+    return changedCells;
+}
+
+/**
+ * @brief Checks whether the last update() rebuilt the whole field.
+ */
+bool DistanceField::wasRebuilt() const {
+    return rebuilt;
+}
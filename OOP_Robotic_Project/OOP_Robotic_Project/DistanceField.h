@@ -0,0 +1,166 @@
+#ifndef DISTANCEFIELD_H
+#define DISTANCEFIELD_H
+
+#include "Map.h"
+#include <functional>
+#include <queue>
+#include <vector>
+
+/**
+ * @file   DistanceField.h
+ * @author Emirhan Kalkan
+ * @date   December, 2024
+ * @brief  Header file for the DistanceField class.
+ *
+ * This file defines the DistanceField class, an incrementally updated
+ * Euclidean distance map over the occupied cells of a Map.
+ */
+
+ /**
+  * @class DistanceField
+  * @brief Distance from every cell to its nearest occupied cell, kept up to date incrementally.
+  *
+  * Every cell stores its nearest obstacle cell and the squared distance to it,
+  * so clearance and gradient queries are single lookups. The field follows the
+  * map with the dynamic brushfire algorithm (Lau, Sprunk and Burgard, 2010):
+  * new obstacles start a "lower" wavefront, removed obstacles a "raise"
+  * wavefront that invalidates the cells which pointed at them, and only cells
+  * whose nearest obstacle changes are visited.
+  *
+  * update() finds the changed cells through the map's tile versions, so only
+  * tiles changed since the previous update are scanned. A maximum distance
+  * bounds the wavefronts: cells farther than it from every obstacle read as
+  * infinitely far.
+  */
+class DistanceField {
+private:
+    /**
+     * @brief Per-cell state.
+     */
+    struct Cell {
+        int obstacle;      /**< Index of the nearest obstacle cell, or -1. */
+        int squared;       /**< Squared distance to it in cells, or NO_OBSTACLE. */
+        bool raise;        /**< The cell is queued for the raise wavefront. */
+    };
+
+    typedef unsigned long long QueueEntry;   /**< Squared distance in the high 32 bits, cell index in the low 32. */
+
+    const Map& map;                          /**< The map the field follows. */
+    int sizeX, sizeY;                        /**< Field size (the map size at the last update). */
+    int maxSquared;                          /**< Squared distance beyond which the wavefronts stop. */
+    std::vector<Cell> cells;                 /**< Row-major cell states. */
+    std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry> > open;  /**< Wavefront queue. */
+    unsigned long long syncedVersion;        /**< Map version the field was last updated to. */
+    std::vector<int> changedCells;           /**< Cells whose distance changed in the last update (may repeat). */
+    bool rebuilt;                            /**< The last update rebuilt the whole field. */
+
+    /**
+     * @brief Checks whether a cell is an obstacle of the field.
+     */
+    bool isObstacle(int index) const { return cells[index].obstacle == index; }
+
+    /**
+     * @brief Queues a cell.
+     */
+    void push(int squared, int index) {
+        open.push((static_cast<QueueEntry>(squared) << 32) | static_cast<unsigned int>(index));
+    }
+
+    /**
+     * @brief Makes a cell an obstacle and queues its lower wavefront.
+     */
+    void setObstacle(int index);
+
+    /**
+     * @brief Clears an obstacle cell and queues its raise wavefront.
+     */
+    void removeObstacle(int index);
+
+    /**
+     * @brief Compares a block of map cells with the field obstacles and applies the differences.
+     */
+    void syncCells(int x0, int y0, int x1, int y1);
+
+    /**
+     * @brief Runs the raise and lower wavefronts until the queue is empty.
+     */
+    void propagate();
+
+public:
+    static const int NO_OBSTACLE = 0x7FFFFFFF;   /**< Squared distance of cells with no obstacle in range. */
+
+    /**
+     * @brief Builds the field over a map.
+     *
+     * @param map The map to follow (non-zero cells are obstacles). It must outlive the field.
+     * @param maxDistance Distance in cells beyond which cells read as infinitely
+     *                    far (0 for no limit). Smaller values make updates cheaper.
+     */
+    explicit DistanceField(const Map& map, double maxDistance = 0.0);
+
+    /**
+     * @brief Brings the field up to date with the map.
+     *
+     * Only tiles changed since the previous update are compared; a map resize
+     * rebuilds the field.
+     */
+    void update();
+
+    /**
+     * @brief Returns the squared distance from a cell to its nearest obstacle (unchecked).
+     *
+     * @return The squared distance in cells, or NO_OBSTACLE.
+     */
+    int getSquaredDistance(int x, int y) const { return cells[static_cast<size_t>(y) * sizeX + x].squared; }
+
+    /**
+     * @brief Returns the distance from a cell to its nearest obstacle.
+     *
+     * @param x The x-coordinate of the cell.
+     * @param y The y-coordinate of the cell.
+     * @return The distance in cells (0 on obstacles), infinity if no obstacle is
+     *         within the maximum distance, or -1 if the cell is outside the map.
+     */
+    double getDistance(int x, int y) const;
+
+    /**
+     * @brief Returns the nearest obstacle of a cell.
+     *
+     * @param x The x-coordinate of the cell.
+     * @param y The y-coordinate of the cell.
+     * @param obstacleX Receives the x-coordinate of the obstacle.
+     * @param obstacleY Receives the y-coordinate of the obstacle.
+     * @return `false` if the cell is outside the map or has no obstacle within range.
+     */
+    bool getNearestObstacle(int x, int y, int& obstacleX, int& obstacleY) const;
+
+    /**
+     * @brief Returns the direction in which the distance grows fastest.
+     *
+     * This is the unit vector from the nearest obstacle to the cell, the
+     * direction to move to get away from obstacles.
+     *
+     * @param x The x-coordinate of the cell.
+     * @param y The y-coordinate of the cell.
+     * @param gradientX Receives the x component.
+     * @param gradientY Receives the y component.
+     * @return `false` (and a zero vector) on obstacles, outside the map, or with
+     *         no obstacle in range.
+     */
+    bool getGradient(int x, int y, double& gradientX, double& gradientY) const;
+
+    /**
+     * @brief Returns the cells (row-major indices) whose distance changed in the last update().
+     *
+     * A cell may appear more than once. After a rebuild (see wasRebuilt()) the
+     * list is empty and every cell must be considered changed.
+     */
+    const std::vector<int>& getChangedCells() const;
+
+    /**
+     * @brief Checks whether the last update() rebuilt the whole field (first update or map resize).
+     */
+    bool wasRebuilt() const;
+};
+
+#endif // DISTANCEFIELD_H
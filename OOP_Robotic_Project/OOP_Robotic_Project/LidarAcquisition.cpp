@@ -0,0 +1,239 @@
+/**
+ * @file   LidarAcquisition.cpp
+ * @author Furkan Gemici
+ * @date   December, 2024
+ * @brief  Implementation file for the LidarAcquisition class.
+ */
+
+#include "LidarAcquisition.h"
+#include "AlignedMemory.h"
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+    /**
+     * @brief Returns the time in seconds on a monotonic clock.
+     */
+    double monotonicSeconds() {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+}
+
+/**
+ * @brief Constructor. Preallocates all slots of the ring.
+ *
+ * @param api A pointer to a FestoRobotAPI object for interacting with the sensor.
+ * @param numSlots Number of scans kept in the ring.
+ * @throw std::invalid_argument If api is null or numSlots is smaller than 2.
+ */
+LidarAcquisition::LidarAcquisition(FestoRobotAPI* api, int numSlots)
+    : robotAPI(api), slotCount(numSlots), beamCount(0), slotStride(0), slots(nullptr),
+    rangeStorage(nullptr), published(0), running(false), firstScan(0), firstTimestamp(0.0),
+    epoch(monotonicSeconds()), period(0.0) {
+    if (!robotAPI) {
+        throw std::invalid_argument("robotAPI is not initialized.");
+    }
+    if (slotCount < 2) {
+        throw std::invalid_argument("LidarAcquisition needs at least 2 slots.");
+    }
+
+    beamCount = robotAPI->getLidarRangeNumber();
+    if (beamCount < 0) {
+        beamCount = 0;
+    }
+    // Round every slot up to a whole number of cache lines.
+    const int floatsPerLine = static_cast<int>(CACHE_LINE_SIZE / sizeof(float));
+    slotStride = (beamCount + floatsPerLine - 1) / floatsPerLine * floatsPerLine;
+
+    static_assert(alignof(ScanSlot) == CACHE_LINE_SIZE, "Slot headers must fill whole cache lines.");
+    slots = alignedAllocate<ScanSlot>(slotCount);
+    for (int i = 0; i < slotCount; ++i) {
+        new (&slots[i]) ScanSlot();
+        slots[i].sequence.store(0, std::memory_order_relaxed);
+        slots[i].timestamp.store(0.0, std::memory_order_relaxed);
+    }
+    rangeStorage = alignedAllocate<float>(static_cast<std::size_t>(slotStride) * slotCount);
+    std::memset(rangeStorage, 0, static_cast<std::size_t>(slotStride) * slotCount * sizeof(float));
+}
+
+/**
+ * @brief Destructor. Stops the acquisition thread and frees the ring.
+ */
+LidarAcquisition::~LidarAcquisition() {
+    stop();
+    alignedFree(slots);
+    alignedFree(rangeStorage);
+}
+
+/**
+ * @brief Starts the acquisition thread.
+ *
+ * @param rateHz Polling rate in scans per second (0 = as fast as possible).
+ * @return false if the thread is already running, true otherwise.
+ */
+bool LidarAcquisition::start(double rateHz) {
+    if (running.load()) {
+        return false;
+    }
+    if (worker.joinable()) {
+        worker.join();
+    }
+    period = rateHz > 0.0 ? 1.0 / rateHz : 0.0;
+    running.store(true);
+    worker = std::thread(&LidarAcquisition::run, this);
+    return true;
+}
+
+/**
+ * @brief Stops the acquisition thread and waits for it to finish.
+ */
+void LidarAcquisition::stop() {
+    running.store(false);
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+bool LidarAcquisition::isRunning() const {
+    return running.load();
+}
+
+/**
+ * @brief Body of the acquisition thread.
+ *
+ * Each iteration writes one scan into the next slot. The slot's sequence is
+ * cleared before the API call and set to the new scan number afterwards,
+ * then the scan number is published. The first scan of the run is recorded
+ * the same way: `firstScan` is cleared, the timestamp written, and the scan
+ * number stored last. If an iteration overruns the period, the next one
+ * starts immediately so the achievable rate can be measured.
+ */
+void LidarAcquisition::run() {
+    double nextTime = monotonicSeconds();
+    unsigned long long scanNumber = published.load(std::memory_order_relaxed);
+    const unsigned long long runFirstScan = scanNumber + 1;
+    firstScan.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    while (running.load(std::memory_order_relaxed)) {
+        ++scanNumber;
+        ScanSlot& slot = slots[scanNumber % slotCount];
+        float* ranges = rangeStorage + static_cast<std::size_t>(scanNumber % slotCount) * slotStride;
+
+        slot.sequence.store(0, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        robotAPI->getLidarRange(ranges);
+        const double timestamp = monotonicSeconds() - epoch;
+        slot.timestamp.store(timestamp, std::memory_order_relaxed);
+
+        slot.sequence.store(scanNumber, std::memory_order_release);
+        if (scanNumber == runFirstScan) {
+            firstTimestamp.store(timestamp, std::memory_order_relaxed);
+            firstScan.store(scanNumber, std::memory_order_release);
+        }
+        published.store(scanNumber, std::memory_order_release);
+
+        if (period > 0.0) {
+            nextTime += period;
+            double wait = nextTime - monotonicSeconds();
+            if (wait > 0.0) {
+                std::this_thread::sleep_for(std::chrono::duration<double>(wait));
+            }
+            else {
+                nextTime = monotonicSeconds();
+            }
+        }
+    }
+}
+
+/**
+ * @brief Retrieves the latest complete scan.
+ *
+ * @param view Receives the scan.
+ * @return false if no scan has been published yet.
+ */
+bool LidarAcquisition::getLatest(ScanView& view) const {
+    // The producer may overwrite the latest slot between the two loads only
+    // after a full ring cycle, in which case the next published scan is used.
+    for (int attempt = 0; attempt < slotCount; ++attempt) {
+        if (getScan(published.load(std::memory_order_acquire), view)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Retrieves a specific scan.
+ *
+ * @param scanNumber Sequence number of the scan.
+ * @param view Receives the scan.
+ * @return false if the scan has not been published yet or was already overwritten.
+ */
+bool LidarAcquisition::getScan(unsigned long long scanNumber, ScanView& view) const {
+    if (scanNumber == 0 || scanNumber > published.load(std::memory_order_acquire)) {
+        return false;
+    }
+    const int index = static_cast<int>(scanNumber % slotCount);
+    const ScanSlot& slot = slots[index];
+    if (slot.sequence.load(std::memory_order_acquire) != scanNumber) {
+        return false;
+    }
+    view.ranges = rangeStorage + static_cast<std::size_t>(index) * slotStride;
+    view.count = beamCount;
+    view.scanNumber = scanNumber;
+    view.timestamp = slot.timestamp.load(std::memory_order_relaxed);
+    return isCurrent(view);
+}
+
+/**
+ * @brief Checks that a view was not overwritten.
+ *
+ * @param view A view obtained from getLatest() or getScan().
+ * @return true if the slot still holds the scan the view refers to.
+ */
+bool LidarAcquisition::isCurrent(const ScanView& view) const {
+    if (view.scanNumber == 0) {
+        return false;
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return slots[view.scanNumber % slotCount].sequence.load(std::memory_order_relaxed) == view.scanNumber;
+}
+
+unsigned long long LidarAcquisition::getScanCount() const {
+    return published.load(std::memory_order_acquire);
+}
+
+int LidarAcquisition::getBeamCount() const {
+    return beamCount;
+}
+
+int LidarAcquisition::getSlotCount() const {
+    return slotCount;
+}
+
+/**
+ * @brief Returns the measured scan rate in scans per second.
+ *
+ * The first scan number and timestamp are read like a ring slot: the pair is
+ * used only if the number did not change while the timestamp was read.
+ */
+double LidarAcquisition::getMeasuredRate() const {
+    ScanView latest;
+    if (!getLatest(latest)) {
+        return 0.0;
+    }
+    unsigned long long first = firstScan.load(std::memory_order_acquire);
+    double firstTime = firstTimestamp.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (firstScan.load(std::memory_order_relaxed) != first) {
+        return 0.0;
+    }
+    double elapsed = latest.timestamp - firstTime;
+    if (first == 0 || latest.scanNumber <= first || elapsed <= 0.0) {
+        return 0.0;
+    }
+    return (latest.scanNumber - first) / elapsed;
+}
@@ -0,0 +1,146 @@
+/**
+ * @file   LidarAcquisition.h
+ * @author Furkan Gemici
+ * @date   December, 2024
+ * @brief  Header file for the LidarAcquisition class.
+ *
+ * This file contains the definition of the LidarAcquisition class, which polls
+ * the Lidar from a background thread and publishes timestamped scans into a
+ * lock-free ring buffer.
+ */
+
+#pragma once
+
+#include "../../oop_project/Project_Packet/FestoRobotAPI.h"
+#include <atomic>
+#include <thread>
+
+/**
+ * @struct ScanView
+ * @brief Zero-copy view of a scan stored in the acquisition ring.
+ *
+ * The view points directly into the ring. It stays valid until the producer
+ * wraps around and reuses the slot, which can be checked with
+ * LidarAcquisition::isCurrent() after the data has been consumed.
+ */
+struct ScanView {
+    const float* ranges;          /*!< Range values of the scan. */
+    int count;                    /*!< Number of range values. */
+    unsigned long long scanNumber; /*!< Sequence number of the scan (starting at 1). */
+    double timestamp;             /*!< Acquisition time in seconds since construction. */
+};
+
+ /**
+  * @class LidarAcquisition
+  * @brief Background Lidar acquisition with a single-producer/multi-consumer ring.
+  *
+  * A dedicated thread calls the robot API at a configured rate and writes each
+  * scan into the next preallocated slot. Every slot carries a sequence number
+  * that is cleared while the slot is written and set to the scan number once
+  * the scan is complete (a sequence lock), so consumers never take a lock and
+  * never copy: they read a ScanView and verify with isCurrent() that the slot
+  * was not reused while they were reading it.
+  *
+  * The acquisition thread must be the only caller of getLidarRange() while
+  * running.
+  */
+class LidarAcquisition {
+private:
+    /**
+     * @struct ScanSlot
+     * @brief Header of a ring slot, aligned to its own cache line.
+     */
+    struct alignas(64) ScanSlot {
+        std::atomic<unsigned long long> sequence; /*!< Scan number stored in the slot, 0 while written. */
+        std::atomic<double> timestamp;            /*!< Acquisition time of the scan. */
+    };
+
+    FestoRobotAPI* robotAPI;       /*!< Pointer to the robot API for hardware interaction. */
+    int slotCount;                 /*!< Number of slots in the ring. */
+    int beamCount;                 /*!< Number of range values per scan. */
+    int slotStride;                /*!< Distance in floats between two slots' range arrays. */
+    ScanSlot* slots;               /*!< Slot headers (cache-line aligned). */
+    float* rangeStorage;           /*!< Range arrays of all slots in one aligned block. */
+    std::atomic<unsigned long long> published; /*!< Number of the latest complete scan (0 if none). */
+    std::atomic<bool> running;     /*!< True while the acquisition thread should keep polling. */
+    std::atomic<unsigned long long> firstScan; /*!< Number of the first scan of the current run, 0 while written. */
+    std::atomic<double> firstTimestamp; /*!< Timestamp of the first scan of the current run, valid while `firstScan` is unchanged. */
+    double epoch;                  /*!< Monotonic clock value at construction. */
+    double period;                 /*!< Polling period in seconds (0 = as fast as possible). */
+    std::thread worker;            /*!< The acquisition thread. */
+
+    //! Body of the acquisition thread
+    void run();
+
+public:
+    //! Constructor
+    /*!
+     * Queries the number of beams from the API and preallocates all slots.
+     * @param api A pointer to a FestoRobotAPI object for interacting with the sensor.
+     * @param numSlots Number of scans kept in the ring (at least 2).
+     * @throw std::invalid_argument If api is null or numSlots is smaller than 2.
+     */
+    LidarAcquisition(FestoRobotAPI* api, int numSlots = 8);
+
+    //! Destructor
+    /*!
+     * Stops the acquisition thread and frees the ring.
+     */
+    ~LidarAcquisition();
+
+    LidarAcquisition(const LidarAcquisition&) = delete;
+    LidarAcquisition& operator=(const LidarAcquisition&) = delete;
+
+    //! Starts the acquisition thread
+    /*!
+     * @param rateHz Polling rate in scans per second (0 = as fast as possible).
+     * @return false if the thread is already running, true otherwise.
+     */
+    bool start(double rateHz);
+
+    //! Stops the acquisition thread and waits for it to finish
+    void stop();
+
+    //! Returns true while the acquisition thread is running
+    bool isRunning() const;
+
+    //! Retrieves the latest complete scan
+    /*!
+     * @param view Receives the scan.
+     * @return false if no scan has been published yet.
+     */
+    bool getLatest(ScanView& view) const;
+
+    //! Retrieves a specific scan
+    /*!
+     * @param scanNumber Sequence number of the scan.
+     * @param view Receives the scan.
+     * @return false if the scan has not been published yet or was already overwritten.
+     */
+    bool getScan(unsigned long long scanNumber, ScanView& view) const;
+
+    //! Checks that a view was not overwritten
+    /*!
+     * Call after reading the view's ranges: if this returns false the data may
+     * be torn and must be discarded.
+     * @param view A view obtained from getLatest() or getScan().
+     * @return true if the slot still holds the scan the view refers to.
+     */
+    bool isCurrent(const ScanView& view) const;
+
+    //! Returns the number of scans published since start()
+    unsigned long long getScanCount() const;
+
+    //! Returns the number of range values per scan
+    int getBeamCount() const;
+
+    //! Returns the number of slots in the ring
+    int getSlotCount() const;
+
+    //! Returns the measured scan rate in scans per second
+    /*!
+     * @return Scans per second between the first scan of the current run and
+     *         the latest scan, or 0 if fewer than two scans were published.
+     */
+    double getMeasuredRate() const;
+};
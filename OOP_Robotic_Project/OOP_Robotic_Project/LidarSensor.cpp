@@ -12,55 +12,263 @@
  */
 
 #include "LidarSensor.h"
+#include "AlignedMemory.h"
+#include "ScanProjector.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <limits>
 #include <stdexcept>
+#include <type_traits>
 #undef max
 
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace {
+    /**
+     * @brief Returns where the API should write a scan for the given storage.
+     *
+     * Float storage receives the scan directly; other types go through the
+     * float staging buffer and are converted in bulk.
+     */
+    float* apiTarget(float* storage, float*) {
+        return storage;
+    }
+
+    template <typename Storage>
+    float* apiTarget(Storage*, float* staging) {
+        return staging;
+    }
+
+    /**
+     * @brief Returns a float view of a stored scan.
+     *
+     * Float storage is its own view; other types are decoded into `view` once
+     * per scan.
+     */
+    const float* floatView(const float* storage, float*, int, bool&) {
+        return storage;
+    }
+
+    template <typename Storage>
+    const float* floatView(const Storage* storage, float* view, int count, bool& valid) {
+        if (!valid) {
+            RangeCodec<Storage>::decode(storage, view, count);
+            valid = true;
+        }
+        return view;
+    }
+}
+
  /**
   * @brief Constructor for LidarSensor.
   *
   * Initializes the LidarSensor object with the specified robot API and number
-  * of range values. Allocates memory for storing range values and initializes them
-  * to zero.
+  * of range values. Allocates the front and back scan buffers (and the float
+  * view and staging buffers for non-float storage) and initializes them to zero.
   *
   * @param api A pointer to a FestoRobotAPI object for interacting with the sensor.
   * @param numRanges The number of ranges to be stored in the sensor.
   */
-LidarSensor::LidarSensor(FestoRobotAPI* api, int numRanges)
-    : robotAPI(api), rangeNumber(numRanges) {
-    ranges = new double[rangeNumber];
+template <typename Storage>
+BasicLidarSensor<Storage>::BasicLidarSensor(FestoRobotAPI* api, int numRanges)
+    : view(nullptr), staging(nullptr), viewValid(false), frontIndex(0), bufferCapacity(0), apiRangeNumber(0), rangeNumber(numRanges), robotAPI(api),
+    fieldOfView(360.0), startAngle(0.0), cosTable(nullptr), sinTable(nullptr), statisticsValid(false),
+    acquisition(nullptr), lastScanNumber(0) {
+    buffers[0] = nullptr;
+    buffers[1] = nullptr;
+    allocateBuffers(rangeNumber);
+    cosTable = alignedAllocate<float>(rangeNumber > 0 ? rangeNumber : 0);
+    sinTable = alignedAllocate<float>(rangeNumber > 0 ? rangeNumber : 0);
+    buildAngleTables();
+    setStandardSectors();
+}
+
+/**
+ * @brief Destructor for LidarSensor.
+ *
+ * Frees the dynamically allocated scan buffers.
+ */
+template <typename Storage>
+BasicLidarSensor<Storage>::~BasicLidarSensor() {
+    stopAcquisition();
+    alignedFree(buffers[0]);
+    alignedFree(buffers[1]);
+    alignedFree(view);
+    alignedFree(staging);
+    alignedFree(cosTable);
+    alignedFree(sinTable);
+}
+
+/**
+ * @brief Rebuilds the per-beam cosine and sine tables.
+ *
+ * The tables are computed in double precision from getAngle() and stored as
+ * float to match the range buffers.
+ */
+template <typename Storage>
+void BasicLidarSensor<Storage>::buildAngleTables() {
     for (int i = 0; i < rangeNumber; ++i) {
-        ranges[i] = 0.0;
+        double angleRad = getAngle(i) * M_PI / 180.0;
+        cosTable[i] = static_cast<float>(std::cos(angleRad));
+        sinTable[i] = static_cast<float>(std::sin(angleRad));
     }
 }
 
 /**
- * @brief Destructor for LidarSensor.
+ * @brief Adopts the number of ranges delivered by the robot API.
+ *
+ * The buffers are grown if needed. If the count differs from `rangeNumber`,
+ * the beams are spread over the same angular layout again: the angle tables
+ * and sector runs are rebuilt for the new count. Readers are locked out
+ * while the buffers and tables are replaced.
+ *
+ * @throw std::runtime_error If the API reports no ranges.
+ */
+template <typename Storage>
+void BasicLidarSensor<Storage>::adoptApiRangeNumber(int count) {
+    if (count <= 0) {
+        throw std::runtime_error("Lidar reports no ranges.");
+    }
+    std::lock_guard<std::mutex> lock(frontMutex);
+    apiRangeNumber = count;
+    if (apiRangeNumber > bufferCapacity) {
+        allocateBuffers(apiRangeNumber);
+    }
+    if (apiRangeNumber != rangeNumber) {
+        rangeNumber = apiRangeNumber;
+        alignedFree(cosTable);
+        alignedFree(sinTable);
+        cosTable = nullptr;
+        sinTable = nullptr;
+        cosTable = alignedAllocate<float>(rangeNumber);
+        sinTable = alignedAllocate<float>(rangeNumber);
+        buildAngleTables();
+        buildSectorRuns();
+        viewValid = false;
+    }
+}
+
+/**
+ * @brief Allocates zeroed scan buffers.
+ *
+ * @param capacity Number of ranges per buffer.
+ */
+template <typename Storage>
+void BasicLidarSensor<Storage>::allocateBuffers(int capacity) {
+    alignedFree(buffers[0]);
+    alignedFree(buffers[1]);
+    alignedFree(view);
+    alignedFree(staging);
+    buffers[0] = nullptr;
+    buffers[1] = nullptr;
+    view = nullptr;
+    staging = nullptr;
+
+    bufferCapacity = capacity > 0 ? capacity : 0;
+    buffers[0] = alignedAllocate<Storage>(bufferCapacity);
+    buffers[1] = alignedAllocate<Storage>(bufferCapacity);
+    std::memset(buffers[0], 0, bufferCapacity * sizeof(Storage));
+    std::memset(buffers[1], 0, bufferCapacity * sizeof(Storage));
+    if (!std::is_same<Storage, float>::value) {
+        view = alignedAllocate<float>(bufferCapacity);
+        staging = alignedAllocate<float>(bufferCapacity);
+        std::memset(view, 0, bufferCapacity * sizeof(float));
+        std::memset(staging, 0, bufferCapacity * sizeof(float));
+    }
+    viewValid = false;
+    statisticsValid = false;
+}
+
+/**
+ * @brief Returns the buffer holding the latest complete scan.
+ */
+template <typename Storage>
+const Storage* BasicLidarSensor<Storage>::rawFront() const {
+    return buffers[frontIndex];
+}
+
+/**
+ * @brief Returns the latest complete scan as float metres (frontMutex held).
  *
- * Frees the dynamically allocated memory for the `ranges` array.
+ * Non-float storage is decoded into the view buffer on the first call after
+ * an update.
  */
-LidarSensor::~LidarSensor() {
-    delete[] ranges;
+template <typename Storage>
+const float* BasicLidarSensor<Storage>::lockedFront() const {
+    return floatView(rawFront(), view, rangeNumber, viewValid);
+}
 
+/**
+ * @brief Returns the latest complete scan as float metres.
+ *
+ * The view is decoded under the lock; the pointer is then only read, and
+ * stays valid until the next update on the owning thread.
+ */
+template <typename Storage>
+const float* BasicLidarSensor<Storage>::front() const {
+    std::lock_guard<std::mutex> lock(frontMutex);
+    return lockedFront();
 }
 
 /**
  * @brief Updates the Lidar range data.
  *
- * Retrieves the latest Lidar measurements from the robot API and stores them
- * in the `ranges` array.
+ * Retrieves the latest Lidar scan from the robot API with one bulk call into
+ * the back buffer. On the first update the sensor adopts the number of ranges
+ * reported by the API (see adoptApiRangeNumber()). The back buffer is filled
+ * without the lock, since readers only touch the front buffer, and becomes
+ * the front buffer under the lock once the scan is complete.
+ *
+ * Non-float storage receives the scan in the float staging buffer and converts
+ * it into the back buffer in one bulk pass.
+ *
+ * In acquisition mode the latest background scan is converted into the back
+ * buffer instead. A copy torn by the producer wrapping around is retried.
+ *
+ * @throw std::runtime_error If the robot API is not initialized.
  */
-void LidarSensor::update() {
+template <typename Storage>
+void BasicLidarSensor<Storage>::update() {
     if (!robotAPI) {
         throw std::runtime_error("robotAPI is not initialized.");
     }
 
-    float tempRange = 0.0f; // Geici deiken tanmlanyor
+    if (acquisition) {
+        int back = 1 - frontIndex;
+        ScanView scan;
+        while (acquisition->getLatest(scan)) {
+            if (scan.scanNumber == lastScanNumber) {
+                return;
+            }
+            int count = scan.count < bufferCapacity ? scan.count : bufferCapacity;
+            RangeCodec<Storage>::encode(scan.ranges, buffers[back], count);
+            if (acquisition->isCurrent(scan)) {
+                lastScanNumber = scan.scanNumber;
+                std::lock_guard<std::mutex> lock(frontMutex);
+                frontIndex = back;
+                statisticsValid = false;
+                viewValid = false;
+                return;
+            }
+        }
+        return;
+    }
 
-    for (int i = 0; i < rangeNumber; ++i) {
-        robotAPI->getLidarRange(&tempRange); // Sensrden veri alnyor
-        ranges[i] = static_cast<double>(tempRange); // Alnan veri diziye aktarlyor
+    if (apiRangeNumber == 0) {
+        adoptApiRangeNumber(robotAPI->getLidarRangeNumber());
     }
+
+    int back = 1 - frontIndex;
+    float* target = apiTarget(buffers[back], staging);
+    robotAPI->getLidarRange(target); // Tek arda tm tarama alnyor
+    RangeCodec<Storage>::encode(target, buffers[back], rangeNumber);
+    std::lock_guard<std::mutex> lock(frontMutex);
+    frontIndex = back;
+    statisticsValid = false;
+    viewValid = false;
 }
 
 
@@ -73,9 +281,11 @@ void LidarSensor::update() {
  * @return The range value at the given index.
  * @throw std::out_of_range If the index is not in the valid range [0, rangeNumber-1].
  */
-double LidarSensor::getRange(int index) const {
+template <typename Storage>
+double BasicLidarSensor<Storage>::getRange(int index) const {
+    std::lock_guard<std::mutex> lock(frontMutex);
     if (index >= 0 && index < rangeNumber) {
-        return ranges[index];
+        return RangeCodec<Storage>::toMetres(rawFront()[index]);
     }
     throw std::out_of_range("Index out of bounds in getRange.");
 }
@@ -83,45 +293,40 @@ double LidarSensor::getRange(int index) const {
 /**
  * @brief Retrieves the minimum range value.
  *
- * Finds the minimum distance measured by the Lidar and returns the corresponding
- * range value along with its index.
+ * Finds the minimum valid distance measured by the Lidar and returns the
+ * corresponding range value along with its index. Zero and non-finite ranges
+ * are ignored.
  *
  * @param index Reference to store the index of the minimum range.
  * @return The minimum range value.
  */
-double LidarSensor::getMin(int& index) const {
-    double minVal = INFINITY; // En byk balang deeri
-    index = -1;
-
-    for (int i = 0; i < rangeNumber; ++i) {
-        if (ranges[i] < minVal) {
-            minVal = ranges[i];
-            index = i;
-        }
-    }
-
-    return minVal;
+template <typename Storage>
+double BasicLidarSensor<Storage>::getMin(int& index) const {
+    std::lock_guard<std::mutex> lock(frontMutex);
+    refreshStatistics();
+    index = statistics.minIndex;
+    return statistics.min;
 }
 
 /**
  * @brief Retrieves the maximum range value.
  *
- * Finds the maximum distance measured by the Lidar and returns the corresponding
- * range value along with its index.
+ * Finds the maximum valid distance measured by the Lidar and returns the
+ * corresponding range value along with its index. Zero and non-finite ranges
+ * are ignored.
  *
  * @param index Reference to store the index of the maximum range.
  * @return The maximum range value.
  */
-double LidarSensor::getMax(int& index) const {
-    double maxVal = std::numeric_limits<double>::lowest();
-    index = -1;
-    for (int i = 0; i < rangeNumber; ++i) {
-        if (ranges[i] > maxVal) {
-            maxVal = ranges[i];
-            index = i;
-        }
+template <typename Storage>
+double BasicLidarSensor<Storage>::getMax(int& index) const {
+    std::lock_guard<std::mutex> lock(frontMutex);
+    refreshStatistics();
+    index = statistics.maxIndex;
+    if (index < 0) {
+        return std::numeric_limits<double>::lowest();
     }
-    return maxVal;
+    return statistics.max;
 }
 
 /**
@@ -133,7 +338,8 @@ double LidarSensor::getMax(int& index) const {
  * @return The range value at the given index.
  * @throw std::out_of_range If the index is out of bounds.
  */
-double LidarSensor::operator[](int i) const {
+template <typename Storage>
+double BasicLidarSensor<Storage>::operator[](int i) const {
     return getRange(i);
 }
 
@@ -145,9 +351,308 @@ double LidarSensor::operator[](int i) const {
  * @param i The index of the desired range.
  * @return The angle corresponding to the specified range.
  */
-double LidarSensor::getAngle(int i) const {
+template <typename Storage>
+double BasicLidarSensor<Storage>::getAngle(int i) const {
     if (i >= 0 && i < rangeNumber) {
-        return i * (360.0 / rangeNumber);
+        return startAngle + i * (fieldOfView / rangeNumber);
     }
     return -1.0;
 }
+
+/**
+ * @brief Sets the angular layout of the scan and rebuilds the angle tables.
+ *
+ * @param fov Angular field of view covered by the scan (degrees).
+ * @param start Angle of the first beam (degrees).
+ * @throw std::invalid_argument If the field of view is not positive.
+ */
+template <typename Storage>
+void BasicLidarSensor<Storage>::setAngularLayout(double fov, double start) {
+    if (!(fov > 0.0)) {
+        throw std::invalid_argument("Field of view must be positive.");
+    }
+    std::lock_guard<std::mutex> lock(frontMutex);
+    fieldOfView = fov;
+    startAngle = start;
+    buildAngleTables();
+    buildSectorRuns();
+}
+
+template <typename Storage>
+double BasicLidarSensor<Storage>::getFieldOfView() const {
+    return fieldOfView;
+}
+
+template <typename Storage>
+double BasicLidarSensor<Storage>::getStartAngle() const {
+    return startAngle;
+}
+
+template <typename Storage>
+int BasicLidarSensor<Storage>::getRangeNumber() const {
+    std::lock_guard<std::mutex> lock(frontMutex);
+    return rangeNumber;
+}
+
+template <typename Storage>
+const float* BasicLidarSensor<Storage>::getRangeData() const {
+    return front();
+}
+
+template <typename Storage>
+const Storage* BasicLidarSensor<Storage>::getRawData() const {
+    return rawFront();
+}
+
+template <typename Storage>
+const float* BasicLidarSensor<Storage>::getCosTable() const {
+    return cosTable;
+}
+
+template <typename Storage>
+const float* BasicLidarSensor<Storage>::getSinTable() const {
+    return sinTable;
+}
+
+/**
+ * @brief Converts the latest scan into points in the sensor frame.
+ *
+ * @param out Batch receiving one point per beam.
+ */
+template <typename Storage>
+void BasicLidarSensor<Storage>::projectScan(PointBatch& out) const {
+    ScanProjector::project(front(), cosTable, sinTable, rangeNumber, out);
+}
+
+/**
+ * @brief Converts the latest scan into points in the world frame.
+ *
+ * @param out Batch receiving one point per beam.
+ * @param pose Pose of the sensor in the world frame.
+ */
+template <typename Storage>
+void BasicLidarSensor<Storage>::projectScan(PointBatch& out, Pose pose) const {
+    ScanProjector::project(front(), cosTable, sinTable, rangeNumber,
+        pose.getX(), pose.getY(), pose.getTh(), out);
+}
+
+/**
+ * @brief Maps the configured sectors onto beam index runs.
+ *
+ * A sector may wrap around 360 degrees, so it can cover more than one
+ * contiguous run of beams. The runs are computed once per configuration, which
+ * turns every sector query into a linear sweep over its beams.
+ */
+template <typename Storage>
+void BasicLidarSensor<Storage>::buildSectorRuns() {
+    sectorRuns.clear();
+    for (int k = 0; k < static_cast<int>(sectors.size()); ++k) {
+        double width = sectors[k].endAngle - sectors[k].startAngle;
+        int runBegin = -1;
+        for (int i = 0; i <= rangeNumber; ++i) {
+            bool inside = false;
+            if (i < rangeNumber) {
+                double offset = std::fmod(getAngle(i) - sectors[k].startAngle, 360.0);
+                if (offset < 0.0) {
+                    offset += 360.0;
+                }
+                inside = width >= 360.0 || offset < width;
+            }
+            if (inside && runBegin < 0) {
+                runBegin = i;
+            }
+            else if (!inside && runBegin >= 0) {
+                SectorRun run = { k, runBegin, i };
+                sectorRuns.push_back(run);
+                runBegin = -1;
+            }
+        }
+    }
+    sectorMin.assign(sectors.size(), std::numeric_limits<float>::infinity());
+    sectorMinIndex.assign(sectors.size(), -1);
+    statisticsValid = false;
+}
+
+/**
+ * @brief Recomputes the cached statistics and sector minimums if needed.
+ *
+ * Writes the caches from a const query, so the caller holds frontMutex.
+ */
+template <typename Storage>
+void BasicLidarSensor<Storage>::refreshStatistics() const {
+    if (statisticsValid) {
+        return;
+    }
+    const float* ranges = lockedFront();
+    ScanAnalyzer::computeStatistics(ranges, rangeNumber, statistics);
+
+    std::fill(sectorMin.begin(), sectorMin.end(), std::numeric_limits<float>::infinity());
+    std::fill(sectorMinIndex.begin(), sectorMinIndex.end(), -1);
+    for (size_t r = 0; r < sectorRuns.size(); ++r) {
+        const SectorRun& run = sectorRuns[r];
+        int index;
+        float value = ScanAnalyzer::minimumInRange(ranges, run.begin, run.end, index);
+        if (index >= 0 && value < sectorMin[run.sector]) {
+            sectorMin[run.sector] = value;
+            sectorMinIndex[run.sector] = index;
+        }
+    }
+    statisticsValid = true;
+}
+
+/**
+ * @brief Returns the statistics of the latest scan.
+ *
+ * Only update() invalidates the cache, so the reference stays valid on the
+ * owning thread until its next update.
+ *
+ * @return The cached statistics.
+ */
+template <typename Storage>
+const ScanStatistics& BasicLidarSensor<Storage>::getStatistics() const {
+    std::lock_guard<std::mutex> lock(frontMutex);
+    refreshStatistics();
+    return statistics;
+}
+
+/**
+ * @brief Copies the latest complete scan and its statistics.
+ *
+ * @param ranges Receives the ranges in float metres.
+ * @param stats Receives the statistics of the copied scan.
+ */
+template <typename Storage>
+void BasicLidarSensor<Storage>::copyScan(std::vector<float>& ranges, ScanStatistics& stats) const {
+    std::lock_guard<std::mutex> lock(frontMutex);
+    refreshStatistics();
+    const float* scan = lockedFront();
+    ranges.assign(scan, scan + rangeNumber);
+    stats = statistics;
+}
+
+/**
+ * @brief Replaces the angular sectors used for sector queries.
+ *
+ * @param newSectors Sectors in the sensor frame (degrees).
+ */
+template <typename Storage>
+void BasicLidarSensor<Storage>::setSectors(const std::vector<ScanSector>& newSectors) {
+    std::lock_guard<std::mutex> lock(frontMutex);
+    sectors = newSectors;
+    buildSectorRuns();
+}
+
+/**
+ * @brief Splits the field of view into equal sectors.
+ *
+ * @param count Number of sectors.
+ * @throw std::invalid_argument If count is not positive.
+ */
+template <typename Storage>
+void BasicLidarSensor<Storage>::setEqualSectors(int count) {
+    if (count <= 0) {
+        throw std::invalid_argument("Sector count must be positive.");
+    }
+    std::vector<ScanSector> bins(count);
+    double width = fieldOfView / count;
+    for (int k = 0; k < count; ++k) {
+        bins[k].startAngle = startAngle + k * width;
+        bins[k].endAngle = startAngle + (k + 1) * width;
+    }
+    setSectors(bins);
+}
+
+/**
+ * @brief Installs the front, left, rear and right quadrants.
+ *
+ * The sectors are indexed by the SECTOR enumeration, each 90 degrees wide and
+ * centred on 0, 90, 180 and 270 degrees respectively.
+ */
+template <typename Storage>
+void BasicLidarSensor<Storage>::setStandardSectors() {
+    std::vector<ScanSector> quadrants(4);
+    quadrants[SECTOR_FRONT].startAngle = -45.0;
+    quadrants[SECTOR_FRONT].endAngle = 45.0;
+    quadrants[SECTOR_LEFT].startAngle = 45.0;
+    quadrants[SECTOR_LEFT].endAngle = 135.0;
+    quadrants[SECTOR_REAR].startAngle = 135.0;
+    quadrants[SECTOR_REAR].endAngle = 225.0;
+    quadrants[SECTOR_RIGHT].startAngle = 225.0;
+    quadrants[SECTOR_RIGHT].endAngle = 315.0;
+    setSectors(quadrants);
+}
+
+template <typename Storage>
+int BasicLidarSensor<Storage>::getSectorCount() const {
+    return static_cast<int>(sectors.size());
+}
+
+/**
+ * @brief Retrieves the minimum range within a sector.
+ *
+ * @param sector Index of the sector.
+ * @param index Reference to store the beam index of the minimum, or -1.
+ * @return The minimum valid range in the sector, or +infinity if there is none.
+ * @throw std::out_of_range If the sector index is out of bounds.
+ */
+template <typename Storage>
+double BasicLidarSensor<Storage>::getSectorMin(int sector, int& index) const {
+    std::lock_guard<std::mutex> lock(frontMutex);
+    if (sector < 0 || sector >= static_cast<int>(sectors.size())) {
+        throw std::out_of_range("Sector index out of bounds in getSectorMin.");
+    }
+    refreshStatistics();
+    index = sectorMinIndex[sector];
+    return sectorMin[sector];
+}
+
+/**
+ * @brief Runs a filter chain over the latest scan.
+ *
+ * @param chain The filter chain to run.
+ * @return Number of filtered beams.
+ */
+template <typename Storage>
+int BasicLidarSensor<Storage>::filterScan(ScanFilterChain& chain) const {
+    return chain.process(front(), cosTable, sinTable, rangeNumber);
+}
+
+/**
+ * @brief Enables acquisition mode.
+ *
+ * The sensor adopts the number of ranges delivered by the API before the
+ * background thread starts.
+ *
+ * @param rateHz Polling rate in scans per second (0 = as fast as possible).
+ * @param slots Number of scans kept in the acquisition ring.
+ * @throw std::runtime_error If the robot API is not initialized.
+ */
+template <typename Storage>
+void BasicLidarSensor<Storage>::startAcquisition(double rateHz, int slots) {
+    if (!robotAPI) {
+        throw std::runtime_error("robotAPI is not initialized.");
+    }
+    stopAcquisition();
+    acquisition = new LidarAcquisition(robotAPI, slots);
+    adoptApiRangeNumber(acquisition->getBeamCount());
+    lastScanNumber = 0;
+    acquisition->start(rateHz);
+}
+
+/**
+ * @brief Disables acquisition mode and stops the background thread.
+ */
+template <typename Storage>
+void BasicLidarSensor<Storage>::stopAcquisition() {
+    delete acquisition;
+    acquisition = nullptr;
+}
+
+template <typename Storage>
+const LidarAcquisition* BasicLidarSensor<Storage>::getAcquisition() const {
+    return acquisition;
+}
+
+template class BasicLidarSensor<float>;
+template class BasicLidarSensor<double>;
+template class BasicLidarSensor<unsigned short>;
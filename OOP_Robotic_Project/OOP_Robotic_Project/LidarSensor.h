@@ -14,20 +14,126 @@
 #pragma once
 
 #include "../../oop_project/Project_Packet/FestoRobotAPI.h"
+#include "LidarAcquisition.h"
+#include "PointBatch.h"
+#include "Pose.h"
+#include "RangeCodec.h"
+#include "ScanAnalyzer.h"
+#include "ScanFilterChain.h"
+#include <mutex>
+#include <vector>
 
  /**
-  * @class LidarSensor
+  * @class BasicLidarSensor
   * @brief Represents a Lidar sensor system for distance measurement.
   *
   * The LidarSensor class interacts with a robot API to retrieve and store Lidar
   * range data. It supports functionality for getting range values, finding the
   * minimum and maximum ranges, and accessing the data via the subscript operator.
+  *
+  * Scans are acquired with a single bulk API call into one of two aligned
+  * buffers. The buffer being filled (back) is only published as the readable
+  * (front) buffer once the scan is complete, so queries never observe a
+  * partially updated scan.
+  *
+  * The buffers hold `Storage` values: float metres (LidarSensor), double metres
+  * (DoubleLidarSensor) or unsigned 16-bit millimetres (MillimetreLidarSensor,
+  * half the footprint of float). Conversions are done in bulk by RangeCodec.
+  * Single-range queries read the stored value directly; whole-scan queries
+  * (statistics, projection, filtering, getRangeData()) use a float view that
+  * non-float sensors decode once per scan, on first use.
+  *
+  * The angle, cosine and sine of every beam are precomputed whenever the angular
+  * layout (field of view and start angle) changes, so projecting a scan into
+  * Cartesian points needs no trigonometric calls.
+  *
+  * Scan statistics and per-sector minimums are computed on the first query
+  * after an update and cached until the next update.
+  *
+  * update() fills the back buffer without a lock and takes `frontMutex` only
+  * to publish it, so the value queries (getRange(), operator[], getMin(),
+  * getMax(), getSectorMin(), getRangeNumber() and copyScan()) may be called
+  * from other threads while the owning thread updates: they read the front
+  * buffer and fill the caches under the same lock, and always see one complete
+  * scan. The queries that return pointers or references into the sensor
+  * (getRangeData(), getRawData(), getStatistics(), projectScan(),
+  * filterScan()), getAngle() and the configuration calls belong to the owning
+  * thread, since the next update() replaces what they point to.
+  *
+  * In acquisition mode a LidarAcquisition thread polls the Lidar in the
+  * background and update() only copies its latest scan, so callers never block
+  * on the robot API.
   */
-class LidarSensor {
+template <typename Storage>
+class BasicLidarSensor {
 private:
-    double* ranges;           /*!< Array to dynamically store Lidar range values. */
-    int rangeNumber;          /*!< Number of ranges measured by the Lidar sensor. */
-    FestoRobotAPI* robotAPI;  /*!< Pointer to the robot API for hardware interaction. */
+    Storage* buffers[2];          /*!< Front/back scan buffers (cache-line aligned). */
+    mutable float* view;          /*!< Float view of the front buffer (nullptr for float storage). */
+    float* staging;               /*!< Float buffer the API writes into (nullptr for float storage). */
+    mutable bool viewValid;       /*!< True if `view` holds the decoded front buffer. */
+    int frontIndex;               /*!< Index of the buffer holding the latest complete scan. */
+    mutable std::mutex frontMutex; /*!< Protects frontIndex, the caches and the scan layout against concurrent readers. */
+    int bufferCapacity;           /*!< Number of ranges allocated for each buffer. */
+    int apiRangeNumber;           /*!< Number of ranges delivered by the API (0 until queried). */
+    int rangeNumber;              /*!< Number of ranges measured by the Lidar sensor. */
+    FestoRobotAPI* robotAPI;      /*!< Pointer to the robot API for hardware interaction. */
+    double fieldOfView;           /*!< Angular field of view covered by the scan (degrees). */
+    double startAngle;            /*!< Angle of the first beam (degrees). */
+    float* cosTable;              /*!< Cosine of each beam angle. */
+    float* sinTable;              /*!< Sine of each beam angle. */
+
+    /**
+     * @struct SectorRun
+     * @brief A contiguous run of beam indices belonging to a sector.
+     */
+    struct SectorRun {
+        int sector;  /*!< Index of the sector. */
+        int begin;   /*!< First beam index (inclusive). */
+        int end;     /*!< Last beam index (exclusive). */
+    };
+
+    std::vector<ScanSector> sectors;      /*!< Configured angular sectors. */
+    std::vector<SectorRun> sectorRuns;    /*!< Beam index runs of each sector. */
+    mutable std::vector<float> sectorMin; /*!< Cached minimum range of each sector. */
+    mutable std::vector<int> sectorMinIndex; /*!< Cached beam index of each sector minimum. */
+    mutable ScanStatistics statistics;    /*!< Cached statistics of the front buffer. */
+    mutable bool statisticsValid;         /*!< True if the cached statistics match the front buffer. */
+    LidarAcquisition* acquisition;        /*!< Background acquisition, or nullptr when disabled. */
+    unsigned long long lastScanNumber;    /*!< Number of the acquisition scan in the front buffer. */
+
+    //! Maps the configured sectors onto beam index runs
+    void buildSectorRuns();
+
+    //! Recomputes the cached statistics and sector minimums if needed (frontMutex held)
+    void refreshStatistics() const;
+
+    //! Rebuilds the per-beam cosine and sine tables
+    void buildAngleTables();
+
+    //! Adopts the number of ranges delivered by the robot API
+    /*!
+     * @param count Number of ranges reported by the API.
+     * @throw std::runtime_error If the count is not positive.
+     */
+    void adoptApiRangeNumber(int count);
+
+    //! Allocates zeroed scan buffers
+    /*!
+     * Releases the current buffers and allocates two new zero filled buffers
+     * (and the float view and staging buffers for non-float storage) with room
+     * for the given number of ranges.
+     * @param capacity Number of ranges per buffer.
+     */
+    void allocateBuffers(int capacity);
+
+    //! Returns the buffer holding the latest complete scan
+    const Storage* rawFront() const;
+
+    //! Returns the latest complete scan as float metres (frontMutex held)
+    const float* lockedFront() const;
+
+    //! Returns the latest complete scan as float metres
+    const float* front() const;
 
 public:
     //! Constructor
@@ -35,20 +141,24 @@ public:
      * Initializes the LidarSensor object with the specified robot API and
      * number of range values.
      * @param api A pointer to a FestoRobotAPI object for interacting with the sensor.
-     * @param numRanges The number of ranges to be stored in the sensor.
+     * @param numRanges The number of ranges to be stored in the sensor until
+     *        the first update, which adopts the number reported by the API.
      */
-    LidarSensor(FestoRobotAPI* api, int numRanges);
+    BasicLidarSensor(FestoRobotAPI* api, int numRanges);
 
     //! Destructor
     /*!
-     * Frees dynamically allocated memory for the ranges array.
+     * Frees the dynamically allocated scan buffers.
      */
-    ~LidarSensor();
+    ~BasicLidarSensor();
 
     //! Updates the Lidar range data
     /*!
-     * Retrieves the latest Lidar measurements from the robot API and stores them
-     * in the `ranges` array.
+     * Retrieves the latest Lidar scan from the robot API with a single bulk call
+     * into the back buffer, then publishes it as the front buffer. In
+     * acquisition mode the latest background scan is copied instead and the
+     * front buffer is left untouched if no new scan is available.
+     * @throw std::runtime_error If the robot API is not initialized.
      */
     void update();
 
@@ -63,8 +173,8 @@ public:
 
     //! Retrieves the minimum range value
     /*!
-     * Finds the minimum distance measured by the Lidar and returns the corresponding
-     * range value along with its index.
+     * Finds the minimum valid distance (finite and greater than zero) measured by
+     * the Lidar and returns the corresponding range value along with its index.
      * @param index Reference to store the index of the minimum range.
      * @return The minimum range value.
      */
@@ -72,8 +182,8 @@ public:
 
     //! Retrieves the maximum range value
     /*!
-     * Finds the maximum distance measured by the Lidar and returns the corresponding
-     * range value along with its index.
+     * Finds the maximum valid distance (finite and greater than zero) measured by
+     * the Lidar and returns the corresponding range value along with its index.
      * @param index Reference to store the index of the maximum range.
      * @return The maximum range value.
      */
@@ -95,4 +205,139 @@ public:
      * @return The angle corresponding to the specified range.
      */
     double getAngle(int i) const;
+
+    //! Sets the angular layout of the scan
+    /*!
+     * Beam i is located at `start + i * (fov / rangeNumber)` degrees. The
+     * cosine and sine tables are rebuilt.
+     * @param fov Angular field of view covered by the scan (degrees).
+     * @param start Angle of the first beam (degrees).
+     * @throw std::invalid_argument If the field of view is not positive.
+     */
+    void setAngularLayout(double fov, double start);
+
+    //! Returns the angular field of view of the scan (degrees)
+    double getFieldOfView() const;
+
+    //! Returns the angle of the first beam (degrees)
+    double getStartAngle() const;
+
+    //! Returns the number of ranges measured by the Lidar sensor
+    int getRangeNumber() const;
+
+    //! Returns the range values of the latest complete scan
+    /*!
+     * The pointer refers to the front buffer (or its float view) and stays
+     * valid until the next update.
+     */
+    const float* getRangeData() const;
+
+    //! Returns the stored values of the latest complete scan
+    /*!
+     * Convert them with RangeCodec<Storage>. The pointer stays valid until the
+     * next update.
+     */
+    const Storage* getRawData() const;
+
+    //! Returns the precomputed cosine of each beam angle
+    const float* getCosTable() const;
+
+    //! Returns the precomputed sine of each beam angle
+    const float* getSinTable() const;
+
+    //! Converts the latest scan into points in the sensor frame
+    /*!
+     * @param out Batch receiving one point per beam.
+     */
+    void projectScan(PointBatch& out) const;
+
+    //! Converts the latest scan into points in the world frame
+    /*!
+     * @param out Batch receiving one point per beam.
+     * @param pose Pose of the sensor in the world frame.
+     */
+    void projectScan(PointBatch& out, Pose pose) const;
+
+    //! Returns the statistics of the latest scan
+    /*!
+     * Min/max/argmin/argmax, mean and the number of valid beams, computed in
+     * a single vectorized pass and cached until the next update.
+     * @return The cached statistics.
+     */
+    const ScanStatistics& getStatistics() const;
+
+    //! Copies the latest complete scan and its statistics
+    /*!
+     * Safe to call from other threads while the owning thread updates: the
+     * ranges and the statistics always come from the same scan.
+     * @param ranges Receives the ranges in float metres.
+     * @param stats Receives the statistics of the copied scan.
+     */
+    void copyScan(std::vector<float>& ranges, ScanStatistics& stats) const;
+
+    //! Replaces the angular sectors used for sector queries
+    /*!
+     * @param newSectors Sectors in the sensor frame (degrees).
+     */
+    void setSectors(const std::vector<ScanSector>& newSectors);
+
+    //! Splits the field of view into equal sectors
+    /*!
+     * @param count Number of sectors.
+     * @throw std::invalid_argument If count is not positive.
+     */
+    void setEqualSectors(int count);
+
+    //! Installs the front, left, rear and right quadrants (see SECTOR)
+    void setStandardSectors();
+
+    //! Returns the number of configured sectors
+    int getSectorCount() const;
+
+    //! Retrieves the minimum range within a sector
+    /*!
+     * @param sector Index of the sector.
+     * @param index Reference to store the beam index of the minimum, or -1.
+     * @return The minimum valid range in the sector, or +infinity if there is none.
+     * @throw std::out_of_range If the sector index is out of bounds.
+     */
+    double getSectorMin(int sector, int& index) const;
+
+    //! Runs a filter chain over the latest scan
+    /*!
+     * The sensor's own buffers are not modified; the filtered scan and its
+     * beam angles are available from the chain.
+     * @param chain The filter chain to run.
+     * @return Number of filtered beams.
+     */
+    int filterScan(ScanFilterChain& chain) const;
+
+    //! Enables acquisition mode
+    /*!
+     * Starts a background thread polling the Lidar at the given rate.
+     * @param rateHz Polling rate in scans per second (0 = as fast as possible).
+     * @param slots Number of scans kept in the acquisition ring.
+     * @throw std::runtime_error If the robot API is not initialized.
+     */
+    void startAcquisition(double rateHz, int slots = 8);
+
+    //! Disables acquisition mode and stops the background thread
+    void stopAcquisition();
+
+    //! Returns the background acquisition, or nullptr when disabled
+    /*!
+     * Consumers can read scans from it directly, without copying.
+     */
+    const LidarAcquisition* getAcquisition() const;
 };
+
+/*! Lidar sensor storing ranges as float metres, as delivered by the API. */
+typedef BasicLidarSensor<float> LidarSensor;
+/*! Lidar sensor storing ranges as double metres. */
+typedef BasicLidarSensor<double> DoubleLidarSensor;
+/*! Lidar sensor storing ranges as unsigned 16-bit millimetres. */
+typedef BasicLidarSensor<unsigned short> MillimetreLidarSensor;
+
+extern template class BasicLidarSensor<float>;
+extern template class BasicLidarSensor<double>;
+extern template class BasicLidarSensor<unsigned short>;
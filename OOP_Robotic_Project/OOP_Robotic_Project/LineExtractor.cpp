@@ -0,0 +1,299 @@
+/**
+ * @file   LineExtractor.cpp
+ * @author Furkan Gemici
+ * @date   December, 2024
+ * @brief  Implementation file for the LineExtractor class.
+ */
+
+#include "LineExtractor.h"
+#include <cmath>
+#include <stdexcept>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace {
+    /**
+     * @brief Total least squares line of a point set given by its sums.
+     *
+     * @param residual Receives the sum of squared point-to-line distances.
+     */
+    template <typename M>
+    void lineFromMoments(const M& m, double& alpha, double& distance, double& residual) {
+        double mx = m.sx / m.n;
+        double my = m.sy / m.n;
+        double cxx = m.sxx / m.n - mx * mx;
+        double cyy = m.syy / m.n - my * my;
+        double cxy = m.sxy / m.n - mx * my;
+        alpha = 0.5 * std::atan2(-2.0 * cxy, cyy - cxx);
+        distance = mx * std::cos(alpha) + my * std::sin(alpha);
+        if (distance < 0.0) {
+            distance = -distance;
+            alpha += alpha < 0.0 ? M_PI : -M_PI;
+        }
+        double c = std::cos(alpha);
+        double s = std::sin(alpha);
+        residual = m.n * (cxx * c * c + 2.0 * cxy * c * s + cyy * s * s);
+        if (residual < 0.0) {
+            residual = 0.0;
+        }
+    }
+
+    template <typename M>
+    void addPoint(M& m, double x, double y) {
+        m.n += 1.0;
+        m.sx += x;
+        m.sy += y;
+        m.sxx += x * x;
+        m.syy += y * y;
+        m.sxy += x * y;
+    }
+
+    template <typename M>
+    void addMoments(M& m, const M& other) {
+        m.n += other.n;
+        m.sx += other.sx;
+        m.sy += other.sy;
+        m.sxx += other.sxx;
+        m.syy += other.syy;
+        m.sxy += other.sxy;
+    }
+
+    bool isFinitePoint(float x, float y) {
+        return std::isfinite(x) && std::isfinite(y);
+    }
+}
+
+/**
+ * @brief Constructor for LineExtractor.
+ *
+ * @throw std::invalid_argument If a parameter is not positive or minPoints is below 2.
+ */
+LineExtractor::LineExtractor(double maxDeviation, double maxGap, int minPoints, double minLength)
+    : maxDeviation(maxDeviation), maxGap(maxGap), minPoints(minPoints), minLength(minLength), minCornerAngle(30.0) {
+    if (!(maxDeviation > 0.0) || !(maxGap > 0.0) || !(minLength > 0.0) || minPoints < 2) {
+        throw std::invalid_argument("Invalid line extraction parameters.");
+    }
+}
+
+void LineExtractor::setMinCornerAngle(double degrees) {
+    if (!(degrees > 0.0 && degrees <= 90.0)) {
+        throw std::invalid_argument("Corner angle must be in (0, 90] degrees.");
+    }
+    minCornerAngle = degrees;
+}
+
+/**
+ * @brief Fits a line to a segment's sums and stores it with its endpoints.
+ *
+ * The endpoints are the first and last points projected onto the line. The
+ * covariance of (alpha, distance) is the inverse of the least squares
+ * information matrix, scaled by the residual variance.
+ */
+void LineExtractor::fitSegment(const Moments& m, const float* xs, const float* ys,
+    int first, int last, LineSegment& segment) const {
+    double alpha, distance, residual;
+    lineFromMoments(m, alpha, distance, residual);
+    double c = std::cos(alpha);
+    double s = std::sin(alpha);
+
+    double d = xs[first] * c + ys[first] * s - distance;
+    segment.startX = static_cast<float>(xs[first] - d * c);
+    segment.startY = static_cast<float>(ys[first] - d * s);
+    d = xs[last] * c + ys[last] * s - distance;
+    segment.endX = static_cast<float>(xs[last] - d * c);
+    segment.endY = static_cast<float>(ys[last] - d * s);
+
+    // t is the coordinate along the line; the residual derivatives are (t, -1)
+    double sumT = -m.sx * s + m.sy * c;
+    double sumTT = m.sxx * s * s - 2.0 * m.sxy * s * c + m.syy * c * c;
+    double det = m.n * sumTT - sumT * sumT;
+    double variance = m.n > 2.0 ? residual / (m.n - 2.0) : 0.0;
+    if (det > 0.0) {
+        segment.varAlpha = static_cast<float>(variance * m.n / det);
+        segment.covAlphaDist = static_cast<float>(variance * sumT / det);
+        segment.varDistance = static_cast<float>(variance * sumTT / det);
+    }
+    else {
+        segment.varAlpha = segment.covAlphaDist = segment.varDistance = 0.0f;
+    }
+
+    segment.alpha = static_cast<float>(alpha);
+    segment.distance = static_cast<float>(distance);
+    segment.firstIndex = first;
+    segment.lastIndex = last;
+    segment.pointCount = static_cast<int>(m.n);
+}
+
+/**
+ * @brief Appends the segment described by `m` if it is long enough.
+ */
+void LineExtractor::closeSegment(const Moments& m, const float* xs, const float* ys, int first, int last) {
+    if (m.n < minPoints) {
+        return;
+    }
+    LineSegment segment;
+    fitSegment(m, xs, ys, first, last, segment);
+    double dx = segment.endX - segment.startX;
+    double dy = segment.endY - segment.startY;
+    if (dx * dx + dy * dy < minLength * minLength) {
+        return;
+    }
+    segments.push_back(segment);
+    moments.push_back(m);
+}
+
+/**
+ * @brief Returns true if segment `b` continues segment `a` on the same line.
+ *
+ * @param merged Receives the sums of both segments.
+ */
+bool LineExtractor::canMerge(int a, int b, const float* xs, const float* ys, Moments& merged) const {
+    const LineSegment& first = segments[a];
+    const LineSegment& second = segments[b];
+    double gapX = xs[second.firstIndex] - xs[first.lastIndex];
+    double gapY = ys[second.firstIndex] - ys[first.lastIndex];
+    if (gapX * gapX + gapY * gapY > maxGap * maxGap) {
+        return false;
+    }
+    merged = moments[a];
+    addMoments(merged, moments[b]);
+    double alpha, distance, residual;
+    lineFromMoments(merged, alpha, distance, residual);
+    double c = std::cos(alpha);
+    double s = std::sin(alpha);
+    const int ends[4] = { first.firstIndex, first.lastIndex, second.firstIndex, second.lastIndex };
+    for (int e = 0; e < 4; ++e) {
+        if (std::fabs(xs[ends[e]] * c + ys[ends[e]] * s - distance) > maxDeviation) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Joins neighbouring collinear segments in place.
+ */
+void LineExtractor::mergeSegments(const float* xs, const float* ys, bool fullCircle) {
+    Moments merged;
+    int kept = 0;
+    for (int k = 0; k < static_cast<int>(segments.size()); ++k) {
+        if (kept > 0 && canMerge(kept - 1, k, xs, ys, merged)) {
+            moments[kept - 1] = merged;
+            fitSegment(merged, xs, ys, segments[kept - 1].firstIndex, segments[k].lastIndex, segments[kept - 1]);
+        }
+        else {
+            segments[kept] = segments[k];
+            moments[kept] = moments[k];
+            ++kept;
+        }
+    }
+    if (fullCircle && kept > 1 && canMerge(kept - 1, 0, xs, ys, merged)) {
+        moments[0] = merged;
+        fitSegment(merged, xs, ys, segments[kept - 1].firstIndex, segments[0].lastIndex, segments[0]);
+        --kept;
+    }
+    segments.resize(kept);
+    moments.resize(kept);
+}
+
+/**
+ * @brief Detects corners between neighbouring segments whose ends touch.
+ */
+void LineExtractor::findCorners(bool fullCircle) {
+    const int count = static_cast<int>(segments.size());
+    const int pairs = fullCircle && count > 2 ? count : count - 1;
+    const double minAngle = minCornerAngle * M_PI / 180.0;
+    for (int k = 0; k < pairs; ++k) {
+        const LineSegment& a = segments[k];
+        const LineSegment& b = segments[(k + 1) % count];
+        double gapX = b.startX - a.endX;
+        double gapY = b.startY - a.endY;
+        if (gapX * gapX + gapY * gapY > maxGap * maxGap) {
+            continue;
+        }
+        double angle = std::fmod(std::fabs(static_cast<double>(b.alpha) - a.alpha), M_PI);
+        if (angle > M_PI / 2.0) {
+            angle = M_PI - angle;
+        }
+        if (angle < minAngle) {
+            continue;
+        }
+        double det = std::sin(static_cast<double>(b.alpha) - a.alpha);
+        CornerFeature corner;
+        corner.x = static_cast<float>((a.distance * std::sin(b.alpha) - b.distance * std::sin(a.alpha)) / det);
+        corner.y = static_cast<float>((b.distance * std::cos(a.alpha) - a.distance * std::cos(b.alpha)) / det);
+        corner.angle = static_cast<float>(angle * 180.0 / M_PI);
+        corner.firstSegment = k;
+        corner.secondSegment = (k + 1) % count;
+        corners.push_back(corner);
+    }
+}
+
+/**
+ * @brief Extracts segments and corners from points in beam order.
+ *
+ * @return Number of extracted segments.
+ */
+int LineExtractor::extract(const PointBatch& scan, bool fullCircle) {
+    segments.clear();
+    moments.clear();
+    corners.clear();
+
+    const float* xs = scan.getX();
+    const float* ys = scan.getY();
+    const int count = scan.size();
+    const double gap2 = maxGap * maxGap;
+
+    Moments current = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+    int first = -1;
+    int last = -1;
+    for (int i = 0; i < count; ++i) {
+        if (!isFinitePoint(xs[i], ys[i])) {
+            continue;
+        }
+        if (current.n > 0.0) {
+            double dx = xs[i] - xs[last];
+            double dy = ys[i] - ys[last];
+            bool split = dx * dx + dy * dy > gap2;
+            if (!split && current.n >= 2.0) {
+                double alpha, distance, residual;
+                lineFromMoments(current, alpha, distance, residual);
+                split = std::fabs(xs[i] * std::cos(alpha) + ys[i] * std::sin(alpha) - distance) > maxDeviation;
+            }
+            if (split) {
+                closeSegment(current, xs, ys, first, last);
+                current = Moments{ 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+            }
+        }
+        if (current.n == 0.0) {
+            first = i;
+        }
+        addPoint(current, xs[i], ys[i]);
+        last = i;
+    }
+    if (current.n > 0.0) {
+        closeSegment(current, xs, ys, first, last);
+    }
+
+    mergeSegments(xs, ys, fullCircle);
+    findCorners(fullCircle);
+    return static_cast<int>(segments.size());
+}
+
+/**
+ * @brief Extracts features from the current scan of a Lidar.
+ */
+int LineExtractor::extract(const LidarSensor& lidar) {
+    lidar.projectScan(points);
+    return extract(points, lidar.getFieldOfView() >= 360.0);
+}
+
+const std::vector<LineSegment>& LineExtractor::getSegments() const {
+    return segments;
+}
+
+const std::vector<CornerFeature>& LineExtractor::getCorners() const {
+    return corners;
+}
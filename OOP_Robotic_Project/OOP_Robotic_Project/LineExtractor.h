@@ -0,0 +1,136 @@
+/**
+ * @file   LineExtractor.h
+ * @author Furkan Gemici
+ * @date   December, 2024
+ * @brief  Header file for the LineExtractor class.
+ *
+ * This file contains the definition of the LineExtractor class, which turns
+ * Lidar scans into wall segments and corner features.
+ */
+
+#pragma once
+
+#include "LidarSensor.h"
+#include "PointBatch.h"
+#include <vector>
+
+ /**
+  * @brief A wall segment fitted to consecutive scan points.
+  *
+  * The infinite line is stored in Hessian normal form,
+  * x * cos(alpha) + y * sin(alpha) = distance, with distance >= 0.
+  */
+struct LineSegment {
+    float startX;        /*!< X-coordinate of the first endpoint (meters). */
+    float startY;        /*!< Y-coordinate of the first endpoint (meters). */
+    float endX;          /*!< X-coordinate of the last endpoint (meters). */
+    float endY;          /*!< Y-coordinate of the last endpoint (meters). */
+    float alpha;         /*!< Direction of the line normal (radians). */
+    float distance;      /*!< Distance of the line from the sensor (meters). */
+    float varAlpha;      /*!< Variance of alpha (radians^2). */
+    float covAlphaDist;  /*!< Covariance of alpha and distance. */
+    float varDistance;   /*!< Variance of distance (meters^2). */
+    int firstIndex;      /*!< Index of the first point in the scan. */
+    int lastIndex;       /*!< Index of the last point in the scan (may be below firstIndex if the segment wraps around). */
+    int pointCount;      /*!< Number of points in the fit. */
+};
+
+ /**
+  * @brief A corner where two consecutive wall segments meet.
+  */
+struct CornerFeature {
+    float x;             /*!< X-coordinate of the line intersection (meters). */
+    float y;             /*!< Y-coordinate of the line intersection (meters). */
+    float angle;         /*!< Angle between the two walls (degrees, 0-90). */
+    int firstSegment;    /*!< Index of the first segment. */
+    int secondSegment;   /*!< Index of the second segment. */
+};
+
+ /**
+  * @class LineExtractor
+  * @brief Incremental line fitting with a merge pass and corner detection.
+  *
+  * Points are visited once in beam order. Each segment keeps running sums of
+  * its coordinates, so the total least squares line of the segment is updated
+  * in constant time per point; a point that lies too far from that line, or
+  * too far from the previous point, closes the segment. A merge pass then
+  * joins neighbouring collinear segments (including across the start of a
+  * full-circle scan) by adding their sums. The fit covariance follows from the
+  * same sums.
+  *
+  * Segment and corner buffers are kept between scans and only grow.
+  */
+class LineExtractor {
+private:
+    /**
+     * @brief Running coordinate sums of a segment.
+     */
+    struct Moments {
+        double n, sx, sy, sxx, syy, sxy;
+    };
+
+    std::vector<LineSegment> segments;  /*!< Extracted segments of the last scan. */
+    std::vector<Moments> moments;       /*!< Sums of each extracted segment. */
+    std::vector<CornerFeature> corners; /*!< Extracted corners of the last scan. */
+    PointBatch points;                  /*!< Scratch batch for extract(const LidarSensor&). */
+    double maxDeviation;                /*!< Largest point-to-line distance in a segment (meters). */
+    double maxGap;                      /*!< Largest distance between consecutive points (meters). */
+    int minPoints;                      /*!< Fewest points in a segment. */
+    double minLength;                   /*!< Shortest segment (meters). */
+    double minCornerAngle;              /*!< Smallest angle between walls at a corner (degrees). */
+
+    //! Fits a line to a segment's sums and stores it with its endpoints
+    void fitSegment(const Moments& m, const float* xs, const float* ys,
+        int first, int last, LineSegment& segment) const;
+
+    //! Appends the segment described by `m` if it is long enough
+    void closeSegment(const Moments& m, const float* xs, const float* ys, int first, int last);
+
+    //! Returns true if two segments lie on one line and touch
+    bool canMerge(int a, int b, const float* xs, const float* ys, Moments& merged) const;
+
+    //! Joins neighbouring collinear segments
+    void mergeSegments(const float* xs, const float* ys, bool fullCircle);
+
+    //! Detects corners between neighbouring segments
+    void findCorners(bool fullCircle);
+
+public:
+    //! Constructor
+    /*!
+     * @param maxDeviation Largest point-to-line distance in a segment (meters).
+     * @param maxGap Largest distance between consecutive points of a segment (meters).
+     * @param minPoints Fewest points in a segment.
+     * @param minLength Shortest segment (meters).
+     * @throw std::invalid_argument If a parameter is not positive or minPoints is below 2.
+     */
+    LineExtractor(double maxDeviation = 0.03, double maxGap = 0.3, int minPoints = 5, double minLength = 0.2);
+
+    //! Sets the smallest angle between walls reported as a corner
+    /*!
+     * @param degrees Angle in degrees, between 0 and 90.
+     * @throw std::invalid_argument If the angle is out of range.
+     */
+    void setMinCornerAngle(double degrees);
+
+    //! Extracts features from points in beam order
+    /*!
+     * @param scan Points in the sensor frame. Non-finite points are skipped.
+     * @param fullCircle True if the last beam is adjacent to the first one.
+     * @return Number of extracted segments.
+     */
+    int extract(const PointBatch& scan, bool fullCircle = false);
+
+    //! Extracts features from the current scan of a Lidar
+    /*!
+     * @param lidar The sensor whose last scan is used.
+     * @return Number of extracted segments.
+     */
+    int extract(const LidarSensor& lidar);
+
+    //! Returns the segments of the last scan
+    const std::vector<LineSegment>& getSegments() const;
+
+    //! Returns the corners of the last scan
+    const std::vector<CornerFeature>& getCorners() const;
+};
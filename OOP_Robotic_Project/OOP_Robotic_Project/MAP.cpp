@@ -8,6 +8,34 @@
  * getter and setter methods, utility methods, and operations to manipulate a grid.
  */
 #include "Map.h"
+#include "MapSnapshot.h"
+#include "AlignedMemory.h"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <string>
+#include <utility>
+
+namespace {
+    /**
+     * @brief Appends raw bytes to a delta buffer.
+     */
+    void appendBytes(std::vector<unsigned char>& out, const void* data, size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        out.insert(out.end(), bytes, bytes + size);
+    }
+
+    /**
+     * @brief Rounds a row length up to a whole number of cache lines.
+     */
+    int alignedStride(int sizeX) {
+        const int line = static_cast<int>(CACHE_LINE_SIZE);
+        return (sizeX + line - 1) / line * line;
+    }
+}
+
+const int Map::DIRTY_TILE_SHIFT;
+const int Map::DIRTY_TILE_SIZE;
 
  /**
   * @brief Constructor for creating a grid with given dimensions and initializing all cells to 0.
@@ -15,19 +43,247 @@
   * @param sizeX The number of columns in the grid.
   * @param sizeY The number of rows in the grid.
   */
-Map::Map(int sizeX, int sizeY) : gridSizeX(sizeX), gridSizeY(sizeY) {
-    // Resize the grid to the specified dimensions and initialize all cells to 0
-    grid.resize(gridSizeY, std::vector<int>(gridSizeX, 0));
+Map::Map(int sizeX, int sizeY) : cells(nullptr), stride(0), gridSizeX(0), gridSizeY(0),
+    dirtyTilesX(0), dirtyTilesY(0), version(0), clearedVersion(0), clearValue(0) {
+    // Allocate the grid with the specified dimensions and initialize all cells to 0
+    reallocate(sizeX, sizeY);
+    clearedVersion = version;
+}
+
+/**
+ * @brief Copy constructor. Copies all cells, including the row padding.
+ */
+Map::Map(const Map& other) : cells(nullptr), stride(other.stride), gridSizeX(other.gridSizeX), gridSizeY(other.gridSizeY),
+    dirtyTilesX(other.dirtyTilesX), dirtyTilesY(other.dirtyTilesY), dirtyBits(other.dirtyBits),
+    tileVersions(other.tileVersions), version(other.version), clearedVersion(other.clearedVersion),
+    clearValue(other.clearValue), snapshotTiles(other.snapshotTiles), snapshotVersions(other.snapshotVersions) {
+    cells = alignedAllocate<MapCell>(static_cast<size_t>(stride) * gridSizeY);
+    std::memcpy(cells, other.cells, static_cast<size_t>(stride) * gridSizeY);
+}
+
+/**
+ * @brief Move constructor. Takes over the other map's buffer and leaves it empty.
+ */
+Map::Map(Map&& other) : cells(other.cells), stride(other.stride), gridSizeX(other.gridSizeX), gridSizeY(other.gridSizeY),
+    dirtyTilesX(other.dirtyTilesX), dirtyTilesY(other.dirtyTilesY), dirtyBits(std::move(other.dirtyBits)),
+    tileVersions(std::move(other.tileVersions)), version(other.version), clearedVersion(other.clearedVersion),
+    clearValue(other.clearValue), snapshotTiles(std::move(other.snapshotTiles)),
+    snapshotVersions(std::move(other.snapshotVersions)) {
+    other.cells = nullptr;
+    other.stride = 0;
+    other.gridSizeX = 0;
+    other.gridSizeY = 0;
+    other.dirtyTilesX = 0;
+    other.dirtyTilesY = 0;
+    other.dirtyBits.clear();
+    other.tileVersions.clear();
+    other.snapshotTiles.clear();
+    other.snapshotVersions.clear();
+}
+
+/**
+ * @brief Copy assignment. Copies all cells.
+ */
+Map& Map::operator=(const Map& other) {
+    if (this != &other) {
+        Map copy(other);
+        std::swap(cells, copy.cells);
+        std::swap(stride, copy.stride);
+        std::swap(gridSizeX, copy.gridSizeX);
+        std::swap(gridSizeY, copy.gridSizeY);
+        std::swap(dirtyTilesX, copy.dirtyTilesX);
+        std::swap(dirtyTilesY, copy.dirtyTilesY);
+        dirtyBits.swap(copy.dirtyBits);
+        tileVersions.swap(copy.tileVersions);
+        std::swap(version, copy.version);
+        std::swap(clearedVersion, copy.clearedVersion);
+        std::swap(clearValue, copy.clearValue);
+        snapshotTiles.swap(copy.snapshotTiles);
+        snapshotVersions.swap(copy.snapshotVersions);
+    }
+    return *this;
+}
+
+/**
+ * @brief Frees the cell buffer.
+ */
+Map::~Map() {
+    alignedFree(cells);
+}
+
+/**
+ * @brief Replaces the buffer with a zeroed one of the given size.
+ *
+ * Cells inside both the old and the new size are copied row by row.
+ *
+ * @param sizeX The new number of columns (negative values are treated as 0).
+ * @param sizeY The new number of rows (negative values are treated as 0).
+ */
+void Map::reallocate(int sizeX, int sizeY) {
+    sizeX = sizeX > 0 ? sizeX : 0;
+    sizeY = sizeY > 0 ? sizeY : 0;
+    const int newStride = alignedStride(sizeX);
+    MapCell* newCells = alignedAllocate<MapCell>(static_cast<size_t>(newStride) * sizeY);
+    std::memset(newCells, 0, static_cast<size_t>(newStride) * sizeY);
+
+    if (cells) {
+        const int keepX = sizeX < gridSizeX ? sizeX : gridSizeX;
+        const int keepY = sizeY < gridSizeY ? sizeY : gridSizeY;
+        for (int y = 0; y < keepY; ++y) {
+            std::memcpy(newCells + static_cast<size_t>(y) * newStride, getRow(y), keepX);
+        }
+        alignedFree(cells);
+    }
+    cells = newCells;
+    stride = newStride;
+    gridSizeX = sizeX;
+    gridSizeY = sizeY;
+
+    // A resize changes every tile
+    dirtyTilesX = (sizeX + DIRTY_TILE_SIZE - 1) >> DIRTY_TILE_SHIFT;
+    dirtyTilesY = (sizeY + DIRTY_TILE_SIZE - 1) >> DIRTY_TILE_SHIFT;
+    const size_t tileCount = static_cast<size_t>(dirtyTilesX) * dirtyTilesY;
+    ++version;
+    tileVersions.assign(tileCount, version);
+    dirtyBits.assign((tileCount + 63) / 64, ~0ull);
+    if (tileCount % 64 != 0) {
+        dirtyBits.back() = (1ull << (tileCount % 64)) - 1;
+    }
+    snapshotTiles.clear();
+    snapshotVersions.clear();
+}
+
+/**
+ * @brief Checks that the tiles not changed since the last clear still hold the cleared value.
+ */
+bool Map::unchangedTilesHoldClearValue() const {
+    for (int ty = 0; ty < dirtyTilesY; ++ty) {
+        for (int tx = 0; tx < dirtyTilesX; ++tx) {
+            if (tileVersions[static_cast<size_t>(ty) * dirtyTilesX + tx] > clearedVersion) {
+                continue;
+            }
+            const int x0 = tx << DIRTY_TILE_SHIFT;
+            const int x1 = std::min(gridSizeX, x0 + DIRTY_TILE_SIZE);
+            const int y1 = std::min(gridSizeY, (ty + 1) << DIRTY_TILE_SHIFT);
+            for (int y = ty << DIRTY_TILE_SHIFT; y < y1; ++y) {
+                const MapCell* row = getRow(y);
+                for (int x = x0; x < x1; ++x) {
+                    if (row[x] != clearValue) {
+                        return false;
+                    }
+                }
+            }
+        }
+    }
+    return true;
 }
 
 /**
- * @brief Clears the grid by setting all cells to 0.
+ * @brief Clears the grid by setting all cells to a value.
+ *
+ * Tiles whose version is not newer than the previous clear still hold the
+ * cleared value and are skipped. Clearing to a different value rewrites the
+ * whole buffer in one sweep. A skipped tile written without markDirty() is a
+ * bug of the writer: debug builds assert, and release builds compiled with
+ * ROBOT_MAP_VERIFY_CLEAR fall back to the full sweep.
+ *
+ * @param value The value of every cell after the clear.
+ */
+void Map::clearMap(MapCell value) {
+    bool fullSweep = value != clearValue;
+#ifndef NDEBUG
+    assert(fullSweep || unchangedTilesHoldClearValue());
+#elif defined(ROBOT_MAP_VERIFY_CLEAR)
+    fullSweep = fullSweep || !unchangedTilesHoldClearValue();
+#endif
+    if (fullSweep) {
+        std::memset(cells, value, static_cast<size_t>(stride) * gridSizeY);
+        markDirty(0, 0, gridSizeX - 1, gridSizeY - 1);
+        clearValue = value;
+        clearedVersion = version;
+        return;
+    }
+
+    const unsigned long long clearVersion = version + 1;
+    bool changed = false;
+    for (int ty = 0; ty < dirtyTilesY; ++ty) {
+        for (int tx = 0; tx < dirtyTilesX; ++tx) {
+            const size_t tile = static_cast<size_t>(ty) * dirtyTilesX + tx;
+            if (tileVersions[tile] <= clearedVersion) {
+                continue;
+            }
+            const int x0 = tx << DIRTY_TILE_SHIFT;
+            const int y0 = ty << DIRTY_TILE_SHIFT;
+            const int width = std::min(DIRTY_TILE_SIZE, gridSizeX - x0);
+            const int y1 = std::min(gridSizeY, y0 + DIRTY_TILE_SIZE);
+            for (int y = y0; y < y1; ++y) {
+                std::memset(getRow(y) + x0, value, width);
+            }
+            dirtyBits[tile >> 6] |= 1ull << (tile & 63);
+            tileVersions[tile] = clearVersion;
+            changed = true;
+        }
+    }
+    if (changed) {
+        version = clearVersion;
+    }
+    clearedVersion = version;
+}
+
+/**
+ * @brief Takes an immutable snapshot of the cells.
+ *
+ * A tile is copied only if its version differs from the buffer cached by the
+ * previous snapshot. Tiles not changed since the last clear all point to one
+ * buffer filled with the cleared value.
  */
-void Map::clearMap() {
-    // Loop through each row and set all cells to 0
-    for (auto& row : grid) {
-        std::fill(row.begin(), row.end(), 0);
+MapSnapshot Map::snapshot() {
+    const size_t tileCount = static_cast<size_t>(dirtyTilesX) * dirtyTilesY;
+    const size_t tileCells = static_cast<size_t>(DIRTY_TILE_SIZE) * DIRTY_TILE_SIZE;
+    if (snapshotTiles.size() != tileCount) {
+        snapshotTiles.assign(tileCount, std::shared_ptr<const MapCell>());
+        snapshotVersions.assign(tileCount, 0);
+    }
+
+    std::shared_ptr<const MapCell> clearedTile;
+    for (int ty = 0; ty < dirtyTilesY; ++ty) {
+        for (int tx = 0; tx < dirtyTilesX; ++tx) {
+            const size_t tile = static_cast<size_t>(ty) * dirtyTilesX + tx;
+            if (snapshotTiles[tile] && snapshotVersions[tile] == tileVersions[tile]) {
+                continue;
+            }
+            if (tileVersions[tile] <= clearedVersion) {
+                if (!clearedTile) {
+                    MapCell* buffer = new MapCell[tileCells];
+                    std::memset(buffer, clearValue, tileCells);
+                    clearedTile.reset(buffer, std::default_delete<MapCell[]>());
+                }
+                snapshotTiles[tile] = clearedTile;
+            }
+            else {
+                MapCell* buffer = new MapCell[tileCells];
+                std::shared_ptr<const MapCell> owner(buffer, std::default_delete<MapCell[]>());
+                std::memset(buffer, 0, tileCells);
+                const int x0 = tx << DIRTY_TILE_SHIFT;
+                const int y0 = ty << DIRTY_TILE_SHIFT;
+                const int width = std::min(DIRTY_TILE_SIZE, gridSizeX - x0);
+                const int height = std::min(DIRTY_TILE_SIZE, gridSizeY - y0);
+                for (int y = 0; y < height; ++y) {
+                    std::memcpy(buffer + (y << DIRTY_TILE_SHIFT), getRow(y0 + y) + x0, width);
+                }
+                snapshotTiles[tile] = owner;
+            }
+            snapshotVersions[tile] = tileVersions[tile];
+        }
     }
+
+    MapSnapshot result;
+    result.sizeX = gridSizeX;
+    result.sizeY = gridSizeY;
+    result.tilesX = dirtyTilesX;
+    result.version = version;
+    result.tiles = snapshotTiles;
+    return result;
 }
 
 /**
@@ -38,7 +294,11 @@ void Map::clearMap() {
 void Map::insertPoint(const Point& point) {
     // Check if the given point is within the bounds of the grid
     if (point.getX() >= 0 && point.getX() < gridSizeX && point.getY() >= 0 && point.getY() < gridSizeY) {
-        grid[point.getY()][point.getX()] = 1;  // Mark the point on the grid
+        MapCell& cell = cellAt(point.getX(), point.getY());
+        if (cell != 1) {
+            cell = 1;  // Mark the point on the grid
+            markDirty(point.getX(), point.getY());
+        }
     }
 }
 
@@ -52,7 +312,7 @@ void Map::insertPoint(const Point& point) {
 int Map::getGrid(int x, int y) const {
     // Check if the coordinates are valid
     if (x >= 0 && x < gridSizeX && y >= 0 && y < gridSizeY) {
-        return grid[y][x];  // Return the value of the grid cell
+        return cellAt(x, y);  // Return the value of the grid cell
     }
     return -1;  // Return -1 if the coordinates are out of bounds
 }
@@ -67,8 +327,182 @@ int Map::getGrid(int x, int y) const {
 void Map::setGrid(int x, int y, int value) {
     // Check if the coordinates are valid
     if (x >= 0 && x < gridSizeX && y >= 0 && y < gridSizeY) {
-        grid[y][x] = value;  // Set the value of the grid cell
+        MapCell& cell = cellAt(x, y);
+        if (cell != static_cast<MapCell>(value)) {
+            cell = static_cast<MapCell>(value);  // Set the value of the grid cell
+            markDirty(x, y);
+        }
+    }
+}
+
+/**
+ * @brief Records a change of a region of cells (clipped to the map).
+ *
+ * All tiles of the region get the same new version.
+ */
+void Map::markDirty(int x0, int y0, int x1, int y1) {
+    x0 = x0 > 0 ? x0 : 0;
+    y0 = y0 > 0 ? y0 : 0;
+    x1 = x1 < gridSizeX ? x1 : gridSizeX - 1;
+    y1 = y1 < gridSizeY ? y1 : gridSizeY - 1;
+    if (x0 > x1 || y0 > y1) {
+        return;
+    }
+    ++version;
+    for (int ty = y0 >> DIRTY_TILE_SHIFT; ty <= y1 >> DIRTY_TILE_SHIFT; ++ty) {
+        for (int tx = x0 >> DIRTY_TILE_SHIFT; tx <= x1 >> DIRTY_TILE_SHIFT; ++tx) {
+            const size_t tile = static_cast<size_t>(ty) * dirtyTilesX + tx;
+            dirtyBits[tile >> 6] |= 1ull << (tile & 63);
+            tileVersions[tile] = version;
+        }
+    }
+}
+
+/**
+ * @brief Returns the regions changed since the last clearDirty().
+ *
+ * The bitset is scanned a word at a time, so clean parts of the map cost one
+ * comparison per 64 tiles.
+ */
+void Map::getDirtyRegions(std::vector<MapRegion>& regions) const {
+    regions.clear();
+    const size_t tileCount = static_cast<size_t>(dirtyTilesX) * dirtyTilesY;
+    size_t tile = 0;
+    while (tile < tileCount) {
+        const unsigned long long word = dirtyBits[tile >> 6] >> (tile & 63);
+        if (word == 0) {
+            tile = (tile | 63) + 1;
+            continue;
+        }
+        if ((word & 1) == 0) {
+            ++tile;
+            continue;
+        }
+
+        // Extend over the following dirty tiles of the same tile row
+        const int ty = static_cast<int>(tile / dirtyTilesX);
+        const int tx = static_cast<int>(tile % dirtyTilesX);
+        int end = tx + 1;
+        size_t next = tile + 1;
+        while (end < dirtyTilesX && (dirtyBits[next >> 6] >> (next & 63) & 1)) {
+            ++end;
+            ++next;
+        }
+
+        MapRegion region;
+        region.x0 = tx << DIRTY_TILE_SHIFT;
+        region.y0 = ty << DIRTY_TILE_SHIFT;
+        region.x1 = std::min((end << DIRTY_TILE_SHIFT) - 1, gridSizeX - 1);
+        region.y1 = std::min(((ty + 1) << DIRTY_TILE_SHIFT) - 1, gridSizeY - 1);
+        regions.push_back(region);
+        tile = next;
+    }
+}
+
+/**
+ * @brief Clears the dirty bitset. Tile versions are kept.
+ */
+void Map::clearDirty() {
+    std::fill(dirtyBits.begin(), dirtyBits.end(), 0ull);
+}
+
+/**
+ * @brief Writes the cells of all tiles changed after a version.
+ */
+unsigned long long Map::exportDelta(unsigned long long sinceVersion, std::vector<unsigned char>& delta) const {
+    delta.clear();
+    const unsigned int header[2] = { static_cast<unsigned int>(gridSizeX), static_cast<unsigned int>(gridSizeY) };
+    const unsigned long long versions[2] = { sinceVersion, version };
+    appendBytes(delta, header, sizeof(header));
+    appendBytes(delta, versions, sizeof(versions));
+    const size_t countOffset = delta.size();
+    unsigned int tileCount = 0;
+    appendBytes(delta, &tileCount, sizeof(tileCount));
+
+    for (int ty = 0; ty < dirtyTilesY; ++ty) {
+        for (int tx = 0; tx < dirtyTilesX; ++tx) {
+            if (tileVersions[static_cast<size_t>(ty) * dirtyTilesX + tx] <= sinceVersion) {
+                continue;
+            }
+            const unsigned int position[2] = { static_cast<unsigned int>(tx), static_cast<unsigned int>(ty) };
+            appendBytes(delta, position, sizeof(position));
+            const int x0 = tx << DIRTY_TILE_SHIFT;
+            const int y0 = ty << DIRTY_TILE_SHIFT;
+            const int width = std::min(DIRTY_TILE_SIZE, gridSizeX - x0);
+            const int height = std::min(DIRTY_TILE_SIZE, gridSizeY - y0);
+            for (int y = y0; y < y0 + height; ++y) {
+                appendBytes(delta, getRow(y) + x0, width);
+            }
+            ++tileCount;
+        }
+    }
+    std::memcpy(&delta[countOffset], &tileCount, sizeof(tileCount));
+    return version;
+}
+
+/**
+ * @brief Applies a delta made by exportDelta(), resizing the map if needed.
+ *
+ * The whole delta is validated before any cell is written.
+ */
+bool Map::applyDelta(const unsigned char* delta, size_t size) {
+    const size_t headerSize = 2 * sizeof(unsigned int) + 2 * sizeof(unsigned long long) + sizeof(unsigned int);
+    if (size < headerSize) {
+        return false;
+    }
+    unsigned int dimensions[2];
+    unsigned int tileCount;
+    std::memcpy(dimensions, delta, sizeof(dimensions));
+    std::memcpy(&tileCount, delta + headerSize - sizeof(tileCount), sizeof(tileCount));
+    if (dimensions[0] > 0x7FFFFFFFu || dimensions[1] > 0x7FFFFFFFu) {
+        return false;
+    }
+    const int sizeX = static_cast<int>(dimensions[0]);
+    const int sizeY = static_cast<int>(dimensions[1]);
+    const unsigned int tilesX = (dimensions[0] + DIRTY_TILE_SIZE - 1) >> DIRTY_TILE_SHIFT;
+    const unsigned int tilesY = (dimensions[1] + DIRTY_TILE_SIZE - 1) >> DIRTY_TILE_SHIFT;
+
+    size_t offset = headerSize;
+    for (unsigned int i = 0; i < tileCount; ++i) {
+        unsigned int position[2];
+        if (size - offset < sizeof(position)) {
+            return false;
+        }
+        std::memcpy(position, delta + offset, sizeof(position));
+        if (position[0] >= tilesX || position[1] >= tilesY) {
+            return false;
+        }
+        const size_t width = std::min(DIRTY_TILE_SIZE, sizeX - static_cast<int>(position[0] << DIRTY_TILE_SHIFT));
+        const size_t height = std::min(DIRTY_TILE_SIZE, sizeY - static_cast<int>(position[1] << DIRTY_TILE_SHIFT));
+        offset += sizeof(position);
+        if (size - offset < width * height) {
+            return false;
+        }
+        offset += width * height;
+    }
+    if (offset != size) {
+        return false;
+    }
+
+    if (sizeX != gridSizeX || sizeY != gridSizeY) {
+        reallocate(sizeX, sizeY);
     }
+    offset = headerSize;
+    for (unsigned int i = 0; i < tileCount; ++i) {
+        unsigned int position[2];
+        std::memcpy(position, delta + offset, sizeof(position));
+        offset += sizeof(position);
+        const int x0 = static_cast<int>(position[0]) << DIRTY_TILE_SHIFT;
+        const int y0 = static_cast<int>(position[1]) << DIRTY_TILE_SHIFT;
+        const int width = std::min(DIRTY_TILE_SIZE, sizeX - x0);
+        const int height = std::min(DIRTY_TILE_SIZE, sizeY - y0);
+        for (int y = y0; y < y0 + height; ++y) {
+            std::memcpy(getRow(y) + x0, delta + offset, width);
+            offset += width;
+        }
+        markDirty(x0, y0, x0 + width - 1, y0 + height - 1);
+    }
+    return true;
 }
 
 /**
@@ -96,17 +530,8 @@ int Map::getNumberY() const {
  * @param deltaY The number of rows to add to the grid.
  */
 void Map::addGridSize(int deltaX, int deltaY) {
-    // Increase the grid dimensions by deltaX and deltaY
-    gridSizeX += deltaX;
-    gridSizeY += deltaY;
-
-    // Resize the grid and add new rows
-    grid.resize(gridSizeY, std::vector<int>(gridSizeX, 0));
-
-    // Resize existing rows to match the new column count
-    for (auto& row : grid) {
-        row.resize(gridSizeX, 0);
-    }
+    // Increase the grid dimensions by deltaX and deltaY, keeping the existing cells
+    reallocate(gridSizeX + deltaX, gridSizeY + deltaY);
 }
 
 /**
@@ -116,9 +541,7 @@ void Map::addGridSize(int deltaX, int deltaY) {
  * @param sizeY The number of rows in the grid.
  */
 void Map::setGridSize(int sizeX, int sizeY) {
-    gridSizeX = sizeX;
-    gridSizeY = sizeY;
-    grid.resize(gridSizeY, std::vector<int>(gridSizeX, 0));  // Resize the grid to the new dimensions
+    reallocate(sizeX, sizeY);  // Resize the grid to the new dimensions
 }
 
 /**
@@ -132,12 +555,16 @@ void Map::printInfo() const {
  * @brief Prints the contents of the grid, using '.' for empty cells and 'x' for filled cells.
  */
 void Map::showMap() const {
-    // Loop through each row and print each cell
-    for (const auto& row : grid) {
-        for (int cell : row) {
-            std::cout << (cell == 0 ? '.' : 'x') << " ";  // Print '.' for empty cells and 'x' for filled cells
+    // Build each row in a line buffer and print it with a single write
+    std::string line(static_cast<size_t>(gridSizeX) * 2 + 1, ' ');
+    line.back() = '\n';
+    for (int y = 0; y < gridSizeY; ++y) {
+        const MapCell* row = getRow(y);
+        for (int x = 0; x < gridSizeX; ++x) {
+            line[2 * x] = row[x] == 0 ? '.' : 'x';  // '.' for empty cells and 'x' for filled cells
         }
-        std::cout << std::endl;
+        std::cout << line;
     }
+    std::cout.flush();
 }
 
@@ -4,8 +4,11 @@
 #include <vector>
 #include <iostream>
 #include <iomanip>
+#include <memory>
 #include "Point.h"
 
+class MapSnapshot;
+
 /**
  * @file   Map.h
  * @author Emirhan Kalkan
@@ -37,19 +40,82 @@
   //    Point(int x = 0, int y = 0) : x(x), y(y) {}
   //};
 
+/**
+ * @brief Storage type of a single grid cell (values 0-255).
+ */
+typedef unsigned char MapCell;
+
+/**
+ * @brief A rectangle of cells, bounds inclusive.
+ */
+struct MapRegion {
+    int x0, y0;   /**< First column and row. */
+    int x1, y1;   /**< Last column and row. */
+};
+
   /**
    * @class Map
    * @brief A class to represent a grid-based map.
    *
    * The Map class provides functionality to create, modify, and display a 2D grid.
    * It supports operations to clear the map, insert points, adjust grid size, and print grid contents.
+   *
+   * The cells are stored in one contiguous, row-major, 64-byte aligned buffer
+   * with one byte per cell. Every row starts on a cache line: rows are padded
+   * to getStride() bytes. Whole-map operations are linear sweeps over this
+   * buffer, and getRow() / cellAt() give unchecked access for hot loops.
+   *
+   * Changes are tracked per tile of DIRTY_TILE_SIZE x DIRTY_TILE_SIZE cells,
+   * in two ways:
+   * - a dirty bitset, read with getDirtyRegions() and reset with clearDirty(),
+   *   for a single consumer such as a viewer;
+   * - a version stamp per tile, set from a map-wide counter on every change,
+   *   so any number of consumers can ask for the tiles changed since the
+   *   version they last saw (exportDelta() / applyDelta()).
+   * setGrid(), insertPoint(), clearMap() and resizes track themselves; code
+   * writing through cellAt() or getRow() must call markDirty().
+   *
+   * The tile versions also make clearing and snapshotting proportional to the
+   * changed area rather than the map area. A tile not changed since the last
+   * clearMap() still holds the cleared value, so the next clear only rewrites
+   * the tiles changed in between, and snapshot() shares one buffer for all
+   * such tiles and copies only the tiles changed since the previous snapshot.
+   *
+   * Both therefore rely on every write being recorded: a cell written through
+   * cellAt() or getRow() without markDirty() is not only missing from deltas,
+   * it also survives the next clearMap() and may be missing from snapshots.
+   * Debug builds assert in clearMap() that no such cell exists. Release
+   * builds compiled with ROBOT_MAP_VERIFY_CLEAR check the same and fall back
+   * to a full sweep instead, as a safety net.
    */
 class Map {
 private:
-    std::vector<std::vector<int>> grid;  /**< 2D vector to store the map data. */
+    MapCell* cells;                      /**< Row-major cell buffer (cache-line aligned). */
+    int stride;                          /**< Distance in cells between the starts of two rows. */
     int gridSizeX, gridSizeY;            /**< The size of the grid (X and Y dimensions). */
+    int dirtyTilesX, dirtyTilesY;        /**< Number of change-tracking tiles along X and Y. */
+    std::vector<unsigned long long> dirtyBits;     /**< One bit per tile, set when the tile changes. */
+    std::vector<unsigned long long> tileVersions;  /**< Version of the last change of each tile. */
+    unsigned long long version;          /**< Counter stamped on changed tiles, increased on every change. */
+    unsigned long long clearedVersion;   /**< Version of the last clear; older tiles hold clearValue. */
+    MapCell clearValue;                  /**< Value written by the last clear. */
+    std::vector<std::shared_ptr<const MapCell> > snapshotTiles;  /**< Tile buffers of the last snapshot. */
+    std::vector<unsigned long long> snapshotVersions;             /**< Tile versions the buffers hold. */
+
+    /**
+     * @brief Replaces the buffer with a zeroed one of the given size, keeping the overlapping cells.
+     */
+    void reallocate(int sizeX, int sizeY);
+
+    /**
+     * @brief Checks that the tiles not changed since the last clear still hold the cleared value.
+     */
+    bool unchangedTilesHoldClearValue() const;
 
 public:
+    static const int DIRTY_TILE_SHIFT = 5;                      /**< log2 of the change-tracking tile size. */
+    static const int DIRTY_TILE_SIZE = 1 << DIRTY_TILE_SHIFT;   /**< Cells along a change-tracking tile side. */
+
     /**
      * @brief Constructs a Map object with specified grid dimensions.
      *
@@ -62,9 +128,48 @@ public:
     Map(int sizeX = 10, int sizeY = 10);
 
     /**
-     * @brief Clears the map by setting all grid cells to 0.
+     * @brief Copy constructor. Copies all cells.
      */
-    void clearMap();
+    Map(const Map& other);
+
+    /**
+     * @brief Move constructor. Takes over the other map's buffer.
+     */
+    Map(Map&& other);
+
+    /**
+     * @brief Copy assignment. Copies all cells.
+     */
+    Map& operator=(const Map& other);
+
+    /**
+     * @brief Frees the cell buffer.
+     */
+    ~Map();
+
+    /**
+     * @brief Clears the map by setting all grid cells to a value (0 by default).
+     *
+     * Only the tiles changed since the previous clear to the same value are
+     * rewritten and recorded as changed, so clearing a map that was partly
+     * rebuilt costs as much as the rebuilt area. This requires every write
+     * through cellAt() or getRow() to be recorded with markDirty(). Debug
+     * builds assert this; release builds with ROBOT_MAP_VERIFY_CLEAR rewrite
+     * the whole buffer instead when they find an unrecorded write.
+     *
+     * @param value The value of every cell after the clear.
+     */
+    void clearMap(MapCell value = 0);
+
+    /**
+     * @brief Takes an immutable snapshot of the cells.
+     *
+     * Only tiles changed since the previous snapshot are copied; the others
+     * are shared with it. The map keeps a reference to the tiles of the last
+     * snapshot to share them with the next one. Cells written without
+     * markDirty() may be missing from the snapshot.
+     */
+    MapSnapshot snapshot();
 
     /**
      * @brief Marks the grid cell corresponding to the given point with a 1.
@@ -87,10 +192,118 @@ public:
      *
      * @param x The x-coordinate of the grid cell.
      * @param y The y-coordinate of the grid cell.
-     * @param value The value to set the grid cell to.
+     * @param value The value to set the grid cell to (stored as a MapCell, 0-255).
      */
     void setGrid(int x, int y, int value);
 
+    /**
+     * @brief Returns a cell without bounds checking.
+     *
+     * @param x The x-coordinate, in [0, getNumberX()-1].
+     * @param y The y-coordinate, in [0, getNumberY()-1].
+     */
+    MapCell cellAt(int x, int y) const { return cells[y * stride + x]; }
+
+    /**
+     * @brief Returns a writable cell without bounds checking.
+     */
+    MapCell& cellAt(int x, int y) { return cells[y * stride + x]; }
+
+    /**
+     * @brief Returns the first cell of a row without bounds checking.
+     *
+     * The row holds getNumberX() cells and is 64-byte aligned.
+     *
+     * @param y The row index, in [0, getNumberY()-1].
+     */
+    const MapCell* getRow(int y) const { return cells + y * stride; }
+
+    /**
+     * @brief Returns the first writable cell of a row without bounds checking.
+     */
+    MapCell* getRow(int y) { return cells + y * stride; }
+
+    /**
+     * @brief Returns the distance in cells between the starts of two rows.
+     */
+    int getStride() const { return stride; }
+
+    /**
+     * @brief Records a change of one cell without bounds checking.
+     *
+     * @param x The x-coordinate, in [0, getNumberX()-1].
+     * @param y The y-coordinate, in [0, getNumberY()-1].
+     */
+    void markDirty(int x, int y) {
+        const size_t tile = static_cast<size_t>(y >> DIRTY_TILE_SHIFT) * dirtyTilesX + (x >> DIRTY_TILE_SHIFT);
+        dirtyBits[tile >> 6] |= 1ull << (tile & 63);
+        tileVersions[tile] = ++version;
+    }
+
+    /**
+     * @brief Records a change of a region of cells (clipped to the map).
+     *
+     * @param x0 First column.
+     * @param y0 First row.
+     * @param x1 Last column (inclusive).
+     * @param y1 Last row (inclusive).
+     */
+    void markDirty(int x0, int y0, int x1, int y1);
+
+    /**
+     * @brief Returns the map version: the number of recorded changes, resizes included.
+     */
+    unsigned long long getVersion() const { return version; }
+
+    /**
+     * @brief Returns the version of the last change of a change-tracking tile (unchecked).
+     *
+     * Tile (tx, ty) covers the cells from (tx, ty) * DIRTY_TILE_SIZE on; there are
+     * ceil(getNumberX() / DIRTY_TILE_SIZE) tiles per tile row.
+     */
+    unsigned long long getTileVersion(int tx, int ty) const {
+        return tileVersions[static_cast<size_t>(ty) * dirtyTilesX + tx];
+    }
+
+    /**
+     * @brief Returns the regions changed since the last clearDirty().
+     *
+     * Horizontally adjacent dirty tiles are merged into one region. Regions are
+     * clipped to the map.
+     *
+     * @param regions Receives the regions (cleared first).
+     */
+    void getDirtyRegions(std::vector<MapRegion>& regions) const;
+
+    /**
+     * @brief Clears the dirty bitset. Tile versions are kept.
+     */
+    void clearDirty();
+
+    /**
+     * @brief Writes the cells of all tiles changed after a version.
+     *
+     * Delta layout (host byte order): u32 width, u32 height, u64 base version,
+     * u64 new version, u32 tile count, then per tile u32 tile x, u32 tile y and
+     * the tile rows clipped to the map.
+     *
+     * @param sinceVersion The version the reader already has (0 for the whole map).
+     * @param delta Receives the delta (cleared first).
+     * @return The version the reader has after applying the delta.
+     */
+    unsigned long long exportDelta(unsigned long long sinceVersion, std::vector<unsigned char>& delta) const;
+
+    /**
+     * @brief Applies a delta made by exportDelta(), resizing the map if needed.
+     *
+     * The changed tiles are recorded as changes of this map.
+     *
+     * @param delta The delta bytes.
+     * @param size The number of bytes.
+     * @return `false` if the delta is malformed; the map is then unchanged.
+     */
+    bool applyDelta(const unsigned char* delta, size_t size);
+
     /**
      * @brief Returns the number of columns (X dimension) in the grid.
      *
@@ -108,6 +321,8 @@ public:
     /**
      * @brief Increases the size of the grid by a specified amount in both X and Y directions.
      *
+     * Existing cells keep their coordinates; new cells are 0.
+     *
      * @param deltaX The number of columns to add to the grid.
      * @param deltaY The number of rows to add to the grid.
      */
@@ -116,6 +331,8 @@ public:
     /**
      * @brief Sets the grid size to the specified dimensions.
      *
+     * Cells inside both the old and the new size keep their values; new cells are 0.
+     *
      * @param sizeX The number of columns in the grid.
      * @param sizeY The number of rows in the grid.
      */
@@ -0,0 +1,358 @@
+/**
+ * @file   MapFile.cpp
+ * @author Emirhan Kalkan
+ * @date   December, 2024
+ * @brief  Implementation of the memory-mapped map file format.
+ */
+#include "MapFile.h"
+#include "Checksum.h"
+#include <cstdio>
+#include <cstring>
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    const unsigned char FILE_MAGIC[4] = { 'R', 'M', 'A', 'P' };
+    const unsigned short FORMAT_VERSION = 1;
+    const size_t HEADER_SIZE = 64;
+
+    void putU16(unsigned char* out, unsigned short value) {
+        out[0] = static_cast<unsigned char>(value);
+        out[1] = static_cast<unsigned char>(value >> 8);
+    }
+
+    void putU32(unsigned char* out, unsigned int value) {
+        for (int i = 0; i < 4; ++i) {
+            out[i] = static_cast<unsigned char>(value >> (8 * i));
+        }
+    }
+
+    void putF64(unsigned char* out, double value) {
+        unsigned long long bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        for (int i = 0; i < 8; ++i) {
+            out[i] = static_cast<unsigned char>(bits >> (8 * i));
+        }
+    }
+
+    unsigned short getU16(const unsigned char* in) {
+        return static_cast<unsigned short>(in[0] | (in[1] << 8));
+    }
+
+    unsigned int getU32(const unsigned char* in) {
+        return in[0] | (in[1] << 8) | (in[2] << 16) | (static_cast<unsigned int>(in[3]) << 24);
+    }
+
+    double getF64(const unsigned char* in) {
+        unsigned long long bits = 0;
+        for (int i = 7; i >= 0; --i) {
+            bits = (bits << 8) | in[i];
+        }
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    bool replaceFile(const std::string& from, const std::string& to) {
+#ifdef _WIN32
+        return MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+        return std::rename(from.c_str(), to.c_str()) == 0;
+#endif
+    }
+}
+
+/**
+ * @brief Constructs an unmapped object.
+ */
+MappedFile::MappedFile() : address(nullptr), length(0),
+#ifdef _WIN32
+    fileHandle(INVALID_HANDLE_VALUE), mappingHandle(nullptr)
+#else
+    descriptor(-1)
+#endif
+{
+}
+
+/**
+ * @brief Unmaps and closes the file.
+ */
+MappedFile::~MappedFile() {
+    close();
+}
+
+/**
+ * @brief Maps an existing file read-only. Pages are loaded on first access.
+ */
+bool MappedFile::openRead(const std::string& filename) {
+    close();
+#ifdef _WIN32
+    fileHandle = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL, nullptr);
+    LARGE_INTEGER fileSize;
+    if (fileHandle == INVALID_HANDLE_VALUE || !GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart == 0) {
+        close();
+        return false;
+    }
+    mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mappingHandle) {
+        close();
+        return false;
+    }
+    address = static_cast<unsigned char*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+    length = static_cast<size_t>(fileSize.QuadPart);
+#else
+    descriptor = ::open(filename.c_str(), O_RDONLY);
+    struct stat status;
+    if (descriptor < 0 || fstat(descriptor, &status) != 0 || status.st_size == 0) {
+        close();
+        return false;
+    }
+    void* view = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_SHARED, descriptor, 0);
+    address = view == MAP_FAILED ? nullptr : static_cast<unsigned char*>(view);
+    length = static_cast<size_t>(status.st_size);
+#endif
+    if (!address) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Creates (or truncates) a file of the given size and maps it read-write.
+ */
+bool MappedFile::create(const std::string& filename, size_t size) {
+    close();
+    if (size == 0) {
+        return false;
+    }
+#ifdef _WIN32
+    fileHandle = CreateFileA(filename.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS,
+        FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE) {
+        close();
+        return false;
+    }
+    // The mapping sets the file size and allocates its blocks
+    const unsigned long long fullSize = size;
+    mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READWRITE,
+        static_cast<DWORD>(fullSize >> 32), static_cast<DWORD>(fullSize & 0xFFFFFFFFu), nullptr);
+    if (!mappingHandle) {
+        close();
+        return false;
+    }
+    address = static_cast<unsigned char*>(MapViewOfFile(mappingHandle, FILE_MAP_WRITE, 0, 0, size));
+#else
+    descriptor = ::open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    // A sparse file would allocate blocks on the first write to each page,
+    // and a full disk would then raise SIGBUS
+    if (descriptor < 0 || posix_fallocate(descriptor, 0, static_cast<off_t>(size)) != 0) {
+        close();
+        return false;
+    }
+    void* view = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+    address = view == MAP_FAILED ? nullptr : static_cast<unsigned char*>(view);
+#endif
+    length = size;
+    if (!address) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Writes the mapped pages and the file to disk.
+ */
+bool MappedFile::flush() {
+    if (!address) {
+        return false;
+    }
+#ifdef _WIN32
+    return FlushViewOfFile(address, length) != 0 && FlushFileBuffers(fileHandle) != 0;
+#else
+    return msync(address, length, MS_SYNC) == 0 && fsync(descriptor) == 0;
+#endif
+}
+
+/**
+ * @brief Unmaps and closes the file. Written pages are flushed by the system.
+ */
+void MappedFile::close() {
+#ifdef _WIN32
+    if (address) {
+        UnmapViewOfFile(address);
+    }
+    if (mappingHandle) {
+        CloseHandle(mappingHandle);
+    }
+    if (fileHandle != INVALID_HANDLE_VALUE) {
+        CloseHandle(fileHandle);
+    }
+    mappingHandle = nullptr;
+    fileHandle = INVALID_HANDLE_VALUE;
+#else
+    if (address) {
+        munmap(address, length);
+    }
+    if (descriptor >= 0) {
+        ::close(descriptor);
+    }
+    descriptor = -1;
+#endif
+    address = nullptr;
+    length = 0;
+}
+
+/**
+ * @brief Constructs an object with no file open.
+ */
+MapFile::MapFile() : info(), cells(nullptr) {
+}
+
+/**
+ * @brief Writes a map to a file through a writable mapping.
+ *
+ * Rows are copied straight into the mapping; the row padding of a new file
+ * is already zero. The checksum is computed on each row while it is still in
+ * the cache. The file only replaces `filename` once it is complete and on disk.
+ */
+bool MapFile::save(const std::string& filename, const Map& map, MAP_CELL_TYPE cellType,
+    double resolution, double originX, double originY) {
+    const int sizeX = map.getNumberX();
+    const int sizeY = map.getNumberY();
+    const int stride = map.getStride();
+    const std::string temporary = filename + ".tmp";
+    MappedFile output;
+    if (!output.create(temporary, HEADER_SIZE + static_cast<size_t>(stride) * sizeY)) {
+        std::remove(temporary.c_str());
+        return false;
+    }
+
+    unsigned char* data = output.data() + HEADER_SIZE;
+    unsigned int checksum = 0;
+    for (int y = 0; y < sizeY; ++y) {
+        unsigned char* row = data + static_cast<size_t>(y) * stride;
+        std::memcpy(row, map.getRow(y), sizeX);
+        checksum = crc32(row, stride, checksum);
+    }
+
+    unsigned char* header = output.data();
+    std::memcpy(header, FILE_MAGIC, 4);
+    putU16(header + 4, FORMAT_VERSION);
+    putU16(header + 6, static_cast<unsigned short>(cellType));
+    putU32(header + 8, static_cast<unsigned int>(sizeX));
+    putU32(header + 12, static_cast<unsigned int>(sizeY));
+    putU32(header + 16, static_cast<unsigned int>(stride));
+    putU32(header + 20, checksum);
+    putF64(header + 24, resolution);
+    putF64(header + 32, originX);
+    putF64(header + 40, originY);
+
+    const bool written = output.flush();
+    output.close();
+    if (!written || !replaceFile(temporary, filename)) {
+        std::remove(temporary.c_str());
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Maps a map file and reads its header.
+ */
+bool MapFile::open(const std::string& filename) {
+    close();
+    if (!file.openRead(filename)) {
+        return false;
+    }
+    const unsigned char* header = file.data();
+    if (file.size() < HEADER_SIZE || std::memcmp(header, FILE_MAGIC, 4) != 0 || getU16(header + 4) != FORMAT_VERSION) {
+        close();
+        return false;
+    }
+
+    const unsigned int sizeX = getU32(header + 8);
+    const unsigned int sizeY = getU32(header + 12);
+    const unsigned int stride = getU32(header + 16);
+    const unsigned short cellType = getU16(header + 6);
+    if (sizeX > 0x7FFFFFFFu || sizeY > 0x7FFFFFFFu || stride > 0x7FFFFFFFu || stride < sizeX ||
+        cellType > MAP_CELL_LOG_ODDS ||
+        file.size() - HEADER_SIZE < static_cast<unsigned long long>(stride) * sizeY) {
+        close();
+        return false;
+    }
+
+    info.sizeX = static_cast<int>(sizeX);
+    info.sizeY = static_cast<int>(sizeY);
+    info.stride = static_cast<int>(stride);
+    info.cellType = static_cast<MAP_CELL_TYPE>(cellType);
+    info.checksum = getU32(header + 20);
+    info.resolution = getF64(header + 24);
+    info.originX = getF64(header + 32);
+    info.originY = getF64(header + 40);
+    cells = file.data() + HEADER_SIZE;
+    return true;
+}
+
+/**
+ * @brief Unmaps the file.
+ */
+void MapFile::close() {
+    file.close();
+    info = MapFileInfo();
+    cells = nullptr;
+}
+
+/**
+ * @brief Checks whether a file is open.
+ */
+bool MapFile::isOpen() const {
+    return cells != nullptr;
+}
+
+/**
+ * @brief Returns the header of the open file.
+ */
+const MapFileInfo& MapFile::getInfo() const {
+    return info;
+}
+
+/**
+ * @brief Recomputes the checksum of the cell data and compares it with the header.
+ */
+bool MapFile::verifyChecksum() const {
+    if (!cells) {
+        return false;
+    }
+    return crc32(cells, static_cast<size_t>(info.stride) * info.sizeY) == info.checksum;
+}
+
+/**
+ * @brief Copies the cells into a map, resizing it to the file dimensions.
+ */
+bool MapFile::copyTo(Map& map) const {
+    if (!cells) {
+        return false;
+    }
+    if (map.getNumberX() != info.sizeX || map.getNumberY() != info.sizeY) {
+        map.setGridSize(info.sizeX, info.sizeY);
+    }
+    unsigned int checksum = 0;
+    for (int y = 0; y < info.sizeY; ++y) {
+        checksum = crc32(getRow(y), info.stride, checksum);
+        std::memcpy(map.getRow(y), getRow(y), info.sizeX);
+    }
+    map.markDirty(0, 0, info.sizeX - 1, info.sizeY - 1);
+    return checksum == info.checksum;
+}
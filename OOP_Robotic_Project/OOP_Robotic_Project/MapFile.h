@@ -0,0 +1,212 @@
+#ifndef MAPFILE_H
+#define MAPFILE_H
+
+#include "Map.h"
+#include <string>
+
+/**
+ * @file   MapFile.h
+ * @author Emirhan Kalkan
+ * @date   December, 2024
+ * @brief  Header file for the binary, memory-mapped map file format.
+ *
+ * File layout (all integers little-endian):
+ *
+ *   Header (64 bytes)  "RMAP", u16 version, u16 cell type, u32 width,
+ *                      u32 height, u32 row stride, u32 CRC-32 of the cell data,
+ *                      f64 resolution (metres per cell), f64 origin x,
+ *                      f64 origin y (metres), 16 reserved bytes
+ *   Cell data          height rows of `stride` bytes, one byte per cell
+ *
+ * The row stride is the Map stride (a multiple of 64), so the cell data starts
+ * on a cache line boundary of the mapping and is laid out exactly as in a Map:
+ * saving is one copy and a mapped file can be read in place.
+ */
+
+ /**
+  * @brief What the bytes of a map file hold.
+  */
+enum MAP_CELL_TYPE {
+    MAP_CELL_OCCUPANCY = 0,   /**< Map cell values (0 free, non-zero occupied). */
+    MAP_CELL_LOG_ODDS = 1     /**< Biased log-odds evidence (128 = no evidence), as kept by Mapper. */
+};
+
+/**
+ * @brief Header fields of a map file.
+ */
+struct MapFileInfo {
+    int sizeX;                   /**< Number of columns. */
+    int sizeY;                   /**< Number of rows. */
+    int stride;                  /**< Bytes per row in the file. */
+    MAP_CELL_TYPE cellType;      /**< What the cells hold. */
+    double resolution;           /**< Size of a cell in metres. */
+    double originX;              /**< World x-coordinate of cell (0, 0) in metres. */
+    double originY;              /**< World y-coordinate of cell (0, 0) in metres. */
+    unsigned int checksum;       /**< CRC-32 of the cell data. */
+};
+
+/**
+ * @class MappedFile
+ * @brief A file mapped into memory (CreateFileMapping on Windows, mmap elsewhere).
+ */
+class MappedFile {
+private:
+    unsigned char* address;      /**< Start of the mapping, or nullptr. */
+    size_t length;               /**< Size of the mapping in bytes. */
+#ifdef _WIN32
+    void* fileHandle;            /**< File handle (HANDLE). */
+    void* mappingHandle;         /**< File mapping handle (HANDLE). */
+#else
+    int descriptor;              /**< File descriptor. */
+#endif
+
+public:
+    /**
+     * @brief Constructs an unmapped object.
+     */
+    MappedFile();
+
+    /**
+     * @brief Unmaps and closes the file.
+     */
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * @brief Maps an existing file read-only. Pages are loaded on first access.
+     *
+     * @param filename The file to map.
+     * @return `true` on success.
+     */
+    bool openRead(const std::string& filename);
+
+    /**
+     * @brief Creates (or truncates) a file of the given size and maps it read-write.
+     *
+     * The disk blocks are allocated before the file is mapped, so running out of
+     * space makes create() fail instead of faulting on a later write to the mapping.
+     *
+     * @param filename The file to create.
+     * @param size The size of the file in bytes (greater than 0).
+     * @return `true` on success.
+     */
+    bool create(const std::string& filename, size_t size);
+
+    /**
+     * @brief Writes the mapped pages and the file to disk.
+     *
+     * @return `false` if the data could not be written.
+     */
+    bool flush();
+
+    /**
+     * @brief Unmaps and closes the file. Written pages are flushed by the system.
+     */
+    void close();
+
+    /**
+     * @brief Returns the start of the mapping, or nullptr if nothing is mapped.
+     */
+    unsigned char* data() const { return address; }
+
+    /**
+     * @brief Returns the size of the mapping in bytes.
+     */
+    size_t size() const { return length; }
+};
+
+/**
+ * @class MapFile
+ * @brief Reads and writes maps in the binary map file format.
+ *
+ * open() only maps the file and checks the header, so it takes the same time
+ * for any map size; cells are paged in by the system when first read through
+ * getRow() or cellAt(). The checksum is checked by verifyChecksum() and
+ * copyTo(), which read every cell anyway.
+ */
+class MapFile {
+private:
+    MappedFile file;             /**< The mapped file. */
+    MapFileInfo info;            /**< Header of the open file. */
+    const MapCell* cells;        /**< First cell in the mapping, or nullptr if no file is open. */
+
+public:
+    /**
+     * @brief Constructs an object with no file open.
+     */
+    MapFile();
+
+    /**
+     * @brief Writes a map to a file through a writable mapping.
+     *
+     * The map is written to `filename` + ".tmp", flushed to disk and then
+     * renamed over `filename`, so a failed save or a crash leaves the previous
+     * file intact. On Windows the rename fails while the previous file is open.
+     *
+     * @param filename The file to write.
+     * @param map The map to save.
+     * @param cellType What the map cells hold.
+     * @param resolution Size of a cell in metres.
+     * @param originX World x-coordinate of cell (0, 0) in metres.
+     * @param originY World y-coordinate of cell (0, 0) in metres.
+     * @return `true` on success.
+     */
+    static bool save(const std::string& filename, const Map& map, MAP_CELL_TYPE cellType = MAP_CELL_OCCUPANCY,
+        double resolution = 1.0, double originX = 0.0, double originY = 0.0);
+
+    /**
+     * @brief Maps a map file and reads its header.
+     *
+     * @param filename The file to open.
+     * @return `false` if the file cannot be mapped, has a wrong magic or version,
+     *         or is shorter than its header says.
+     */
+    bool open(const std::string& filename);
+
+    /**
+     * @brief Unmaps the file.
+     */
+    void close();
+
+    /**
+     * @brief Checks whether a file is open.
+     */
+    bool isOpen() const;
+
+    /**
+     * @brief Returns the header of the open file.
+     */
+    const MapFileInfo& getInfo() const;
+
+    /**
+     * @brief Returns a row of cells in the mapping (unchecked).
+     */
+    const MapCell* getRow(int y) const { return cells + static_cast<size_t>(y) * info.stride; }
+
+    /**
+     * @brief Returns a cell in the mapping (unchecked).
+     */
+    MapCell cellAt(int x, int y) const { return getRow(y)[x]; }
+
+    /**
+     * @brief Recomputes the checksum of the cell data and compares it with the header.
+     *
+     * @return `true` if the cell data is intact.
+     */
+    bool verifyChecksum() const;
+
+    /**
+     * @brief Copies the cells into a map, resizing it to the file dimensions.
+     *
+     * The checksum is computed while copying.
+     *
+     * @param map The map receiving the cells.
+     * @return `false` if no file is open or the checksum does not match (the map
+     *         then holds the corrupted cells).
+     */
+    bool copyTo(Map& map) const;
+};
+
+#endif // MAPFILE_H
@@ -0,0 +1,326 @@
+/**
+ * @file   MapPyramid.cpp
+ * @author Emirhan Kalkan
+ * @date   December, 2024
+ * @brief  Implementation of the MapPyramid class.
+ *
+ * This file contains the construction and incremental maintenance of the
+ * occupancy pyramid and the hierarchical box and ray queries.
+ */
+#include "MapPyramid.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+/**
+ * @brief Builds the pyramid over a map.
+ *
+ * @param map The map to index. It must outlive the pyramid.
+ */
+MapPyramid::MapPyramid(Map& map) : map(map), sizeX(0), sizeY(0), syncedVersion(0) {
+    rebuild();
+}
+
+/**
+ * @brief Rebuilds every level from the map, picking up size changes.
+ */
+void MapPyramid::rebuild() {
+    sizeX = map.getNumberX();
+    sizeY = map.getNumberY();
+    syncedVersion = map.getVersion();
+    counts.clear();
+    levelSizeX.assign(1, sizeX);
+    levelSizeY.assign(1, sizeY);
+    if (sizeX <= 0 || sizeY <= 0) {
+        return;
+    }
+
+    // Halve until a single cell covers the whole map
+    while (levelSizeX.back() > 1 || levelSizeY.back() > 1) {
+        const int w = (levelSizeX.back() + 1) / 2;
+        const int h = (levelSizeY.back() + 1) / 2;
+        levelSizeX.push_back(w);
+        levelSizeY.push_back(h);
+        counts.push_back(std::vector<int>(static_cast<size_t>(w) * h, 0));
+    }
+    refreshRegion(0, 0, sizeX - 1, sizeY - 1);
+}
+
+/**
+ * @brief Brings the levels up to date with the map.
+ *
+ * Runs of changed tiles along a tile row are refreshed as one region, so the
+ * coarse levels above them are recomputed once per run rather than per tile.
+ */
+void MapPyramid::update() {
+    if (map.getNumberX() != sizeX || map.getNumberY() != sizeY) {
+        rebuild();
+        return;
+    }
+    if (map.getVersion() == syncedVersion) {
+        return;
+    }
+
+    const int tilesX = (sizeX + Map::DIRTY_TILE_SIZE - 1) >> Map::DIRTY_TILE_SHIFT;
+    const int tilesY = (sizeY + Map::DIRTY_TILE_SIZE - 1) >> Map::DIRTY_TILE_SHIFT;
+    for (int ty = 0; ty < tilesY; ++ty) {
+        for (int tx = 0; tx < tilesX; ++tx) {
+            if (map.getTileVersion(tx, ty) <= syncedVersion) {
+                continue;
+            }
+            const int first = tx;
+            while (tx + 1 < tilesX && map.getTileVersion(tx + 1, ty) > syncedVersion) {
+                ++tx;
+            }
+            refreshRegion(first << Map::DIRTY_TILE_SHIFT, ty << Map::DIRTY_TILE_SHIFT,
+                ((tx + 1) << Map::DIRTY_TILE_SHIFT) - 1, ((ty + 1) << Map::DIRTY_TILE_SHIFT) - 1);
+        }
+    }
+    syncedVersion = map.getVersion();
+}
+
+/**
+ * @brief Recomputes the levels over a region of cells changed directly in the map.
+ */
+void MapPyramid::refreshRegion(int x0, int y0, int x1, int y1) {
+    x0 = std::max(x0, 0);
+    y0 = std::max(y0, 0);
+    x1 = std::min(x1, sizeX - 1);
+    y1 = std::min(y1, sizeY - 1);
+    if (x0 > x1 || y0 > y1) {
+        return;
+    }
+
+    for (int level = 1; level < static_cast<int>(levelSizeX.size()); ++level) {
+        x0 >>= 1;
+        y0 >>= 1;
+        x1 >>= 1;
+        y1 >>= 1;
+        const int childW = levelSizeX[level - 1];
+        const int childH = levelSizeY[level - 1];
+        std::vector<int>& levelCounts = counts[level - 1];
+        for (int by = y0; by <= y1; ++by) {
+            for (int bx = x0; bx <= x1; ++bx) {
+                const int cx = bx * 2;
+                const int cy = by * 2;
+                int total = countAt(level - 1, cx, cy);
+                if (cx + 1 < childW) {
+                    total += countAt(level - 1, cx + 1, cy);
+                }
+                if (cy + 1 < childH) {
+                    total += countAt(level - 1, cx, cy + 1);
+                    if (cx + 1 < childW) {
+                        total += countAt(level - 1, cx + 1, cy + 1);
+                    }
+                }
+                levelCounts[by * levelSizeX[level] + bx] = total;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Sets a map cell and updates the levels above it.
+ */
+void MapPyramid::setGrid(int x, int y, int value) {
+    if (x < 0 || x >= sizeX || y < 0 || y >= sizeY) {
+        return;
+    }
+    MapCell& cell = map.cellAt(x, y);
+    const MapCell newValue = static_cast<MapCell>(value);
+    if (cell == newValue) {
+        return;
+    }
+    const bool wasOccupied = cell != 0;
+    const bool occupied = newValue != 0;
+    const bool synced = map.getVersion() == syncedVersion;
+    cell = newValue;
+    map.markDirty(x, y);
+    if (synced) {
+        // The levels are updated below, so update() need not revisit the tile
+        syncedVersion = map.getVersion();
+    }
+    if (wasOccupied == occupied) {
+        return;
+    }
+
+    const int delta = occupied ? 1 : -1;
+    for (int level = 1; level < static_cast<int>(levelSizeX.size()); ++level) {
+        counts[level - 1][(y >> level) * levelSizeX[level] + (x >> level)] += delta;
+    }
+}
+
+/**
+ * @brief Returns the number of levels, including the map itself.
+ */
+int MapPyramid::getLevelCount() const {
+    return static_cast<int>(levelSizeX.size());
+}
+
+/**
+ * @brief Throws if the map was resized since the last update, so queries never read past it.
+ */
+void MapPyramid::checkSize() const {
+    if (map.getNumberX() != sizeX || map.getNumberY() != sizeY) {
+        throw std::logic_error("Map was resized since the last MapPyramid update.");
+    }
+}
+
+/**
+ * @brief Returns the number of occupied map cells under a cell of a level.
+ */
+int MapPyramid::getBlockCount(int level, int bx, int by) const {
+    checkSize();
+    if (level < 0 || level >= getLevelCount() ||
+        bx < 0 || bx >= levelSizeX[level] || by < 0 || by >= levelSizeY[level]) {
+        return -1;
+    }
+    return countAt(level, bx, by);
+}
+
+/**
+ * @brief Counts occupied cells of a block inside the box (x0, y0)-(x1, y1), stopping at `limit`.
+ *
+ * Empty blocks and blocks entirely inside the box are answered from their own
+ * count; only blocks straddling the box edge are split into their children.
+ */
+int MapPyramid::countInBlock(int level, int bx, int by, int x0, int y0, int x1, int y1, int limit) const {
+    const int cellX0 = bx << level;
+    const int cellY0 = by << level;
+    const int cellX1 = cellX0 + (1 << level) - 1;
+    const int cellY1 = cellY0 + (1 << level) - 1;
+    if (cellX0 > x1 || cellX1 < x0 || cellY0 > y1 || cellY1 < y0) {
+        return 0;
+    }
+    const int count = countAt(level, bx, by);
+    if (count == 0 || (cellX0 >= x0 && cellX1 <= x1 && cellY0 >= y0 && cellY1 <= y1)) {
+        return count;
+    }
+
+    int total = 0;
+    for (int j = 0; j < 2 && total < limit; ++j) {
+        for (int i = 0; i < 2 && total < limit; ++i) {
+            total += countInBlock(level - 1, bx * 2 + i, by * 2 + j, x0, y0, x1, y1, limit - total);
+        }
+    }
+    return total;
+}
+
+/**
+ * @brief Checks whether any cell in a box is occupied.
+ */
+bool MapPyramid::anyOccupied(int x0, int y0, int x1, int y1) const {
+    checkSize();
+    x0 = std::max(x0, 0);
+    y0 = std::max(y0, 0);
+    x1 = std::min(x1, sizeX - 1);
+    y1 = std::min(y1, sizeY - 1);
+    if (x0 > x1 || y0 > y1) {
+        return false;
+    }
+    return countInBlock(getLevelCount() - 1, 0, 0, x0, y0, x1, y1, 1) > 0;
+}
+
+/**
+ * @brief Counts the occupied cells in a box.
+ */
+int MapPyramid::countOccupied(int x0, int y0, int x1, int y1) const {
+    checkSize();
+    x0 = std::max(x0, 0);
+    y0 = std::max(y0, 0);
+    x1 = std::min(x1, sizeX - 1);
+    y1 = std::min(y1, sizeY - 1);
+    if (x0 > x1 || y0 > y1) {
+        return 0;
+    }
+    return countInBlock(getLevelCount() - 1, 0, 0, x0, y0, x1, y1, std::numeric_limits<int>::max());
+}
+
+/**
+ * @brief Finds the first occupied cell along a segment.
+ *
+ * The segment is first clipped to the map. From the current cell, the ray
+ * climbs to the coarsest level whose block is still empty and moves to the
+ * neighbouring cell across the face where it leaves that block. The exit
+ * coordinate along the other axis is clamped to the block, so rounding can
+ * never move the ray backwards or skip a cell.
+ */
+bool MapPyramid::castRay(double startX, double startY, double endX, double endY, int& hitX, int& hitY) const {
+    checkSize();
+    if (sizeX <= 0 || sizeY <= 0) {
+        return false;
+    }
+    const double dx = endX - startX;
+    const double dy = endY - startY;
+
+    // Liang-Barsky clip against [0, sizeX] x [0, sizeY]
+    double tEnter = 0.0;
+    double tExit = 1.0;
+    const double p[4] = { -dx, dx, -dy, dy };
+    const double q[4] = { startX, sizeX - startX, startY, sizeY - startY };
+    for (int i = 0; i < 4; ++i) {
+        if (p[i] == 0.0) {
+            if (q[i] < 0.0) {
+                return false;
+            }
+            continue;
+        }
+        const double t = q[i] / p[i];
+        if (p[i] < 0.0) {
+            tEnter = std::max(tEnter, t);
+        }
+        else {
+            tExit = std::min(tExit, t);
+        }
+    }
+    if (tEnter > tExit) {
+        return false;
+    }
+
+    int x = std::min(std::max(static_cast<int>(std::floor(startX + dx * tEnter)), 0), sizeX - 1);
+    int y = std::min(std::max(static_cast<int>(std::floor(startY + dy * tEnter)), 0), sizeY - 1);
+    const int topLevel = getLevelCount() - 1;
+    const double infinity = std::numeric_limits<double>::infinity();
+
+    while (true) {
+        if (map.cellAt(x, y) != 0) {
+            hitX = x;
+            hitY = y;
+            return true;
+        }
+
+        // Coarsest empty block around the current cell
+        int level = 0;
+        while (level < topLevel && countAt(level + 1, x >> (level + 1), y >> (level + 1)) == 0) {
+            ++level;
+        }
+        const int blockX0 = (x >> level) << level;
+        const int blockY0 = (y >> level) << level;
+        const int blockX1 = blockX0 + (1 << level);
+        const int blockY1 = blockY0 + (1 << level);
+
+        const double tx = dx > 0.0 ? (blockX1 - startX) / dx : dx < 0.0 ? (blockX0 - startX) / dx : infinity;
+        const double ty = dy > 0.0 ? (blockY1 - startY) / dy : dy < 0.0 ? (blockY0 - startY) / dy : infinity;
+        const double t = std::min(tx, ty);
+        if (t > tExit) {
+            return false;
+        }
+
+        if (tx <= ty) {
+            x = dx > 0.0 ? blockX1 : blockX0 - 1;
+        }
+        else {
+            x = std::min(std::max(static_cast<int>(std::floor(startX + dx * t)), blockX0), blockX1 - 1);
+        }
+        if (ty <= tx) {
+            y = dy > 0.0 ? blockY1 : blockY0 - 1;
+        }
+        else {
+            y = std::min(std::max(static_cast<int>(std::floor(startY + dy * t)), blockY0), blockY1 - 1);
+        }
+        if (x < 0 || x >= sizeX || y < 0 || y >= sizeY) {
+            return false;
+        }
+    }
+}
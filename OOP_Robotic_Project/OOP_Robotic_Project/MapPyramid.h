@@ -0,0 +1,167 @@
+#ifndef MAPPYRAMID_H
+#define MAPPYRAMID_H
+
+#include "Map.h"
+#include <vector>
+
+/**
+ * @file   MapPyramid.h
+ * @author Emirhan Kalkan
+ * @date   December, 2024
+ * @brief  Header file for the MapPyramid class.
+ *
+ * This file defines the MapPyramid class, a mip-map style hierarchy of
+ * occupied-cell counts over a Map, used to skip empty space in box and ray queries.
+ */
+
+ /**
+  * @class MapPyramid
+  * @brief Multi-resolution occupancy counts over a Map.
+  *
+  * Level 0 is the map itself (a cell is occupied when it is non-zero). Each
+  * coarser level L halves the resolution: its cell (bx, by) holds the number of
+  * occupied map cells in the 2^L x 2^L block starting at (bx << L, by << L).
+  * The last level is a single cell covering the whole map.
+  *
+  * Queries descend from the top and stop at the first empty block, so large
+  * free areas cost one lookup instead of one per cell. The pyramid keeps a
+  * reference to the map: writes made through setGrid() update every level in
+  * O(levels). update() picks up any other change, like DistanceField::update():
+  * it recomputes the levels over the map tiles changed since the last update
+  * and rebuilds the pyramid when the map was resized. It must be called after
+  * the map changes and before querying.
+  */
+class MapPyramid {
+private:
+    Map& map;                                /**< The map the pyramid is built over. */
+    int sizeX, sizeY;                        /**< Map size when the pyramid was built. */
+    unsigned long long syncedVersion;        /**< Map version the levels reflect. */
+    std::vector<std::vector<int> > counts;   /**< Occupied counts of levels 1 and up (counts[L - 1] is level L). */
+    std::vector<int> levelSizeX;             /**< Width of each level (index 0 is the map). */
+    std::vector<int> levelSizeY;             /**< Height of each level (index 0 is the map). */
+
+    /**
+     * @brief Returns the occupied count of a cell of any level (unchecked).
+     */
+    int countAt(int level, int bx, int by) const {
+        if (level == 0) {
+            return map.cellAt(bx, by) != 0 ? 1 : 0;
+        }
+        return counts[level - 1][by * levelSizeX[level] + bx];
+    }
+
+    /**
+     * @brief Counts occupied cells of a block inside the box (x0, y0)-(x1, y1), stopping at `limit`.
+     */
+    int countInBlock(int level, int bx, int by, int x0, int y0, int x1, int y1, int limit) const;
+
+    /**
+     * @brief Throws if the map was resized since the last update, so queries never read past it.
+     */
+    void checkSize() const;
+
+public:
+    /**
+     * @brief Builds the pyramid over a map.
+     *
+     * @param map The map to index. It must outlive the pyramid.
+     */
+    explicit MapPyramid(Map& map);
+
+    /**
+     * @brief Rebuilds every level from the map, picking up size changes.
+     */
+    void rebuild();
+
+    /**
+     * @brief Brings the levels up to date with the map.
+     *
+     * Only the tiles whose version is newer than the last update are
+     * recomputed; a resized map is rebuilt.
+     */
+    void update();
+
+    /**
+     * @brief Recomputes the levels over a region of cells changed directly in the map.
+     *
+     * Cost is proportional to the region, not to the map. update() finds the
+     * changed regions itself; this is for callers that already know them.
+     *
+     * @param x0 First column of the region.
+     * @param y0 First row of the region.
+     * @param x1 Last column of the region (inclusive).
+     * @param y1 Last row of the region (inclusive).
+     */
+    void refreshRegion(int x0, int y0, int x1, int y1);
+
+    /**
+     * @brief Sets a map cell and updates the levels above it.
+     *
+     * Out-of-bounds coordinates are ignored, as in Map::setGrid().
+     *
+     * @param x The x-coordinate of the cell.
+     * @param y The y-coordinate of the cell.
+     * @param value The value to set.
+     */
+    void setGrid(int x, int y, int value);
+
+    /**
+     * @brief Returns the number of levels, including the map itself.
+     */
+    int getLevelCount() const;
+
+    /**
+     * @brief Returns the number of occupied map cells under a cell of a level.
+     *
+     * @param level The level (0 is the map).
+     * @param bx The x-coordinate of the cell in that level.
+     * @param by The y-coordinate of the cell in that level.
+     * @return The occupied count, or -1 if the coordinates are out of bounds.
+     * @throw std::logic_error If the map was resized since the last update.
+     */
+    int getBlockCount(int level, int bx, int by) const;
+
+    /**
+     * @brief Checks whether any cell in a box is occupied.
+     *
+     * @param x0 First column of the box.
+     * @param y0 First row of the box.
+     * @param x1 Last column of the box (inclusive).
+     * @param y1 Last row of the box (inclusive).
+     * @return true if an occupied cell lies in the box (clipped to the map).
+     * @throw std::logic_error If the map was resized since the last update.
+     */
+    bool anyOccupied(int x0, int y0, int x1, int y1) const;
+
+    /**
+     * @brief Counts the occupied cells in a box.
+     *
+     * @param x0 First column of the box.
+     * @param y0 First row of the box.
+     * @param x1 Last column of the box (inclusive).
+     * @param y1 Last row of the box (inclusive).
+     * @return The number of occupied cells in the box (clipped to the map).
+     * @throw std::logic_error If the map was resized since the last update.
+     */
+    int countOccupied(int x0, int y0, int x1, int y1) const;
+
+    /**
+     * @brief Finds the first occupied cell along a segment.
+     *
+     * Coordinates are in cell units: cell (i, j) covers [i, i + 1) x [j, j + 1).
+     * At each step the ray jumps across the largest empty block containing the
+     * current cell.
+     *
+     * @param startX The x-coordinate of the segment start.
+     * @param startY The y-coordinate of the segment start.
+     * @param endX The x-coordinate of the segment end.
+     * @param endY The y-coordinate of the segment end.
+     * @param hitX Receives the column of the first occupied cell.
+     * @param hitY Receives the row of the first occupied cell.
+     * @return true if the segment meets an occupied cell inside the map.
+     * @throw std::logic_error If the map was resized since the last update.
+     */
+    bool castRay(double startX, double startY, double endX, double endY, int& hitX, int& hitY) const;
+};
+
+#endif // MAPPYRAMID_H
@@ -0,0 +1,429 @@
+#include "MapRenderer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+/**
+ * @file   MapRenderer.cpp
+ * @author Emirhan Kalkan
+ * @date   December, 2024
+ * @brief  Implementation of the MapRenderer class.
+ */
+
+const char* const MapRenderer::ANSI_HOME = "\x1b[H";
+
+namespace {
+    /**
+     * @brief Rounds a viewport coordinate down to a column or row.
+     *
+     * Far coordinates are clamped to a million cells past the viewport, which
+     * keeps the conversion defined; NaN maps to -1, outside the viewport.
+     */
+    int viewportCell(double value) {
+        const double LIMIT = 1e6;
+        if (!(value > -LIMIT)) {
+            return value < 0 ? -static_cast<int>(LIMIT) : -1;
+        }
+        return static_cast<int>(std::floor(std::min(value, LIMIT)));
+    }
+
+    /**
+     * @brief Clips a segment to the cells [0, width) x [0, height) (Liang-Barsky).
+     *
+     * The far edges are excluded, and the clipped ends are rounded down and
+     * clamped against rounding, so far points cost no more than the visible
+     * part of the segment.
+     *
+     * @param ends Receives the first and last cell of the clipped segment, as c0, r0, c1, r1.
+     * @return `false` if the segment misses the rectangle or an end is not finite.
+     */
+    bool clipSegment(double u0, double v0, double u1, double v1, int width, int height, int ends[4]) {
+        const double du = u1 - u0;
+        const double dv = v1 - v0;
+        if (!std::isfinite(u0) || !std::isfinite(v0) || !std::isfinite(du) || !std::isfinite(dv)) {
+            return false;
+        }
+        const double p[4] = { -du, du, -dv, dv };
+        const double q[4] = { u0, std::nextafter(static_cast<double>(width), 0.0) - u0,
+                              v0, std::nextafter(static_cast<double>(height), 0.0) - v0 };
+        double enter = 0.0;
+        double leave = 1.0;
+        for (int k = 0; k < 4; ++k) {
+            if (p[k] == 0.0) {
+                if (q[k] < 0.0) {
+                    return false;
+                }
+            }
+            else if (p[k] < 0.0) {
+                enter = std::max(enter, q[k] / p[k]);
+            }
+            else {
+                leave = std::min(leave, q[k] / p[k]);
+            }
+        }
+        if (enter > leave) {
+            return false;
+        }
+        ends[0] = std::min(width - 1, std::max(0, viewportCell(u0 + enter * du)));
+        ends[1] = std::min(height - 1, std::max(0, viewportCell(v0 + enter * dv)));
+        ends[2] = std::min(width - 1, std::max(0, viewportCell(u0 + leave * du)));
+        ends[3] = std::min(height - 1, std::max(0, viewportCell(v0 + leave * dv)));
+        return true;
+    }
+
+    /**
+     * @brief Calls plot(c, r) for every cell of a Bresenham line, both ends included.
+     */
+    template <typename Plot>
+    void drawLine(int c, int r, int c1, int r1, const Plot& plot) {
+        const int dc = std::abs(c1 - c);
+        const int dr = -std::abs(r1 - r);
+        const int sc = c < c1 ? 1 : -1;
+        const int sr = r < r1 ? 1 : -1;
+        int error = dc + dr;
+        while (true) {
+            plot(c, r);
+            if (c == c1 && r == r1) {
+                break;
+            }
+            const int doubled = 2 * error;
+            if (doubled >= dr) {
+                error += dr;
+                c += sc;
+            }
+            if (doubled <= dc) {
+                error += dc;
+                r += sr;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Constructs a renderer with a viewport of the given size.
+ */
+MapRenderer::MapRenderer(int width, int height, bool ansi)
+    : width(0), height(0), originX(0), originY(0), zoom(1), ansi(ansi),
+      hasRobot(false), robotX(0), robotY(0), robotTh(0) {
+    setSize(width, height);
+}
+
+/**
+ * @brief Resizes the viewport, reallocating the frame buffer.
+ */
+void MapRenderer::setSize(int _width, int _height) {
+    if (_width <= 0 || _height <= 0) {
+        throw std::invalid_argument("Viewport size must be positive.");
+    }
+    width = _width;
+    height = _height;
+    allocateFrame();
+}
+
+/**
+ * @brief Sizes the frame buffer for the viewport and output mode.
+ *
+ * The cursor-home prefix and the line breaks never change, so they are
+ * written once here and render() only overwrites the characters of the map.
+ */
+void MapRenderer::allocateFrame() {
+    frame.assign(bodyOffset() + static_cast<size_t>(width + 1) * height, ' ');
+    if (ansi) {
+        std::memcpy(&frame[0], ANSI_HOME, std::strlen(ANSI_HOME));
+    }
+    for (int row = 0; row < height; ++row) {
+        frame[bodyOffset() + static_cast<size_t>(row) * (width + 1) + width] = '\n';
+    }
+    blockCounts.assign(width, 0);
+}
+
+/**
+ * @brief Returns the offset of the first character of the frame body.
+ */
+size_t MapRenderer::bodyOffset() const {
+    return ansi ? std::strlen(ANSI_HOME) : 0;
+}
+
+/**
+ * @brief Converts a map x-coordinate to a viewport column.
+ */
+int MapRenderer::toColumn(double x) const {
+    return viewportCell((x - originX) / zoom);
+}
+
+/**
+ * @brief Converts a map y-coordinate to a viewport row.
+ */
+int MapRenderer::toRow(double y) const {
+    return viewportCell((y - originY) / zoom);
+}
+
+/**
+ * @brief Sets the part of the map shown in the viewport.
+ */
+void MapRenderer::setViewport(int _originX, int _originY, int _zoom) {
+    if (_zoom <= 0) {
+        throw std::invalid_argument("Zoom must be positive.");
+    }
+    originX = _originX;
+    originY = _originY;
+    zoom = _zoom;
+}
+
+/**
+ * @brief Moves the viewport so that a cell is at its centre, keeping the zoom.
+ */
+void MapRenderer::centerOn(double x, double y) {
+    originX = static_cast<int>(std::floor(x)) - width * zoom / 2;
+    originY = static_cast<int>(std::floor(y)) - height * zoom / 2;
+}
+
+/**
+ * @brief Chooses the smallest zoom that fits the whole map and shows it from (0, 0).
+ */
+void MapRenderer::fitMap(const Map& map) {
+    int zoomX = (map.getNumberX() + width - 1) / width;
+    int zoomY = (map.getNumberY() + height - 1) / height;
+    setViewport(0, 0, std::max(1, std::max(zoomX, zoomY)));
+}
+
+/**
+ * @brief Sets the robot pose drawn over the map.
+ */
+void MapRenderer::setRobotPose(Pose pose) {
+    pose.getPose(robotX, robotY, robotTh);
+    hasRobot = true;
+}
+
+/**
+ * @brief Sets the path drawn over the map.
+ */
+void MapRenderer::setPath(const std::vector<Point>& _path) {
+    path = _path;
+}
+
+/**
+ * @brief Removes the robot and the path.
+ */
+void MapRenderer::clearOverlay() {
+    hasRobot = false;
+    path.clear();
+}
+
+/**
+ * @brief Composes a frame of the map and the overlay into the frame buffer.
+ *
+ * Each text row accumulates the occupied cells of its zoom map rows per
+ * character, reading the map one row at a time, then classifies the blocks.
+ */
+const std::string& MapRenderer::render(const Map& map) {
+    const int nx = map.getNumberX();
+    const int ny = map.getNumberY();
+    char* out = &frame[bodyOffset()];
+
+    for (int row = 0; row < height; ++row, out += width + 1) {
+        const int y0 = std::max(0, originY + row * zoom);
+        const int y1 = std::min(ny, originY + (row + 1) * zoom);
+        if (y0 >= y1) {
+            std::fill(out, out + width, ' ');
+            continue;
+        }
+        std::fill(blockCounts.begin(), blockCounts.end(), 0);
+        for (int y = y0; y < y1; ++y) {
+            const MapCell* cells = map.getRow(y);
+            for (int column = 0; column < width; ++column) {
+                const int x0 = std::max(0, originX + column * zoom);
+                const int x1 = std::min(nx, originX + (column + 1) * zoom);
+                int count = 0;
+                for (int x = x0; x < x1; ++x) {
+                    count += cells[x] != 0;
+                }
+                blockCounts[column] += count;
+            }
+        }
+        for (int column = 0; column < width; ++column) {
+            const int x0 = std::max(0, originX + column * zoom);
+            const int x1 = std::min(nx, originX + (column + 1) * zoom);
+            const int area = std::max(0, x1 - x0) * (y1 - y0);
+            const int count = blockCounts[column];
+            out[column] = area == 0 ? ' ' : count == 0 ? '.' : 2 * count < area ? '+' : '#';
+        }
+    }
+
+    drawPath();
+    drawRobot();
+    return frame;
+}
+
+/**
+ * @brief Draws the path over the composed occupancy characters.
+ *
+ * Consecutive points are joined with Bresenham lines in viewport coordinates,
+ * so the path stays connected at any zoom. Each segment is first clipped to
+ * the viewport (Liang-Barsky), so far points cost no more than the visible
+ * part of their segments; segments with a non-finite end are skipped.
+ */
+void MapRenderer::drawPath() {
+    char* body = &frame[bodyOffset()];
+    for (size_t i = 0; i < path.size(); ++i) {
+        const Point& end = path[i];
+        const Point& start = i > 0 ? path[i - 1] : end;
+        int ends[4];
+        if (!clipSegment((start.getX() - originX) / zoom, (start.getY() - originY) / zoom,
+                (end.getX() - originX) / zoom, (end.getY() - originY) / zoom, width, height, ends)) {
+            continue;
+        }
+        drawLine(ends[0], ends[1], ends[2], ends[3], [&](int c, int r) {
+            body[static_cast<size_t>(r) * (width + 1) + c] = '*';
+        });
+    }
+}
+
+/**
+ * @brief Draws the robot over the composed occupancy characters.
+ *
+ * The map y-axis points down the screen, so a heading of 90 degrees is drawn as 'v'.
+ */
+void MapRenderer::drawRobot() {
+    if (!hasRobot) {
+        return;
+    }
+    const int column = toColumn(robotX);
+    const int row = toRow(robotY);
+    if (column < 0 || column >= width || row < 0 || row >= height) {
+        return;
+    }
+    double heading = std::fmod(robotTh, 360.0);
+    if (heading < 0) {
+        heading += 360.0;
+    }
+    static const char arrows[] = { '>', 'v', '<', '^' };
+    frame[bodyOffset() + static_cast<size_t>(row) * (width + 1) + column] =
+        arrows[static_cast<int>((heading + 45.0) / 90.0) % 4];
+}
+
+/**
+ * @brief Writes the last composed frame with a single write and flushes it.
+ */
+void MapRenderer::present(std::ostream& out) const {
+    out.write(frame.data(), static_cast<std::streamsize>(frame.size()));
+    out.flush();
+}
+
+/**
+ * @brief Renders and presents a frame.
+ */
+void MapRenderer::draw(const Map& map, std::ostream& out) {
+    render(map);
+    present(out);
+}
+
+/**
+ * @brief Returns the last composed frame.
+ */
+const std::string& MapRenderer::getFrame() const {
+    return frame;
+}
+
+/**
+ * @brief Returns the character at a viewport position of the last frame.
+ *
+ * @throw std::out_of_range If the position is outside the viewport.
+ */
+char MapRenderer::charAt(int column, int row) const {
+    if (column < 0 || column >= width || row < 0 || row >= height) {
+        throw std::out_of_range("Position is outside the viewport.");
+    }
+    return frame[bodyOffset() + static_cast<size_t>(row) * (width + 1) + column];
+}
+
+/**
+ * @brief Writes a binary image (PGM or PPM).
+ *
+ * The header and pixels are assembled in one buffer and written at once.
+ */
+bool MapRenderer::writeImage(const std::string& filename, const char* magic, int imageWidth, int imageHeight,
+    const std::vector<unsigned char>& pixels) {
+    std::ofstream file(filename, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    std::string image = std::string(magic) + "\n" + std::to_string(imageWidth) + " "
+        + std::to_string(imageHeight) + "\n255\n";
+    image.append(reinterpret_cast<const char*>(pixels.data()), pixels.size());
+    file.write(image.data(), static_cast<std::streamsize>(image.size()));
+    return static_cast<bool>(file);
+}
+
+/**
+ * @brief Saves the whole map as a binary greyscale PGM image, one pixel per cell.
+ */
+bool MapRenderer::savePGM(const Map& map, const std::string& filename, bool scaleValues) {
+    const int nx = map.getNumberX();
+    const int ny = map.getNumberY();
+    std::vector<unsigned char> pixels(static_cast<size_t>(nx) * ny);
+    unsigned char* out = pixels.data();
+    for (int y = 0; y < ny; ++y, out += nx) {
+        const MapCell* cells = map.getRow(y);
+        for (int x = 0; x < nx; ++x) {
+            out[x] = scaleValues ? static_cast<unsigned char>(255 - cells[x]) : (cells[x] != 0 ? 0 : 255);
+        }
+    }
+    return writeImage(filename, "P5", nx, ny, pixels);
+}
+
+/**
+ * @brief Saves the whole map with the overlay as a binary colour PPM image.
+ */
+bool MapRenderer::savePPM(const Map& map, const std::string& filename) const {
+    const int nx = map.getNumberX();
+    const int ny = map.getNumberY();
+    std::vector<unsigned char> pixels(static_cast<size_t>(nx) * ny * 3);
+    unsigned char* out = pixels.data();
+    for (int y = 0; y < ny; ++y) {
+        const MapCell* cells = map.getRow(y);
+        for (int x = 0; x < nx; ++x, out += 3) {
+            const unsigned char grey = cells[x] != 0 ? 0 : 255;
+            out[0] = out[1] = out[2] = grey;
+        }
+    }
+
+    auto paint = [&](int x, int y, unsigned char r, unsigned char g, unsigned char b) {
+        if (x >= 0 && x < nx && y >= 0 && y < ny) {
+            unsigned char* pixel = &pixels[(static_cast<size_t>(y) * nx + x) * 3];
+            pixel[0] = r;
+            pixel[1] = g;
+            pixel[2] = b;
+        }
+    };
+
+    // Segments are clipped to the image like in drawPath()
+    for (size_t i = 0; i < path.size(); ++i) {
+        const Point& end = path[i];
+        const Point& start = i > 0 ? path[i - 1] : end;
+        int ends[4];
+        if (nx > 0 && ny > 0 && clipSegment(start.getX(), start.getY(), end.getX(), end.getY(), nx, ny, ends)) {
+            drawLine(ends[0], ends[1], ends[2], ends[3], [&](int x, int y) { paint(x, y, 0, 0, 255); });
+        }
+    }
+
+    // Far coordinates are clamped like viewport cells; a robot at NaN is not drawn
+    if (hasRobot && !std::isnan(robotX) && !std::isnan(robotY)) {
+        const int x = viewportCell(robotX);
+        const int y = viewportCell(robotY);
+        for (int dy = -1; dy <= 1; ++dy) {
+            for (int dx = -1; dx <= 1; ++dx) {
+                paint(x + dx, y + dy, 255, 0, 0);
+            }
+        }
+        const double radians = robotTh * 3.14159265358979323846 / 180.0;
+        if (std::isfinite(radians)) {
+            paint(x + static_cast<int>(std::lround(std::cos(radians))),
+                y + static_cast<int>(std::lround(std::sin(radians))), 255, 255, 0);
+        }
+    }
+    return writeImage(filename, "P6", nx, ny, pixels);
+}
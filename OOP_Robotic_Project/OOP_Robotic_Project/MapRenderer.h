@@ -0,0 +1,201 @@
+#ifndef MAPRENDERER_H
+#define MAPRENDERER_H
+
+#include "Map.h"
+#include "Point.h"
+#include "Pose.h"
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * @file   MapRenderer.h
+ * @author Emirhan Kalkan
+ * @date   December, 2024
+ * @brief  Header file for the MapRenderer class.
+ *
+ * This file defines the MapRenderer class, which draws a Map as text frames
+ * for a terminal and exports PGM/PPM snapshots.
+ */
+
+ /**
+  * @class MapRenderer
+  * @brief Draws a viewport of a map, with the robot and its path, at a high frame rate.
+  *
+  * A frame is composed into a buffer allocated once for the frame size and
+  * emitted with a single write, so a live view does not pay for per-cell
+  * stream insertions or repeated allocations. Each character covers a block of
+  * zoom x zoom cells and shows how much of it is occupied:
+  * - ' ' outside the map,
+  * - '.' free,
+  * - '+' partly occupied (less than half),
+  * - '#' mostly occupied.
+  *
+  * The path is drawn with '*' and the robot with an arrow ('>', 'v', '<', '^')
+  * pointing along its heading. Row y of the map is printed top to bottom, as in
+  * Map::showMap(). Overlay coordinates are in cells, the units of Map::insertPoint().
+  *
+  * With ANSI output enabled, each frame starts by moving the cursor home, so
+  * successive frames redraw in place instead of scrolling.
+  */
+class MapRenderer {
+private:
+    int width;                   /**< Viewport width in characters. */
+    int height;                  /**< Viewport height in characters. */
+    int originX;                 /**< Map x-coordinate of the top-left character. */
+    int originY;                 /**< Map y-coordinate of the top-left character. */
+    int zoom;                    /**< Cells per character along each axis. */
+    bool ansi;                   /**< Whether frames start with an ANSI cursor-home sequence. */
+    std::string frame;           /**< The composed frame, reused between renders. */
+    std::vector<int> blockCounts;/**< Occupied cells per character of the current text row. */
+    bool hasRobot;               /**< Whether a robot pose is set. */
+    double robotX;               /**< Robot x-coordinate in cells. */
+    double robotY;               /**< Robot y-coordinate in cells. */
+    double robotTh;              /**< Robot heading in degrees. */
+    std::vector<Point> path;     /**< Path drawn under the robot. */
+
+    /**
+     * @brief Sizes the frame buffer for the viewport and output mode.
+     */
+    void allocateFrame();
+
+    /**
+     * @brief Returns the offset of the first character of the frame body.
+     */
+    size_t bodyOffset() const;
+
+    /**
+     * @brief Converts a map coordinate to a viewport column or row (may be outside the viewport).
+     *
+     * Far coordinates are clamped and NaN maps to -1, so any double is accepted.
+     */
+    int toColumn(double x) const;
+    int toRow(double y) const;
+
+    /**
+     * @brief Draws the path over the composed occupancy characters.
+     */
+    void drawPath();
+
+    /**
+     * @brief Draws the robot over the composed occupancy characters.
+     */
+    void drawRobot();
+
+    /**
+     * @brief Writes a binary image (PGM or PPM) in a single write.
+     */
+    static bool writeImage(const std::string& filename, const char* magic, int width, int height,
+        const std::vector<unsigned char>& pixels);
+
+public:
+    static const char* const ANSI_HOME;   /**< Cursor-home sequence written before each ANSI frame. */
+
+    /**
+     * @brief Constructs a renderer with a viewport of the given size.
+     *
+     * The viewport starts at cell (0, 0) with a zoom of 1.
+     *
+     * @param width Viewport width in characters.
+     * @param height Viewport height in characters.
+     * @param ansi Whether frames redraw in place using ANSI escape sequences.
+     * @throw std::invalid_argument If the width or height is not positive.
+     */
+    MapRenderer(int width = 80, int height = 40, bool ansi = true);
+
+    /**
+     * @brief Resizes the viewport, reallocating the frame buffer.
+     *
+     * @throw std::invalid_argument If the width or height is not positive.
+     */
+    void setSize(int width, int height);
+
+    /**
+     * @brief Sets the part of the map shown in the viewport.
+     *
+     * @param originX Map x-coordinate of the top-left character.
+     * @param originY Map y-coordinate of the top-left character.
+     * @param zoom Cells per character along each axis (1 shows every cell).
+     * @throw std::invalid_argument If the zoom is not positive.
+     */
+    void setViewport(int originX, int originY, int zoom = 1);
+
+    /**
+     * @brief Moves the viewport so that a cell is at its centre, keeping the zoom.
+     */
+    void centerOn(double x, double y);
+
+    /**
+     * @brief Chooses the smallest zoom that fits the whole map and shows it from (0, 0).
+     */
+    void fitMap(const Map& map);
+
+    /**
+     * @brief Sets the robot pose drawn over the map.
+     *
+     * @param pose Position in cells and heading in degrees.
+     */
+    void setRobotPose(Pose pose);
+
+    /**
+     * @brief Sets the path drawn over the map; consecutive points are joined.
+     */
+    void setPath(const std::vector<Point>& path);
+
+    /**
+     * @brief Removes the robot and the path.
+     */
+    void clearOverlay();
+
+    /**
+     * @brief Composes a frame of the map and the overlay into the frame buffer.
+     *
+     * @return The frame, valid until the next call to render() or setSize().
+     */
+    const std::string& render(const Map& map);
+
+    /**
+     * @brief Writes the last composed frame with a single write and flushes it.
+     */
+    void present(std::ostream& out = std::cout) const;
+
+    /**
+     * @brief Renders and presents a frame.
+     */
+    void draw(const Map& map, std::ostream& out = std::cout);
+
+    /**
+     * @brief Returns the last composed frame.
+     */
+    const std::string& getFrame() const;
+
+    /**
+     * @brief Returns the character at a viewport position of the last frame.
+     */
+    char charAt(int column, int row) const;
+
+    /**
+     * @brief Saves the whole map as a binary greyscale PGM image, one pixel per cell.
+     *
+     * @param map The map to save.
+     * @param filename The name of the file.
+     * @param scaleValues If `false`, occupied cells are black and free cells white;
+     *        if `true`, a pixel is 255 minus the cell value, e.g. to view a costmap.
+     * @return `true` if the image was written, `false` otherwise.
+     */
+    static bool savePGM(const Map& map, const std::string& filename, bool scaleValues = false);
+
+    /**
+     * @brief Saves the whole map with the overlay as a binary colour PPM image.
+     *
+     * Occupied cells are black, free cells white, the path blue and the robot
+     * a red 3x3 square with a yellow pixel in the direction of its heading.
+     * Path segments are clipped to the image as in render(); segments with a
+     * non-finite end are skipped.
+     *
+     * @return `true` if the image was written, `false` otherwise.
+     */
+    bool savePPM(const Map& map, const std::string& filename) const;
+};
+
+#endif // MAPRENDERER_H
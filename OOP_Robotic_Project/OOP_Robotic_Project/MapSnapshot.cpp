@@ -0,0 +1,56 @@
+#include "MapSnapshot.h"
+#include <algorithm>
+#include <cstring>
+
+/**
+ * @file   MapSnapshot.cpp
+ * @author Emirhan Kalkan
+ * @date   December, 2024
+ * @brief  Implementation of the MapSnapshot class.
+ */
+
+/**
+ * @brief Constructs an empty snapshot.
+ */
+MapSnapshot::MapSnapshot() : sizeX(0), sizeY(0), tilesX(0), version(0) {
+}
+
+int MapSnapshot::getNumberX() const {
+    return sizeX;
+}
+
+int MapSnapshot::getNumberY() const {
+    return sizeY;
+}
+
+unsigned long long MapSnapshot::getVersion() const {
+    return version;
+}
+
+/**
+ * @brief Returns the value of a cell, or -1 if the coordinates are out of bounds.
+ */
+int MapSnapshot::getGrid(int x, int y) const {
+    if (x >= 0 && x < sizeX && y >= 0 && y < sizeY) {
+        return cellAt(x, y);
+    }
+    return -1;
+}
+
+/**
+ * @brief Copies the snapshot into a map, resizing it and recording the change.
+ */
+void MapSnapshot::copyTo(Map& map) const {
+    if (map.getNumberX() != sizeX || map.getNumberY() != sizeY) {
+        map.setGridSize(sizeX, sizeY);
+    }
+    for (int y = 0; y < sizeY; ++y) {
+        MapCell* row = map.getRow(y);
+        const int tileRow = (y & (Map::DIRTY_TILE_SIZE - 1)) << Map::DIRTY_TILE_SHIFT;
+        for (int x0 = 0; x0 < sizeX; x0 += Map::DIRTY_TILE_SIZE) {
+            const MapCell* tile = getTile(x0 >> Map::DIRTY_TILE_SHIFT, y >> Map::DIRTY_TILE_SHIFT);
+            std::memcpy(row + x0, tile + tileRow, std::min(Map::DIRTY_TILE_SIZE, sizeX - x0));
+        }
+    }
+    map.markDirty(0, 0, sizeX - 1, sizeY - 1);
+}
@@ -0,0 +1,92 @@
+#ifndef MAPSNAPSHOT_H
+#define MAPSNAPSHOT_H
+
+#include "Map.h"
+#include <memory>
+#include <vector>
+
+/**
+ * @file   MapSnapshot.h
+ * @author Emirhan Kalkan
+ * @date   December, 2024
+ * @brief  Header file for the MapSnapshot class.
+ *
+ * This file defines the MapSnapshot class, an immutable view of a Map taken
+ * with Map::snapshot().
+ */
+
+ /**
+  * @class MapSnapshot
+  * @brief A read-only copy of a map at one version, sharing unchanged tiles with other snapshots.
+  *
+  * The cells are held per change-tracking tile (Map::DIRTY_TILE_SIZE squared
+  * cells, rows of DIRTY_TILE_SIZE cells; edge tiles are padded). Tiles are
+  * immutable and reference counted: a new snapshot only copies the tiles the
+  * map changed since the previous one, and tiles still holding the value of
+  * the last Map::clearMap() all share one buffer.
+  *
+  * Snapshots never change after they are taken, so a planner or logger can
+  * read one on another thread while the mapper keeps writing to the map.
+  * Copying a snapshot copies the tile pointers only.
+  */
+class MapSnapshot {
+private:
+    int sizeX, sizeY;                                   /**< Map size when the snapshot was taken. */
+    int tilesX;                                         /**< Number of tiles per tile row. */
+    unsigned long long version;                         /**< Map version when the snapshot was taken. */
+    std::vector<std::shared_ptr<const MapCell> > tiles; /**< Cells of each tile, row-major. */
+
+    friend class Map;
+
+public:
+    /**
+     * @brief Constructs an empty snapshot.
+     */
+    MapSnapshot();
+
+    /**
+     * @brief Returns the number of columns of the map when the snapshot was taken.
+     */
+    int getNumberX() const;
+
+    /**
+     * @brief Returns the number of rows of the map when the snapshot was taken.
+     */
+    int getNumberY() const;
+
+    /**
+     * @brief Returns the map version when the snapshot was taken.
+     */
+    unsigned long long getVersion() const;
+
+    /**
+     * @brief Returns the value of a cell.
+     *
+     * @return The value of the cell, or -1 if the coordinates are out of bounds.
+     */
+    int getGrid(int x, int y) const;
+
+    /**
+     * @brief Returns a cell without bounds checking.
+     */
+    MapCell cellAt(int x, int y) const {
+        const MapCell* tile = tiles[static_cast<size_t>(y >> Map::DIRTY_TILE_SHIFT) * tilesX + (x >> Map::DIRTY_TILE_SHIFT)].get();
+        return tile[((y & (Map::DIRTY_TILE_SIZE - 1)) << Map::DIRTY_TILE_SHIFT) + (x & (Map::DIRTY_TILE_SIZE - 1))];
+    }
+
+    /**
+     * @brief Returns the cells of a tile (unchecked), DIRTY_TILE_SIZE rows of DIRTY_TILE_SIZE cells.
+     *
+     * Two snapshots returning the same pointer share the tile.
+     */
+    const MapCell* getTile(int tx, int ty) const {
+        return tiles[static_cast<size_t>(ty) * tilesX + tx].get();
+    }
+
+    /**
+     * @brief Copies the snapshot into a map, resizing it and recording the change.
+     */
+    void copyTo(Map& map) const;
+};
+
+#endif // MAPSNAPSHOT_H
@@ -1,7 +1,13 @@
 #include "mapper.h"
+#include "MapFile.h"
+#include "ThreadPool.h"
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <cmath>  
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
@@ -17,6 +23,51 @@
  * for mapping and updating the robot's environment using lidar data.
  */
 
+namespace {
+    /**
+     * @brief Cosine and sine of all 360 whole degrees, computed once.
+     *
+     * Lidar angles handed to updateMap() are whole degrees, so per-reading
+     * trigonometric calls are replaced by a table lookup.
+     */
+    struct DegreeTable {
+        double cosValues[360];
+        double sinValues[360];
+
+        DegreeTable() {
+            for (int i = 0; i < 360; ++i) {
+                cosValues[i] = cos(i * M_PI / 180);
+                sinValues[i] = sin(i * M_PI / 180);
+            }
+        }
+    };
+
+    const DegreeTable& degreeTable() {
+        static const DegreeTable table;
+        return table;
+    }
+
+    const int LOG_ODDS_BIAS = 128;  /**< Stored evidence value meaning "no evidence". */
+
+    /**
+     * @brief Largest beam endpoint coordinate traced, keeps float-to-int conversions defined.
+     */
+    const float MAX_ENDPOINT = 1 << 24;
+
+    /**
+     * @brief Row bands per thread in the parallel path; more bands balance uneven scans.
+     */
+    const int BANDS_PER_THREAD = 4;
+
+    const unsigned int MAP_CHANGED = 1;        /**< Flag of a band change: the map cell changed. */
+    const unsigned int EVIDENCE_CHANGED = 2;   /**< Flag of a band change: the evidence cell changed. */
+
+    /**
+     * @brief Smallest batch integrated in parallel; smaller ones do not pay for the hand-over.
+     */
+    const int PARALLEL_MIN_POINTS = 64;
+}
+
  /**
   * @class Mapper
   * @brief A class that maps the environment based on lidar data.
@@ -26,8 +77,193 @@
   * points on the map.
   */
 Mapper::Mapper(int gridSizeX, int gridSizeY, int startX, int startY)
-    : map(gridSizeX, gridSizeY), robotX(startX), robotY(startY) {
+    : map(gridSizeX, gridSizeY), robotX(startX), robotY(startY), mode(MAPPING_BINARY), evidence(0, 0),
+    occupiedThreshold(0) {
+    setLogOddsParameters(17, 4, 100, 10);
+}
+
+/**
+ * @brief Destructor. Defined here, where ThreadPool is a complete type, so
+ *        that the pool's unique_ptr can destroy it.
+ */
+Mapper::~Mapper() {
+}
 
+/**
+ * @brief Sets the number of threads used by updateMap(const PointBatch&).
+ */
+void Mapper::setThreadCount(int threads) {
+    if (threads <= 1) {
+        pool.reset();
+    }
+    else if (getThreadCount() != threads) {
+        pool.reset(new ThreadPool(threads));
+    }
+}
+
+int Mapper::getThreadCount() const {
+    return pool ? pool->getThreadCount() : 1;
+}
+
+/**
+ * @brief Sets the robot cell used as the origin of the lidar readings.
+ */
+void Mapper::setRobotPosition(int x, int y) {
+    robotX = x;
+    robotY = y;
+}
+
+/**
+ * @brief Selects how readings are written into the map.
+ *
+ * The evidence grid is only allocated in log-odds mode.
+ */
+void Mapper::setMappingMode(MAPPING_MODE newMode) {
+    mode = newMode;
+    map.clearMap();
+    if (mode == MAPPING_LOG_ODDS) {
+        if (evidence.getNumberX() != map.getNumberX() || evidence.getNumberY() != map.getNumberY()) {
+            evidence.setGridSize(map.getNumberX(), map.getNumberY());
+        }
+        evidence.clearMap(LOG_ODDS_BIAS);
+    }
+    else {
+        evidence.setGridSize(0, 0);
+    }
+}
+
+MAPPING_MODE Mapper::getMappingMode() const {
+    return mode;
+}
+
+/**
+ * @brief Sets the log-odds update parameters and rebuilds the update tables.
+ *
+ * @throw std::invalid_argument If a value is out of range.
+ */
+void Mapper::setLogOddsParameters(int hit, int miss, int limit, int threshold) {
+    if (limit < 1 || limit > 127 || hit < 1 || hit > limit || miss < 1 || miss > limit ||
+        threshold < 0 || threshold > limit) {
+        throw std::invalid_argument("Invalid log-odds parameters.");
+    }
+    for (int value = 0; value < 256; ++value) {
+        int logOdds = value - LOG_ODDS_BIAS;
+        int afterHit = logOdds + hit < limit ? logOdds + hit : limit;
+        int afterMiss = logOdds - miss > -limit ? logOdds - miss : -limit;
+        hitTable[value] = static_cast<MapCell>(afterHit + LOG_ODDS_BIAS);
+        missTable[value] = static_cast<MapCell>(afterMiss + LOG_ODDS_BIAS);
+        occupiedTable[value] = logOdds > threshold ? 1 : 0;
+    }
+    occupiedThreshold = threshold;
+}
+
+/**
+ * @brief Returns the log-odds evidence of a cell.
+ */
+int Mapper::getLogOdds(int x, int y) const {
+    int value = evidence.getGrid(x, y);
+    return value < 0 ? 0 : value - LOG_ODDS_BIAS;
+}
+
+/**
+ * @brief Returns the occupancy state of a cell in log-odds mode.
+ */
+CELL_STATE Mapper::getOccupancy(int x, int y) const {
+    int logOdds = getLogOdds(x, y);
+    if (logOdds > occupiedThreshold) {
+        return CELL_OCCUPIED;
+    }
+    if (logOdds < -occupiedThreshold) {
+        return CELL_FREE;
+    }
+    return CELL_UNKNOWN;
+}
+
+/**
+ * @brief Walks one beam from the robot cell.
+ *
+ * The beam is first clipped to the map rectangle (Liang-Barsky), so the walk
+ * costs at most the cells of the beam inside the map, even for a robot outside
+ * the map or an endpoint far away. The clipped segment is then walked with an
+ * integer Bresenham walk over all octants. Every cell before the endpoint is
+ * visited as a miss and the endpoint, if inside the map, as a hit; a beam
+ * clipped at its far end ends with a miss.
+ *
+ * @param endX The x-coordinate of the endpoint cell.
+ * @param endY The y-coordinate of the endpoint cell.
+ * @param visit Called as visit(x, y, hit) for each cell inside the map.
+ */
+template <typename Visitor>
+void Mapper::walkBeam(int endX, int endY, Visitor visit) const {
+    const double deltaX = static_cast<double>(endX) - robotX;
+    const double deltaY = static_cast<double>(endY) - robotY;
+    const double p[4] = { -deltaX, deltaX, -deltaY, deltaY };
+    const double q[4] = { static_cast<double>(robotX), map.getNumberX() - 1.0 - robotX,
+                          static_cast<double>(robotY), map.getNumberY() - 1.0 - robotY };
+    double enter = 0.0;
+    double leave = 1.0;
+    for (int k = 0; k < 4; ++k) {
+        if (p[k] == 0.0) {
+            if (q[k] < 0.0) {
+                return;
+            }
+        }
+        else if (p[k] < 0.0) {
+            enter = std::max(enter, q[k] / p[k]);
+        }
+        else {
+            leave = std::min(leave, q[k] / p[k]);
+        }
+    }
+    if (enter > leave) {
+        return;
+    }
+
+    // Both ends now lie in the map, and so does every cell between them
+    int x = enter > 0.0 ? static_cast<int>(std::lround(robotX + enter * deltaX)) : robotX;
+    int y = enter > 0.0 ? static_cast<int>(std::lround(robotY + enter * deltaY)) : robotY;
+    const bool hitEnd = leave >= 1.0;
+    const int lastX = hitEnd ? endX : static_cast<int>(std::lround(robotX + leave * deltaX));
+    const int lastY = hitEnd ? endY : static_cast<int>(std::lround(robotY + leave * deltaY));
+    const int dx = std::abs(lastX - x);
+    const int dy = -std::abs(lastY - y);
+    const int stepX = x < lastX ? 1 : -1;
+    const int stepY = y < lastY ? 1 : -1;
+    int error = dx + dy;
+
+    while (x != lastX || y != lastY) {
+        visit(x, y, false);
+        int doubled = 2 * error;
+        if (doubled >= dy) {
+            error += dy;
+            x += stepX;
+        }
+        if (doubled <= dx) {
+            error += dx;
+            y += stepY;
+        }
+    }
+    visit(x, y, hitEnd);
+}
+
+/**
+ * @brief Traces one beam from the robot cell in log-odds mode.
+ *
+ * Cells along the beam get a miss update and the endpoint a hit update.
+ *
+ * @param endX The x-coordinate of the endpoint cell.
+ * @param endY The y-coordinate of the endpoint cell.
+ */
+void Mapper::traceBeam(int endX, int endY) {
+    walkBeam(endX, endY, [this](int x, int y, bool hit) {
+        MapCell& cell = evidence.cellAt(x, y);
+        const MapCell updated = hit ? hitTable[cell] : missTable[cell];
+        if (updated != cell) {
+            cell = updated;
+            evidence.markDirty(x, y);
+        }
+        setCell(x, y, occupiedTable[cell]);
+    });
 }
 
 /**
@@ -41,23 +277,166 @@ Mapper::Mapper(int gridSizeX, int gridSizeY, int startX, int startY)
  *                  and angle in degrees.
  */
 void Mapper::updateMap(const std::vector<std::pair<int, int>>& lidarData) {
+    const DegreeTable& table = degreeTable();
+
     for (const auto& data : lidarData) {
         int distance = data.first;  /**< Distance from the robot to the obstacle. */
         int angle = data.second;    /**< Angle of the lidar reading in degrees. */
 
-        int x = robotX + distance * cos(angle * M_PI / 180);  /**< X coordinate calculation. */
-        int y = robotY + distance * sin(angle * M_PI / 180);  /**< Y coordinate calculation. */
+        int index = angle % 360;
+        if (index < 0) {
+            index += 360;
+        }
+
+        int x = robotX + distance * table.cosValues[index];  /**< X coordinate calculation. */
+        int y = robotY + distance * table.sinValues[index];  /**< Y coordinate calculation. */
 
-        if (x >= 0 && x < map.getNumberX() && y >= 0 && y < map.getNumberY()) {
+        if (mode == MAPPING_LOG_ODDS) {
+            traceBeam(x, y);  /**< Clear the cells along the beam and mark the endpoint. */
+        }
+        else if (x >= 0 && x < map.getNumberX() && y >= 0 && y < map.getNumberY()) {
             map.insertPoint(Point(x, y));  /**< If valid, mark the point on the map. */
         }
     }
 }
 
+/**
+ * @brief Updates the map using a batch of projected lidar points.
+ *
+ * Points that are not finite, e.g. beams masked by a ScanFilter, are skipped.
+ *
+ * @param points Batch of points in the map frame (grid units).
+ */
+void Mapper::updateMap(const PointBatch& points) {
+    // Parallel updates pack a 30-bit cell offset with two change flags
+    if (pool && points.size() >= PARALLEL_MIN_POINTS && map.getNumberY() > 0 &&
+        static_cast<long long>(map.getStride()) * map.getNumberY() < (1ll << 30)) {
+        updateMapParallel(points);
+        return;
+    }
+
+    const float* xs = points.getX();
+    const float* ys = points.getY();
+    const int sizeX = map.getNumberX();
+    const int sizeY = map.getNumberY();
+
+    for (int i = 0; i < points.size(); ++i) {
+        float fx = std::floor(xs[i]);
+        float fy = std::floor(ys[i]);
+
+        // Comparing before the conversion also rejects invalid (NaN) beams.
+        if (mode == MAPPING_LOG_ODDS) {
+            if (std::fabs(fx) < MAX_ENDPOINT && std::fabs(fy) < MAX_ENDPOINT) {
+                traceBeam(static_cast<int>(fx), static_cast<int>(fy));
+            }
+        }
+        else if (fx >= 0.0f && fx < sizeX && fy >= 0.0f && fy < sizeY) {
+            setCell(static_cast<int>(fx), static_cast<int>(fy), 1);
+        }
+    }
+}
+
+/**
+ * @brief Integrates a batch of points on the thread pool.
+ *
+ * Phase 1: each thread traces a contiguous range of beams and appends every
+ * visited cell to the list of its (thread, band) pair. Phase 2: each band
+ * applies the lists of all threads in thread order, which is beam order, so
+ * every cell is updated in the same sequence as by the serial loop. Changed
+ * cells are recorded per band and marked dirty afterwards on the calling
+ * thread, since the map's change tracking is not thread-safe.
+ */
+void Mapper::updateMapParallel(const PointBatch& points) {
+    const int threads = pool->getThreadCount();
+    const int sizeX = map.getNumberX();
+    const int sizeY = map.getNumberY();
+    const int stride = map.getStride();
+    const int bandCount = std::min(sizeY, threads * BANDS_PER_THREAD);
+    const int bandHeight = (sizeY + bandCount - 1) / bandCount;
+    const int pointCount = points.size();
+    const float* xs = points.getX();
+    const float* ys = points.getY();
+    const bool logOdds = mode == MAPPING_LOG_ODDS;
+
+    beamUpdates.resize(static_cast<size_t>(threads) * bandCount);
+    for (std::vector<unsigned int>& updates : beamUpdates) {
+        updates.clear();
+    }
+    bandChanges.resize(bandCount);
+    for (std::vector<unsigned int>& changes : bandChanges) {
+        changes.clear();
+    }
+
+    pool->run(threads, [&](int part) {
+        std::vector<unsigned int>* updates = &beamUpdates[static_cast<size_t>(part) * bandCount];
+        auto record = [&](int x, int y, bool hit) {
+            updates[y / bandHeight].push_back((static_cast<unsigned int>(y * stride + x) << 1) | (hit ? 1u : 0u));
+        };
+        const int first = static_cast<int>(static_cast<long long>(pointCount) * part / threads);
+        const int last = static_cast<int>(static_cast<long long>(pointCount) * (part + 1) / threads);
+        for (int i = first; i < last; ++i) {
+            float fx = std::floor(xs[i]);
+            float fy = std::floor(ys[i]);
+            if (logOdds) {
+                if (std::fabs(fx) < MAX_ENDPOINT && std::fabs(fy) < MAX_ENDPOINT) {
+                    walkBeam(static_cast<int>(fx), static_cast<int>(fy), record);
+                }
+            }
+            else if (fx >= 0.0f && fx < sizeX && fy >= 0.0f && fy < sizeY) {
+                record(static_cast<int>(fx), static_cast<int>(fy), true);
+            }
+        }
+    });
+
+    MapCell* mapCells = map.getRow(0);
+    MapCell* evidenceCells = logOdds ? evidence.getRow(0) : nullptr;
+    pool->run(bandCount, [&](int band) {
+        std::vector<unsigned int>& changes = bandChanges[band];
+        for (int part = 0; part < threads; ++part) {
+            for (unsigned int update : beamUpdates[static_cast<size_t>(part) * bandCount + band]) {
+                const unsigned int offset = update >> 1;
+                MapCell value = 1;
+                unsigned int changed = 0;
+                if (logOdds) {
+                    MapCell& cell = evidenceCells[offset];
+                    const MapCell updated = (update & 1) ? hitTable[cell] : missTable[cell];
+                    if (updated != cell) {
+                        cell = updated;
+                        changed |= EVIDENCE_CHANGED;
+                    }
+                    value = occupiedTable[cell];
+                }
+                if (mapCells[offset] != value) {
+                    mapCells[offset] = value;
+                    changed |= MAP_CHANGED;
+                }
+                if (changed != 0) {
+                    changes.push_back((offset << 2) | changed);
+                }
+            }
+        }
+    });
+
+    for (const std::vector<unsigned int>& changes : bandChanges) {
+        for (unsigned int change : changes) {
+            const unsigned int offset = change >> 2;
+            const int x = static_cast<int>(offset % stride);
+            const int y = static_cast<int>(offset / stride);
+            if (change & MAP_CHANGED) {
+                map.markDirty(x, y);
+            }
+            if (change & EVIDENCE_CHANGED) {
+                evidence.markDirty(x, y);
+            }
+        }
+    }
+}
+
 /**
  * @brief Records the current map to a file.
  *
  * This method saves the current state of the map (grid values) to a specified file.
+ * Each row is formatted into a line buffer and written with a single call.
  *
  * @param filename The name of the file where the map will be saved.
  */
@@ -65,11 +444,24 @@ void Mapper::recordMap(const std::string& filename) const {
     std::ofstream outFile(filename);  /**< Open the file for writing. */
 
     if (outFile.is_open()) {
+        std::string line;
+        line.reserve(static_cast<size_t>(map.getNumberX()) * 4 + 1);
         for (int i = 0; i < map.getNumberY(); ++i) {
+            const MapCell* row = map.getRow(i);
+            line.clear();
             for (int j = 0; j < map.getNumberX(); ++j) {
-                outFile << map.getGrid(j, i) << " ";  /**< Write grid values to the file. */
+                /**< Write grid values to the file. */
+                if (row[j] >= 100) {
+                    line += static_cast<char>('0' + row[j] / 100);
+                }
+                if (row[j] >= 10) {
+                    line += static_cast<char>('0' + row[j] / 10 % 10);
+                }
+                line += static_cast<char>('0' + row[j] % 10);
+                line += ' ';
             }
-            outFile << "\n";  /**< Newline for the next row. */
+            line += '\n';  /**< Newline for the next row. */
+            outFile.write(line.data(), line.size());
         }
         outFile.close();  /**< Close the file after writing. */
     }
@@ -78,6 +470,50 @@ void Mapper::recordMap(const std::string& filename) const {
     }
 }
 
+/**
+ * @brief Saves the map in the binary map file format.
+ */
+bool Mapper::saveMap(const std::string& filename, double resolution) const {
+    if (mode == MAPPING_LOG_ODDS) {
+        return MapFile::save(filename, evidence, MAP_CELL_LOG_ODDS, resolution);
+    }
+    return MapFile::save(filename, map, MAP_CELL_OCCUPANCY, resolution);
+}
+
+/**
+ * @brief Loads a map saved by saveMap().
+ *
+ * The file is mapped and copied straight into the grid; the map cells of a
+ * log-odds file are rebuilt from the evidence with the occupied table.
+ */
+bool Mapper::loadMap(const std::string& filename) {
+    MapFile file;
+    bool loaded = file.open(filename);
+    if (loaded && file.getInfo().cellType == MAP_CELL_LOG_ODDS) {
+        mode = MAPPING_LOG_ODDS;
+        loaded = file.copyTo(evidence);
+        map.setGridSize(evidence.getNumberX(), evidence.getNumberY());
+        for (int y = 0; y < map.getNumberY(); ++y) {
+            const MapCell* source = evidence.getRow(y);
+            MapCell* row = map.getRow(y);
+            for (int x = 0; x < map.getNumberX(); ++x) {
+                row[x] = occupiedTable[source[x]];
+            }
+        }
+        map.markDirty(0, 0, map.getNumberX() - 1, map.getNumberY() - 1);
+    }
+    else if (loaded) {
+        mode = MAPPING_BINARY;
+        evidence.setGridSize(0, 0);
+        loaded = file.copyTo(map);
+    }
+
+    if (!loaded) {
+        setMappingMode(mode);
+    }
+    return loaded;
+}
+
 /**
  * @brief Displays the map visually on the console.
  *
@@ -85,10 +521,14 @@ void Mapper::recordMap(const std::string& filename) const {
  * and '.' for empty cells.
  */
 void Mapper::showMap() const {
+    std::string line(static_cast<size_t>(map.getNumberX()) * 2 + 1, ' ');
+    line.back() = '\n';  /**< Move to the next line after a row of the map is printed. */
     for (int i = 0; i < map.getNumberY(); ++i) {
+        const MapCell* row = map.getRow(i);
         for (int j = 0; j < map.getNumberX(); ++j) {
-            std::cout << (map.getGrid(j, i) == 1 ? "x" : ".") << " ";  /**< Display map cell. */
+            line[2 * j] = row[j] == 1 ? 'x' : '.';  /**< Display map cell. */
         }
-        std::cout << std::endl;  /**< Move to the next line after a row of the map is printed. */
+        std::cout << line;
     }
+    std::cout.flush();
 }
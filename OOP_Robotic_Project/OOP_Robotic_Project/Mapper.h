@@ -2,9 +2,13 @@
 #define MAPPER_H
 
 #include "Map.h"
+#include "PointBatch.h"
+#include <memory>
 #include <vector>
 #include <string>
 
+class ThreadPool;
+
 /**
  * @file   Mapper.h
  * @author Emirhan Kalkan
@@ -16,6 +20,23 @@
  * and displaying it visually.
  */
 
+/**
+ * @brief How lidar readings are written into the map.
+ */
+enum MAPPING_MODE {
+    MAPPING_BINARY = 0,   /**< Endpoint cells are marked with 1 and never cleared. */
+    MAPPING_LOG_ODDS      /**< Beams are ray traced; cells accumulate clamped log-odds evidence. */
+};
+
+/**
+ * @brief Occupancy state of a cell in log-odds mode.
+ */
+enum CELL_STATE {
+    CELL_UNKNOWN = -1,    /**< Not enough evidence either way (or outside the map). */
+    CELL_FREE = 0,        /**< Evidence below -threshold. */
+    CELL_OCCUPIED = 1     /**< Evidence above +threshold. */
+};
+
  /**
   * @class Mapper
   * @brief A class responsible for mapping the robot's environment using lidar data.
@@ -23,11 +44,71 @@
   * The Mapper class uses lidar data (distance and angle) to update the map with the robot's
   * surroundings. It also provides functionality to store the map to a file and display it
   * visually on the console.
+  *
+  * In log-odds mode every beam is traced from the robot cell to its endpoint
+  * with integer Bresenham steps. Cells along the beam receive a miss update,
+  * the endpoint a hit update. The evidence is kept as a biased byte per cell
+  * (128 = no evidence) and the clamped updates are precomputed 256-entry
+  * tables, so the inner loop is table lookups and integer steps only. The map
+  * cells are kept in sync: 1 where the evidence is above the occupied
+  * threshold, 0 elsewhere, so showMap() and recordMap() work in both modes and
+  * obstacles that move away are cleared.
+  *
+  * With setThreadCount() above 1, batches of points are integrated in
+  * parallel in two phases. First the beams are split into contiguous ranges,
+  * one per thread, and traced into per-band update lists (a band is a range of
+  * map rows). Then each band applies its lists in thread order, i.e. in beam
+  * order. Every cell is owned by one band and sees its updates in the same
+  * order as in the serial loop, so the result is identical to it and
+  * deterministic, without atomics or locks on the cells. The update lists
+  * hold 30-bit cell offsets, so maps of 2^30 cells or more (row padding
+  * included) are always updated serially.
   */
 class Mapper {
 private:
     Map map;  /**< The map that stores the environment grid. */
     int robotX, robotY;  /**< The current position of the robot (x, y coordinates). */
+    MAPPING_MODE mode;  /**< How readings are written into the map. */
+    Map evidence;  /**< Biased log-odds of each cell (128 = no evidence), used in log-odds mode. */
+    MapCell hitTable[256];  /**< Evidence after a hit, indexed by the evidence before it. */
+    MapCell missTable[256];  /**< Evidence after a miss, indexed by the evidence before it. */
+    MapCell occupiedTable[256];  /**< Map cell value (0 or 1) for each evidence value. */
+    int occupiedThreshold;  /**< Log-odds above which a cell is occupied (below the negative value it is free). */
+    std::unique_ptr<ThreadPool> pool;  /**< Threads of the parallel update path, or null for serial updates. */
+    std::vector<std::vector<unsigned int> > beamUpdates;  /**< Parallel updates per (thread, band): cell offset << 1 | hit. */
+    std::vector<std::vector<unsigned int> > bandChanges;  /**< Changed cells per band: offset << 2 | changed flags. */
+
+    /**
+     * @brief Walks one beam from the robot cell, calling visit(x, y, hit) for each cell inside the map.
+     *
+     * The beam is clipped to the map first, so the cost is bounded by the map size.
+     */
+    template <typename Visitor>
+    void walkBeam(int endX, int endY, Visitor visit) const;
+
+    /**
+     * @brief Traces one beam in log-odds mode.
+     *
+     * @param endX The x-coordinate of the endpoint cell.
+     * @param endY The y-coordinate of the endpoint cell.
+     */
+    void traceBeam(int endX, int endY);
+
+    /**
+     * @brief Integrates a batch of points on the thread pool.
+     */
+    void updateMapParallel(const PointBatch& points);
+
+    /**
+     * @brief Writes a map cell (unchecked), recording it as changed only if its value changes.
+     */
+    void setCell(int x, int y, MapCell value) {
+        MapCell& cell = map.cellAt(x, y);
+        if (cell != value) {
+            cell = value;
+            map.markDirty(x, y);
+        }
+    }
 
 public:
     /**
@@ -42,17 +123,106 @@ public:
      */
     Mapper(int gridSizeX, int gridSizeY, int startX = 0, int startY = 0);
 
+    /**
+     * @brief Destructor. Defined where ThreadPool is a complete type, for the pool's unique_ptr.
+     */
+    ~Mapper();
+
+    /**
+     * @brief Sets the number of threads used by updateMap(const PointBatch&).
+     *
+     * @param threads Number of threads, including the caller (1 for serial updates).
+     */
+    void setThreadCount(int threads);
+
+    /**
+     * @brief Returns the number of threads used by updateMap(const PointBatch&).
+     */
+    int getThreadCount() const;
+
+    /**
+     * @brief Sets the robot cell used as the origin of the lidar readings.
+     *
+     * @param x The x-coordinate of the robot (grid units).
+     * @param y The y-coordinate of the robot (grid units).
+     */
+    void setRobotPosition(int x, int y);
+
+    /**
+     * @brief Selects how readings are written into the map.
+     *
+     * Switching modes clears the map and the log-odds evidence.
+     *
+     * @param newMode The mapping mode.
+     */
+    void setMappingMode(MAPPING_MODE newMode);
+
+    /**
+     * @brief Returns the current mapping mode.
+     */
+    MAPPING_MODE getMappingMode() const;
+
+    /**
+     * @brief Sets the log-odds update parameters.
+     *
+     * Log-odds are integers in units of 0.1 nat; the defaults are hit +17
+     * (p = 0.85), miss -4 (p = 0.4), clamped to [-100, 100] with an occupied
+     * threshold of 10.
+     *
+     * @param hit Increment applied to an endpoint cell.
+     * @param miss Decrement applied to a cell crossed by a beam.
+     * @param limit Evidence is clamped to [-limit, limit].
+     * @param threshold Evidence above which a cell is occupied.
+     * @throw std::invalid_argument If a value is out of range (limit 1-127, hit and miss 1-limit, threshold 0-limit).
+     */
+    void setLogOddsParameters(int hit, int miss, int limit, int threshold);
+
+    /**
+     * @brief Returns the log-odds evidence of a cell (0 outside the map or in binary mode).
+     *
+     * @param x The x-coordinate of the cell.
+     * @param y The y-coordinate of the cell.
+     */
+    int getLogOdds(int x, int y) const;
+
+    /**
+     * @brief Returns the occupancy state of a cell in log-odds mode.
+     *
+     * @param x The x-coordinate of the cell.
+     * @param y The y-coordinate of the cell.
+     * @return CELL_FREE, CELL_OCCUPIED or CELL_UNKNOWN (also outside the map).
+     */
+    CELL_STATE getOccupancy(int x, int y) const;
+
     /**
      * @brief Updates the map using lidar data.
      *
      * This method takes lidar data (a vector of distance and angle pairs) and updates
      * the map by marking the corresponding points based on the robot's current position.
      *
+     * In log-odds mode each reading is traced as a beam from the robot cell.
+     *
      * @param lidarData A vector of lidar data, where each pair consists of distance
      *                  and angle (in degrees).
      */
     void updateMap(const std::vector<std::pair<int, int>>& lidarData);
 
+    /**
+     * @brief Updates the map using a batch of projected lidar points.
+     *
+     * The points are expected in the map frame (grid units), for example the
+     * output of LidarSensor::projectScan(). Points outside the map and
+     * non-finite points are ignored. In log-odds mode each point is traced as a
+     * beam from the robot cell; beams ending outside the map still clear the
+     * cells they cross inside it.
+     *
+     * With more than one thread (see setThreadCount()), batches of at least 64
+     * points are integrated in parallel, with the same result.
+     *
+     * @param points Batch of points in the map frame.
+     */
+    void updateMap(const PointBatch& points);
+
     /**
      * @brief Records the current map to a file.
      *
@@ -62,6 +232,31 @@ public:
      */
     void recordMap(const std::string& filename) const;
 
+    /**
+     * @brief Saves the map in the binary map file format (see MapFile.h).
+     *
+     * In log-odds mode the evidence grid is saved, so mapping can resume from
+     * the file; in binary mode the map cells are saved.
+     *
+     * @param filename The name of the file where the map will be saved.
+     * @param resolution Size of a cell in metres, stored in the file header.
+     * @return `true` if the file was written.
+     */
+    bool saveMap(const std::string& filename, double resolution = 1.0) const;
+
+    /**
+     * @brief Loads a map saved by saveMap().
+     *
+     * The map is resized to the file dimensions and the mapping mode follows the
+     * file: a log-odds file restores the evidence grid and switches to log-odds
+     * mode, an occupancy file switches to binary mode.
+     *
+     * @param filename The name of the file to load.
+     * @return `false` if the file cannot be opened, is not a map file or fails
+     *         its checksum; the map is then left empty.
+     */
+    bool loadMap(const std::string& filename);
+
     /**
      * @brief Displays the map visually on the console.
      *
@@ -0,0 +1,458 @@
+#include "OccupancyBitmap.h"
+#include "AlignedMemory.h"
+#include "SimdConfig.h"
+#include <algorithm>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+/**
+ * @file   OccupancyBitmap.cpp
+ * @author Emirhan Kalkan
+ * @date   December, 2024
+ * @brief  Implementation of the OccupancyBitmap class.
+ */
+
+namespace {
+    const int WORD_BITS = 64;             /**< Cells per word. */
+    const int ROW_ALIGNMENT_WORDS = 4;    /**< Rows are padded to a multiple of this many words (32 bytes). */
+
+    /**
+     * @brief Returns the number of set bits of a word.
+     */
+    int popcount64(uint64_t word) {
+        word = word - ((word >> 1) & 0x5555555555555555ull);
+        word = (word & 0x3333333333333333ull) + ((word >> 2) & 0x3333333333333333ull);
+        word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+        return static_cast<int>((word * 0x0101010101010101ull) >> 56);
+    }
+
+    /**
+     * @brief Packs 64 cells into a word: bit i is set if cell i is non-zero.
+     *
+     * The 64 bytes must be readable; Map rows are padded to whole cache lines.
+     */
+    uint64_t packWord(const MapCell* cells) {
+#if defined(ROBOT_SIMD_AVX2)
+        const __m256i zero = _mm256_setzero_si256();
+        const uint32_t low = static_cast<uint32_t>(_mm256_movemask_epi8(
+            _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(cells)), zero)));
+        const uint32_t high = static_cast<uint32_t>(_mm256_movemask_epi8(
+            _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(cells + 32)), zero)));
+        return ~((static_cast<uint64_t>(high) << 32) | low);
+#elif defined(ROBOT_SIMD_SSE2)
+        const __m128i zero = _mm_setzero_si128();
+        uint64_t empty = 0;
+        for (int i = 0; i < 4; ++i) {
+            const uint64_t mask = static_cast<uint32_t>(_mm_movemask_epi8(
+                _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(cells + 16 * i)), zero)));
+            empty |= mask << (16 * i);
+        }
+        return ~empty;
+#else
+        uint64_t word = 0;
+        for (int i = 0; i < WORD_BITS; ++i) {
+            word |= static_cast<uint64_t>(cells[i] != 0) << i;
+        }
+        return word;
+#endif
+    }
+
+    /**
+     * @brief Combines a row into another with OR (dilation) or AND (erosion).
+     *
+     * Rows are 32-byte aligned and a multiple of four words long.
+     */
+    void combineRow(uint64_t* dst, const uint64_t* src, int count, bool dilation) {
+        int i = 0;
+#if defined(ROBOT_SIMD_AVX2)
+        for (; i + 4 <= count; i += 4) {
+            __m256i a = _mm256_load_si256(reinterpret_cast<const __m256i*>(dst + i));
+            __m256i b = _mm256_load_si256(reinterpret_cast<const __m256i*>(src + i));
+            _mm256_store_si256(reinterpret_cast<__m256i*>(dst + i), dilation ? _mm256_or_si256(a, b) : _mm256_and_si256(a, b));
+        }
+#elif defined(ROBOT_SIMD_SSE2)
+        for (; i + 2 <= count; i += 2) {
+            __m128i a = _mm_load_si128(reinterpret_cast<const __m128i*>(dst + i));
+            __m128i b = _mm_load_si128(reinterpret_cast<const __m128i*>(src + i));
+            _mm_store_si128(reinterpret_cast<__m128i*>(dst + i), dilation ? _mm_or_si128(a, b) : _mm_and_si128(a, b));
+        }
+#endif
+        for (; i < count; ++i) {
+            dst[i] = dilation ? dst[i] | src[i] : dst[i] & src[i];
+        }
+    }
+
+    /**
+     * @brief Shifts a row by a number of cells, filling with zeros.
+     *
+     * @param shift Positive values move cells towards higher x, negative towards lower x.
+     */
+    void shiftRow(uint64_t* dst, const uint64_t* src, int count, int shift) {
+        const int distance = shift < 0 ? -shift : shift;
+        const int wordShift = distance / WORD_BITS;
+        const int bitShift = distance % WORD_BITS;
+        for (int w = 0; w < count; ++w) {
+            uint64_t word = 0;
+            if (shift > 0) {
+                const int from = w - wordShift;
+                if (from >= 0) {
+                    word = src[from] << bitShift;
+                    if (bitShift != 0 && from > 0) {
+                        word |= src[from - 1] >> (WORD_BITS - bitShift);
+                    }
+                }
+            }
+            else {
+                const int from = w + wordShift;
+                if (from < count) {
+                    word = src[from] >> bitShift;
+                    if (bitShift != 0 && from + 1 < count) {
+                        word |= src[from + 1] << (WORD_BITS - bitShift);
+                    }
+                }
+            }
+            dst[w] = word;
+        }
+    }
+}
+
+/**
+ * @brief Constructs an empty (all free) bitmap.
+ */
+OccupancyBitmap::OccupancyBitmap(int _sizeX, int _sizeY) : words(nullptr), sizeX(0), sizeY(0), stride(0) {
+    sizeX = _sizeX > 0 ? _sizeX : 0;
+    sizeY = _sizeY > 0 ? _sizeY : 0;
+    const int used = (sizeX + WORD_BITS - 1) / WORD_BITS;
+    stride = (used + ROW_ALIGNMENT_WORDS - 1) / ROW_ALIGNMENT_WORDS * ROW_ALIGNMENT_WORDS;
+    words = alignedAllocate<uint64_t>(static_cast<size_t>(stride) * sizeY);
+    std::memset(words, 0, static_cast<size_t>(stride) * sizeY * sizeof(uint64_t));
+}
+
+/**
+ * @brief Constructs the bitmap of a map.
+ */
+OccupancyBitmap::OccupancyBitmap(const Map& map) : OccupancyBitmap(map.getNumberX(), map.getNumberY()) {
+    syncFrom(map);
+}
+
+/**
+ * @brief Copy constructor.
+ */
+OccupancyBitmap::OccupancyBitmap(const OccupancyBitmap& other)
+    : words(nullptr), sizeX(other.sizeX), sizeY(other.sizeY), stride(other.stride) {
+    words = alignedAllocate<uint64_t>(static_cast<size_t>(stride) * sizeY);
+    std::memcpy(words, other.words, static_cast<size_t>(stride) * sizeY * sizeof(uint64_t));
+}
+
+/**
+ * @brief Move constructor. Leaves the other bitmap empty.
+ */
+OccupancyBitmap::OccupancyBitmap(OccupancyBitmap&& other)
+    : words(other.words), sizeX(other.sizeX), sizeY(other.sizeY), stride(other.stride) {
+    other.words = nullptr;
+    other.sizeX = 0;
+    other.sizeY = 0;
+    other.stride = 0;
+}
+
+/**
+ * @brief Copy assignment.
+ */
+OccupancyBitmap& OccupancyBitmap::operator=(const OccupancyBitmap& other) {
+    if (this != &other) {
+        OccupancyBitmap copy(other);
+        std::swap(words, copy.words);
+        std::swap(sizeX, copy.sizeX);
+        std::swap(sizeY, copy.sizeY);
+        std::swap(stride, copy.stride);
+    }
+    return *this;
+}
+
+/**
+ * @brief Frees the bit rows.
+ */
+OccupancyBitmap::~OccupancyBitmap() {
+    alignedFree(words);
+}
+
+/**
+ * @brief Makes a disk-shaped footprint of a radius, centred on cell (radius, radius).
+ */
+OccupancyBitmap OccupancyBitmap::disk(int radius) {
+    radius = radius > 0 ? radius : 0;
+    OccupancyBitmap footprint(2 * radius + 1, 2 * radius + 1);
+    for (int dy = -radius; dy <= radius; ++dy) {
+        for (int dx = -radius; dx <= radius; ++dx) {
+            if (dx * dx + dy * dy <= radius * radius) {
+                footprint.set(radius + dx, radius + dy, true);
+            }
+        }
+    }
+    return footprint;
+}
+
+/**
+ * @brief Returns the mask of the valid bits of the last word of a row.
+ */
+uint64_t OccupancyBitmap::lastWordMask() const {
+    const int bits = sizeX % WORD_BITS;
+    return bits == 0 ? ~0ull : (1ull << bits) - 1;
+}
+
+/**
+ * @brief Packs the words [w0, w1) of rows [y0, y1) from a map of the same size.
+ */
+void OccupancyBitmap::packRows(const Map& map, int y0, int y1, int w0, int w1) {
+    const int lastWord = (sizeX - 1) / WORD_BITS;
+    for (int y = y0; y < y1; ++y) {
+        const MapCell* cells = map.getRow(y);
+        uint64_t* row = words + static_cast<size_t>(y) * stride;
+        for (int w = w0; w < w1; ++w) {
+            row[w] = packWord(cells + w * WORD_BITS);
+        }
+        if (w0 <= lastWord && lastWord < w1) {
+            row[lastWord] &= lastWordMask();
+        }
+    }
+}
+
+/**
+ * @brief Brings the bitmap up to date with a map.
+ *
+ * A change-tracking tile is half a word wide, so each changed tile repacks
+ * the word holding it for the rows of the tile.
+ */
+unsigned long long OccupancyBitmap::syncFrom(const Map& map, unsigned long long sinceVersion) {
+    if (map.getNumberX() != sizeX || map.getNumberY() != sizeY) {
+        OccupancyBitmap resized(map.getNumberX(), map.getNumberY());
+        std::swap(words, resized.words);
+        std::swap(sizeX, resized.sizeX);
+        std::swap(sizeY, resized.sizeY);
+        std::swap(stride, resized.stride);
+        sinceVersion = 0;
+    }
+    if (sizeX == 0 || sizeY == 0) {
+        return map.getVersion();
+    }
+    const int usedWords = (sizeX + WORD_BITS - 1) / WORD_BITS;
+    if (sinceVersion == 0) {
+        packRows(map, 0, sizeY, 0, usedWords);
+        return map.getVersion();
+    }
+
+    const int tilesX = (sizeX + Map::DIRTY_TILE_SIZE - 1) >> Map::DIRTY_TILE_SHIFT;
+    const int tilesY = (sizeY + Map::DIRTY_TILE_SIZE - 1) >> Map::DIRTY_TILE_SHIFT;
+    const int tilesPerWord = WORD_BITS / Map::DIRTY_TILE_SIZE;
+    for (int ty = 0; ty < tilesY; ++ty) {
+        const int y0 = ty << Map::DIRTY_TILE_SHIFT;
+        const int y1 = std::min(sizeY, y0 + Map::DIRTY_TILE_SIZE);
+        int lastPacked = -1;
+        for (int tx = 0; tx < tilesX; ++tx) {
+            const int w = tx / tilesPerWord;
+            if (w != lastPacked && map.getTileVersion(tx, ty) > sinceVersion) {
+                packRows(map, y0, y1, w, w + 1);
+                lastPacked = w;
+            }
+        }
+    }
+    return map.getVersion();
+}
+
+/**
+ * @brief Writes the bitmap into a map.
+ *
+ * Each word is compared with the packed map row, so only the cells whose
+ * occupancy differs are visited. Occupied cells that stay occupied keep
+ * their value.
+ */
+void OccupancyBitmap::copyTo(Map& map, MapCell occupiedValue) const {
+    if (map.getNumberX() != sizeX || map.getNumberY() != sizeY) {
+        map.setGridSize(sizeX, sizeY);
+    }
+    const int usedWords = (sizeX + WORD_BITS - 1) / WORD_BITS;
+    for (int y = 0; y < sizeY; ++y) {
+        MapCell* cells = map.getRow(y);
+        const uint64_t* row = getRow(y);
+        for (int w = 0; w < usedWords; ++w) {
+            uint64_t current = packWord(cells + w * WORD_BITS);
+            if (w == usedWords - 1) {
+                current &= lastWordMask();
+            }
+            uint64_t changed = current ^ row[w];
+            while (changed != 0) {
+                const uint64_t bit = changed & (~changed + 1);
+                const int x = w * WORD_BITS + popcount64(bit - 1);
+                cells[x] = (row[w] & bit) != 0 ? occupiedValue : 0;
+                map.markDirty(x, y);
+                changed ^= bit;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Returns whether a cell is occupied (`false` outside the grid).
+ */
+bool OccupancyBitmap::get(int x, int y) const {
+    if (x < 0 || x >= sizeX || y < 0 || y >= sizeY) {
+        return false;
+    }
+    return (getRow(y)[x / WORD_BITS] >> (x % WORD_BITS)) & 1u;
+}
+
+/**
+ * @brief Sets or clears a cell; cells outside the grid are ignored.
+ */
+void OccupancyBitmap::set(int x, int y, bool occupied) {
+    if (x < 0 || x >= sizeX || y < 0 || y >= sizeY) {
+        return;
+    }
+    uint64_t& word = words[static_cast<size_t>(y) * stride + x / WORD_BITS];
+    const uint64_t bit = 1ull << (x % WORD_BITS);
+    word = occupied ? word | bit : word & ~bit;
+}
+
+/**
+ * @brief Returns the number of occupied cells.
+ */
+long long OccupancyBitmap::count() const {
+    long long total = 0;
+    const size_t size = static_cast<size_t>(stride) * sizeY;
+    for (size_t i = 0; i < size; ++i) {
+        total += popcount64(words[i]);
+    }
+    return total;
+}
+
+/**
+ * @brief Returns the size of the bit rows in bytes.
+ */
+size_t OccupancyBitmap::getMemoryUsage() const {
+    return static_cast<size_t>(stride) * sizeY * sizeof(uint64_t);
+}
+
+/**
+ * @brief Dilates (or erodes) every row by a radius along x.
+ *
+ * Each pass combines the row with copies shifted by s cells both ways, which
+ * grows the covered interval from [-reach, reach] to [-reach - s, reach + s];
+ * s is at most reach + 1 so the interval has no gaps.
+ */
+void OccupancyBitmap::morphRows(int radius, bool dilation) {
+    if (radius <= 0 || sizeX == 0) {
+        return;
+    }
+    const int usedWords = (sizeX + WORD_BITS - 1) / WORD_BITS;
+    std::vector<uint64_t> up(usedWords);
+    std::vector<uint64_t> down(usedWords);
+    for (int y = 0; y < sizeY; ++y) {
+        uint64_t* row = words + static_cast<size_t>(y) * stride;
+        for (int reach = 0; reach < radius;) {
+            const int step = std::min(reach + 1, radius - reach);
+            shiftRow(up.data(), row, usedWords, step);
+            shiftRow(down.data(), row, usedWords, -step);
+            for (int w = 0; w < usedWords; ++w) {
+                row[w] = dilation ? row[w] | up[w] | down[w] : row[w] & up[w] & down[w];
+            }
+            row[usedWords - 1] &= lastWordMask();
+            reach += step;
+        }
+    }
+}
+
+/**
+ * @brief Dilates (or erodes) every column by a radius along y.
+ *
+ * Same doubling as morphRows(), combining whole rows with SIMD; rows outside
+ * the grid are empty.
+ */
+void OccupancyBitmap::morphColumns(int radius, bool dilation) {
+    if (radius <= 0 || sizeY == 0 || stride == 0) {
+        return;
+    }
+    const size_t size = static_cast<size_t>(stride) * sizeY;
+    uint64_t* source = alignedAllocate<uint64_t>(size);
+    for (int reach = 0; reach < radius;) {
+        const int step = std::min(reach + 1, radius - reach);
+        std::memcpy(source, words, size * sizeof(uint64_t));
+        for (int y = 0; y < sizeY; ++y) {
+            uint64_t* row = words + static_cast<size_t>(y) * stride;
+            const int neighbours[2] = { y - step, y + step };
+            for (int n = 0; n < 2; ++n) {
+                if (neighbours[n] >= 0 && neighbours[n] < sizeY) {
+                    combineRow(row, source + static_cast<size_t>(neighbours[n]) * stride, stride, dilation);
+                }
+                else if (!dilation) {
+                    std::memset(row, 0, static_cast<size_t>(stride) * sizeof(uint64_t));
+                }
+            }
+        }
+        reach += step;
+    }
+    alignedFree(source);
+}
+
+/**
+ * @brief Grows every obstacle by a rectangle of radiusX x radiusY cells.
+ */
+void OccupancyBitmap::dilate(int radiusX, int radiusY) {
+    morphRows(radiusX, true);
+    morphColumns(radiusY, true);
+}
+
+/**
+ * @brief Shrinks every obstacle by a rectangle of radiusX x radiusY cells.
+ */
+void OccupancyBitmap::erode(int radiusX, int radiusY) {
+    morphRows(radiusX, false);
+    morphColumns(radiusY, false);
+}
+
+/**
+ * @brief Erodes then dilates: removes obstacles smaller than the element.
+ */
+void OccupancyBitmap::open(int radius) {
+    erode(radius);
+    dilate(radius);
+}
+
+/**
+ * @brief Dilates then erodes: fills gaps and holes smaller than the element.
+ */
+void OccupancyBitmap::close(int radius) {
+    dilate(radius);
+    erode(radius);
+}
+
+/**
+ * @brief Checks whether a footprint placed at a cell overlaps an occupied cell.
+ *
+ * Each footprint word is shifted to the column of the placement and ANDed
+ * with the one or two grid words it covers.
+ */
+bool OccupancyBitmap::collides(const OccupancyBitmap& footprint, int x, int y) const {
+    if (x < 0 || y < 0 || x > sizeX - footprint.sizeX || y > sizeY - footprint.sizeY) {
+        return true;
+    }
+    const int footprintWords = (footprint.sizeX + WORD_BITS - 1) / WORD_BITS;
+    const int wordOffset = x / WORD_BITS;
+    const int bitOffset = x % WORD_BITS;
+    for (int fy = 0; fy < footprint.sizeY; ++fy) {
+        const uint64_t* shape = footprint.getRow(fy);
+        const uint64_t* row = getRow(y + fy) + wordOffset;
+        for (int w = 0; w < footprintWords; ++w) {
+            if (row[w] & (shape[w] << bitOffset)) {
+                return true;
+            }
+            if (bitOffset != 0) {
+                const uint64_t spill = shape[w] >> (WORD_BITS - bitOffset);
+                if (spill != 0 && (row[w + 1] & spill)) {
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
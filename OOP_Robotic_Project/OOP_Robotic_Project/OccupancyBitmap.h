@@ -0,0 +1,199 @@
+#ifndef OCCUPANCYBITMAP_H
+#define OCCUPANCYBITMAP_H
+
+#include "Map.h"
+#include <cstdint>
+
+/**
+ * @file   OccupancyBitmap.h
+ * @author Emirhan Kalkan
+ * @date   December, 2024
+ * @brief  Header file for the OccupancyBitmap class.
+ *
+ * This file defines the OccupancyBitmap class, a bit-packed binary view of a
+ * Map with word-parallel morphology and footprint collision tests.
+ */
+
+ /**
+  * @class OccupancyBitmap
+  * @brief Binary occupancy grid with one bit per cell and word-parallel operations.
+  *
+  * Bit (x & 63) of word (x >> 6) of a row is cell x; a set bit is an occupied
+  * cell. Rows are padded to a multiple of four 64-bit words (32 bytes) and are
+  * 32-byte aligned, and the bits past the last column are always zero.
+  *
+  * Morphology uses a rectangular structuring element of (2 * radiusX + 1) x
+  * (2 * radiusY + 1) cells. A radius r takes about log2(r) passes along each
+  * axis: each pass ORs (dilation) or ANDs (erosion) every row with copies of
+  * itself shifted across word boundaries, then every row with the rows at a
+  * distance, 64 cells per operation (256 with AVX2). Cells outside the grid
+  * count as free, so erosion also shrinks obstacles touching the border.
+  *
+  * syncFrom() packs a Map with SIMD compares, and with a version only repacks
+  * the tiles changed since then, so the bitmap can follow a map cheaply.
+  */
+class OccupancyBitmap {
+private:
+    uint64_t* words;       /**< Row-major bit rows (32-byte aligned). */
+    int sizeX, sizeY;      /**< Number of columns and rows. */
+    int stride;            /**< Words per row (a multiple of 4). */
+
+    /**
+     * @brief Returns the mask of the valid bits of the last word of a row.
+     */
+    uint64_t lastWordMask() const;
+
+    /**
+     * @brief Packs the words [w0, w1) of rows [y0, y1) from a map of the same size.
+     */
+    void packRows(const Map& map, int y0, int y1, int w0, int w1);
+
+    /**
+     * @brief Dilates (or erodes) every row by a radius along x.
+     */
+    void morphRows(int radius, bool dilation);
+
+    /**
+     * @brief Dilates (or erodes) every column by a radius along y.
+     */
+    void morphColumns(int radius, bool dilation);
+
+public:
+    /**
+     * @brief Constructs an empty (all free) bitmap.
+     *
+     * @param sizeX Number of columns (negative values are treated as 0).
+     * @param sizeY Number of rows (negative values are treated as 0).
+     */
+    OccupancyBitmap(int sizeX = 0, int sizeY = 0);
+
+    /**
+     * @brief Constructs the bitmap of a map: non-zero cells are occupied.
+     */
+    explicit OccupancyBitmap(const Map& map);
+
+    /**
+     * @brief Copy constructor.
+     */
+    OccupancyBitmap(const OccupancyBitmap& other);
+
+    /**
+     * @brief Move constructor. Leaves the other bitmap empty.
+     */
+    OccupancyBitmap(OccupancyBitmap&& other);
+
+    /**
+     * @brief Copy assignment.
+     */
+    OccupancyBitmap& operator=(const OccupancyBitmap& other);
+
+    /**
+     * @brief Frees the bit rows.
+     */
+    ~OccupancyBitmap();
+
+    /**
+     * @brief Makes a disk-shaped footprint of a radius, centred on cell (radius, radius).
+     */
+    static OccupancyBitmap disk(int radius);
+
+    /**
+     * @brief Brings the bitmap up to date with a map.
+     *
+     * @param map The map (non-zero cells are occupied).
+     * @param sinceVersion The map version the bitmap already reflects, or 0
+     *        to repack everything. Only tiles changed after it are repacked.
+     * @return The map version the bitmap now reflects.
+     */
+    unsigned long long syncFrom(const Map& map, unsigned long long sinceVersion = 0);
+
+    /**
+     * @brief Writes the bitmap into a map: occupied cells get a value, free cells 0.
+     *
+     * The map is resized if needed; only cells whose value changes are written
+     * and recorded as changed.
+     */
+    void copyTo(Map& map, MapCell occupiedValue = 1) const;
+
+    /**
+     * @brief Returns the number of columns.
+     */
+    int getNumberX() const { return sizeX; }
+
+    /**
+     * @brief Returns the number of rows.
+     */
+    int getNumberY() const { return sizeY; }
+
+    /**
+     * @brief Returns the number of words per row.
+     */
+    int getStride() const { return stride; }
+
+    /**
+     * @brief Returns the words of a row without bounds checking.
+     */
+    const uint64_t* getRow(int y) const { return words + static_cast<size_t>(y) * stride; }
+
+    /**
+     * @brief Returns whether a cell is occupied (`false` outside the grid).
+     */
+    bool get(int x, int y) const;
+
+    /**
+     * @brief Sets or clears a cell; cells outside the grid are ignored.
+     */
+    void set(int x, int y, bool occupied);
+
+    /**
+     * @brief Returns the number of occupied cells.
+     */
+    long long count() const;
+
+    /**
+     * @brief Returns the size of the bit rows in bytes.
+     */
+    size_t getMemoryUsage() const;
+
+    /**
+     * @brief Grows every obstacle by a rectangle of radiusX x radiusY cells.
+     */
+    void dilate(int radiusX, int radiusY);
+
+    /**
+     * @brief Grows every obstacle by a square of the given radius.
+     */
+    void dilate(int radius) { dilate(radius, radius); }
+
+    /**
+     * @brief Shrinks every obstacle by a rectangle of radiusX x radiusY cells.
+     */
+    void erode(int radiusX, int radiusY);
+
+    /**
+     * @brief Shrinks every obstacle by a square of the given radius.
+     */
+    void erode(int radius) { erode(radius, radius); }
+
+    /**
+     * @brief Erodes then dilates: removes obstacles smaller than the element.
+     */
+    void open(int radius);
+
+    /**
+     * @brief Dilates then erodes: fills gaps and holes smaller than the element.
+     */
+    void close(int radius);
+
+    /**
+     * @brief Checks whether a footprint placed at a cell overlaps an occupied cell.
+     *
+     * @param footprint The footprint; its cell (0, 0) is placed on (x, y).
+     * @param x The column of the footprint's first column.
+     * @param y The row of the footprint's first row.
+     * @return `true` on overlap, or if the footprint does not lie entirely inside the grid.
+     */
+    bool collides(const OccupancyBitmap& footprint, int x, int y) const;
+};
+
+#endif // OCCUPANCYBITMAP_H
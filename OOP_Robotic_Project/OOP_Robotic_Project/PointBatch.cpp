@@ -0,0 +1,114 @@
+/**
+ * @file   PointBatch.cpp
+ * @author Furkan Gemici
+ * @date   December, 2024
+ * @brief  Implementation file for the PointBatch class.
+ */
+
+#include "PointBatch.h"
+#include "AlignedMemory.h"
+#include <cstring>
+#include <stdexcept>
+
+/**
+ * @brief Default constructor. Creates an empty batch.
+ */
+PointBatch::PointBatch() : xs(nullptr), ys(nullptr), count(0), capacity(0) {
+}
+
+/**
+ * @brief Creates an empty batch with room for the given number of points.
+ *
+ * @param initialCapacity Number of points to allocate room for.
+ */
+PointBatch::PointBatch(int initialCapacity) : xs(nullptr), ys(nullptr), count(0), capacity(0) {
+    reserve(initialCapacity);
+}
+
+/**
+ * @brief Destructor. Frees the coordinate arrays.
+ */
+PointBatch::~PointBatch() {
+    alignedFree(xs);
+    alignedFree(ys);
+}
+
+/**
+ * @brief Ensures room for at least the given number of points.
+ *
+ * @param newCapacity Required number of points.
+ */
+void PointBatch::reserve(int newCapacity) {
+    if (newCapacity <= capacity) {
+        return;
+    }
+    float* newXs = alignedAllocate<float>(newCapacity);
+    float* newYs = alignedAllocate<float>(newCapacity);
+    if (count > 0) {
+        std::memcpy(newXs, xs, count * sizeof(float));
+        std::memcpy(newYs, ys, count * sizeof(float));
+    }
+    alignedFree(xs);
+    alignedFree(ys);
+    xs = newXs;
+    ys = newYs;
+    capacity = newCapacity;
+}
+
+/**
+ * @brief Sets the number of valid points, growing the storage if needed.
+ *
+ * @param newCount New number of points.
+ */
+void PointBatch::resize(int newCount) {
+    if (newCount < 0) {
+        newCount = 0;
+    }
+    reserve(newCount);
+    count = newCount;
+}
+
+/**
+ * @brief Removes all points without releasing storage.
+ */
+void PointBatch::clear() {
+    count = 0;
+}
+
+int PointBatch::size() const {
+    return count;
+}
+
+int PointBatch::getCapacity() const {
+    return capacity;
+}
+
+float* PointBatch::getX() {
+    return xs;
+}
+
+const float* PointBatch::getX() const {
+    return xs;
+}
+
+float* PointBatch::getY() {
+    return ys;
+}
+
+const float* PointBatch::getY() const {
+    return ys;
+}
+
+/**
+ * @brief Returns a single point.
+ *
+ * @param index Index of the point.
+ * @return The point at the given index.
+ * @throw std::out_of_range If the index is out of bounds.
+ */
+Point PointBatch::getPoint(int index) const {
+    if (index >= 0 && index < count) {
+        return Point(xs[index], ys[index]);
+    }
+    throw std::out_of_range("Index out of bounds in getPoint.");
+}
@@ -0,0 +1,93 @@
+/**
+ * @file   PointBatch.h
+ * @author Furkan Gemici
+ * @date   December, 2024
+ * @brief  Header file for the PointBatch class.
+ *
+ * This file contains the definition of the PointBatch class, a structure-of-arrays
+ * container for 2D points produced from Lidar scans.
+ */
+
+#pragma once
+
+#include "Point.h"
+
+ /**
+  * @class PointBatch
+  * @brief Stores a batch of 2D points as separate, aligned x and y arrays.
+  *
+  * Keeping the coordinates in two contiguous arrays lets the projection and
+  * mapping kernels process several points per SIMD instruction. Storage only
+  * grows, so a batch reused across scans does not allocate after the first one.
+  */
+class PointBatch {
+private:
+    float* xs;     /*!< X-coordinates of the points. */
+    float* ys;     /*!< Y-coordinates of the points. */
+    int count;     /*!< Number of valid points in the batch. */
+    int capacity;  /*!< Number of points the arrays can hold. */
+
+public:
+    //! Default constructor
+    /*!
+     * Creates an empty batch without allocating storage.
+     */
+    PointBatch();
+
+    //! Constructor with initial capacity
+    /*!
+     * @param initialCapacity Number of points to allocate room for.
+     */
+    explicit PointBatch(int initialCapacity);
+
+    //! Destructor
+    /*!
+     * Frees the coordinate arrays.
+     */
+    ~PointBatch();
+
+    PointBatch(const PointBatch&) = delete;
+    PointBatch& operator=(const PointBatch&) = delete;
+
+    //! Ensures room for at least the given number of points
+    /*!
+     * Existing points are preserved. Storage is never shrunk.
+     * @param newCapacity Required number of points.
+     */
+    void reserve(int newCapacity);
+
+    //! Sets the number of valid points, growing the storage if needed
+    /*!
+     * @param newCount New number of points.
+     */
+    void resize(int newCount);
+
+    //! Removes all points without releasing storage
+    void clear();
+
+    //! Returns the number of valid points
+    int size() const;
+
+    //! Returns the number of points the batch can hold without reallocating
+    int getCapacity() const;
+
+    //! Returns the x array
+    float* getX();
+
+    //! Returns the x array (read-only)
+    const float* getX() const;
+
+    //! Returns the y array
+    float* getY();
+
+    //! Returns the y array (read-only)
+    const float* getY() const;
+
+    //! Returns a single point
+    /*!
+     * @param index Index of the point.
+     * @return The point at the given index.
+     * @throw std::out_of_range If the index is not in the valid range [0, size()-1].
+     */
+    Point getPoint(int index) const;
+};
@@ -0,0 +1,162 @@
+/**
+ * @file   RangeCodec.cpp
+ * @author Furkan Gemici
+ * @date   December, 2024
+ * @brief  Implementation file for the Lidar range storage conversions.
+ */
+
+#include "RangeCodec.h"
+#include "SimdConfig.h"
+#include <cstring>
+#include <limits>
+
+namespace {
+    const float MILLIMETRES_PER_METRE = 1000.0f;
+    const float METRES_PER_MILLIMETRE = 0.001f;
+
+#if defined(ROBOT_SIMD_SSE2) && !defined(ROBOT_SIMD_AVX2)
+    /**
+     * @brief Quantizes 4 ranges to millimetres in 32-bit lanes (0 for invalid).
+     *
+     * Same arithmetic as RangeCodec<unsigned short>::fromMetres(): the clamped
+     * value is truncated after adding one half, which rounds positive values.
+     */
+    inline __m128i quantize4(__m128 range) {
+        __m128 valid = _mm_cmpgt_ps(range, _mm_setzero_ps());
+        __m128 scaled = _mm_add_ps(_mm_mul_ps(range, _mm_set1_ps(MILLIMETRES_PER_METRE)), _mm_set1_ps(0.5f));
+        scaled = _mm_max_ps(_mm_min_ps(scaled, _mm_set1_ps(65535.0f)), _mm_set1_ps(1.0f));
+        return _mm_and_si128(_mm_cvttps_epi32(scaled), _mm_castps_si128(valid));
+    }
+
+    /**
+     * @brief Converts 4 millimetre values in 32-bit lanes to metres.
+     */
+    inline __m128 dequantize4(__m128i value) {
+        __m128 range = _mm_mul_ps(_mm_cvtepi32_ps(value), _mm_set1_ps(METRES_PER_MILLIMETRE));
+        __m128 invalid = _mm_castsi128_ps(_mm_cmpeq_epi32(value, _mm_setzero_si128()));
+        __m128 beyond = _mm_castsi128_ps(_mm_cmpeq_epi32(value, _mm_set1_epi32(65535)));
+        range = _mm_or_ps(_mm_andnot_ps(invalid, range),
+            _mm_and_ps(invalid, _mm_set1_ps(std::numeric_limits<float>::quiet_NaN())));
+        return _mm_or_ps(_mm_andnot_ps(beyond, range),
+            _mm_and_ps(beyond, _mm_set1_ps(std::numeric_limits<float>::infinity())));
+    }
+#endif
+}
+
+void RangeCodec<float>::encode(const float* in, float* out, int count) {
+    if (in != out && count > 0) {
+        std::memcpy(out, in, count * sizeof(float));
+    }
+}
+
+void RangeCodec<float>::decode(const float* in, float* out, int count) {
+    encode(in, out, count);
+}
+
+void RangeCodec<double>::encode(const float* in, double* out, int count) {
+    for (int i = 0; i < count; ++i) {
+        out[i] = in[i];
+    }
+}
+
+void RangeCodec<double>::decode(const double* in, float* out, int count) {
+    for (int i = 0; i < count; ++i) {
+        out[i] = static_cast<float>(in[i]);
+    }
+}
+
+/**
+ * @brief Converts a range in metres to millimetres.
+ */
+unsigned short RangeCodec<unsigned short>::fromMetres(float range) {
+    if (!(range > 0.0f)) {
+        return INVALID;
+    }
+    float scaled = range * MILLIMETRES_PER_METRE + 0.5f;
+    if (!(scaled < 65535.0f)) {
+        return OUT_OF_RANGE;
+    }
+    return scaled < 1.0f ? 1 : static_cast<unsigned short>(scaled);
+}
+
+/**
+ * @brief Converts millimetres to metres.
+ */
+double RangeCodec<unsigned short>::toMetres(unsigned short value) {
+    if (value == INVALID) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    if (value == OUT_OF_RANGE) {
+        return std::numeric_limits<double>::infinity();
+    }
+    return value * METRES_PER_MILLIMETRE;
+}
+
+/**
+ * @brief Converts ranges from float metres to millimetres.
+ *
+ * Quantized lanes are packed to 16 bits with unsigned saturation (AVX2) or by
+ * biasing them into the signed range (SSE2, which has no unsigned pack).
+ */
+void RangeCodec<unsigned short>::encode(const float* in, unsigned short* out, int count) {
+    int i = 0;
+#if defined(ROBOT_SIMD_AVX2)
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 scale = _mm256_set1_ps(MILLIMETRES_PER_METRE);
+    const __m256 half = _mm256_set1_ps(0.5f);
+    const __m256 top = _mm256_set1_ps(65535.0f);
+    const __m256 one = _mm256_set1_ps(1.0f);
+    for (; i + 8 <= count; i += 8) {
+        __m256 range = _mm256_loadu_ps(in + i);
+        __m256 valid = _mm256_cmp_ps(range, zero, _CMP_GT_OQ);
+        __m256 scaled = _mm256_add_ps(_mm256_mul_ps(range, scale), half);
+        scaled = _mm256_max_ps(_mm256_min_ps(scaled, top), one);
+        __m256i value = _mm256_and_si256(_mm256_cvttps_epi32(scaled), _mm256_castps_si256(valid));
+        __m128i packed = _mm_packus_epi32(_mm256_castsi256_si128(value), _mm256_extracti128_si256(value, 1));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), packed);
+    }
+#elif defined(ROBOT_SIMD_SSE2)
+    const __m128i bias = _mm_set1_epi32(32768);
+    const __m128i flip = _mm_set1_epi16(static_cast<short>(0x8000));
+    for (; i + 8 <= count; i += 8) {
+        __m128i low = _mm_sub_epi32(quantize4(_mm_loadu_ps(in + i)), bias);
+        __m128i high = _mm_sub_epi32(quantize4(_mm_loadu_ps(in + i + 4)), bias);
+        __m128i packed = _mm_xor_si128(_mm_packs_epi32(low, high), flip);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), packed);
+    }
+#endif
+    for (; i < count; ++i) {
+        out[i] = fromMetres(in[i]);
+    }
+}
+
+/**
+ * @brief Converts millimetres to float metres.
+ */
+void RangeCodec<unsigned short>::decode(const unsigned short* in, float* out, int count) {
+    int i = 0;
+#if defined(ROBOT_SIMD_AVX2)
+    const __m256 scale = _mm256_set1_ps(METRES_PER_MILLIMETRE);
+    const __m256 nan = _mm256_set1_ps(std::numeric_limits<float>::quiet_NaN());
+    const __m256 inf = _mm256_set1_ps(std::numeric_limits<float>::infinity());
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i top = _mm256_set1_epi32(65535);
+    for (; i + 8 <= count; i += 8) {
+        __m256i value = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)));
+        __m256 range = _mm256_mul_ps(_mm256_cvtepi32_ps(value), scale);
+        range = _mm256_blendv_ps(range, nan, _mm256_castsi256_ps(_mm256_cmpeq_epi32(value, zero)));
+        range = _mm256_blendv_ps(range, inf, _mm256_castsi256_ps(_mm256_cmpeq_epi32(value, top)));
+        _mm256_storeu_ps(out + i, range);
+    }
+#elif defined(ROBOT_SIMD_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 8 <= count; i += 8) {
+        __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        _mm_storeu_ps(out + i, dequantize4(_mm_unpacklo_epi16(value, zero)));
+        _mm_storeu_ps(out + i + 4, dequantize4(_mm_unpackhi_epi16(value, zero)));
+    }
+#endif
+    for (; i < count; ++i) {
+        out[i] = static_cast<float>(toMetres(in[i]));
+    }
+}
@@ -0,0 +1,79 @@
+/**
+ * @file   RangeCodec.h
+ * @author Furkan Gemici
+ * @date   December, 2024
+ * @brief  Conversions between Lidar ranges in metres and their storage types.
+ *
+ * The robot API delivers ranges as float metres. Scans can be stored as float,
+ * double or unsigned 16-bit millimetres; RangeCodec converts whole scans
+ * between the API format and the storage type, and single values to metres.
+ */
+
+#pragma once
+
+ /**
+  * @brief Conversion traits of a range storage type.
+  *
+  * Specialized for float, double and unsigned short (millimetres).
+  */
+template <typename Storage>
+struct RangeCodec;
+
+ /**
+  * @brief Ranges stored as float metres, as delivered by the API.
+  */
+template <>
+struct RangeCodec<float> {
+    //! Converts a stored value to metres
+    static double toMetres(float value) { return value; }
+
+    //! Converts `count` ranges from float metres (no-op if `in` equals `out`)
+    static void encode(const float* in, float* out, int count);
+
+    //! Converts `count` stored values to float metres (no-op if `in` equals `out`)
+    static void decode(const float* in, float* out, int count);
+};
+
+ /**
+  * @brief Ranges stored as double metres.
+  */
+template <>
+struct RangeCodec<double> {
+    //! Converts a stored value to metres
+    static double toMetres(double value) { return value; }
+
+    //! Converts `count` ranges from float metres
+    static void encode(const float* in, double* out, int count);
+
+    //! Converts `count` stored values to float metres
+    static void decode(const double* in, float* out, int count);
+};
+
+ /**
+  * @brief Ranges stored as unsigned 16-bit millimetres.
+  *
+  * Ranges are rounded to the nearest millimetre. Zero, negative and NaN ranges
+  * are stored as INVALID and read back as NaN; ranges of 65.535 m and above
+  * (including infinity) are stored as OUT_OF_RANGE and read back as +infinity.
+  * A positive range below half a millimetre is stored as 1 mm so that it stays
+  * valid.
+  */
+template <>
+struct RangeCodec<unsigned short> {
+    /*! Stored value of an invalid beam. */
+    static const unsigned short INVALID = 0;
+    /*! Stored value of a beam beyond the representable range. */
+    static const unsigned short OUT_OF_RANGE = 65535;
+
+    //! Converts a range in metres to millimetres
+    static unsigned short fromMetres(float range);
+
+    //! Converts a stored value to metres
+    static double toMetres(unsigned short value);
+
+    //! Converts `count` ranges from float metres, 8 per iteration with SIMD
+    static void encode(const float* in, unsigned short* out, int count);
+
+    //! Converts `count` stored values to float metres, 8 per iteration with SIMD
+    static void decode(const unsigned short* in, float* out, int count);
+};
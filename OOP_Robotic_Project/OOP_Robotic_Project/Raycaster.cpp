@@ -0,0 +1,500 @@
+#include "Raycaster.h"
+#include "AlignedMemory.h"
+#include "SimdConfig.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+
+/**
+ * @file   Raycaster.cpp
+ * @author Emirhan Kalkan
+ * @date   December, 2024
+ * @brief  Implementation of the RayBatch and Raycaster classes.
+ */
+
+const int Raycaster::BLOCK_SHIFT;
+const int Raycaster::BLOCK_SIZE;
+const int Raycaster::RAY_PACKET;
+const int Raycaster::MAX_MAP_SIZE;
+const int Raycaster::PARALLEL_MIN_RAYS;
+
+namespace {
+    const int FRACTION_BITS = 16;                              /**< Fraction bits of the fixed-point format. */
+    const int64_t FIXED_ONE = int64_t(1) << FRACTION_BITS;     /**< One cell in fixed point. */
+    const float FIXED_SCALE = static_cast<float>(FIXED_ONE);   /**< Float to fixed-point scale. */
+    const int64_t NEVER = int64_t(1) << 62;                    /**< Crossing time along an axis the ray does not move on. */
+    const double DEGREES_TO_RADIANS = 3.14159265358979323846 / 180.0;
+
+    /**
+     * @brief Converts RAY_PACKET floats to fixed point, rounding to nearest.
+     */
+    void toFixed(const float* in, int* out) {
+        int i = 0;
+#if defined(ROBOT_SIMD_AVX2)
+        const __m256 scale8 = _mm256_set1_ps(FIXED_SCALE);
+        for (; i + 8 <= Raycaster::RAY_PACKET; i += 8) {
+            _mm256_store_si256(reinterpret_cast<__m256i*>(out + i),
+                _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_load_ps(in + i), scale8)));
+        }
+#endif
+#if defined(ROBOT_SIMD_SSE2)
+        const __m128 scale4 = _mm_set1_ps(FIXED_SCALE);
+        for (; i + 4 <= Raycaster::RAY_PACKET; i += 4) {
+            _mm_store_si128(reinterpret_cast<__m128i*>(out + i),
+                _mm_cvtps_epi32(_mm_mul_ps(_mm_load_ps(in + i), scale4)));
+        }
+#endif
+        for (; i < Raycaster::RAY_PACKET; ++i) {
+            out[i] = static_cast<int>(std::lrint(in[i] * FIXED_SCALE));
+        }
+    }
+
+    /**
+     * @brief Moves an origin outside the map to where the ray enters it.
+     *
+     * @return Distance from the original origin to the entry point, or -1 if
+     *         the ray does not enter the map within the given range.
+     */
+    float clipOrigin(float& x, float& y, float dx, float dy, int sizeX, int sizeY, float range) {
+        if (x >= 0 && x < sizeX && y >= 0 && y < sizeY) {
+            return 0.0f;
+        }
+        float enter = 0.0f;
+        float exit = range;
+        const float origins[2] = { x, y };
+        const float directions[2] = { dx, dy };
+        const int sizes[2] = { sizeX, sizeY };
+        for (int axis = 0; axis < 2; ++axis) {
+            if (directions[axis] == 0.0f) {
+                if (origins[axis] < 0 || origins[axis] >= sizes[axis]) {
+                    return -1.0f;
+                }
+                continue;
+            }
+            float t0 = -origins[axis] / directions[axis];
+            float t1 = (sizes[axis] - origins[axis]) / directions[axis];
+            if (t0 > t1) {
+                std::swap(t0, t1);
+            }
+            enter = std::max(enter, t0);
+            exit = std::min(exit, t1);
+        }
+        if (enter >= exit) {
+            return -1.0f;
+        }
+        x += enter * dx;
+        y += enter * dy;
+        return enter;
+    }
+}
+
+/**
+ * @brief Creates an empty batch with room for the given number of rays.
+ */
+RayBatch::RayBatch(int initialCapacity)
+    : originX(nullptr), originY(nullptr), dirX(nullptr), dirY(nullptr), ranges(nullptr),
+      hitX(nullptr), hitY(nullptr), count(0), capacity(0) {
+    reserve(initialCapacity);
+}
+
+/**
+ * @brief Destructor. Frees the arrays.
+ */
+RayBatch::~RayBatch() {
+    alignedFree(originX);
+    alignedFree(originY);
+    alignedFree(dirX);
+    alignedFree(dirY);
+    alignedFree(ranges);
+    alignedFree(hitX);
+    alignedFree(hitY);
+}
+
+/**
+ * @brief Ensures room for at least the given number of rays.
+ */
+void RayBatch::reserve(int newCapacity) {
+    if (newCapacity <= capacity) {
+        return;
+    }
+    auto grow = [&](auto*& array) {
+        typedef typename std::remove_reference<decltype(*array)>::type Element;
+        Element* grown = alignedAllocate<Element>(newCapacity);
+        if (count > 0) {
+            std::memcpy(grown, array, count * sizeof(Element));
+        }
+        alignedFree(array);
+        array = grown;
+    };
+    grow(originX);
+    grow(originY);
+    grow(dirX);
+    grow(dirY);
+    grow(ranges);
+    grow(hitX);
+    grow(hitY);
+    capacity = newCapacity;
+}
+
+/**
+ * @brief Sets the number of rays, growing the storage if needed.
+ */
+void RayBatch::resize(int newCount) {
+    if (newCount < 0) {
+        newCount = 0;
+    }
+    reserve(newCount);
+    count = newCount;
+}
+
+/**
+ * @brief Removes all rays without releasing storage.
+ */
+void RayBatch::clear() {
+    count = 0;
+}
+
+int RayBatch::size() const {
+    return count;
+}
+
+/**
+ * @brief Sets the origin and direction of a ray.
+ */
+void RayBatch::setRay(int index, double x, double y, double angle) {
+    originX[index] = static_cast<float>(x);
+    originY[index] = static_cast<float>(y);
+    dirX[index] = static_cast<float>(std::cos(angle * DEGREES_TO_RADIANS));
+    dirY[index] = static_cast<float>(std::sin(angle * DEGREES_TO_RADIANS));
+}
+
+/**
+ * @brief Appends a ray and returns its index.
+ */
+int RayBatch::addRay(double x, double y, double angle) {
+    if (count == capacity) {
+        reserve(std::max(16, capacity * 2));
+    }
+    setRay(count, x, y, angle);
+    return count++;
+}
+
+/**
+ * @brief Appends a fan of rays from one origin.
+ */
+void RayBatch::addFan(double x, double y, double startAngle, double increment, int rays) {
+    if (rays <= 0) {
+        return;
+    }
+    int first = count;
+    if (count + rays > capacity) {
+        reserve(std::max(count + rays, capacity * 2));
+    }
+    count += rays;
+    for (int i = 0; i < rays; ++i) {
+        setRay(first + i, x, y, startAngle + i * increment);
+    }
+}
+
+/**
+ * @brief Builds the block flags of a map.
+ */
+Raycaster::Raycaster(const Map& map, double maxRange)
+    : map(map), maxRange(static_cast<float>(maxRange)), sizeX(-1), sizeY(-1), blocksX(0), blocksY(0),
+      syncedVersion(0) {
+    if (!(maxRange > 0)) {
+        throw std::invalid_argument("Maximum range must be positive.");
+    }
+    update();
+}
+
+/**
+ * @brief Destructor. Stops the threads.
+ */
+Raycaster::~Raycaster() {
+}
+
+/**
+ * @brief Recomputes the flags of the blocks overlapping a change-tracking tile.
+ */
+void Raycaster::refreshTile(int tx, int ty) {
+    const int x0 = tx << Map::DIRTY_TILE_SHIFT;
+    const int y0 = ty << Map::DIRTY_TILE_SHIFT;
+    const int x1 = std::min(sizeX, x0 + Map::DIRTY_TILE_SIZE);
+    const int y1 = std::min(sizeY, y0 + Map::DIRTY_TILE_SIZE);
+    for (int by = y0 >> BLOCK_SHIFT; by << BLOCK_SHIFT < y1; ++by) {
+        const int rowEnd = std::min(y1, (by + 1) << BLOCK_SHIFT);
+        for (int bx = x0 >> BLOCK_SHIFT; bx << BLOCK_SHIFT < x1; ++bx) {
+            const int columnStart = bx << BLOCK_SHIFT;
+            const int columnEnd = std::min(x1, columnStart + BLOCK_SIZE);
+            bool occupied = false;
+            for (int y = by << BLOCK_SHIFT; y < rowEnd && !occupied; ++y) {
+                const MapCell* row = map.getRow(y);
+                for (int x = columnStart; x < columnEnd; ++x) {
+                    occupied |= row[x] != 0;
+                }
+            }
+            blocks[static_cast<size_t>(by) * blocksX + bx] = occupied;
+        }
+    }
+}
+
+/**
+ * @brief Brings the block flags up to date with the map.
+ *
+ * Only the tiles whose version is newer than the last update are rescanned.
+ */
+void Raycaster::update() {
+    if (map.getNumberX() > MAX_MAP_SIZE || map.getNumberY() > MAX_MAP_SIZE) {
+        throw std::length_error("Map is too large for the raycaster.");
+    }
+    const bool resized = map.getNumberX() != sizeX || map.getNumberY() != sizeY;
+    if (resized) {
+        sizeX = map.getNumberX();
+        sizeY = map.getNumberY();
+        blocksX = (sizeX + BLOCK_SIZE - 1) >> BLOCK_SHIFT;
+        blocksY = (sizeY + BLOCK_SIZE - 1) >> BLOCK_SHIFT;
+        blocks.assign(static_cast<size_t>(blocksX) * blocksY, 0);
+    }
+
+    const int tilesX = (sizeX + Map::DIRTY_TILE_SIZE - 1) >> Map::DIRTY_TILE_SHIFT;
+    const int tilesY = (sizeY + Map::DIRTY_TILE_SIZE - 1) >> Map::DIRTY_TILE_SHIFT;
+    for (int ty = 0; ty < tilesY; ++ty) {
+        for (int tx = 0; tx < tilesX; ++tx) {
+            if (resized || map.getTileVersion(tx, ty) > syncedVersion) {
+                refreshTile(tx, ty);
+            }
+        }
+    }
+    syncedVersion = map.getVersion();
+}
+
+/**
+ * @brief Sets the number of threads used by castRays().
+ */
+void Raycaster::setThreadCount(int threads) {
+    if (threads <= 1) {
+        pool.reset();
+    }
+    else if (getThreadCount() != threads) {
+        pool.reset(new ThreadPool(threads));
+    }
+}
+
+int Raycaster::getThreadCount() const {
+    return pool ? pool->getThreadCount() : 1;
+}
+
+double Raycaster::getMaxRange() const {
+    return maxRange;
+}
+
+/**
+ * @brief Traverses the grid from a fixed-point origin inside the map.
+ *
+ * The time to the next x boundary is kept as errorX * |dy| and the time to the
+ * next y boundary as errorY * |dx|, where errorX and errorY are the fixed-point
+ * distances to the boundaries. Both are scaled by |dx| * |dy|, so comparing
+ * and advancing them needs only integer additions. Inside an empty block the
+ * number of steps to each block side is known, and the side crossed first and
+ * the steps taken along the other axis follow from the same times.
+ */
+bool Raycaster::traverse(int px, int py, int dx, int dy, float range, int& hitX, int& hitY, int& entryAxis) const {
+    if (dx == 0 && dy == 0) {
+        return false;
+    }
+    int cx = px >> FRACTION_BITS;
+    int cy = py >> FRACTION_BITS;
+    const int sx = dx > 0 ? 1 : dx < 0 ? -1 : 0;
+    const int sy = dy > 0 ? 1 : dy < 0 ? -1 : 0;
+    const int64_t adx = std::abs(dx);
+    const int64_t ady = std::abs(dy);
+    const int64_t stepX = FIXED_ONE * ady;     // Time to cross a whole cell along x
+    const int64_t stepY = FIXED_ONE * adx;     // Time to cross a whole cell along y
+    int64_t timeX = sx > 0 ? ((int64_t(cx) + 1) << FRACTION_BITS) - px : px - (int64_t(cx) << FRACTION_BITS);
+    int64_t timeY = sy > 0 ? ((int64_t(cy) + 1) << FRACTION_BITS) - py : py - (int64_t(cy) << FRACTION_BITS);
+    timeX = sx != 0 ? timeX * ady : NEVER;
+    timeY = sy != 0 ? timeY * adx : NEVER;
+
+    // Number of boundaries crossed up to the end of the ray
+    const double length = std::sqrt(static_cast<double>(dx) * dx + static_cast<double>(dy) * dy);
+    const double scale = range * FIXED_ONE / length;
+    const int64_t endX = static_cast<int64_t>(std::floor((px + scale * dx) / FIXED_ONE));
+    const int64_t endY = static_cast<int64_t>(std::floor((py + scale * dy) / FIXED_ONE));
+    int64_t steps = std::abs(endX - cx) + std::abs(endY - cy);
+
+    bool moved = false;
+    bool lastStepX = false;
+    while (true) {
+        if (!blocks[static_cast<size_t>(cy >> BLOCK_SHIFT) * blocksX + (cx >> BLOCK_SHIFT)]) {
+            const int blockX = (cx >> BLOCK_SHIFT) << BLOCK_SHIFT;
+            const int blockY = (cy >> BLOCK_SHIFT) << BLOCK_SHIFT;
+            const int64_t leaveX = sx > 0 ? blockX + BLOCK_SIZE - cx : cx - blockX + 1;
+            const int64_t leaveY = sy > 0 ? blockY + BLOCK_SIZE - cy : cy - blockY + 1;
+            const int64_t exitX = sx != 0 ? timeX + (leaveX - 1) * stepX : NEVER;
+            const int64_t exitY = sy != 0 ? timeY + (leaveY - 1) * stepY : NEVER;
+            if (exitX <= exitY) {
+                const int64_t along = (sy == 0 || timeY >= exitX) ? 0 : (exitX - timeY - 1) / stepY + 1;
+                cx += static_cast<int>(sx * leaveX);
+                cy += static_cast<int>(sy * along);
+                steps -= leaveX + along;
+                if (sy != 0) {
+                    timeY += along * stepY - exitX;
+                }
+                timeX = stepX;
+                lastStepX = true;
+            }
+            else {
+                const int64_t along = (sx == 0 || timeX > exitY) ? 0 : (exitY - timeX) / stepX + 1;
+                cy += static_cast<int>(sy * leaveY);
+                cx += static_cast<int>(sx * along);
+                steps -= leaveY + along;
+                if (sx != 0) {
+                    timeX += along * stepX - exitY;
+                }
+                timeY = stepY;
+                lastStepX = false;
+            }
+        }
+        else {
+            if (map.cellAt(cx, cy) != 0) {
+                break;
+            }
+            if (timeX <= timeY) {
+                cx += sx;
+                timeY -= timeX;
+                timeX = stepX;
+                lastStepX = true;
+            }
+            else {
+                cy += sy;
+                timeX -= timeY;
+                timeY = stepY;
+                lastStepX = false;
+            }
+            --steps;
+        }
+        moved = true;
+        if (steps < 0 || cx < 0 || cx >= sizeX || cy < 0 || cy >= sizeY) {
+            return false;
+        }
+    }
+
+    hitX = cx;
+    hitY = cy;
+    entryAxis = !moved ? -1 : lastStepX ? 0 : 1;
+    return true;
+}
+
+/**
+ * @brief Casts the rays of a batch in the range [begin, end).
+ *
+ * Each packet is clipped to the map, converted to fixed point with SIMD
+ * instructions, then traversed ray by ray.
+ */
+void Raycaster::castRange(RayBatch& rays, int begin, int end) const {
+    alignas(32) float x[RAY_PACKET];
+    alignas(32) float y[RAY_PACKET];
+    alignas(32) float offsets[RAY_PACKET];
+    alignas(32) int fixedX[RAY_PACKET];
+    alignas(32) int fixedY[RAY_PACKET];
+    alignas(32) int fixedDirX[RAY_PACKET];
+    alignas(32) int fixedDirY[RAY_PACKET];
+    const int64_t limitX = (int64_t(sizeX) << FRACTION_BITS) - 1;
+    const int64_t limitY = (int64_t(sizeY) << FRACTION_BITS) - 1;
+
+    for (int first = begin; first < end; first += RAY_PACKET) {
+        const int packet = std::min(RAY_PACKET, end - first);
+        const float* dirX = rays.getDirX() + first;
+        const float* dirY = rays.getDirY() + first;
+        alignas(32) float dx[RAY_PACKET];
+        alignas(32) float dy[RAY_PACKET];
+        for (int i = 0; i < RAY_PACKET; ++i) {
+            if (i < packet) {
+                x[i] = rays.getOriginX()[first + i];
+                y[i] = rays.getOriginY()[first + i];
+                dx[i] = dirX[i];
+                dy[i] = dirY[i];
+                offsets[i] = clipOrigin(x[i], y[i], dx[i], dy[i], sizeX, sizeY, maxRange);
+                if (offsets[i] < 0) {
+                    x[i] = y[i] = 0.0f;
+                }
+            }
+            else {
+                x[i] = y[i] = dx[i] = dy[i] = 0.0f;
+            }
+        }
+        toFixed(x, fixedX);
+        toFixed(y, fixedY);
+        toFixed(dx, fixedDirX);
+        toFixed(dy, fixedDirY);
+
+        for (int i = 0; i < packet; ++i) {
+            float distance = 0.0f;
+            int cellX = -1;
+            int cellY = -1;
+            int entryAxis = -1;
+            bool hit = false;
+            if (offsets[i] >= 0) {
+                const int px = static_cast<int>(std::min<int64_t>(std::max(fixedX[i], 0), limitX));
+                const int py = static_cast<int>(std::min<int64_t>(std::max(fixedY[i], 0), limitY));
+                hit = traverse(px, py, fixedDirX[i], fixedDirY[i], maxRange - offsets[i], cellX, cellY, entryAxis);
+            }
+            if (hit && entryAxis >= 0) {
+                // Distance along the unquantized ray to the boundary crossed into the hit cell
+                distance = entryAxis == 0
+                    ? (cellX + (dx[i] < 0) - x[i]) / dx[i]
+                    : (cellY + (dy[i] < 0) - y[i]) / dy[i];
+                distance = std::max(0.0f, distance);
+            }
+            rays.getRanges()[first + i] = hit ? offsets[i] + distance : maxRange;
+            rays.getHitX()[first + i] = hit ? cellX : -1;
+            rays.getHitY()[first + i] = hit ? cellY : -1;
+        }
+    }
+}
+
+/**
+ * @brief Casts every ray of a batch and stores the ranges and hit cells in it.
+ *
+ * With a thread pool, the batch is split into runs of whole packets, several
+ * per thread so that runs with long rays do not hold up the others.
+ */
+void Raycaster::castRays(RayBatch& rays) const {
+    const int count = rays.size();
+    if (sizeX == 0 || sizeY == 0) {
+        std::fill(rays.getRanges(), rays.getRanges() + count, maxRange);
+        std::fill(rays.getHitX(), rays.getHitX() + count, -1);
+        std::fill(rays.getHitY(), rays.getHitY() + count, -1);
+        return;
+    }
+    if (!pool || count < PARALLEL_MIN_RAYS) {
+        castRange(rays, 0, count);
+        return;
+    }
+    const int packets = (count + RAY_PACKET - 1) / RAY_PACKET;
+    const int tasks = std::min(packets, pool->getThreadCount() * 4);
+    pool->run(tasks, [&](int task) {
+        const int begin = static_cast<int>(static_cast<int64_t>(packets) * task / tasks) * RAY_PACKET;
+        const int end = std::min(count, static_cast<int>(static_cast<int64_t>(packets) * (task + 1) / tasks) * RAY_PACKET);
+        castRange(rays, begin, end);
+    });
+}
+
+/**
+ * @brief Casts a single ray.
+ */
+bool Raycaster::castRay(double x, double y, double angle, double& range, int& hitX, int& hitY) const {
+    RayBatch ray(1);
+    ray.addRay(x, y, angle);
+    castRays(ray);
+    range = ray.getRanges()[0];
+    hitX = ray.getHitX()[0];
+    hitY = ray.getHitY()[0];
+    return ray.isHit(0);
+}
@@ -0,0 +1,255 @@
+#ifndef RAYCASTER_H
+#define RAYCASTER_H
+
+#include "Map.h"
+#include <memory>
+#include <vector>
+
+class ThreadPool;
+
+/**
+ * @file   Raycaster.h
+ * @author Emirhan Kalkan
+ * @date   December, 2024
+ * @brief  Header file for the RayBatch and Raycaster classes.
+ *
+ * This file defines the Raycaster class, which casts many rays against a Map
+ * at once (a virtual lidar), and the RayBatch class holding its rays and results.
+ */
+
+ /**
+  * @class RayBatch
+  * @brief A batch of rays and their results, stored as aligned structure-of-arrays.
+  *
+  * Each ray has an origin and a unit direction in map cells. Raycaster::castRays()
+  * fills in the range to the first occupied cell and the coordinates of that
+  * cell. Storage is kept between batches, so a particle filter can refill the
+  * same batch every step without allocating.
+  */
+class RayBatch {
+private:
+    float* originX;    /**< X-coordinates of the ray origins. */
+    float* originY;    /**< Y-coordinates of the ray origins. */
+    float* dirX;       /**< X-components of the unit directions. */
+    float* dirY;       /**< Y-components of the unit directions. */
+    float* ranges;     /**< Range to the hit cell, or the maximum range on a miss. */
+    int* hitX;         /**< X-coordinate of the hit cell, or -1 on a miss. */
+    int* hitY;         /**< Y-coordinate of the hit cell, or -1 on a miss. */
+    int count;         /**< Number of rays in the batch. */
+    int capacity;      /**< Number of rays the arrays can hold. */
+
+public:
+    /**
+     * @brief Creates an empty batch with room for the given number of rays.
+     */
+    explicit RayBatch(int initialCapacity = 0);
+
+    /**
+     * @brief Destructor. Frees the arrays.
+     */
+    ~RayBatch();
+
+    RayBatch(const RayBatch&) = delete;
+    RayBatch& operator=(const RayBatch&) = delete;
+
+    /**
+     * @brief Ensures room for at least the given number of rays.
+     */
+    void reserve(int newCapacity);
+
+    /**
+     * @brief Sets the number of rays, growing the storage if needed. New rays are undefined.
+     */
+    void resize(int newCount);
+
+    /**
+     * @brief Removes all rays without releasing storage.
+     */
+    void clear();
+
+    /**
+     * @brief Returns the number of rays in the batch.
+     */
+    int size() const;
+
+    /**
+     * @brief Sets the origin and direction of a ray.
+     *
+     * @param index Index of the ray.
+     * @param x X-coordinate of the origin in cells.
+     * @param y Y-coordinate of the origin in cells.
+     * @param angle Direction in degrees, counterclockwise from the x-axis.
+     */
+    void setRay(int index, double x, double y, double angle);
+
+    /**
+     * @brief Appends a ray and returns its index.
+     */
+    int addRay(double x, double y, double angle);
+
+    /**
+     * @brief Appends a fan of rays from one origin, e.g. the beams of a lidar scan.
+     *
+     * @param x X-coordinate of the origin in cells.
+     * @param y Y-coordinate of the origin in cells.
+     * @param startAngle Direction of the first ray in degrees.
+     * @param increment Angle between consecutive rays in degrees.
+     * @param rays Number of rays to append.
+     */
+    void addFan(double x, double y, double startAngle, double increment, int rays);
+
+    /**
+     * @brief Returns the input and output arrays, for filling and reading batches in bulk.
+     */
+    float* getOriginX() { return originX; }
+    float* getOriginY() { return originY; }
+    float* getDirX() { return dirX; }
+    float* getDirY() { return dirY; }
+    const float* getOriginX() const { return originX; }
+    const float* getOriginY() const { return originY; }
+    const float* getDirX() const { return dirX; }
+    const float* getDirY() const { return dirY; }
+    float* getRanges() { return ranges; }
+    int* getHitX() { return hitX; }
+    int* getHitY() { return hitY; }
+    const float* getRanges() const { return ranges; }
+    const int* getHitX() const { return hitX; }
+    const int* getHitY() const { return hitY; }
+
+    /**
+     * @brief Returns whether a ray hit an occupied cell within the maximum range.
+     */
+    bool isHit(int index) const { return hitX[index] >= 0; }
+};
+
+ /**
+  * @class Raycaster
+  * @brief Casts batches of rays against the occupied cells of a Map.
+  *
+  * Rays walk the grid with an integer DDA: the origin and direction are
+  * converted to 16.16 fixed point, and the next cell boundary is chosen by
+  * comparing integer crossing times, so every cell the ray touches is visited
+  * and the result does not depend on floating point rounding. When several
+  * boundaries are crossed at once (through a corner), the x step comes first.
+  *
+  * The raycaster keeps one flag per BLOCK_SIZE x BLOCK_SIZE block of the map
+  * telling whether it holds any occupied cell. A ray entering an empty block
+  * jumps straight to the block where it leaves, computing the skipped steps in
+  * closed form. update() refreshes only the blocks of map tiles changed since
+  * the last update, like DistanceField::update().
+  *
+  * castRays() processes rays in packets of RAY_PACKET: their origins and
+  * directions are converted to fixed point with SIMD instructions, then each
+  * ray is traversed. With setThreadCount() above 1, packets are split between
+  * threads; results do not depend on the thread count.
+  *
+  * The hit range is the distance from the origin to where the ray enters the
+  * hit cell (0 if the origin cell is occupied). Rays that leave the map or
+  * reach the maximum range first are misses. Origins outside the map are
+  * allowed; such rays start where they enter the map.
+  */
+class Raycaster {
+private:
+    const Map& map;                       /**< The map rays are cast against (non-zero cells are occupied). */
+    float maxRange;                       /**< Maximum range of a ray in cells. */
+    int sizeX, sizeY;                     /**< Map size at the last update. */
+    int blocksX, blocksY;                 /**< Number of blocks along X and Y. */
+    std::vector<unsigned char> blocks;    /**< Whether each block holds an occupied cell. */
+    unsigned long long syncedVersion;     /**< Map version the blocks reflect. */
+    std::unique_ptr<ThreadPool> pool;     /**< Threads casting packets, or null for serial casts. */
+
+    /**
+     * @brief Recomputes the flags of the blocks overlapping a change-tracking tile.
+     */
+    void refreshTile(int tx, int ty);
+
+    /**
+     * @brief Casts the rays of a batch in the range [begin, end).
+     */
+    void castRange(RayBatch& rays, int begin, int end) const;
+
+    /**
+     * @brief Traverses the grid from a fixed-point origin inside the map.
+     *
+     * @param px X-coordinate of the origin in 16.16 fixed point.
+     * @param py Y-coordinate of the origin in 16.16 fixed point.
+     * @param dx X-component of the direction in 16.16 fixed point.
+     * @param dy Y-component of the direction in 16.16 fixed point.
+     * @param range Length of the ray from the origin, in cells.
+     * @param hitX Set to the x-coordinate of the hit cell.
+     * @param hitY Set to the y-coordinate of the hit cell.
+     * @param entryAxis Set to the axis of the boundary crossed into the hit cell
+     *        (0 for x, 1 for y), or -1 if the origin cell is occupied.
+     * @return `true` if an occupied cell was hit.
+     */
+    bool traverse(int px, int py, int dx, int dy, float range, int& hitX, int& hitY, int& entryAxis) const;
+
+public:
+    static const int BLOCK_SHIFT = 3;                   /**< log2 of the block size. */
+    static const int BLOCK_SIZE = 1 << BLOCK_SHIFT;     /**< Cells along a block side. */
+    static const int RAY_PACKET = 8;                    /**< Rays converted to fixed point at once. */
+    static const int MAX_MAP_SIZE = 32767;              /**< Largest map side supported by the fixed-point format. */
+    static const int PARALLEL_MIN_RAYS = 256;           /**< Smallest batch split between threads. */
+
+    /**
+     * @brief Builds the block flags of a map.
+     *
+     * @param map The map. It must outlive the raycaster.
+     * @param maxRange Maximum range of a ray in cells.
+     * @throw std::invalid_argument If the maximum range is not positive.
+     * @throw std::length_error If a map side exceeds MAX_MAP_SIZE.
+     */
+    Raycaster(const Map& map, double maxRange);
+
+    /**
+     * @brief Destructor. Stops the threads.
+     */
+    ~Raycaster();
+
+    Raycaster(const Raycaster&) = delete;
+    Raycaster& operator=(const Raycaster&) = delete;
+
+    /**
+     * @brief Brings the block flags up to date with the map.
+     *
+     * Must be called after the map changes and before casting.
+     *
+     * @throw std::length_error If a map side exceeds MAX_MAP_SIZE.
+     */
+    void update();
+
+    /**
+     * @brief Sets the number of threads used by castRays().
+     */
+    void setThreadCount(int threads);
+
+    /**
+     * @brief Returns the number of threads used by castRays().
+     */
+    int getThreadCount() const;
+
+    /**
+     * @brief Returns the maximum range of a ray in cells.
+     */
+    double getMaxRange() const;
+
+    /**
+     * @brief Casts every ray of a batch and stores the ranges and hit cells in it.
+     */
+    void castRays(RayBatch& rays) const;
+
+    /**
+     * @brief Casts a single ray.
+     *
+     * @param x X-coordinate of the origin in cells.
+     * @param y Y-coordinate of the origin in cells.
+     * @param angle Direction in degrees, counterclockwise from the x-axis.
+     * @param range Set to the range to the hit cell, or the maximum range on a miss.
+     * @param hitX Set to the x-coordinate of the hit cell, or -1 on a miss.
+     * @param hitY Set to the y-coordinate of the hit cell, or -1 on a miss.
+     * @return `true` if an occupied cell was hit.
+     */
+    bool castRay(double x, double y, double angle, double& range, int& hitX, int& hitY) const;
+};
+
+#endif // RAYCASTER_H
@@ -0,0 +1,309 @@
+#include "RoomSegmentation.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <stdexcept>
+#include <utility>
+
+/**
+ * @file   RoomSegmentation.cpp
+ * @author Emirhan Kalkan
+ * @date   December, 2024
+ * @brief  Implementation of the RoomSegmentation class.
+ */
+
+const int RoomSegmentation::NO_REGION;
+
+/**
+ * @brief Segments a map.
+ */
+RoomSegmentation::RoomSegmentation(const Map& map, double doorWidth, int minSeedArea)
+    : map(map), doorWidth(doorWidth), minSeedArea(minSeedArea), field(map),
+      seeds(map.getNumberX(), map.getNumberY()), seedComponents(seeds, 4, true), sizeX(-1), sizeY(-1),
+      syncedVersion(0) {
+    if (!(doorWidth > 0)) {
+        throw std::invalid_argument("Door width must be positive.");
+    }
+    if (minSeedArea < 1) {
+        throw std::invalid_argument("Minimum seed area must be at least 1.");
+    }
+    update();
+}
+
+/**
+ * @brief Segments the map again if it changed since the last update.
+ */
+void RoomSegmentation::update() {
+    if (map.getNumberX() == sizeX && map.getNumberY() == sizeY && map.getVersion() == syncedVersion) {
+        return;
+    }
+    sizeX = map.getNumberX();
+    sizeY = map.getNumberY();
+    syncedVersion = map.getVersion();
+    field.update();
+    placeSeeds();
+    flood();
+    buildGraph();
+}
+
+/**
+ * @brief Marks the seed cells and starts a region for every large enough seed blob.
+ *
+ * A seed cell is a free cell whose clearance exceeds half the door width.
+ */
+void RoomSegmentation::placeSeeds() {
+    if (seeds.getNumberX() != sizeX || seeds.getNumberY() != sizeY) {
+        seeds.setGridSize(sizeX, sizeY);
+    }
+    const double thresholdSquared = doorWidth * doorWidth / 4.0;
+    for (int y = 0; y < sizeY; ++y) {
+        const MapCell* row = map.getRow(y);
+        MapCell* seedRow = seeds.getRow(y);
+        for (int x = 0; x < sizeX; ++x) {
+            seedRow[x] = row[x] == 0 && field.getSquaredDistance(x, y) > thresholdSquared;
+        }
+    }
+    if (sizeX > 0 && sizeY > 0) {
+        seeds.markDirty(0, 0, sizeX - 1, sizeY - 1);
+    }
+    seedComponents.update();
+
+    std::vector<int> regionOfSeed(seedComponents.getComponentCount(), NO_REGION);
+    int regionCount = 0;
+    for (size_t seed = 0; seed < regionOfSeed.size(); ++seed) {
+        if (seedComponents.getComponentSize(static_cast<int>(seed)) >= minSeedArea) {
+            regionOfSeed[seed] = regionCount++;
+        }
+    }
+    const std::vector<int>& labels = seedComponents.getLabels();
+    regions.resize(labels.size());
+    for (size_t index = 0; index < labels.size(); ++index) {
+        regions[index] = labels[index] == ConnectedComponents::NO_COMPONENT ? NO_REGION : regionOfSeed[labels[index]];
+    }
+    regionInfo.assign(regionCount, Region());
+}
+
+/**
+ * @brief Grows the regions over free space in order of decreasing clearance.
+ *
+ * A cell joins the first region that reaches it; cells are expanded from the
+ * highest clearance down, so two regions meet where the clearance between
+ * them is lowest. Free cells left over form regions of their own.
+ */
+void RoomSegmentation::flood() {
+    typedef unsigned long long QueueEntry;   // Squared distance in the high 32 bits, cell index in the low 32
+    std::priority_queue<QueueEntry> open;
+    for (int y = 0; y < sizeY; ++y) {
+        for (int x = 0; x < sizeX; ++x) {
+            const int index = y * sizeX + x;
+            if (regions[index] != NO_REGION) {
+                open.push((static_cast<QueueEntry>(field.getSquaredDistance(x, y)) << 32) | static_cast<unsigned int>(index));
+            }
+        }
+    }
+
+    const int offsetX[4] = { 1, -1, 0, 0 };
+    const int offsetY[4] = { 0, 0, 1, -1 };
+    auto grow = [&](int index, int x, int y, bool byClearance, std::vector<int>& stack) {
+        for (int k = 0; k < 4; ++k) {
+            const int nx = x + offsetX[k];
+            const int ny = y + offsetY[k];
+            if (nx < 0 || nx >= sizeX || ny < 0 || ny >= sizeY) {
+                continue;
+            }
+            const int neighbour = ny * sizeX + nx;
+            if (regions[neighbour] != NO_REGION || map.getRow(ny)[nx] != 0) {
+                continue;
+            }
+            regions[neighbour] = regions[index];
+            if (byClearance) {
+                open.push((static_cast<QueueEntry>(field.getSquaredDistance(nx, ny)) << 32) | static_cast<unsigned int>(neighbour));
+            }
+            else {
+                stack.push_back(neighbour);
+            }
+        }
+    };
+
+    std::vector<int> stack;
+    while (!open.empty()) {
+        const int index = static_cast<int>(open.top() & 0xFFFFFFFFu);
+        open.pop();
+        grow(index, index % sizeX, index / sizeX, true, stack);
+    }
+
+    for (int y = 0; y < sizeY; ++y) {
+        const MapCell* row = map.getRow(y);
+        for (int x = 0; x < sizeX; ++x) {
+            const int start = y * sizeX + x;
+            if (row[x] != 0 || regions[start] != NO_REGION) {
+                continue;
+            }
+            regions[start] = static_cast<int>(regionInfo.size());
+            regionInfo.push_back(Region());
+            stack.assign(1, start);
+            while (!stack.empty()) {
+                const int index = stack.back();
+                stack.pop_back();
+                grow(index, index % sizeX, index / sizeX, false, stack);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Records one shared cell edge between two regions.
+ */
+void RoomSegmentation::addBorder(int from, int to, int x, int y) {
+    std::vector<RegionLink>& links = graph[from];
+    auto link = std::find_if(links.begin(), links.end(), [to](const RegionLink& candidate) { return candidate.region == to; });
+    const double clearance = field.getDistance(x, y);
+    if (link == links.end()) {
+        RegionLink added = { to, 1, x, y, clearance };
+        links.push_back(added);
+        return;
+    }
+    ++link->borderLength;
+    if (clearance > link->doorClearance) {
+        link->doorX = x;
+        link->doorY = y;
+        link->doorClearance = clearance;
+    }
+}
+
+/**
+ * @brief Computes the region summaries and the adjacency graph.
+ */
+void RoomSegmentation::buildGraph() {
+    const int regionCount = static_cast<int>(regionInfo.size());
+    std::vector<double> sumX(regionCount, 0.0);
+    std::vector<double> sumY(regionCount, 0.0);
+    for (Region& region : regionInfo) {
+        region.area = 0;
+        region.clearance = 0.0;
+    }
+    graph.assign(regionCount, std::vector<RegionLink>());
+
+    for (int y = 0; y < sizeY; ++y) {
+        for (int x = 0; x < sizeX; ++x) {
+            const int index = y * sizeX + x;
+            const int region = regions[index];
+            if (region == NO_REGION) {
+                continue;
+            }
+            Region& info = regionInfo[region];
+            ++info.area;
+            sumX[region] += x;
+            sumY[region] += y;
+            info.clearance = std::max(info.clearance, field.getDistance(x, y));
+            if (x + 1 < sizeX && regions[index + 1] != NO_REGION && regions[index + 1] != region) {
+                addBorder(region, regions[index + 1], x, y);
+                addBorder(regions[index + 1], region, x + 1, y);
+            }
+            if (y + 1 < sizeY && regions[index + sizeX] != NO_REGION && regions[index + sizeX] != region) {
+                addBorder(region, regions[index + sizeX], x, y);
+                addBorder(regions[index + sizeX], region, x, y + 1);
+            }
+        }
+    }
+    for (int region = 0; region < regionCount; ++region) {
+        regionInfo[region].centroidX = sumX[region] / regionInfo[region].area;
+        regionInfo[region].centroidY = sumY[region] / regionInfo[region].area;
+    }
+}
+
+/**
+ * @brief Sets the number of threads used to label seeds.
+ */
+void RoomSegmentation::setThreadCount(int threads) {
+    seedComponents.setThreadCount(threads);
+}
+
+/**
+ * @brief Returns the region of a cell, or NO_REGION.
+ */
+int RoomSegmentation::getRegion(int x, int y) const {
+    if (x < 0 || x >= sizeX || y < 0 || y >= sizeY) {
+        return NO_REGION;
+    }
+    return regions[static_cast<size_t>(y) * sizeX + x];
+}
+
+const std::vector<int>& RoomSegmentation::getRegions() const {
+    return regions;
+}
+
+int RoomSegmentation::getRegionCount() const {
+    return static_cast<int>(regionInfo.size());
+}
+
+/**
+ * @brief Returns the summary of a region.
+ */
+const RoomSegmentation::Region& RoomSegmentation::getRegionInfo(int region) const {
+    if (region < 0 || region >= getRegionCount()) {
+        throw std::out_of_range("Invalid region id.");
+    }
+    return regionInfo[region];
+}
+
+/**
+ * @brief Returns the links of a region to its neighbours.
+ */
+const std::vector<RoomSegmentation::RegionLink>& RoomSegmentation::getNeighbours(int region) const {
+    if (region < 0 || region >= getRegionCount()) {
+        throw std::out_of_range("Invalid region id.");
+    }
+    return graph[region];
+}
+
+/**
+ * @brief Finds the shortest chain of regions between two regions.
+ *
+ * Dijkstra's algorithm over the region graph.
+ */
+std::vector<int> RoomSegmentation::findRegionPath(int from, int to) const {
+    const int regionCount = getRegionCount();
+    if (from < 0 || from >= regionCount || to < 0 || to >= regionCount) {
+        return std::vector<int>();
+    }
+    typedef std::pair<double, int> QueueEntry;   // Cost so far, region
+    std::vector<double> cost(regionCount, std::numeric_limits<double>::infinity());
+    std::vector<int> previous(regionCount, NO_REGION);
+    std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry> > open;
+    cost[from] = 0.0;
+    open.push(QueueEntry(0.0, from));
+    while (!open.empty()) {
+        const QueueEntry entry = open.top();
+        open.pop();
+        const int region = entry.second;
+        if (entry.first > cost[region]) {
+            continue;
+        }
+        if (region == to) {
+            break;
+        }
+        const Region& info = regionInfo[region];
+        for (const RegionLink& link : graph[region]) {
+            const Region& next = regionInfo[link.region];
+            const double step = std::hypot(link.doorX - info.centroidX, link.doorY - info.centroidY) +
+                std::hypot(next.centroidX - link.doorX, next.centroidY - link.doorY);
+            if (cost[region] + step < cost[link.region]) {
+                cost[link.region] = cost[region] + step;
+                previous[link.region] = region;
+                open.push(QueueEntry(cost[link.region], link.region));
+            }
+        }
+    }
+    if (cost[to] == std::numeric_limits<double>::infinity()) {
+        return std::vector<int>();
+    }
+    std::vector<int> path;
+    for (int region = to; region != NO_REGION; region = previous[region]) {
+        path.push_back(region);
+    }
+    std::reverse(path.begin(), path.end());
+    return path;
+}
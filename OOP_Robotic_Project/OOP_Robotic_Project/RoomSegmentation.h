@@ -0,0 +1,161 @@
+#ifndef ROOMSEGMENTATION_H
+#define ROOMSEGMENTATION_H
+
+#include "Map.h"
+#include "ConnectedComponents.h"
+#include "DistanceField.h"
+#include <vector>
+
+/**
+ * @file   RoomSegmentation.h
+ * @author Emirhan Kalkan
+ * @date   December, 2024
+ * @brief  Header file for the RoomSegmentation class.
+ *
+ * This file defines the RoomSegmentation class, which splits the free space
+ * of a Map into rooms and corridors and connects them in a region graph.
+ */
+
+ /**
+  * @class RoomSegmentation
+  * @brief Distance-transform watershed segmentation of free space into regions.
+  *
+  * Doorways are the narrow places of free space. The free cells farther than
+  * half a door width from every obstacle form blobs that cannot pass through
+  * doorways; each blob of at least a minimum area (labelled with
+  * ConnectedComponents) seeds a region. The regions then grow over the rest
+  * of free space in order of decreasing clearance, a watershed on the
+  * distance field, so region borders settle in the narrowest places. Free
+  * cells that no region reaches (pockets narrower than a door) each become
+  * a region of their own.
+  *
+  * Every free cell gets a region id; occupied cells get NO_REGION. Two
+  * regions are adjacent when they share an edge, and the link records the
+  * length of the shared border and its door: the border cell with the most
+  * clearance. findRegionPath() plans over this graph, so a path search can
+  * be restricted to the regions it returns.
+  *
+  * update() segments again when the map changed; the distance field is kept
+  * up to date incrementally.
+  */
+class RoomSegmentation {
+public:
+    /**
+     * @brief Summary of a region.
+     */
+    struct Region {
+        int area;                  /**< Number of cells. */
+        double centroidX;          /**< Mean x-coordinate of the cells. */
+        double centroidY;          /**< Mean y-coordinate of the cells. */
+        double clearance;          /**< Largest distance to an obstacle inside the region. */
+    };
+
+    /**
+     * @brief Edge of the region adjacency graph.
+     */
+    struct RegionLink {
+        int region;                /**< The neighbouring region. */
+        int borderLength;          /**< Number of cell edges shared with it. */
+        int doorX, doorY;          /**< Border cell (in this region) with the most clearance. */
+        double doorClearance;      /**< Distance to an obstacle at the door. */
+    };
+
+private:
+    const Map& map;                           /**< The segmented map (non-zero cells are occupied). */
+    double doorWidth;                         /**< Widest opening treated as a doorway, in cells. */
+    int minSeedArea;                          /**< Smallest seed blob that starts a region. */
+    DistanceField field;                      /**< Clearance of every cell. */
+    Map seeds;                                /**< Cells wider than a doorway (non-zero). */
+    ConnectedComponents seedComponents;       /**< Blobs of the seed cells. */
+    int sizeX, sizeY;                         /**< Map size at the last update. */
+    unsigned long long syncedVersion;         /**< Map version the regions reflect. */
+    std::vector<int> regions;                 /**< Row-major region ids, or NO_REGION. */
+    std::vector<Region> regionInfo;           /**< Summary of each region. */
+    std::vector<std::vector<RegionLink> > graph;  /**< Links of each region. */
+
+    /**
+     * @brief Marks the seed cells and starts a region for every large enough seed blob.
+     */
+    void placeSeeds();
+
+    /**
+     * @brief Grows the regions over free space in order of decreasing clearance.
+     */
+    void flood();
+
+    /**
+     * @brief Computes the region summaries and the adjacency graph.
+     */
+    void buildGraph();
+
+    /**
+     * @brief Records one shared cell edge between two regions.
+     */
+    void addBorder(int from, int to, int x, int y);
+
+public:
+    static const int NO_REGION = -1;          /**< Region id of occupied cells and cells outside the map. */
+
+    /**
+     * @brief Segments a map.
+     *
+     * @param map The map. It must outlive the segmentation.
+     * @param doorWidth Widest opening (in cells) that separates two regions.
+     * @param minSeedArea Smallest area (in cells) of a region seed; smaller
+     *        blobs, such as the wide spots of a cluttered room, do not start regions.
+     * @throw std::invalid_argument If the door width is not positive or the area is below 1.
+     */
+    RoomSegmentation(const Map& map, double doorWidth, int minSeedArea = 9);
+
+    /**
+     * @brief Segments the map again if it changed since the last update.
+     */
+    void update();
+
+    /**
+     * @brief Sets the number of threads used to label seeds.
+     */
+    void setThreadCount(int threads);
+
+    /**
+     * @brief Returns the region of a cell, or NO_REGION.
+     */
+    int getRegion(int x, int y) const;
+
+    /**
+     * @brief Returns the row-major region ids of all cells.
+     */
+    const std::vector<int>& getRegions() const;
+
+    /**
+     * @brief Returns the number of regions.
+     */
+    int getRegionCount() const;
+
+    /**
+     * @brief Returns the summary of a region.
+     *
+     * @throw std::out_of_range If the id is invalid.
+     */
+    const Region& getRegionInfo(int region) const;
+
+    /**
+     * @brief Returns the links of a region to its neighbours.
+     *
+     * @throw std::out_of_range If the id is invalid.
+     */
+    const std::vector<RegionLink>& getNeighbours(int region) const;
+
+    /**
+     * @brief Finds the shortest chain of regions between two regions.
+     *
+     * Links cost the distance from a region's centroid through the door to the
+     * neighbour's centroid.
+     *
+     * @return The regions from the first to the last, or an empty list if they
+     *         are not connected or an id is invalid.
+     */
+    std::vector<int> findRegionPath(int from, int to) const;
+};
+
+#endif // ROOMSEGMENTATION_H
@@ -0,0 +1,216 @@
+/**
+ * @file   ScanAnalyzer.cpp
+ * @author Furkan Gemici
+ * @date   December, 2024
+ * @brief  Implementation file for the ScanAnalyzer class.
+ */
+
+#include "ScanAnalyzer.h"
+#include "SimdConfig.h"
+#include <limits>
+#undef max
+#undef min
+
+namespace {
+    /**
+     * @brief Returns true if the range is finite and greater than zero.
+     */
+    inline bool isValidRange(float r) {
+        return r > 0.0f && r <= std::numeric_limits<float>::max();
+    }
+
+    /**
+     * @brief Merges a candidate (value, index) into the running minimum.
+     *
+     * Ties are resolved towards the smallest index so the SIMD lanes give the
+     * same result as a sequential scan.
+     */
+    inline void mergeMin(float value, int index, float& best, int& bestIndex) {
+        if (value < best || (value == best && index >= 0 && (bestIndex < 0 || index < bestIndex))) {
+            best = value;
+            bestIndex = index;
+        }
+    }
+
+    /**
+     * @brief Merges a candidate (value, index) into the running maximum.
+     */
+    inline void mergeMax(float value, int index, float& best, int& bestIndex) {
+        if (value > best || (value == best && index >= 0 && (bestIndex < 0 || index < bestIndex))) {
+            best = value;
+            bestIndex = index;
+        }
+    }
+}
+
+/**
+ * @brief Computes min/max/argmin/argmax, mean and valid beam count in one pass.
+ *
+ * Each SIMD lane keeps its own running minimum, maximum, index, sum and count.
+ * Invalid beams are replaced by neutral values (+inf for the minimum, -inf for
+ * the maximum, 0 for the sum) so the loop has no branches. The lanes are
+ * reduced at the end.
+ */
+void ScanAnalyzer::computeStatistics(const float* ranges, int count, ScanStatistics& stats) {
+    const float inf = std::numeric_limits<float>::infinity();
+    float best = inf;
+    float worst = -inf;
+    int bestIndex = -1;
+    int worstIndex = -1;
+    double sum = 0.0;
+    int valid = 0;
+
+    int i = 0;
+#if defined(ROBOT_SIMD_AVX2)
+    {
+        const __m256 zero = _mm256_setzero_ps();
+        const __m256 posInf = _mm256_set1_ps(inf);
+        const __m256 negInf = _mm256_set1_ps(-inf);
+        const __m256i step = _mm256_set1_epi32(8);
+        __m256i index = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+        __m256 minV = posInf, maxV = negInf, sumV = zero;
+        __m256i minI = _mm256_set1_epi32(-1), maxI = _mm256_set1_epi32(-1), countV = _mm256_setzero_si256();
+
+        for (; i + 8 <= count; i += 8) {
+            __m256 r = _mm256_loadu_ps(ranges + i);
+            __m256 mask = _mm256_and_ps(_mm256_cmp_ps(r, zero, _CMP_GT_OQ), _mm256_cmp_ps(r, posInf, _CMP_LT_OQ));
+            __m256 rMin = _mm256_blendv_ps(posInf, r, mask);
+            __m256 rMax = _mm256_blendv_ps(negInf, r, mask);
+
+            __m256 lower = _mm256_cmp_ps(rMin, minV, _CMP_LT_OQ);
+            minV = _mm256_blendv_ps(minV, rMin, lower);
+            minI = _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(minI), _mm256_castsi256_ps(index), lower));
+
+            __m256 higher = _mm256_cmp_ps(rMax, maxV, _CMP_GT_OQ);
+            maxV = _mm256_blendv_ps(maxV, rMax, higher);
+            maxI = _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(maxI), _mm256_castsi256_ps(index), higher));
+
+            sumV = _mm256_add_ps(sumV, _mm256_and_ps(r, mask));
+            countV = _mm256_sub_epi32(countV, _mm256_castps_si256(mask));
+            index = _mm256_add_epi32(index, step);
+        }
+
+        alignas(32) float minLanes[8], maxLanes[8], sumLanes[8];
+        alignas(32) int minIdx[8], maxIdx[8], countLanes[8];
+        _mm256_store_ps(minLanes, minV);
+        _mm256_store_ps(maxLanes, maxV);
+        _mm256_store_ps(sumLanes, sumV);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(minIdx), minI);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(maxIdx), maxI);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(countLanes), countV);
+        for (int lane = 0; lane < 8; ++lane) {
+            mergeMin(minLanes[lane], minIdx[lane], best, bestIndex);
+            mergeMax(maxLanes[lane], maxIdx[lane], worst, worstIndex);
+            sum += sumLanes[lane];
+            valid += countLanes[lane];
+        }
+    }
+#elif defined(ROBOT_SIMD_SSE2)
+    {
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 posInf = _mm_set1_ps(inf);
+        const __m128 negInf = _mm_set1_ps(-inf);
+        const __m128i step = _mm_set1_epi32(4);
+        __m128i index = _mm_setr_epi32(0, 1, 2, 3);
+        __m128 minV = posInf, maxV = negInf, sumV = zero;
+        __m128i minI = _mm_set1_epi32(-1), maxI = _mm_set1_epi32(-1), countV = _mm_setzero_si128();
+
+        for (; i + 4 <= count; i += 4) {
+            __m128 r = _mm_loadu_ps(ranges + i);
+            __m128 mask = _mm_and_ps(_mm_cmpgt_ps(r, zero), _mm_cmplt_ps(r, posInf));
+            __m128 rMin = _mm_or_ps(_mm_and_ps(mask, r), _mm_andnot_ps(mask, posInf));
+            __m128 rMax = _mm_or_ps(_mm_and_ps(mask, r), _mm_andnot_ps(mask, negInf));
+
+            __m128 lower = _mm_cmplt_ps(rMin, minV);
+            __m128i lowerI = _mm_castps_si128(lower);
+            minV = _mm_or_ps(_mm_and_ps(lower, rMin), _mm_andnot_ps(lower, minV));
+            minI = _mm_or_si128(_mm_and_si128(lowerI, index), _mm_andnot_si128(lowerI, minI));
+
+            __m128 higher = _mm_cmpgt_ps(rMax, maxV);
+            __m128i higherI = _mm_castps_si128(higher);
+            maxV = _mm_or_ps(_mm_and_ps(higher, rMax), _mm_andnot_ps(higher, maxV));
+            maxI = _mm_or_si128(_mm_and_si128(higherI, index), _mm_andnot_si128(higherI, maxI));
+
+            sumV = _mm_add_ps(sumV, _mm_and_ps(r, mask));
+            countV = _mm_sub_epi32(countV, _mm_castps_si128(mask));
+            index = _mm_add_epi32(index, step);
+        }
+
+        alignas(16) float minLanes[4], maxLanes[4], sumLanes[4];
+        alignas(16) int minIdx[4], maxIdx[4], countLanes[4];
+        _mm_store_ps(minLanes, minV);
+        _mm_store_ps(maxLanes, maxV);
+        _mm_store_ps(sumLanes, sumV);
+        _mm_store_si128(reinterpret_cast<__m128i*>(minIdx), minI);
+        _mm_store_si128(reinterpret_cast<__m128i*>(maxIdx), maxI);
+        _mm_store_si128(reinterpret_cast<__m128i*>(countLanes), countV);
+        for (int lane = 0; lane < 4; ++lane) {
+            mergeMin(minLanes[lane], minIdx[lane], best, bestIndex);
+            mergeMax(maxLanes[lane], maxIdx[lane], worst, worstIndex);
+            sum += sumLanes[lane];
+            valid += countLanes[lane];
+        }
+    }
+#endif
+    for (; i < count; ++i) {
+        float r = ranges[i];
+        if (isValidRange(r)) {
+            mergeMin(r, i, best, bestIndex);
+            mergeMax(r, i, worst, worstIndex);
+            sum += r;
+            ++valid;
+        }
+    }
+
+    stats.min = best;
+    stats.minIndex = bestIndex;
+    stats.max = bestIndex < 0 ? std::numeric_limits<float>::lowest() : worst;
+    stats.maxIndex = worstIndex;
+    stats.mean = valid > 0 ? static_cast<float>(sum / valid) : 0.0f;
+    stats.validCount = valid;
+}
+
+/**
+ * @brief Finds the smallest valid range in [begin, end).
+ */
+float ScanAnalyzer::minimumInRange(const float* ranges, int begin, int end, int& index) {
+    const float inf = std::numeric_limits<float>::infinity();
+    float best = inf;
+    index = -1;
+
+    int i = begin;
+#if defined(ROBOT_SIMD_SSE2) || defined(ROBOT_SIMD_AVX2)
+    {
+        // Vector pass finds the minimum value, the index is recovered afterwards.
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 posInf = _mm_set1_ps(inf);
+        __m128 minV = posInf;
+        for (; i + 4 <= end; i += 4) {
+            __m128 r = _mm_loadu_ps(ranges + i);
+            __m128 mask = _mm_and_ps(_mm_cmpgt_ps(r, zero), _mm_cmplt_ps(r, posInf));
+            minV = _mm_min_ps(minV, _mm_or_ps(_mm_and_ps(mask, r), _mm_andnot_ps(mask, posInf)));
+        }
+        alignas(16) float lanes[4];
+        _mm_store_ps(lanes, minV);
+        for (int lane = 0; lane < 4; ++lane) {
+            if (lanes[lane] < best) {
+                best = lanes[lane];
+            }
+        }
+    }
+#endif
+    for (; i < end; ++i) {
+        if (isValidRange(ranges[i]) && ranges[i] < best) {
+            best = ranges[i];
+        }
+    }
+    if (best < inf) {
+        for (int j = begin; j < end; ++j) {
+            if (ranges[j] == best) {
+                index = j;
+                break;
+            }
+        }
+    }
+    return best;
+}
@@ -0,0 +1,74 @@
+/**
+ * @file   ScanAnalyzer.h
+ * @author Furkan Gemici
+ * @date   December, 2024
+ * @brief  Header file for the ScanAnalyzer class.
+ *
+ * This file contains the definition of the ScanAnalyzer class together with the
+ * ScanStatistics and ScanSector structures used to summarize a Lidar scan.
+ */
+
+#pragma once
+
+ /**
+  * @enum SECTOR
+  * @brief Indices of the standard sectors installed by LidarSensor::setStandardSectors().
+  */
+enum SECTOR { SECTOR_FRONT = 0, SECTOR_LEFT, SECTOR_REAR, SECTOR_RIGHT };
+
+/**
+ * @struct ScanStatistics
+ * @brief Summary of a Lidar scan computed in a single pass.
+ *
+ * Only valid beams (finite and greater than zero) contribute. When a scan has
+ * no valid beam, the indices are -1, min is +infinity and max is the lowest
+ * representable value.
+ */
+struct ScanStatistics {
+    float min;        /*!< Smallest valid range. */
+    float max;        /*!< Largest valid range. */
+    int minIndex;     /*!< Index of the first beam holding the smallest range. */
+    int maxIndex;     /*!< Index of the first beam holding the largest range. */
+    float mean;       /*!< Mean of the valid ranges (0 if there is none). */
+    int validCount;   /*!< Number of valid beams. */
+};
+
+/**
+ * @struct ScanSector
+ * @brief An angular sector of the scan, [startAngle, endAngle) in degrees.
+ *
+ * Angles are in the sensor frame and may wrap around 360 degrees,
+ * e.g. [-45, 45) is the front quadrant.
+ */
+struct ScanSector {
+    double startAngle;  /*!< First angle of the sector (degrees, inclusive). */
+    double endAngle;    /*!< Last angle of the sector (degrees, exclusive). */
+};
+
+ /**
+  * @class ScanAnalyzer
+  * @brief Vectorized reductions over Lidar range buffers.
+  *
+  * The kernels process 8 beams per iteration with AVX2, 4 with SSE2 and fall
+  * back to scalar code for the remaining beams.
+  */
+class ScanAnalyzer {
+public:
+    //! Computes min/max/argmin/argmax, mean and valid beam count in one pass
+    /*!
+     * @param ranges Range values of the scan.
+     * @param count Number of beams.
+     * @param stats Receives the statistics.
+     */
+    static void computeStatistics(const float* ranges, int count, ScanStatistics& stats);
+
+    //! Finds the smallest valid range in [begin, end)
+    /*!
+     * @param ranges Range values of the scan.
+     * @param begin First beam index (inclusive).
+     * @param end Last beam index (exclusive).
+     * @param index Receives the index of the smallest valid range, or -1.
+     * @return The smallest valid range, or +infinity if there is none.
+     */
+    static float minimumInRange(const float* ranges, int begin, int end, int& index);
+};
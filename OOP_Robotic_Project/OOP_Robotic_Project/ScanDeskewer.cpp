@@ -0,0 +1,217 @@
+/**
+ * @file   ScanDeskewer.cpp
+ * @author Furkan Gemici
+ * @date   December, 2024
+ * @brief  Implementation file for the ScanDeskewer class.
+ */
+
+#include "ScanDeskewer.h"
+#include "SimdConfig.h"
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+const double ScanDeskewer::MAX_POLYNOMIAL_TURN = 0.5;
+
+namespace {
+    double monotonicSeconds() {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    /**
+     * @brief Returns the heading change from `from` to `to` in radians, in [-pi, pi].
+     */
+    double headingDelta(double fromDeg, double toDeg) {
+        double delta = std::fmod(toDeg - fromDeg, 360.0);
+        if (delta > 180.0) {
+            delta -= 360.0;
+        }
+        else if (delta < -180.0) {
+            delta += 360.0;
+        }
+        return delta * M_PI / 180.0;
+    }
+}
+
+/**
+ * @brief Constructor for ScanDeskewer.
+ */
+ScanDeskewer::ScanDeskewer(RobotControler* ctrl, LidarSensor* sensor)
+    : controller(ctrl), lidar(sensor), startTime(0.0), endTime(0.0) {
+}
+
+/**
+ * @brief Acquires a scan bracketed by two pose samples.
+ *
+ * @throw std::runtime_error If the controller or the sensor is not set.
+ */
+void ScanDeskewer::captureScan() {
+    if (!controller || !lidar) {
+        throw std::runtime_error("ScanDeskewer needs a controller and a sensor.");
+    }
+    startTime = monotonicSeconds();
+    startPose = controller->getPose();
+    lidar->update();
+    endPose = controller->getPose();
+    endTime = monotonicSeconds();
+}
+
+/**
+ * @brief Projects the captured scan into the world frame with per-beam poses.
+ */
+void ScanDeskewer::deskew(PointBatch& out) const {
+    if (!lidar) {
+        throw std::runtime_error("ScanDeskewer needs a sensor.");
+    }
+    deskew(lidar->getRangeData(), lidar->getCosTable(), lidar->getSinTable(), lidar->getRangeNumber(),
+        startPose, endPose, out);
+}
+
+/**
+ * @brief Returns the interpolated pose at a fraction of the scan.
+ */
+Pose ScanDeskewer::interpolatePose(double fraction) const {
+    Pose start(startPose);
+    Pose end(endPose);
+    double th = start.getTh() + fraction * headingDelta(start.getTh(), end.getTh()) * 180.0 / M_PI;
+    return Pose(start.getX() + fraction * (end.getX() - start.getX()),
+        start.getY() + fraction * (end.getY() - start.getY()), th);
+}
+
+Pose ScanDeskewer::getStartPose() const {
+    return startPose;
+}
+
+Pose ScanDeskewer::getEndPose() const {
+    return endPose;
+}
+
+double ScanDeskewer::getScanDuration() const {
+    return endTime - startTime;
+}
+
+/**
+ * @brief Projects a scan into the world frame with per-beam interpolated poses.
+ *
+ * For beam i at fraction t = i / (count - 1) with heading change u = t * dth:
+ *   cos(th0 + u) = cos(th0) cos(u) - sin(th0) sin(u)
+ *   sin(th0 + u) = sin(th0) cos(u) + cos(th0) sin(u)
+ * where cos(u) and sin(u) come from Taylor polynomials (error below 3e-5 for
+ * |u| <= MAX_POLYNOMIAL_TURN).
+ */
+void ScanDeskewer::deskew(const float* ranges, const float* cosTable, const float* sinTable,
+    int count, Pose start, Pose end, PointBatch& out) {
+    out.resize(count);
+    float* xs = out.getX();
+    float* ys = out.getY();
+    if (count == 0) {
+        return;
+    }
+
+    const double th0 = start.getTh() * M_PI / 180.0;
+    const double dth = headingDelta(start.getTh(), end.getTh());
+    const float x0 = static_cast<float>(start.getX());
+    const float y0 = static_cast<float>(start.getY());
+    const float dx = static_cast<float>(end.getX() - start.getX());
+    const float dy = static_cast<float>(end.getY() - start.getY());
+    const float c0 = static_cast<float>(std::cos(th0));
+    const float s0 = static_cast<float>(std::sin(th0));
+    const float turn = static_cast<float>(dth);
+    const float step = count > 1 ? 1.0f / (count - 1) : 0.0f;
+
+    int i = 0;
+    if (std::fabs(dth) <= MAX_POLYNOMIAL_TURN) {
+#if defined(ROBOT_SIMD_AVX2)
+        {
+            const __m256 x08 = _mm256_set1_ps(x0), y08 = _mm256_set1_ps(y0);
+            const __m256 dx8 = _mm256_set1_ps(dx), dy8 = _mm256_set1_ps(dy);
+            const __m256 c08 = _mm256_set1_ps(c0), s08 = _mm256_set1_ps(s0);
+            const __m256 turn8 = _mm256_set1_ps(turn), step8 = _mm256_set1_ps(step);
+            const __m256 one = _mm256_set1_ps(1.0f);
+            const __m256 half = _mm256_set1_ps(0.5f), c24 = _mm256_set1_ps(1.0f / 24.0f);
+            const __m256 c6 = _mm256_set1_ps(1.0f / 6.0f), c120 = _mm256_set1_ps(1.0f / 120.0f);
+            __m256 index = _mm256_setr_ps(0, 1, 2, 3, 4, 5, 6, 7);
+            const __m256 eight = _mm256_set1_ps(8.0f);
+            for (; i + 8 <= count; i += 8) {
+                __m256 t = _mm256_mul_ps(index, step8);
+                __m256 u = _mm256_mul_ps(t, turn8);
+                __m256 u2 = _mm256_mul_ps(u, u);
+                __m256 cu = _mm256_add_ps(one, _mm256_mul_ps(u2, _mm256_sub_ps(_mm256_mul_ps(u2, c24), half)));
+                __m256 su = _mm256_mul_ps(u, _mm256_add_ps(one, _mm256_mul_ps(u2, _mm256_sub_ps(_mm256_mul_ps(u2, c120), c6))));
+                __m256 ch = _mm256_sub_ps(_mm256_mul_ps(c08, cu), _mm256_mul_ps(s08, su));
+                __m256 sh = _mm256_add_ps(_mm256_mul_ps(s08, cu), _mm256_mul_ps(c08, su));
+
+                __m256 r = _mm256_loadu_ps(ranges + i);
+                __m256 lx = _mm256_mul_ps(r, _mm256_loadu_ps(cosTable + i));
+                __m256 ly = _mm256_mul_ps(r, _mm256_loadu_ps(sinTable + i));
+                __m256 ox = _mm256_add_ps(x08, _mm256_mul_ps(t, dx8));
+                __m256 oy = _mm256_add_ps(y08, _mm256_mul_ps(t, dy8));
+                _mm256_storeu_ps(xs + i, _mm256_add_ps(ox, _mm256_sub_ps(_mm256_mul_ps(lx, ch), _mm256_mul_ps(ly, sh))));
+                _mm256_storeu_ps(ys + i, _mm256_add_ps(oy, _mm256_add_ps(_mm256_mul_ps(lx, sh), _mm256_mul_ps(ly, ch))));
+                index = _mm256_add_ps(index, eight);
+            }
+        }
+#endif
+#if defined(ROBOT_SIMD_SSE2)
+        {
+            const __m128 x04 = _mm_set1_ps(x0), y04 = _mm_set1_ps(y0);
+            const __m128 dx4 = _mm_set1_ps(dx), dy4 = _mm_set1_ps(dy);
+            const __m128 c04 = _mm_set1_ps(c0), s04 = _mm_set1_ps(s0);
+            const __m128 turn4 = _mm_set1_ps(turn), step4 = _mm_set1_ps(step);
+            const __m128 one = _mm_set1_ps(1.0f);
+            const __m128 half = _mm_set1_ps(0.5f), c24 = _mm_set1_ps(1.0f / 24.0f);
+            const __m128 c6 = _mm_set1_ps(1.0f / 6.0f), c120 = _mm_set1_ps(1.0f / 120.0f);
+            __m128 index = _mm_setr_ps(static_cast<float>(i), static_cast<float>(i + 1),
+                static_cast<float>(i + 2), static_cast<float>(i + 3));
+            const __m128 four = _mm_set1_ps(4.0f);
+            for (; i + 4 <= count; i += 4) {
+                __m128 t = _mm_mul_ps(index, step4);
+                __m128 u = _mm_mul_ps(t, turn4);
+                __m128 u2 = _mm_mul_ps(u, u);
+                __m128 cu = _mm_add_ps(one, _mm_mul_ps(u2, _mm_sub_ps(_mm_mul_ps(u2, c24), half)));
+                __m128 su = _mm_mul_ps(u, _mm_add_ps(one, _mm_mul_ps(u2, _mm_sub_ps(_mm_mul_ps(u2, c120), c6))));
+                __m128 ch = _mm_sub_ps(_mm_mul_ps(c04, cu), _mm_mul_ps(s04, su));
+                __m128 sh = _mm_add_ps(_mm_mul_ps(s04, cu), _mm_mul_ps(c04, su));
+
+                __m128 r = _mm_loadu_ps(ranges + i);
+                __m128 lx = _mm_mul_ps(r, _mm_loadu_ps(cosTable + i));
+                __m128 ly = _mm_mul_ps(r, _mm_loadu_ps(sinTable + i));
+                __m128 ox = _mm_add_ps(x04, _mm_mul_ps(t, dx4));
+                __m128 oy = _mm_add_ps(y04, _mm_mul_ps(t, dy4));
+                _mm_storeu_ps(xs + i, _mm_add_ps(ox, _mm_sub_ps(_mm_mul_ps(lx, ch), _mm_mul_ps(ly, sh))));
+                _mm_storeu_ps(ys + i, _mm_add_ps(oy, _mm_add_ps(_mm_mul_ps(lx, sh), _mm_mul_ps(ly, ch))));
+                index = _mm_add_ps(index, four);
+            }
+        }
+#endif
+        for (; i < count; ++i) {
+            float t = i * step;
+            float u = t * turn;
+            float u2 = u * u;
+            float cu = 1.0f + u2 * (u2 / 24.0f - 0.5f);
+            float su = u * (1.0f + u2 * (u2 / 120.0f - 1.0f / 6.0f));
+            float ch = c0 * cu - s0 * su;
+            float sh = s0 * cu + c0 * su;
+            float lx = ranges[i] * cosTable[i];
+            float ly = ranges[i] * sinTable[i];
+            xs[i] = x0 + t * dx + (lx * ch - ly * sh);
+            ys[i] = y0 + t * dy + (lx * sh + ly * ch);
+        }
+        return;
+    }
+
+    for (; i < count; ++i) {
+        float t = i * step;
+        double heading = th0 + t * dth;
+        float ch = static_cast<float>(std::cos(heading));
+        float sh = static_cast<float>(std::sin(heading));
+        float lx = ranges[i] * cosTable[i];
+        float ly = ranges[i] * sinTable[i];
+        xs[i] = x0 + t * dx + (lx * ch - ly * sh);
+        ys[i] = y0 + t * dy + (lx * sh + ly * ch);
+    }
+}
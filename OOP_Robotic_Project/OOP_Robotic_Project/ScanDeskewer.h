@@ -0,0 +1,95 @@
+/**
+ * @file   ScanDeskewer.h
+ * @author Furkan Gemici
+ * @date   December, 2024
+ * @brief  Header file for the ScanDeskewer class.
+ *
+ * This file contains the definition of the ScanDeskewer class, which removes
+ * the distortion caused by robot motion during a Lidar scan.
+ */
+
+#pragma once
+
+#include "LidarSensor.h"
+#include "RobotControler.h"
+#include "PointBatch.h"
+#include "Pose.h"
+
+ /**
+  * @class ScanDeskewer
+  * @brief Motion-compensated projection of Lidar scans.
+  *
+  * The robot pose is sampled right before and right after a scan. Every beam is
+  * assumed to be taken at a time proportional to its index, so its pose is
+  * linearly interpolated between the two samples (heading along the shortest
+  * arc) and the beam is transformed with its own pose instead of a single pose
+  * for the whole scan.
+  *
+  * The rotation for each beam is obtained from the start heading and a short
+  * polynomial for the small heading change, so the whole scan is transformed
+  * in one vectorized pass without trigonometric calls. Heading changes above
+  * MAX_POLYNOMIAL_TURN during one scan use the exact scalar path.
+  */
+class ScanDeskewer {
+private:
+    RobotControler* controller; /*!< Controller used to sample the robot pose. */
+    LidarSensor* lidar;         /*!< Sensor providing the scans. */
+    Pose startPose;             /*!< Pose sampled right before the scan. */
+    Pose endPose;               /*!< Pose sampled right after the scan. */
+    double startTime;           /*!< Time of the start pose sample (seconds). */
+    double endTime;             /*!< Time of the end pose sample (seconds). */
+
+public:
+    /*! Largest heading change per scan (radians) handled by the polynomial path. */
+    static const double MAX_POLYNOMIAL_TURN;
+
+    //! Constructor
+    /*!
+     * @param ctrl A pointer to a RobotControler used to sample the robot pose.
+     * @param sensor A pointer to the LidarSensor providing the scans.
+     */
+    ScanDeskewer(RobotControler* ctrl, LidarSensor* sensor);
+
+    //! Acquires a scan bracketed by two pose samples
+    /*!
+     * Samples the pose, updates the Lidar and samples the pose again. The
+     * sensor must be in synchronous mode (no background acquisition).
+     * @throw std::runtime_error If the controller or the sensor is not set.
+     */
+    void captureScan();
+
+    //! Projects the captured scan into the world frame with per-beam poses
+    /*!
+     * @param out Batch receiving one point per beam.
+     */
+    void deskew(PointBatch& out) const;
+
+    //! Returns the interpolated pose at a fraction of the scan
+    /*!
+     * @param fraction 0 for the first beam, 1 for the last beam.
+     * @return The interpolated pose.
+     */
+    Pose interpolatePose(double fraction) const;
+
+    //! Returns the pose sampled right before the scan
+    Pose getStartPose() const;
+
+    //! Returns the pose sampled right after the scan
+    Pose getEndPose() const;
+
+    //! Returns the time between the two pose samples (seconds)
+    double getScanDuration() const;
+
+    //! Projects a scan into the world frame with per-beam interpolated poses
+    /*!
+     * @param ranges Range values of the scan.
+     * @param cosTable Cosine of each beam angle.
+     * @param sinTable Sine of each beam angle.
+     * @param count Number of beams.
+     * @param start Pose of the sensor at the first beam.
+     * @param end Pose of the sensor at the last beam.
+     * @param out Batch receiving one point per beam. Resized to `count`.
+     */
+    static void deskew(const float* ranges, const float* cosTable, const float* sinTable,
+        int count, Pose start, Pose end, PointBatch& out);
+};
@@ -0,0 +1,212 @@
+/**
+ * @file   ScanFilter.cpp
+ * @author Furkan Gemici
+ * @date   December, 2024
+ * @brief  Implementation file for the Lidar scan filters.
+ */
+
+#include "ScanFilter.h"
+#include "AlignedMemory.h"
+#include "SimdConfig.h"
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+    /**
+     * @brief Grows an aligned float buffer if it is smaller than the request.
+     */
+    void ensureCapacity(float*& buffer, int& capacity, int required) {
+        if (required > capacity) {
+            alignedFree(buffer);
+            buffer = alignedAllocate<float>(required);
+            capacity = required;
+        }
+    }
+
+    inline bool isNaN(float value) {
+        return value != value;
+    }
+}
+
+/**
+ * @brief Constructor for RangeClampFilter.
+ */
+RangeClampFilter::RangeClampFilter(float minimum, float maximum)
+    : minRange(minimum), maxRange(maximum) {
+}
+
+/**
+ * @brief Marks ranges outside [minRange, maxRange] as invalid.
+ */
+int RangeClampFilter::apply(float* ranges, int count) {
+    int i = 0;
+#if defined(ROBOT_SIMD_SSE2)
+    const __m128 lo = _mm_set1_ps(minRange);
+    const __m128 hi = _mm_set1_ps(maxRange);
+    const __m128 invalid = _mm_set1_ps(INVALID_RANGE);
+    for (; i + 4 <= count; i += 4) {
+        __m128 r = _mm_loadu_ps(ranges + i);
+        __m128 keep = _mm_and_ps(_mm_cmpge_ps(r, lo), _mm_cmple_ps(r, hi));
+        _mm_storeu_ps(ranges + i, _mm_or_ps(_mm_and_ps(keep, r), _mm_andnot_ps(keep, invalid)));
+    }
+#endif
+    for (; i < count; ++i) {
+        if (!(ranges[i] >= minRange && ranges[i] <= maxRange)) {
+            ranges[i] = INVALID_RANGE;
+        }
+    }
+    return count;
+}
+
+/**
+ * @brief Constructor for MedianFilter.
+ */
+MedianFilter::MedianFilter() : scratch(nullptr), capacity(0) {
+}
+
+/**
+ * @brief Destructor for MedianFilter.
+ */
+MedianFilter::~MedianFilter() {
+    alignedFree(scratch);
+}
+
+/**
+ * @brief Replaces each beam by the median of itself and its neighbours.
+ *
+ * The median of three is max(min(a, b), min(max(a, b), c)), which needs no
+ * branches. Windows containing an invalid beam keep the original value.
+ */
+int MedianFilter::apply(float* ranges, int count) {
+    if (count < 3) {
+        return count;
+    }
+    ensureCapacity(scratch, capacity, count);
+    std::memcpy(scratch, ranges, count * sizeof(float));
+
+    int i = 1;
+#if defined(ROBOT_SIMD_SSE2)
+    for (; i + 4 <= count - 1; i += 4) {
+        __m128 a = _mm_loadu_ps(scratch + i - 1);
+        __m128 b = _mm_loadu_ps(scratch + i);
+        __m128 c = _mm_loadu_ps(scratch + i + 1);
+        __m128 median = _mm_max_ps(_mm_min_ps(a, b), _mm_min_ps(_mm_max_ps(a, b), c));
+        __m128 ordered = _mm_and_ps(_mm_cmpord_ps(a, b), _mm_cmpord_ps(b, c));
+        _mm_storeu_ps(ranges + i, _mm_or_ps(_mm_and_ps(ordered, median), _mm_andnot_ps(ordered, b)));
+    }
+#endif
+    for (; i < count - 1; ++i) {
+        float a = scratch[i - 1];
+        float b = scratch[i];
+        float c = scratch[i + 1];
+        if (isNaN(a) || isNaN(b) || isNaN(c)) {
+            continue;
+        }
+        float low = a < b ? a : b;
+        float high = a < b ? b : a;
+        float upper = high < c ? high : c;
+        ranges[i] = low > upper ? low : upper;
+    }
+    return count;
+}
+
+/**
+ * @brief Constructor for DownsampleFilter.
+ *
+ * @throw std::invalid_argument If decimation is smaller than 1.
+ */
+DownsampleFilter::DownsampleFilter(int decimation) : factor(decimation) {
+    if (factor < 1) {
+        throw std::invalid_argument("Downsampling factor must be at least 1.");
+    }
+}
+
+/**
+ * @brief Reduces every group of beams to its smallest valid range.
+ *
+ * Output beam j only depends on input beams j*factor and later, so the scan
+ * can be rewritten in place. A trailing partial group is dropped.
+ */
+int DownsampleFilter::apply(float* ranges, int count) {
+    if (factor == 1) {
+        return count;
+    }
+    const int outCount = count / factor;
+    for (int j = 0; j < outCount; ++j) {
+        const float* group = ranges + j * factor;
+        float best = INVALID_RANGE;
+        for (int k = 0; k < factor; ++k) {
+            if (!isNaN(group[k]) && (isNaN(best) || group[k] < best)) {
+                best = group[k];
+            }
+        }
+        ranges[j] = best;
+    }
+    return outCount;
+}
+
+int DownsampleFilter::getDecimation() const {
+    return factor;
+}
+
+/**
+ * @brief Constructor for TemporalAverageFilter.
+ *
+ * @throw std::invalid_argument If the weight is out of range.
+ */
+TemporalAverageFilter::TemporalAverageFilter(float currentWeight)
+    : weight(currentWeight), state(nullptr), capacity(0), stateCount(0) {
+    if (!(weight > 0.0f && weight <= 1.0f)) {
+        throw std::invalid_argument("Temporal weight must be in (0, 1].");
+    }
+}
+
+/**
+ * @brief Destructor for TemporalAverageFilter.
+ */
+TemporalAverageFilter::~TemporalAverageFilter() {
+    alignedFree(state);
+}
+
+/**
+ * @brief Blends the scan with the average of the previous scans.
+ *
+ * The first scan, or a scan with a different beam count, restarts the average.
+ */
+int TemporalAverageFilter::apply(float* ranges, int count) {
+    ensureCapacity(state, capacity, count);
+    if (stateCount != count) {
+        std::memcpy(state, ranges, count * sizeof(float));
+        stateCount = count;
+        return count;
+    }
+
+    int i = 0;
+#if defined(ROBOT_SIMD_SSE2)
+    const __m128 w = _mm_set1_ps(weight);
+    for (; i + 4 <= count; i += 4) {
+        __m128 current = _mm_loadu_ps(ranges + i);
+        __m128 previous = _mm_load_ps(state + i);
+        __m128 average = _mm_add_ps(previous, _mm_mul_ps(w, _mm_sub_ps(current, previous)));
+        __m128 ordered = _mm_cmpord_ps(current, previous);
+        __m128 result = _mm_or_ps(_mm_and_ps(ordered, average), _mm_andnot_ps(ordered, current));
+        _mm_storeu_ps(ranges + i, result);
+        _mm_store_ps(state + i, result);
+    }
+#endif
+    for (; i < count; ++i) {
+        float current = ranges[i];
+        float previous = state[i];
+        float result = (isNaN(current) || isNaN(previous)) ? current : previous + weight * (current - previous);
+        ranges[i] = result;
+        state[i] = result;
+    }
+    return count;
+}
+
+/**
+ * @brief Clears the average so the next scan restarts it.
+ */
+void TemporalAverageFilter::reset() {
+    stateCount = 0;
+}
@@ -0,0 +1,150 @@
+/**
+ * @file   ScanFilter.h
+ * @author Furkan Gemici
+ * @date   December, 2024
+ * @brief  Header file for the Lidar scan filters.
+ *
+ * This file contains the ScanFilter interface and the filters that can be
+ * chained with ScanFilterChain: range clamping, median spike removal, angular
+ * downsampling and temporal averaging.
+ */
+
+#pragma once
+
+#include <limits>
+
+/*! Value written into beams that a filter marks as invalid. */
+const float INVALID_RANGE = std::numeric_limits<float>::quiet_NaN();
+
+ /**
+  * @class ScanFilter
+  * @brief Interface of an in-place Lidar scan filter.
+  *
+  * A filter rewrites the ranges in place and returns the number of ranges left,
+  * which is smaller than the input only for decimating filters. Filters must not
+  * allocate once they have seen a scan of the current size.
+  */
+class ScanFilter {
+public:
+    //! Virtual destructor
+    virtual ~ScanFilter() {}
+
+    //! Filters the ranges in place
+    /*!
+     * @param ranges Range values, rewritten by the filter.
+     * @param count Number of range values.
+     * @return Number of range values after filtering.
+     */
+    virtual int apply(float* ranges, int count) = 0;
+
+    //! Returns how many input beams are merged into one output beam
+    virtual int getDecimation() const { return 1; }
+
+    //! Clears any state carried between scans
+    virtual void reset() {}
+};
+
+ /**
+  * @class RangeClampFilter
+  * @brief Marks ranges outside [minRange, maxRange] as INVALID_RANGE.
+  *
+  * Zero returns, max-range returns and non-finite values are masked so that
+  * later stages and consumers can skip them.
+  */
+class RangeClampFilter : public ScanFilter {
+private:
+    float minRange;  /*!< Smallest accepted range. */
+    float maxRange;  /*!< Largest accepted range. */
+
+public:
+    //! Constructor
+    /*!
+     * @param minimum Smallest accepted range.
+     * @param maximum Largest accepted range.
+     */
+    RangeClampFilter(float minimum, float maximum);
+
+    int apply(float* ranges, int count) override;
+};
+
+ /**
+  * @class MedianFilter
+  * @brief Removes single-beam spikes with a 3-beam median.
+  *
+  * Each beam is replaced by the median of itself and its two neighbours. Beams
+  * next to an invalid beam, and the first and last beam, are left unchanged.
+  */
+class MedianFilter : public ScanFilter {
+private:
+    float* scratch;   /*!< Copy of the input scan. */
+    int capacity;     /*!< Number of floats allocated for the copy. */
+
+public:
+    //! Constructor
+    MedianFilter();
+
+    //! Destructor
+    ~MedianFilter();
+
+    MedianFilter(const MedianFilter&) = delete;
+    MedianFilter& operator=(const MedianFilter&) = delete;
+
+    int apply(float* ranges, int count) override;
+};
+
+ /**
+  * @class DownsampleFilter
+  * @brief Reduces every group of `factor` beams to the smallest valid range.
+  *
+  * Keeping the minimum is conservative for obstacle detection. A group without
+  * any valid beam becomes INVALID_RANGE.
+  */
+class DownsampleFilter : public ScanFilter {
+private:
+    int factor;  /*!< Number of input beams per output beam. */
+
+public:
+    //! Constructor
+    /*!
+     * @param decimation Number of input beams per output beam.
+     * @throw std::invalid_argument If decimation is smaller than 1.
+     */
+    explicit DownsampleFilter(int decimation);
+
+    int apply(float* ranges, int count) override;
+
+    int getDecimation() const override;
+};
+
+ /**
+  * @class TemporalAverageFilter
+  * @brief Exponential moving average of every beam across scans.
+  *
+  * out = previous + weight * (current - previous). A beam invalid in either
+  * scan takes the current value.
+  */
+class TemporalAverageFilter : public ScanFilter {
+private:
+    float weight;   /*!< Weight of the current scan, in (0, 1]. */
+    float* state;   /*!< Average of the previous scans. */
+    int capacity;   /*!< Number of floats allocated for the state. */
+    int stateCount; /*!< Number of beams in the state, 0 after reset. */
+
+public:
+    //! Constructor
+    /*!
+     * @param currentWeight Weight of the current scan, in (0, 1].
+     * @throw std::invalid_argument If the weight is out of range.
+     */
+    explicit TemporalAverageFilter(float currentWeight);
+
+    //! Destructor
+    ~TemporalAverageFilter();
+
+    TemporalAverageFilter(const TemporalAverageFilter&) = delete;
+    TemporalAverageFilter& operator=(const TemporalAverageFilter&) = delete;
+
+    int apply(float* ranges, int count) override;
+
+    void reset() override;
+};
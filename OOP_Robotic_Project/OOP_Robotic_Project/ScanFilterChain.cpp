@@ -0,0 +1,135 @@
+/**
+ * @file   ScanFilterChain.cpp
+ * @author Furkan Gemici
+ * @date   December, 2024
+ * @brief  Implementation file for the ScanFilterChain class.
+ */
+
+#include "ScanFilterChain.h"
+#include "AlignedMemory.h"
+#include "ScanProjector.h"
+#include <cstring>
+#include <stdexcept>
+
+/**
+ * @brief Constructor. Creates an empty chain.
+ */
+ScanFilterChain::ScanFilterChain()
+    : ranges(nullptr), cosTable(nullptr), sinTable(nullptr), capacity(0), count(0), decimation(1) {
+}
+
+/**
+ * @brief Destructor. Frees the buffers.
+ */
+ScanFilterChain::~ScanFilterChain() {
+    alignedFree(ranges);
+    alignedFree(cosTable);
+    alignedFree(sinTable);
+}
+
+/**
+ * @brief Appends a filter stage.
+ *
+ * @param filter The filter to append.
+ * @return A reference to the chain.
+ * @throw std::invalid_argument If filter is null.
+ */
+ScanFilterChain& ScanFilterChain::addFilter(ScanFilter* filter) {
+    if (!filter) {
+        throw std::invalid_argument("Filter must not be null.");
+    }
+    filters.push_back(filter);
+    return *this;
+}
+
+/**
+ * @brief Removes all filter stages.
+ */
+void ScanFilterChain::clearFilters() {
+    filters.clear();
+}
+
+/**
+ * @brief Resets the state of every filter stage.
+ */
+void ScanFilterChain::reset() {
+    for (size_t i = 0; i < filters.size(); ++i) {
+        filters[i]->reset();
+    }
+}
+
+/**
+ * @brief Filters a scan.
+ *
+ * The scan is copied once, then every stage runs in place. Filtered beam j
+ * stands for the input beams [j * decimation, (j + 1) * decimation) and takes
+ * the angle of the middle one.
+ *
+ * @return Number of filtered beams.
+ */
+int ScanFilterChain::process(const float* input, const float* inputCos, const float* inputSin, int inputCount) {
+    if (inputCount > capacity) {
+        alignedFree(ranges);
+        alignedFree(cosTable);
+        alignedFree(sinTable);
+        ranges = alignedAllocate<float>(inputCount);
+        cosTable = alignedAllocate<float>(inputCount);
+        sinTable = alignedAllocate<float>(inputCount);
+        capacity = inputCount;
+    }
+
+    std::memcpy(ranges, input, inputCount * sizeof(float));
+    count = inputCount;
+    decimation = 1;
+    for (size_t i = 0; i < filters.size(); ++i) {
+        count = filters[i]->apply(ranges, count);
+        decimation *= filters[i]->getDecimation();
+    }
+
+    if (decimation == 1) {
+        std::memcpy(cosTable, inputCos, count * sizeof(float));
+        std::memcpy(sinTable, inputSin, count * sizeof(float));
+    }
+    else {
+        for (int j = 0; j < count; ++j) {
+            int source = j * decimation + decimation / 2;
+            cosTable[j] = inputCos[source];
+            sinTable[j] = inputSin[source];
+        }
+    }
+    return count;
+}
+
+const float* ScanFilterChain::getRanges() const {
+    return ranges;
+}
+
+const float* ScanFilterChain::getCosTable() const {
+    return cosTable;
+}
+
+const float* ScanFilterChain::getSinTable() const {
+    return sinTable;
+}
+
+int ScanFilterChain::getCount() const {
+    return count;
+}
+
+int ScanFilterChain::getDecimation() const {
+    return decimation;
+}
+
+/**
+ * @brief Converts the filtered scan into points in the sensor frame.
+ */
+void ScanFilterChain::projectScan(PointBatch& out) const {
+    ScanProjector::project(ranges, cosTable, sinTable, count, out);
+}
+
+/**
+ * @brief Converts the filtered scan into points in the world frame.
+ */
+void ScanFilterChain::projectScan(PointBatch& out, Pose pose) const {
+    ScanProjector::project(ranges, cosTable, sinTable, count, pose.getX(), pose.getY(), pose.getTh(), out);
+}
@@ -0,0 +1,104 @@
+/**
+ * @file   ScanFilterChain.h
+ * @author Furkan Gemici
+ * @date   December, 2024
+ * @brief  Header file for the ScanFilterChain class.
+ *
+ * This file contains the definition of the ScanFilterChain class, which runs a
+ * sequence of ScanFilter stages over a Lidar scan.
+ */
+
+#pragma once
+
+#include "ScanFilter.h"
+#include "PointBatch.h"
+#include "Pose.h"
+#include <vector>
+
+ /**
+  * @class ScanFilterChain
+  * @brief Runs a sequence of scan filters on a preallocated copy of a scan.
+  *
+  * The chain copies the input scan once into its own aligned buffer and lets
+  * every stage rewrite it in place. When a stage downsamples the scan, the
+  * chain also keeps the matching cosine and sine of each remaining beam so the
+  * filtered scan can be projected directly. Buffers only grow, so a chain
+  * reused across scans does not allocate.
+  *
+  * The chain does not own its filters.
+  */
+class ScanFilterChain {
+private:
+    std::vector<ScanFilter*> filters; /*!< Filter stages, applied in order. */
+    float* ranges;     /*!< Filtered ranges. */
+    float* cosTable;   /*!< Cosine of each filtered beam. */
+    float* sinTable;   /*!< Sine of each filtered beam. */
+    int capacity;      /*!< Number of floats allocated for each buffer. */
+    int count;         /*!< Number of filtered ranges. */
+    int decimation;    /*!< Input beams per filtered beam. */
+
+public:
+    //! Constructor
+    ScanFilterChain();
+
+    //! Destructor
+    /*!
+     * Frees the buffers. The filters are not deleted.
+     */
+    ~ScanFilterChain();
+
+    ScanFilterChain(const ScanFilterChain&) = delete;
+    ScanFilterChain& operator=(const ScanFilterChain&) = delete;
+
+    //! Appends a filter stage
+    /*!
+     * @param filter The filter to append. Must outlive the chain.
+     * @return A reference to the chain, so stages can be added fluently.
+     * @throw std::invalid_argument If filter is null.
+     */
+    ScanFilterChain& addFilter(ScanFilter* filter);
+
+    //! Removes all filter stages
+    void clearFilters();
+
+    //! Resets the state of every filter stage
+    void reset();
+
+    //! Filters a scan
+    /*!
+     * @param input Range values of the scan.
+     * @param inputCos Cosine of each input beam angle.
+     * @param inputSin Sine of each input beam angle.
+     * @param inputCount Number of beams.
+     * @return Number of filtered beams.
+     */
+    int process(const float* input, const float* inputCos, const float* inputSin, int inputCount);
+
+    //! Returns the filtered ranges
+    const float* getRanges() const;
+
+    //! Returns the cosine of each filtered beam angle
+    const float* getCosTable() const;
+
+    //! Returns the sine of each filtered beam angle
+    const float* getSinTable() const;
+
+    //! Returns the number of filtered ranges
+    int getCount() const;
+
+    //! Returns the number of input beams merged into one filtered beam
+    int getDecimation() const;
+
+    //! Converts the filtered scan into points in the sensor frame
+    /*!
+     * @param out Batch receiving one point per filtered beam.
+     */
+    void projectScan(PointBatch& out) const;
+
+    //! Converts the filtered scan into points in the world frame
+    /*!
+     * @param out Batch receiving one point per filtered beam.
+     * @param pose Pose of the sensor in the world frame.
+     */
+    void projectScan(PointBatch& out, Pose pose) const;
+};
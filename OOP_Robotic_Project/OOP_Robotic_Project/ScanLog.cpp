@@ -0,0 +1,413 @@
+/**
+ * @file   ScanLog.cpp
+ * @author Furkan Gemici
+ * @date   December, 2024
+ * @brief  Implementation file for the binary Lidar scan log writer and reader.
+ */
+
+#include "ScanLog.h"
+#include "Checksum.h"
+#include "RangeCodec.h"
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+    const unsigned char FILE_MAGIC[4] = { 'R', 'L', 'O', 'G' };
+    const unsigned short FORMAT_VERSION = 1;
+    const size_t FILE_HEADER_SIZE = 20;
+    const size_t CHUNK_HEADER_SIZE = 12;
+    const unsigned int MAX_CHUNK_SIZE = 1u << 28;
+
+    void putU16(unsigned char* out, unsigned short value) {
+        out[0] = static_cast<unsigned char>(value);
+        out[1] = static_cast<unsigned char>(value >> 8);
+    }
+
+    void putU32(unsigned char* out, unsigned int value) {
+        for (int i = 0; i < 4; ++i) {
+            out[i] = static_cast<unsigned char>(value >> (8 * i));
+        }
+    }
+
+    unsigned int getU32(const unsigned char* in) {
+        return in[0] | (in[1] << 8) | (in[2] << 16) | (static_cast<unsigned int>(in[3]) << 24);
+    }
+
+    void putF32(unsigned char* out, float value) {
+        unsigned int bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        putU32(out, bits);
+    }
+
+    float getF32(const unsigned char* in) {
+        unsigned int bits = getU32(in);
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    void putVarint(std::vector<unsigned char>& out, unsigned long long value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<unsigned char>(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<unsigned char>(value));
+    }
+
+    bool getVarint(const std::vector<unsigned char>& in, size_t& position, unsigned long long& value) {
+        value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (position >= in.size()) {
+                return false;
+            }
+            unsigned char byte = in[position++];
+            value |= static_cast<unsigned long long>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    unsigned long long zigzag(long long value) {
+        return (static_cast<unsigned long long>(value) << 1) ^ static_cast<unsigned long long>(value >> 63);
+    }
+
+    long long unzigzag(unsigned long long value) {
+        return static_cast<long long>(value >> 1) ^ -static_cast<long long>(value & 1);
+    }
+}
+
+const int ScanLogWriter::MAX_BEAM_COUNT;
+
+/**
+ * @brief Constructor for ScanLogWriter.
+ */
+ScanLogWriter::ScanLogWriter()
+    : beamCount(0), scansPerChunk(0), chunkScans(0), previousTime(0), pendingFull(false),
+    stopping(false), bytesWritten(0), failed(false) {
+}
+
+/**
+ * @brief Destructor. Closes the log if it is still open.
+ */
+ScanLogWriter::~ScanLogWriter() {
+    close();
+}
+
+/**
+ * @brief Creates a log file, writes its header and starts the writer thread.
+ *
+ * Both chunk buffers are reserved for a full chunk of worst-case scans, so no
+ * allocation happens while logging.
+ */
+bool ScanLogWriter::open(const std::string& filename, int beams, double fov, double startAngle, int chunkSize) {
+    close();
+    if (beams <= 0 || beams > MAX_BEAM_COUNT || chunkSize <= 0) {
+        return false;
+    }
+    file.open(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    beamCount = beams;
+    scansPerChunk = chunkSize;
+    chunkScans = 0;
+    previous.assign(beamCount, 0);
+
+    unsigned char header[FILE_HEADER_SIZE];
+    std::memcpy(header, FILE_MAGIC, 4);
+    putU16(header + 4, FORMAT_VERSION);
+    putU16(header + 6, 0);
+    putU32(header + 8, static_cast<unsigned int>(beamCount));
+    putF32(header + 12, static_cast<float>(fov));
+    putF32(header + 16, static_cast<float>(startAngle));
+    if (!file.write(reinterpret_cast<const char*>(header), FILE_HEADER_SIZE)) {
+        file.close();
+        return false;
+    }
+
+    size_t worstCase = CHUNK_HEADER_SIZE + static_cast<size_t>(scansPerChunk) * (10 + 3 * beamCount);
+    active.reserve(worstCase);
+    pending.reserve(worstCase);
+    active.assign(CHUNK_HEADER_SIZE, 0);
+    pending.clear();
+
+    pendingFull = false;
+    stopping = false;
+    failed = false;
+    bytesWritten = FILE_HEADER_SIZE;
+    writer = std::thread(&ScanLogWriter::run, this);
+    return true;
+}
+
+/**
+ * @brief Appends a scan to the log.
+ *
+ * @param ranges Range values in metres.
+ * @param timestamp Acquisition time in seconds.
+ * @throw std::runtime_error If the log is not open or a write has failed.
+ */
+void ScanLogWriter::writeScan(const float* ranges, double timestamp) {
+    if (!writer.joinable()) {
+        throw std::runtime_error("Scan log is not open.");
+    }
+    if (failed) {
+        throw std::runtime_error("Scan log could not be written.");
+    }
+    long long micros = static_cast<long long>(std::floor(timestamp * 1e6 + 0.5));
+    const bool keyframe = chunkScans == 0;
+
+    putVarint(active, zigzag(keyframe ? micros : micros - previousTime));
+    for (int i = 0; i < beamCount; ++i) {
+        unsigned short value = RangeCodec<unsigned short>::fromMetres(ranges[i]);
+        long long delta = keyframe ? value : static_cast<long long>(value) - previous[i];
+        putVarint(active, zigzag(delta));
+        previous[i] = value;
+    }
+    previousTime = micros;
+
+    if (++chunkScans == scansPerChunk) {
+        submitChunk();
+    }
+}
+
+/**
+ * @brief Appends a scan from the acquisition ring to the log.
+ */
+void ScanLogWriter::writeScan(const ScanView& view) {
+    if (view.count != beamCount) {
+        throw std::invalid_argument("Scan beam count does not match the log.");
+    }
+    writeScan(view.ranges, view.timestamp);
+}
+
+/**
+ * @brief Completes the chunk header and hands the chunk to the writer thread.
+ *
+ * Waits only if the previous chunk is still being written.
+ */
+void ScanLogWriter::submitChunk() {
+    unsigned int payloadSize = static_cast<unsigned int>(active.size() - CHUNK_HEADER_SIZE);
+    putU32(&active[0], payloadSize);
+    putU32(&active[4], static_cast<unsigned int>(chunkScans));
+    putU32(&active[8], crc32(&active[CHUNK_HEADER_SIZE], payloadSize));
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait(lock, [this] { return !pendingFull; });
+        active.swap(pending);
+        pendingFull = true;
+    }
+    condition.notify_all();
+
+    active.assign(CHUNK_HEADER_SIZE, 0);
+    chunkScans = 0;
+}
+
+/**
+ * @brief Body of the writer thread. Writes handed-over chunks until stopped.
+ *
+ * The first failed write latches `failed`; later chunks are dropped.
+ */
+void ScanLogWriter::run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        condition.wait(lock, [this] { return pendingFull || stopping; });
+        if (pendingFull) {
+            lock.unlock();
+            const bool written = !failed && file.write(reinterpret_cast<const char*>(pending.data()), pending.size());
+            lock.lock();
+            if (written) {
+                bytesWritten += pending.size();
+            }
+            else {
+                failed = true;
+            }
+            pendingFull = false;
+            condition.notify_all();
+        }
+        else if (stopping) {
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Writes the remaining scans and closes the file.
+ *
+ * Closing flushes the stream, so a failure to flush is reported as well.
+ *
+ * @return false if any write to the file failed since it was opened.
+ */
+bool ScanLogWriter::close() {
+    if (!writer.joinable()) {
+        return !failed;
+    }
+    if (chunkScans > 0) {
+        submitChunk();
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    condition.notify_all();
+    writer.join();
+    file.close();
+    if (!file) {
+        failed = true;
+    }
+    return !failed;
+}
+
+bool ScanLogWriter::isOpen() const {
+    return writer.joinable() && !failed;
+}
+
+unsigned long long ScanLogWriter::getBytesWritten() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return bytesWritten;
+}
+
+/**
+ * @brief Constructor for ScanLogReader.
+ */
+ScanLogReader::ScanLogReader()
+    : beamCount(0), fieldOfView(0.0), startAngle(0.0), position(0), chunkScansLeft(0),
+    firstInChunk(true), previousTime(0), checksumError(false) {
+}
+
+/**
+ * @brief Opens a log file and reads its header.
+ *
+ * @return true if the file is a valid scan log, false otherwise.
+ */
+bool ScanLogReader::open(const std::string& filename) {
+    close();
+    file.open(filename, std::ios::in | std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    unsigned char header[FILE_HEADER_SIZE];
+    if (!file.read(reinterpret_cast<char*>(header), FILE_HEADER_SIZE) ||
+        std::memcmp(header, FILE_MAGIC, 4) != 0 ||
+        (header[4] | (header[5] << 8)) != FORMAT_VERSION) {
+        file.close();
+        return false;
+    }
+    // The header has no checksum, so the beam count is bounded before anything is allocated
+    const unsigned int beams = getU32(header + 8);
+    if (beams == 0 || beams > static_cast<unsigned int>(ScanLogWriter::MAX_BEAM_COUNT)) {
+        file.close();
+        return false;
+    }
+    beamCount = static_cast<int>(beams);
+    fieldOfView = getF32(header + 12);
+    startAngle = getF32(header + 16);
+    previous.assign(beamCount, 0);
+    chunkScansLeft = 0;
+    checksumError = false;
+    return true;
+}
+
+/**
+ * @brief Loads the next chunk whose checksum matches.
+ *
+ * @return false at the end of the file.
+ */
+bool ScanLogReader::loadChunk() {
+    unsigned char header[CHUNK_HEADER_SIZE];
+    while (file.read(reinterpret_cast<char*>(header), CHUNK_HEADER_SIZE)) {
+        unsigned int payloadSize = getU32(header);
+        unsigned int scans = getU32(header + 4);
+        unsigned int checksum = getU32(header + 8);
+        if (payloadSize > MAX_CHUNK_SIZE) {
+            checksumError = true;
+            return false;
+        }
+        chunk.resize(payloadSize);
+        if (payloadSize > 0 && !file.read(reinterpret_cast<char*>(&chunk[0]), payloadSize)) {
+            checksumError = true;
+            return false;
+        }
+        if (crc32(chunk.data(), payloadSize) != checksum) {
+            checksumError = true;
+            continue;
+        }
+        position = 0;
+        chunkScansLeft = static_cast<int>(scans);
+        firstInChunk = true;
+        if (chunkScansLeft > 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Reads the next scan.
+ *
+ * @param ranges Receives the ranges in metres.
+ * @param timestamp Receives the acquisition time in seconds.
+ * @return false at the end of the log.
+ */
+bool ScanLogReader::readScan(float* ranges, double& timestamp) {
+    if (!file.is_open()) {
+        return false;
+    }
+    if (chunkScansLeft == 0 && !loadChunk()) {
+        return false;
+    }
+
+    unsigned long long raw;
+    if (!getVarint(chunk, position, raw)) {
+        checksumError = true;
+        chunkScansLeft = 0;
+        return false;
+    }
+    long long micros = firstInChunk ? unzigzag(raw) : previousTime + unzigzag(raw);
+    for (int i = 0; i < beamCount; ++i) {
+        if (!getVarint(chunk, position, raw)) {
+            checksumError = true;
+            chunkScansLeft = 0;
+            return false;
+        }
+        long long value = firstInChunk ? unzigzag(raw) : previous[i] + unzigzag(raw);
+        previous[i] = static_cast<unsigned short>(value);
+        ranges[i] = static_cast<float>(RangeCodec<unsigned short>::toMetres(previous[i]));
+    }
+    previousTime = micros;
+    firstInChunk = false;
+    --chunkScansLeft;
+    timestamp = micros * 1e-6;
+    return true;
+}
+
+/**
+ * @brief Closes the file.
+ */
+void ScanLogReader::close() {
+    if (file.is_open()) {
+        file.close();
+    }
+    file.clear();
+    chunkScansLeft = 0;
+}
+
+int ScanLogReader::getBeamCount() const {
+    return beamCount;
+}
+
+double ScanLogReader::getFieldOfView() const {
+    return fieldOfView;
+}
+
+double ScanLogReader::getStartAngle() const {
+    return startAngle;
+}
+
+bool ScanLogReader::hasChecksumError() const {
+    return checksumError;
+}
@@ -0,0 +1,182 @@
+/**
+ * @file   ScanLog.h
+ * @author Furkan Gemici
+ * @date   December, 2024
+ * @brief  Header file for the binary Lidar scan log writer and reader.
+ *
+ * File layout (all integers little-endian):
+ *
+ *   File header   "RLOG", u16 version, u16 flags, u32 beam count,
+ *                 f32 field of view, f32 start angle (degrees)
+ *   Chunk         u32 payload size, u32 scan count, u32 CRC-32 of the payload,
+ *                 followed by the payload
+ *   Scan record   varint timestamp (microseconds), then one varint per beam
+ *
+ * Ranges are quantized to millimetres in 16 bits (0 = invalid, 65535 = out of
+ * range). The first scan of a chunk stores its timestamp and ranges as is; the
+ * following scans store the zigzag-encoded difference to the previous scan.
+ * Every chunk can therefore be decoded on its own, and a corrupted chunk only
+ * loses the scans it contains.
+ */
+
+#pragma once
+
+#include "LidarAcquisition.h"
+#include <atomic>
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+ /**
+  * @class ScanLogWriter
+  * @brief Streams Lidar scans into a compact binary log.
+  *
+  * Scans are encoded into an in-memory chunk by the caller. Full chunks are
+  * handed to a background thread that writes them to disk, so writeScan() only
+  * waits for the disk if the previous chunk has not been written yet.
+  *
+  * A failed write (e.g. a full disk) is latched: the log stops writing,
+  * isOpen() turns false and close() reports the failure.
+  */
+class ScanLogWriter {
+public:
+    static const int MAX_BEAM_COUNT = 1 << 16;  /*!< Largest number of beams per scan a log may hold. */
+
+private:
+    std::ofstream file;                    /*!< Output file, used by the writer thread. */
+    int beamCount;                         /*!< Number of beams per scan. */
+    int scansPerChunk;                     /*!< Number of scans collected before a chunk is written. */
+    int chunkScans;                        /*!< Number of scans in the active chunk. */
+    long long previousTime;                /*!< Timestamp of the previous scan in the chunk (microseconds). */
+    std::vector<unsigned short> previous;  /*!< Quantized ranges of the previous scan in the chunk. */
+    std::vector<unsigned char> active;     /*!< Chunk being encoded. */
+    std::vector<unsigned char> pending;    /*!< Chunk waiting for or being written by the writer thread. */
+    bool pendingFull;                      /*!< True while `pending` holds a chunk to write. */
+    bool stopping;                         /*!< Tells the writer thread to exit. */
+    unsigned long long bytesWritten;       /*!< Total number of bytes written to the file. */
+    std::atomic<bool> failed;              /*!< Set once a write to the file fails, until the next open. */
+    std::mutex mutex;                      /*!< Protects pending, pendingFull, stopping and bytesWritten. */
+    std::condition_variable condition;     /*!< Signals chunk hand-over and completion. */
+    std::thread writer;                    /*!< The writer thread. */
+
+    //! Body of the writer thread
+    void run();
+
+    //! Hands the active chunk to the writer thread
+    void submitChunk();
+
+public:
+    //! Constructor
+    ScanLogWriter();
+
+    //! Destructor
+    /*!
+     * Closes the log if it is still open.
+     */
+    ~ScanLogWriter();
+
+    ScanLogWriter(const ScanLogWriter&) = delete;
+    ScanLogWriter& operator=(const ScanLogWriter&) = delete;
+
+    //! Creates a log file and writes its header
+    /*!
+     * @param filename Name of the file to create.
+     * @param beams Number of beams per scan.
+     * @param fov Angular field of view of the scans (degrees).
+     * @param startAngle Angle of the first beam (degrees).
+     * @param chunkSize Number of scans per chunk.
+     * @return true if the file was created, false otherwise (also if `beams`
+     *         is not positive or above ScanLogWriter::MAX_BEAM_COUNT).
+     */
+    bool open(const std::string& filename, int beams, double fov, double startAngle, int chunkSize = 50);
+
+    //! Appends a scan to the log
+    /*!
+     * @param ranges Range values in metres, `beams` of them.
+     * @param timestamp Acquisition time in seconds.
+     * @throw std::runtime_error If the log is not open or a write has failed.
+     */
+    void writeScan(const float* ranges, double timestamp);
+
+    //! Appends a scan from the acquisition ring to the log
+    /*!
+     * @param view The scan to append.
+     * @throw std::runtime_error If the log is not open or a write has failed.
+     */
+    void writeScan(const ScanView& view);
+
+    //! Writes the remaining scans and closes the file
+    /*!
+     * @return false if any write to the file failed since it was opened.
+     */
+    bool close();
+
+    //! Returns true if a log is open and no write to it has failed
+    bool isOpen() const;
+
+    //! Returns the number of bytes written to the file so far
+    unsigned long long getBytesWritten();
+};
+
+ /**
+  * @class ScanLogReader
+  * @brief Reads scans back from a binary log written by ScanLogWriter.
+  *
+  * Chunks are read and verified one at a time. A chunk whose checksum does not
+  * match is skipped and reported by hasChecksumError().
+  */
+class ScanLogReader {
+private:
+    std::ifstream file;                    /*!< Input file. */
+    int beamCount;                         /*!< Number of beams per scan. */
+    double fieldOfView;                    /*!< Angular field of view (degrees). */
+    double startAngle;                     /*!< Angle of the first beam (degrees). */
+    std::vector<unsigned char> chunk;      /*!< Payload of the current chunk. */
+    size_t position;                       /*!< Read position within the chunk. */
+    int chunkScansLeft;                    /*!< Number of scans left in the current chunk. */
+    bool firstInChunk;                     /*!< True before the first scan of a chunk is decoded. */
+    long long previousTime;                /*!< Timestamp of the previous scan (microseconds). */
+    std::vector<unsigned short> previous;  /*!< Quantized ranges of the previous scan. */
+    bool checksumError;                    /*!< True if a corrupted chunk was skipped. */
+
+    //! Loads the next valid chunk
+    bool loadChunk();
+
+public:
+    //! Constructor
+    ScanLogReader();
+
+    //! Opens a log file and reads its header
+    /*!
+     * @param filename Name of the file to open.
+     * @return true if the file is a valid scan log, false otherwise (also if
+     *         the header's beam count is not in [1, ScanLogWriter::MAX_BEAM_COUNT]).
+     */
+    bool open(const std::string& filename);
+
+    //! Reads the next scan
+    /*!
+     * @param ranges Receives `getBeamCount()` ranges in metres (NaN for invalid beams).
+     * @param timestamp Receives the acquisition time in seconds.
+     * @return false at the end of the log.
+     */
+    bool readScan(float* ranges, double& timestamp);
+
+    //! Closes the file
+    void close();
+
+    //! Returns the number of beams per scan
+    int getBeamCount() const;
+
+    //! Returns the angular field of view (degrees)
+    double getFieldOfView() const;
+
+    //! Returns the angle of the first beam (degrees)
+    double getStartAngle() const;
+
+    //! Returns true if a corrupted chunk was skipped
+    bool hasChecksumError() const;
+};
@@ -0,0 +1,377 @@
+/**
+ * @file   ScanMatcher.cpp
+ * @author Furkan Gemici
+ * @date   December, 2024
+ * @brief  Implementation file for the ScanMatcher class.
+ */
+
+#include "ScanMatcher.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+const int ScanMatcher::MIN_CORRESPONDENCES = 10;
+
+namespace {
+    const double TRANSLATION_TOLERANCE = 1e-5;
+    const double ROTATION_TOLERANCE = 1e-6;
+
+    bool isFinitePoint(float x, float y) {
+        return std::isfinite(x) && std::isfinite(y);
+    }
+
+    /**
+     * @brief Solves the symmetric 3x3 system A x = b with Cramer's rule.
+     *
+     * @return false if the system is singular (degenerate geometry).
+     */
+    bool solve3(const double a[6], const double b[3], double x[3]) {
+        // a = { a00, a01, a02, a11, a12, a22 }
+        double c00 = a[3] * a[5] - a[4] * a[4];
+        double c01 = a[2] * a[4] - a[1] * a[5];
+        double c02 = a[1] * a[4] - a[2] * a[3];
+        double det = a[0] * c00 + a[1] * c01 + a[2] * c02;
+        if (!(std::fabs(det) > 1e-12 * std::fabs(a[0] * a[3] * a[5]))) {
+            return false;
+        }
+        double c11 = a[0] * a[5] - a[2] * a[2];
+        double c12 = a[1] * a[2] - a[0] * a[4];
+        double c22 = a[0] * a[3] - a[1] * a[1];
+        x[0] = (c00 * b[0] + c01 * b[1] + c02 * b[2]) / det;
+        x[1] = (c01 * b[0] + c11 * b[1] + c12 * b[2]) / det;
+        x[2] = (c02 * b[0] + c12 * b[1] + c22 * b[2]) / det;
+        return true;
+    }
+
+    /**
+     * @brief Adds one residual row J * delta + r to the normal equations.
+     */
+    void accumulate(double h[6], double g[3], double j0, double j1, double j2, double r) {
+        h[0] += j0 * j0; h[1] += j0 * j1; h[2] += j0 * j2;
+        h[3] += j1 * j1; h[4] += j1 * j2; h[5] += j2 * j2;
+        g[0] -= j0 * r; g[1] -= j1 * r; g[2] -= j2 * r;
+    }
+}
+
+/**
+ * @brief Constructor for ScanMatcher.
+ *
+ * @throw std::invalid_argument If a parameter is not positive.
+ */
+ScanMatcher::ScanMatcher(double maxCorrespondenceDistance, int iterations)
+    : refCount(0), bucketMask(0), maxDistance(0.5), cellSize(0.5), maxIterations(30), hasReference(false) {
+    setMaxCorrespondenceDistance(maxCorrespondenceDistance);
+    setMaxIterations(iterations);
+}
+
+void ScanMatcher::setMaxCorrespondenceDistance(double distance) {
+    if (!(distance > 0.0)) {
+        throw std::invalid_argument("Correspondence distance must be positive.");
+    }
+    maxDistance = distance;
+}
+
+void ScanMatcher::setMaxIterations(int iterations) {
+    if (iterations <= 0) {
+        throw std::invalid_argument("Iteration limit must be positive.");
+    }
+    maxIterations = iterations;
+}
+
+int ScanMatcher::cellOf(float value) const {
+    return static_cast<int>(std::floor(value / cellSize));
+}
+
+int ScanMatcher::bucketOf(int cellX, int cellY) const {
+    unsigned int hash = static_cast<unsigned int>(cellX) * 73856093u ^ static_cast<unsigned int>(cellY) * 19349663u;
+    return static_cast<int>(hash & static_cast<unsigned int>(bucketMask));
+}
+
+/**
+ * @brief Stores a scan as the reference and builds its hash grid and normals.
+ */
+void ScanMatcher::setReference(const PointBatch& scan) {
+    cellSize = maxDistance;
+    refCount = scan.size();
+    const float* xs = scan.getX();
+    const float* ys = scan.getY();
+    if (static_cast<int>(refX.size()) < refCount) {
+        refX.resize(refCount);
+        refY.resize(refCount);
+        normalX.resize(refCount);
+        normalY.resize(refCount);
+        pointBucket.resize(refCount);
+        bucketPoints.resize(refCount);
+    }
+
+    int buckets = 16;
+    while (buckets < 2 * refCount) {
+        buckets *= 2;
+    }
+    bucketMask = buckets - 1;
+    if (static_cast<int>(bucketStart.size()) < buckets + 1) {
+        bucketStart.resize(buckets + 1);
+    }
+    std::fill(bucketStart.begin(), bucketStart.begin() + buckets + 1, 0);
+
+    // Copy the points and count them per bucket
+    for (int i = 0; i < refCount; ++i) {
+        refX[i] = xs[i];
+        refY[i] = ys[i];
+        if (isFinitePoint(xs[i], ys[i])) {
+            pointBucket[i] = bucketOf(cellOf(xs[i]), cellOf(ys[i]));
+            ++bucketStart[pointBucket[i] + 1];
+        }
+        else {
+            pointBucket[i] = -1;
+        }
+    }
+    for (int b = 0; b < buckets; ++b) {
+        bucketStart[b + 1] += bucketStart[b];
+    }
+    // Scatter the point indices; this advances every start to the end of its bucket
+    for (int i = 0; i < refCount; ++i) {
+        if (pointBucket[i] >= 0) {
+            bucketPoints[bucketStart[pointBucket[i]]++] = i;
+        }
+    }
+    for (int b = buckets; b > 0; --b) {
+        bucketStart[b] = bucketStart[b - 1];
+    }
+    bucketStart[0] = 0;
+
+    // Normals from the neighbouring beams, if they lie on the same surface
+    const float gap2 = static_cast<float>(maxDistance * maxDistance);
+    for (int i = 0; i < refCount; ++i) {
+        normalX[i] = 0.0f;
+        normalY[i] = 0.0f;
+        if (pointBucket[i] < 0) {
+            continue;
+        }
+        int prev = i;
+        int next = i;
+        if (i > 0 && pointBucket[i - 1] >= 0) {
+            float dx = refX[i - 1] - refX[i], dy = refY[i - 1] - refY[i];
+            if (dx * dx + dy * dy < gap2) {
+                prev = i - 1;
+            }
+        }
+        if (i + 1 < refCount && pointBucket[i + 1] >= 0) {
+            float dx = refX[i + 1] - refX[i], dy = refY[i + 1] - refY[i];
+            if (dx * dx + dy * dy < gap2) {
+                next = i + 1;
+            }
+        }
+        float tx = refX[next] - refX[prev];
+        float ty = refY[next] - refY[prev];
+        float length = std::sqrt(tx * tx + ty * ty);
+        if (length > 1e-6f) {
+            normalX[i] = -ty / length;
+            normalY[i] = tx / length;
+        }
+    }
+    hasReference = true;
+}
+
+/**
+ * @brief Finds the nearest reference point within the correspondence gate.
+ *
+ * The search reaches one cell around the query while the gate matches the
+ * grid, and further if the gate was widened after setReference(). When the
+ * gate spans more cells than there are buckets, every point is tested.
+ */
+int ScanMatcher::findNearest(float x, float y) const {
+    float best = static_cast<float>(maxDistance * maxDistance);
+    int bestIndex = -1;
+    double reach = std::ceil(maxDistance / cellSize);
+    if ((2.0 * reach + 1.0) * (2.0 * reach + 1.0) > bucketMask + 1.0) {
+        for (int j = 0; j < refCount; ++j) {
+            float ex = refX[j] - x;
+            float ey = refY[j] - y;
+            float d2 = ex * ex + ey * ey;
+            if (pointBucket[j] >= 0 && d2 < best) {
+                best = d2;
+                bestIndex = j;
+            }
+        }
+        return bestIndex;
+    }
+    int cx = cellOf(x);
+    int cy = cellOf(y);
+    int cells = static_cast<int>(reach);
+    for (int dy = -cells; dy <= cells; ++dy) {
+        for (int dx = -cells; dx <= cells; ++dx) {
+            int bucket = bucketOf(cx + dx, cy + dy);
+            for (int k = bucketStart[bucket]; k < bucketStart[bucket + 1]; ++k) {
+                int j = bucketPoints[k];
+                float ex = refX[j] - x;
+                float ey = refY[j] - y;
+                float d2 = ex * ex + ey * ey;
+                if (d2 < best) {
+                    best = d2;
+                    bestIndex = j;
+                }
+            }
+        }
+    }
+    return bestIndex;
+}
+
+/**
+ * @brief Aligns a scan to the reference scan with point-to-line ICP.
+ *
+ * @throw std::logic_error If no reference scan is set.
+ */
+ScanMatch ScanMatcher::match(const PointBatch& scan, const ScanMatch& guess) const {
+    if (!hasReference) {
+        throw std::logic_error("ScanMatcher has no reference scan.");
+    }
+    const float* xs = scan.getX();
+    const float* ys = scan.getY();
+    const int count = scan.size();
+
+    ScanMatch result = guess;
+    result.iterations = 0;
+    result.correspondences = 0;
+    result.error = 0.0;
+    result.converged = false;
+
+    double theta = guess.th * M_PI / 180.0;
+    double tx = guess.x;
+    double ty = guess.y;
+
+    for (int iteration = 0; iteration < maxIterations; ++iteration) {
+        const float c = static_cast<float>(std::cos(theta));
+        const float s = static_cast<float>(std::sin(theta));
+        const float ftx = static_cast<float>(tx);
+        const float fty = static_cast<float>(ty);
+        double h[6] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+        double g[3] = { 0.0, 0.0, 0.0 };
+        double squaredError = 0.0;
+        int matches = 0;
+
+        for (int i = 0; i < count; ++i) {
+            if (!isFinitePoint(xs[i], ys[i])) {
+                continue;
+            }
+            float px = c * xs[i] - s * ys[i] + ftx;
+            float py = s * xs[i] + c * ys[i] + fty;
+            int j = findNearest(px, py);
+            if (j < 0) {
+                continue;
+            }
+            float ex = px - refX[j];
+            float ey = py - refY[j];
+            float nx = normalX[j];
+            float ny = normalY[j];
+            if (nx != 0.0f || ny != 0.0f) {
+                double r = nx * ex + ny * ey;
+                accumulate(h, g, nx, ny, ny * px - nx * py, r);
+                squaredError += r * r;
+            }
+            else {
+                accumulate(h, g, 1.0, 0.0, -py, ex);
+                accumulate(h, g, 0.0, 1.0, px, ey);
+                squaredError += ex * ex + ey * ey;
+            }
+            ++matches;
+        }
+
+        result.iterations = iteration + 1;
+        result.correspondences = matches;
+        result.error = matches > 0 ? std::sqrt(squaredError / matches) : 0.0;
+        if (matches < MIN_CORRESPONDENCES) {
+            break;
+        }
+
+        double delta[3];
+        if (!solve3(h, g, delta)) {
+            break;
+        }
+        // Compose the increment on the left: R <- R(d) R, t <- R(d) t + dt
+        double dc = std::cos(delta[2]);
+        double ds = std::sin(delta[2]);
+        double newX = dc * tx - ds * ty + delta[0];
+        double newY = ds * tx + dc * ty + delta[1];
+        tx = newX;
+        ty = newY;
+        theta += delta[2];
+
+        if (std::fabs(delta[0]) < TRANSLATION_TOLERANCE && std::fabs(delta[1]) < TRANSLATION_TOLERANCE &&
+            std::fabs(delta[2]) < ROTATION_TOLERANCE) {
+            result.converged = true;
+            break;
+        }
+    }
+
+    result.x = tx;
+    result.y = ty;
+    result.th = theta * 180.0 / M_PI;
+    return result;
+}
+
+/**
+ * @brief Corrects an odometry pose with scan matching.
+ */
+Pose ScanMatcher::track(const PointBatch& scan, Pose odometry) {
+    if (!hasReference) {
+        trackedPose = odometry;
+    }
+    else {
+        ScanMatch motion = relativeMotion(lastOdometry, odometry);
+        ScanMatch matched = match(scan, motion);
+        trackedPose = compose(trackedPose, matched.converged ? matched : motion);
+    }
+    lastOdometry = odometry;
+    setReference(scan);
+    return trackedPose;
+}
+
+Pose ScanMatcher::getTrackedPose() const {
+    return trackedPose;
+}
+
+/**
+ * @brief Forgets the reference scan and the tracked pose.
+ */
+void ScanMatcher::reset() {
+    hasReference = false;
+    refCount = 0;
+    trackedPose = Pose();
+    lastOdometry = Pose();
+}
+
+/**
+ * @brief Applies a scan-to-scan motion to a pose.
+ */
+Pose ScanMatcher::compose(Pose pose, const ScanMatch& motion) {
+    double heading = pose.getTh() * M_PI / 180.0;
+    double c = std::cos(heading);
+    double s = std::sin(heading);
+    return Pose(pose.getX() + c * motion.x - s * motion.y,
+        pose.getY() + s * motion.x + c * motion.y,
+        pose.getTh() + motion.th);
+}
+
+/**
+ * @brief Returns the motion between two poses in the frame of the first.
+ */
+ScanMatch ScanMatcher::relativeMotion(Pose from, Pose to) {
+    double heading = from.getTh() * M_PI / 180.0;
+    double c = std::cos(heading);
+    double s = std::sin(heading);
+    double dx = to.getX() - from.getX();
+    double dy = to.getY() - from.getY();
+    double dth = std::fmod(to.getTh() - from.getTh(), 360.0);
+    if (dth > 180.0) {
+        dth -= 360.0;
+    }
+    else if (dth < -180.0) {
+        dth += 360.0;
+    }
+    return ScanMatch(c * dx + s * dy, -s * dx + c * dy, dth);
+}
@@ -0,0 +1,158 @@
+/**
+ * @file   ScanMatcher.h
+ * @author Furkan Gemici
+ * @date   December, 2024
+ * @brief  Header file for the ScanMatcher class.
+ *
+ * This file contains the definition of the ScanMatcher class, which estimates
+ * the robot motion between two Lidar scans with point-to-line ICP.
+ */
+
+#pragma once
+
+#include "PointBatch.h"
+#include "Pose.h"
+#include <vector>
+
+ /**
+  * @brief Rigid 2D transformation between two scans, with match diagnostics.
+  *
+  * The transformation is the pose of the current scan expressed in the frame
+  * of the reference scan.
+  */
+struct ScanMatch {
+    double x;            /*!< Translation along the reference x axis (meters). */
+    double y;            /*!< Translation along the reference y axis (meters). */
+    double th;           /*!< Rotation (degrees). */
+    int iterations;      /*!< Number of ICP iterations performed. */
+    int correspondences; /*!< Number of matched points in the last iteration. */
+    double error;        /*!< RMS residual of the last iteration (meters). */
+    bool converged;      /*!< True if the estimate converged with enough correspondences. */
+
+    ScanMatch(double x = 0.0, double y = 0.0, double th = 0.0)
+        : x(x), y(y), th(th), iterations(0), correspondences(0), error(0.0), converged(false) {
+    }
+};
+
+ /**
+  * @class ScanMatcher
+  * @brief Scan-to-scan ICP odometry.
+  *
+  * The reference scan is stored in a spatial hash grid whose cells are as large
+  * as the correspondence gate, so the nearest reference point of a query is
+  * found among the 3x3 surrounding cells. Each reference point gets a surface
+  * normal from its neighbours in beam order; matches are then weighted along
+  * that normal (point-to-line), which converges in far fewer iterations than
+  * point-to-point ICP on walls. Points without a usable normal fall back to
+  * point-to-point.
+  *
+  * All buffers are kept between calls and only grow, so matching scans of a
+  * constant size does not allocate.
+  */
+class ScanMatcher {
+private:
+    std::vector<float> refX;        /*!< Reference point x coordinates. */
+    std::vector<float> refY;        /*!< Reference point y coordinates. */
+    std::vector<float> normalX;     /*!< Reference normal x components (0 if no normal). */
+    std::vector<float> normalY;     /*!< Reference normal y components (0 if no normal). */
+    std::vector<int> bucketStart;   /*!< First entry of each hash bucket in `bucketPoints`. */
+    std::vector<int> bucketPoints;  /*!< Reference point indices sorted by bucket. */
+    std::vector<int> pointBucket;   /*!< Hash bucket of each reference point (-1 if invalid). */
+    int refCount;                   /*!< Number of points in the reference scan. */
+    int bucketMask;                 /*!< Number of hash buckets minus one. */
+    double maxDistance;             /*!< Correspondence gate (meters). */
+    double cellSize;                /*!< Grid cell size of the reference (meters), the gate at setReference(). */
+    int maxIterations;              /*!< Iteration limit per match. */
+    bool hasReference;              /*!< True once a reference scan is set. */
+    Pose trackedPose;               /*!< Pose accumulated by track(). */
+    Pose lastOdometry;              /*!< Odometry pose of the reference scan in track(). */
+
+    //! Returns the hash bucket of a grid cell
+    int bucketOf(int cellX, int cellY) const;
+
+    //! Returns the grid cell coordinate of a position
+    int cellOf(float value) const;
+
+    //! Finds the nearest reference point within the gate
+    /*!
+     * Searches as many grid cells around the query as the gate spans.
+     * @return The reference index, or -1 if no point is close enough.
+     */
+    int findNearest(float x, float y) const;
+
+public:
+    /*! Minimum number of correspondences for a match to be accepted. */
+    static const int MIN_CORRESPONDENCES;
+
+    //! Constructor
+    /*!
+     * @param maxCorrespondenceDistance Correspondence gate (meters).
+     * @param iterations Iteration limit per match.
+     * @throw std::invalid_argument If a parameter is not positive.
+     */
+    ScanMatcher(double maxCorrespondenceDistance = 0.5, int iterations = 30);
+
+    //! Sets the correspondence gate
+    /*!
+     * The gate applies to the next match(); the grid cells of the reference
+     * are resized to it with the next setReference().
+     * @param distance Largest accepted point distance (meters).
+     * @throw std::invalid_argument If the distance is not positive.
+     */
+    void setMaxCorrespondenceDistance(double distance);
+
+    //! Sets the iteration limit per match
+    /*!
+     * @throw std::invalid_argument If the limit is not positive.
+     */
+    void setMaxIterations(int iterations);
+
+    //! Stores a scan as the reference for subsequent matches
+    /*!
+     * @param scan Points in the sensor frame, in beam order. Non-finite points are ignored.
+     */
+    void setReference(const PointBatch& scan);
+
+    //! Aligns a scan to the reference scan
+    /*!
+     * @param scan Points in the sensor frame, in beam order.
+     * @param guess Initial estimate of the scan pose in the reference frame.
+     * @return The refined transformation. If it did not converge, `converged`
+     *         is false and the transformation should not be trusted.
+     * @throw std::logic_error If no reference scan is set.
+     */
+    ScanMatch match(const PointBatch& scan, const ScanMatch& guess = ScanMatch()) const;
+
+    //! Corrects an odometry pose with scan matching
+    /*!
+     * The odometry motion since the previous call seeds the match; the matched
+     * motion is accumulated onto the corrected pose and the scan becomes the
+     * new reference. If the match fails, the odometry motion is used.
+     * @param scan Points in the sensor frame, in beam order.
+     * @param odometry Current pose reported by the robot.
+     * @return The corrected pose.
+     */
+    Pose track(const PointBatch& scan, Pose odometry);
+
+    //! Returns the pose accumulated by track()
+    Pose getTrackedPose() const;
+
+    //! Forgets the reference scan and the tracked pose
+    void reset();
+
+    //! Applies a scan-to-scan motion to a pose
+    /*!
+     * @param pose Pose of the reference scan.
+     * @param motion Motion of the current scan in the reference frame.
+     * @return Pose of the current scan.
+     */
+    static Pose compose(Pose pose, const ScanMatch& motion);
+
+    //! Returns the motion between two poses in the frame of the first
+    /*!
+     * @param from Starting pose.
+     * @param to Final pose.
+     * @return Motion such that compose(from, motion) equals `to`.
+     */
+    static ScanMatch relativeMotion(Pose from, Pose to);
+};
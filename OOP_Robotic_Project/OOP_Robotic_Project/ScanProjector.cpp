@@ -0,0 +1,81 @@
+/**
+ * @file   ScanProjector.cpp
+ * @author Furkan Gemici
+ * @date   December, 2024
+ * @brief  Implementation file for the ScanProjector class.
+ */
+
+#include "ScanProjector.h"
+#include "SimdConfig.h"
+#include <cmath>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+/**
+ * @brief Projects a scan into the sensor (robot) frame.
+ */
+void ScanProjector::project(const float* ranges, const float* cosTable, const float* sinTable,
+    int count, PointBatch& out) {
+    project(ranges, cosTable, sinTable, count, 0.0, 0.0, 0.0, out);
+}
+
+/**
+ * @brief Projects a scan into the world frame.
+ *
+ * Computes, for each beam i:
+ *   lx = r[i] * cos[i], ly = r[i] * sin[i]
+ *   x  = originX + lx * cos(heading) - ly * sin(heading)
+ *   y  = originY + lx * sin(heading) + ly * cos(heading)
+ */
+void ScanProjector::project(const float* ranges, const float* cosTable, const float* sinTable,
+    int count, double originX, double originY, double headingDeg, PointBatch& out) {
+    out.resize(count);
+    float* xs = out.getX();
+    float* ys = out.getY();
+
+    const double headingRad = headingDeg * M_PI / 180.0;
+    const float ox = static_cast<float>(originX);
+    const float oy = static_cast<float>(originY);
+    const float ch = static_cast<float>(std::cos(headingRad));
+    const float sh = static_cast<float>(std::sin(headingRad));
+
+    int i = 0;
+#if defined(ROBOT_SIMD_AVX2)
+    const __m256 ox8 = _mm256_set1_ps(ox);
+    const __m256 oy8 = _mm256_set1_ps(oy);
+    const __m256 ch8 = _mm256_set1_ps(ch);
+    const __m256 sh8 = _mm256_set1_ps(sh);
+    for (; i + 8 <= count; i += 8) {
+        __m256 r = _mm256_loadu_ps(ranges + i);
+        __m256 lx = _mm256_mul_ps(r, _mm256_loadu_ps(cosTable + i));
+        __m256 ly = _mm256_mul_ps(r, _mm256_loadu_ps(sinTable + i));
+        __m256 x = _mm256_add_ps(ox8, _mm256_sub_ps(_mm256_mul_ps(lx, ch8), _mm256_mul_ps(ly, sh8)));
+        __m256 y = _mm256_add_ps(oy8, _mm256_add_ps(_mm256_mul_ps(lx, sh8), _mm256_mul_ps(ly, ch8)));
+        _mm256_storeu_ps(xs + i, x);
+        _mm256_storeu_ps(ys + i, y);
+    }
+#endif
+#if defined(ROBOT_SIMD_SSE2)
+    const __m128 ox4 = _mm_set1_ps(ox);
+    const __m128 oy4 = _mm_set1_ps(oy);
+    const __m128 ch4 = _mm_set1_ps(ch);
+    const __m128 sh4 = _mm_set1_ps(sh);
+    for (; i + 4 <= count; i += 4) {
+        __m128 r = _mm_loadu_ps(ranges + i);
+        __m128 lx = _mm_mul_ps(r, _mm_loadu_ps(cosTable + i));
+        __m128 ly = _mm_mul_ps(r, _mm_loadu_ps(sinTable + i));
+        __m128 x = _mm_add_ps(ox4, _mm_sub_ps(_mm_mul_ps(lx, ch4), _mm_mul_ps(ly, sh4)));
+        __m128 y = _mm_add_ps(oy4, _mm_add_ps(_mm_mul_ps(lx, sh4), _mm_mul_ps(ly, ch4)));
+        _mm_storeu_ps(xs + i, x);
+        _mm_storeu_ps(ys + i, y);
+    }
+#endif
+    for (; i < count; ++i) {
+        float lx = ranges[i] * cosTable[i];
+        float ly = ranges[i] * sinTable[i];
+        xs[i] = ox + (lx * ch - ly * sh);
+        ys[i] = oy + (lx * sh + ly * ch);
+    }
+}
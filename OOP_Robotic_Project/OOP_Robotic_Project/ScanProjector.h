@@ -0,0 +1,51 @@
+/**
+ * @file   ScanProjector.h
+ * @author Furkan Gemici
+ * @date   December, 2024
+ * @brief  Header file for the ScanProjector class.
+ *
+ * This file contains the definition of the ScanProjector class, which converts
+ * Lidar range scans from polar form into Cartesian point batches.
+ */
+
+#pragma once
+
+#include "PointBatch.h"
+
+ /**
+  * @class ScanProjector
+  * @brief Vectorized polar-to-Cartesian conversion of Lidar scans.
+  *
+  * The projection uses precomputed per-beam cosine and sine tables, so no
+  * trigonometric function is evaluated per beam. The kernel processes 8 beams
+  * per iteration with AVX2, 4 with SSE2 and falls back to scalar code for the
+  * remaining beams or when no SIMD instruction set is available.
+  */
+class ScanProjector {
+public:
+    //! Projects a scan into the sensor (robot) frame
+    /*!
+     * @param ranges Range values of the scan.
+     * @param cosTable Cosine of each beam angle.
+     * @param sinTable Sine of each beam angle.
+     * @param count Number of beams.
+     * @param out Batch receiving the points. Resized to `count`.
+     */
+    static void project(const float* ranges, const float* cosTable, const float* sinTable,
+        int count, PointBatch& out);
+
+    //! Projects a scan into the world frame
+    /*!
+     * Each beam endpoint is rotated by the heading and translated by the origin.
+     * @param ranges Range values of the scan.
+     * @param cosTable Cosine of each beam angle.
+     * @param sinTable Sine of each beam angle.
+     * @param count Number of beams.
+     * @param originX X-coordinate of the sensor in the world frame.
+     * @param originY Y-coordinate of the sensor in the world frame.
+     * @param headingDeg Heading of the sensor in the world frame (degrees).
+     * @param out Batch receiving the points. Resized to `count`.
+     */
+    static void project(const float* ranges, const float* cosTable, const float* sinTable,
+        int count, double originX, double originY, double headingDeg, PointBatch& out);
+};
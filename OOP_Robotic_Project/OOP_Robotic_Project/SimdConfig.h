@@ -0,0 +1,38 @@
+/**
+ * @file   SimdConfig.h
+ * @author Furkan Gemici
+ * @date   December, 2024
+ * @brief  Compile-time selection of the SIMD instruction set.
+ *
+ * Defines ROBOT_SIMD_AVX2 and/or ROBOT_SIMD_SSE2 depending on what the compiler
+ * targets (/arch:AVX2 on MSVC, -mavx2 on GCC/Clang; SSE2 is always available on
+ * x64). Defining ROBOT_SIMD_DISABLE forces the scalar fallback paths.
+ */
+
+#pragma once
+
+#if !defined(ROBOT_SIMD_DISABLE)
+#if defined(__AVX2__)
+#define ROBOT_SIMD_AVX2 1
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ROBOT_SIMD_SSE2 1
+#endif
+#endif
+
+#if defined(ROBOT_SIMD_AVX2)
+#include <immintrin.h>
+#elif defined(ROBOT_SIMD_SSE2)
+#include <emmintrin.h>
+#endif
+
+//! Returns the name of the instruction set the SIMD kernels were compiled for
+inline const char* simdInstructionSet() {
+#if defined(ROBOT_SIMD_AVX2)
+    return "AVX2";
+#elif defined(ROBOT_SIMD_SSE2)
+    return "SSE2";
+#else
+    return "scalar";
+#endif
+}
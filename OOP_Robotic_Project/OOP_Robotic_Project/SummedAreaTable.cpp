@@ -0,0 +1,155 @@
+#include "SummedAreaTable.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+/**
+ * @file   SummedAreaTable.cpp
+ * @author Emirhan Kalkan
+ * @date   December, 2024
+ * @brief  Implementation of the SummedAreaTable class.
+ */
+
+/**
+ * @brief Builds the table of a map.
+ */
+SummedAreaTable::SummedAreaTable(const Map& map)
+    : map(map), sizeX(-1), sizeY(-1), syncedVersion(0), resolution(1.0), originX(0.0), originY(0.0) {
+    update();
+}
+
+/**
+ * @brief Recomputes the entries of the cells from (x0, y0) to the end of the map.
+ *
+ * Each row keeps a running count of its occupied cells; the count of the
+ * cells left of x0 is the difference of two entries that did not change.
+ */
+void SummedAreaTable::recompute(int x0, int y0) {
+    const size_t width = static_cast<size_t>(sizeX) + 1;
+    for (int y = y0; y < sizeY; ++y) {
+        const MapCell* row = map.getRow(y);
+        const unsigned int* above = &sums[static_cast<size_t>(y) * width];
+        unsigned int* current = &sums[static_cast<size_t>(y + 1) * width];
+        unsigned int running = current[x0] - above[x0];
+        for (int x = x0; x < sizeX; ++x) {
+            running += row[x] != 0;
+            current[x + 1] = above[x + 1] + running;
+        }
+    }
+}
+
+/**
+ * @brief Brings the table up to date with the map.
+ *
+ * The first changed tile column and row are found from the tile versions,
+ * and everything to their lower right is recomputed.
+ */
+void SummedAreaTable::update() {
+    if (map.getNumberX() != sizeX || map.getNumberY() != sizeY) {
+        sizeX = map.getNumberX();
+        sizeY = map.getNumberY();
+        sums.assign((static_cast<size_t>(sizeX) + 1) * (static_cast<size_t>(sizeY) + 1), 0);
+        recompute(0, 0);
+        syncedVersion = map.getVersion();
+        return;
+    }
+    if (map.getVersion() == syncedVersion) {
+        return;
+    }
+
+    const int tilesX = (sizeX + Map::DIRTY_TILE_SIZE - 1) >> Map::DIRTY_TILE_SHIFT;
+    const int tilesY = (sizeY + Map::DIRTY_TILE_SIZE - 1) >> Map::DIRTY_TILE_SHIFT;
+    int firstX = tilesX;
+    int firstY = tilesY;
+    for (int ty = 0; ty < tilesY; ++ty) {
+        for (int tx = 0; tx < firstX; ++tx) {
+            if (map.getTileVersion(tx, ty) > syncedVersion) {
+                firstX = tx;
+                firstY = std::min(firstY, ty);
+                break;
+            }
+        }
+    }
+    if (firstY < tilesY) {
+        recompute(firstX << Map::DIRTY_TILE_SHIFT, firstY << Map::DIRTY_TILE_SHIFT);
+    }
+    syncedVersion = map.getVersion();
+}
+
+/**
+ * @brief Sets the world frame used by the world-space queries.
+ */
+void SummedAreaTable::setWorldFrame(double _resolution, double _originX, double _originY) {
+    if (!(_resolution > 0)) {
+        throw std::invalid_argument("Resolution must be positive.");
+    }
+    resolution = _resolution;
+    originX = _originX;
+    originY = _originY;
+}
+
+/**
+ * @brief Counts the occupied cells of a rectangle, clipped to the map.
+ */
+int SummedAreaTable::countOccupied(int x0, int y0, int x1, int y1) const {
+    x0 = std::max(x0, 0);
+    y0 = std::max(y0, 0);
+    x1 = std::min(x1, sizeX - 1);
+    y1 = std::min(y1, sizeY - 1);
+    if (x0 > x1 || y0 > y1) {
+        return 0;
+    }
+    return static_cast<int>(sumAt(x1 + 1, y1 + 1) - sumAt(x0, y1 + 1) - sumAt(x1 + 1, y0) + sumAt(x0, y0));
+}
+
+/**
+ * @brief Checks whether a rectangle lies inside the map and holds no occupied cell.
+ */
+bool SummedAreaTable::isFree(int x0, int y0, int x1, int y1) const {
+    if (x0 < 0 || y0 < 0 || x1 >= sizeX || y1 >= sizeY) {
+        return false;
+    }
+    return countOccupied(x0, y0, x1, y1) == 0;
+}
+
+/**
+ * @brief Converts a world box to the inclusive range of cells it overlaps.
+ *
+ * Coordinates are clamped to the int range before conversion.
+ */
+void SummedAreaTable::toCells(double minX, double minY, double maxX, double maxY,
+    int& x0, int& y0, int& x1, int& y1) const {
+    auto toCell = [this](double world, double origin) {
+        const double cell = std::floor((world - origin) / resolution);
+        return static_cast<int>(std::max(-1e9, std::min(1e9, cell)));
+    };
+    x0 = toCell(minX, originX);
+    y0 = toCell(minY, originY);
+    x1 = toCell(maxX, originX);
+    y1 = toCell(maxY, originY);
+}
+
+/**
+ * @brief Counts the occupied cells overlapping a world-space box, clipped to the map.
+ */
+int SummedAreaTable::countOccupiedInBox(double minX, double minY, double maxX, double maxY) const {
+    int x0, y0, x1, y1;
+    toCells(minX, minY, maxX, maxY, x0, y0, x1, y1);
+    return countOccupied(x0, y0, x1, y1);
+}
+
+/**
+ * @brief Checks whether a world-space box lies inside the map and overlaps no occupied cell.
+ */
+bool SummedAreaTable::isBoxFree(double minX, double minY, double maxX, double maxY) const {
+    int x0, y0, x1, y1;
+    toCells(minX, minY, maxX, maxY, x0, y0, x1, y1);
+    return isFree(x0, y0, x1, y1);
+}
+
+/**
+ * @brief Returns the number of occupied cells of the whole map.
+ */
+int SummedAreaTable::getTotalOccupied() const {
+    return static_cast<int>(sumAt(sizeX, sizeY));
+}
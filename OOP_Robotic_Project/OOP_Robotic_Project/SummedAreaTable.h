@@ -0,0 +1,115 @@
+#ifndef SUMMEDAREATABLE_H
+#define SUMMEDAREATABLE_H
+
+#include "Map.h"
+#include <vector>
+
+/**
+ * @file   SummedAreaTable.h
+ * @author Emirhan Kalkan
+ * @date   December, 2024
+ * @brief  Header file for the SummedAreaTable class.
+ *
+ * This file defines the SummedAreaTable class, which counts the occupied
+ * cells of any rectangle of a Map in constant time.
+ */
+
+ /**
+  * @class SummedAreaTable
+  * @brief Integral image of the occupied cells of a map, kept up to date incrementally.
+  *
+  * Entry (x, y) of the table holds the number of occupied (non-zero) cells
+  * with coordinates below x and y, so the count of any rectangle takes four
+  * lookups. The table has a zero first row and column, so queries need no
+  * special cases at the map border.
+  *
+  * A change of one cell changes every entry to its lower right, so update()
+  * recomputes the table from the first column and row of the tiles changed
+  * since the last update (found through the map's tile versions) to the end
+  * of the map; the rows above and the columns to the left are kept.
+  *
+  * Rectangles can also be given in world coordinates, using the resolution
+  * and origin set with setWorldFrame() (a cell and the origin by default).
+  */
+class SummedAreaTable {
+private:
+    const Map& map;                      /**< The map the table follows. */
+    int sizeX, sizeY;                    /**< Map size at the last update. */
+    std::vector<unsigned int> sums;      /**< (sizeX + 1) x (sizeY + 1) entries, row-major. */
+    unsigned long long syncedVersion;    /**< Map version the table reflects. */
+    double resolution;                   /**< Size of a cell in world units. */
+    double originX, originY;             /**< World coordinates of the corner of cell (0, 0). */
+
+    /**
+     * @brief Recomputes the entries of the cells from (x0, y0) to the end of the map.
+     */
+    void recompute(int x0, int y0);
+
+    /**
+     * @brief Returns the entry for the cells below (x, y), without bounds checking.
+     */
+    unsigned int sumAt(int x, int y) const {
+        return sums[static_cast<size_t>(y) * (sizeX + 1) + x];
+    }
+
+    /**
+     * @brief Converts a world box to the inclusive range of cells it overlaps.
+     */
+    void toCells(double minX, double minY, double maxX, double maxY, int& x0, int& y0, int& x1, int& y1) const;
+
+public:
+    /**
+     * @brief Builds the table of a map.
+     *
+     * @param map The map (non-zero cells are occupied). It must outlive the table.
+     */
+    explicit SummedAreaTable(const Map& map);
+
+    /**
+     * @brief Brings the table up to date with the map.
+     */
+    void update();
+
+    /**
+     * @brief Sets the world frame used by the world-space queries.
+     *
+     * @param resolution Size of a cell in world units.
+     * @param originX World x-coordinate of the corner of cell (0, 0).
+     * @param originY World y-coordinate of the corner of cell (0, 0).
+     * @throw std::invalid_argument If the resolution is not positive.
+     */
+    void setWorldFrame(double resolution, double originX, double originY);
+
+    /**
+     * @brief Counts the occupied cells of a rectangle, clipped to the map.
+     *
+     * @param x0 First column.
+     * @param y0 First row.
+     * @param x1 Last column (inclusive).
+     * @param y1 Last row (inclusive).
+     * @return The number of occupied cells (0 for an empty or outside rectangle).
+     */
+    int countOccupied(int x0, int y0, int x1, int y1) const;
+
+    /**
+     * @brief Checks whether a rectangle lies inside the map and holds no occupied cell.
+     */
+    bool isFree(int x0, int y0, int x1, int y1) const;
+
+    /**
+     * @brief Counts the occupied cells overlapping a world-space box, clipped to the map.
+     */
+    int countOccupiedInBox(double minX, double minY, double maxX, double maxY) const;
+
+    /**
+     * @brief Checks whether a world-space box lies inside the map and overlaps no occupied cell.
+     */
+    bool isBoxFree(double minX, double minY, double maxX, double maxY) const;
+
+    /**
+     * @brief Returns the number of occupied cells of the whole map.
+     */
+    int getTotalOccupied() const;
+};
+
+#endif // SUMMEDAREATABLE_H
@@ -0,0 +1,175 @@
+#include "TestConnectedComponents.h"
+#include <iostream>
+#include <cassert>
+#include <cstdlib>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * @file   TestConnectedComponents.cpp
+ * @author Emirhan Kalkan
+ * @date   December, 2024
+ * @brief  Implementation of the test methods for the ConnectedComponents class.
+ */
+
+namespace {
+    /**
+     * @brief Labels the cells of a map with flood fills started in raster order.
+     */
+    std::vector<int> floodLabels(const Map& map, int connectivity, bool occupied) {
+        const int sizeX = map.getNumberX();
+        const int sizeY = map.getNumberY();
+        std::vector<int> labels(static_cast<size_t>(sizeX) * sizeY, ConnectedComponents::NO_COMPONENT);
+        int next = 0;
+        std::vector<int> stack;
+        for (int start = 0; start < sizeX * sizeY; ++start) {
+            if ((map.getGrid(start % sizeX, start / sizeX) != 0) != occupied || labels[start] != ConnectedComponents::NO_COMPONENT) {
+                continue;
+            }
+            labels[start] = next;
+            stack.assign(1, start);
+            while (!stack.empty()) {
+                const int index = stack.back();
+                stack.pop_back();
+                for (int dy = -1; dy <= 1; ++dy) {
+                    for (int dx = -1; dx <= 1; ++dx) {
+                        if ((dx == 0 && dy == 0) || (connectivity == 4 && dx != 0 && dy != 0)) {
+                            continue;
+                        }
+                        const int x = index % sizeX + dx;
+                        const int y = index / sizeX + dy;
+                        if (x < 0 || x >= sizeX || y < 0 || y >= sizeY) {
+                            continue;
+                        }
+                        const int neighbour = y * sizeX + x;
+                        if ((map.getGrid(x, y) != 0) == occupied && labels[neighbour] == ConnectedComponents::NO_COMPONENT) {
+                            labels[neighbour] = next;
+                            stack.push_back(neighbour);
+                        }
+                    }
+                }
+            }
+            ++next;
+        }
+        return labels;
+    }
+
+    /**
+     * @brief Fills a map with random walls and obstacles.
+     */
+    void fillMaze(Map& map, int obstacles) {
+        for (int i = 0; i < obstacles; ++i) {
+            const int x = std::rand() % map.getNumberX();
+            const int y = std::rand() % map.getNumberY();
+            const int length = std::rand() % 40;
+            for (int k = 0; k < length; ++k) {
+                map.setGrid(i % 2 ? x + k : x, i % 2 ? y : y + k, 1);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Runs all the tests for the ConnectedComponents class.
+ */
+void TestConnectedComponents::runAllTests() {
+    std::cout << "Running tests for ConnectedComponents...\n";
+    testLabels();
+    testThreads();
+    testUpdates();
+    std::cout << "All ConnectedComponents tests passed successfully!\n";
+}
+
+/**
+ * @brief Tests labels against a flood fill for both connectivities.
+ */
+void TestConnectedComponents::testLabels() {
+    std::srand(17);
+    Map map(203, 150);
+    fillMaze(map, 700);
+    for (int connectivity = 4; connectivity <= 8; connectivity += 4) {
+        for (int occupied = 0; occupied < 2; ++occupied) {
+            ConnectedComponents components(map, connectivity, occupied != 0);
+            const std::vector<int> expected = floodLabels(map, connectivity, occupied != 0);
+            assert(components.getLabels() == expected);
+            int total = 0;
+            for (int c = 0; c < components.getComponentCount(); ++c) {
+                total += components.getComponentSize(c);
+            }
+            int targets = 0;
+            for (int label : expected) {
+                targets += label != ConnectedComponents::NO_COMPONENT;
+            }
+            assert(total == targets);
+        }
+    }
+
+    // Free cells on both sides of a diagonal wall touch only at corners
+    Map wall(5, 5);
+    for (int i = 0; i < 5; ++i) {
+        wall.setGrid(i, i, 1);
+    }
+    ConnectedComponents four(wall, 4);
+    ConnectedComponents eight(wall, 8);
+    assert(four.getComponentCount() == 2 && eight.getComponentCount() == 1);
+    assert(!four.isConnected(1, 0, 0, 1) && eight.isConnected(1, 0, 0, 1));
+    assert(four.getLabel(0, 0) == ConnectedComponents::NO_COMPONENT && four.getLabel(-1, 0) == ConnectedComponents::NO_COMPONENT);
+    assert(!four.isConnected(0, 0, 0, 0) && four.getComponentSize(99) == 0);
+
+    bool thrown = false;
+    try {
+        ConnectedComponents invalid(wall, 6);
+    }
+    catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    assert(thrown);
+    std::cout << "testLabels: Passed\n";
+}
+
+/**
+ * @brief Tests that labels do not depend on the thread count.
+ */
+void TestConnectedComponents::testThreads() {
+    std::srand(2);
+    Map map(500, 333);
+    fillMaze(map, 3000);
+    ConnectedComponents serial(map, 8);
+    ConnectedComponents parallel(map, 8);
+    parallel.setThreadCount(4);
+    assert(parallel.getThreadCount() == 4);
+    map.setGrid(0, 0, 1);
+    serial.update();
+    parallel.update();
+    assert(serial.getLabels() == parallel.getLabels());
+    assert(serial.getLabels() == floodLabels(map, 8, false));
+    parallel.setThreadCount(1);
+    assert(parallel.getThreadCount() == 1);
+    std::cout << "testThreads: Passed\n";
+}
+
+/**
+ * @brief Tests relabelling after map changes and resizes.
+ */
+void TestConnectedComponents::testUpdates() {
+    Map map(130, 70);
+    for (int y = 0; y < 70; ++y) {
+        map.setGrid(65, y, 1);
+    }
+    ConnectedComponents components(map);
+    assert(components.getComponentCount() == 2 && !components.isConnected(0, 0, 129, 69));
+
+    // A door in the wall joins both sides
+    map.setGrid(65, 40, 0);
+    components.update();
+    assert(components.getComponentCount() == 1 && components.isConnected(0, 0, 129, 69));
+    assert(components.getComponentSize(0) == 130 * 70 - 69);
+
+    map.setGridSize(200, 10);
+    components.update();
+    assert(components.getLabels() == floodLabels(map, 4, false));
+    Map empty(0, 0);
+    ConnectedComponents none(empty);
+    assert(none.getComponentCount() == 0);
+    std::cout << "testUpdates: Passed\n";
+}
@@ -0,0 +1,36 @@
+#ifndef TESTCONNECTEDCOMPONENTS_H
+#define TESTCONNECTEDCOMPONENTS_H
+
+#include "ConnectedComponents.h"
+
+/**
+ * @file   TestConnectedComponents.h
+ * @author Emirhan Kalkan
+ * @date   December, 2024
+ * @brief  Header file for the TestConnectedComponents class, which contains methods to test the ConnectedComponents class.
+ */
+class TestConnectedComponents {
+public:
+    /**
+     * @brief Runs all the tests for the ConnectedComponents class.
+     */
+    static void runAllTests();
+
+private:
+    /**
+     * @brief Tests labels against a flood fill for both connectivities.
+     */
+    static void testLabels();
+
+    /**
+     * @brief Tests that labels do not depend on the thread count.
+     */
+    static void testThreads();
+
+    /**
+     * @brief Tests relabelling after map changes and resizes.
+     */
+    static void testUpdates();
+};
+
+#endif // TESTCONNECTEDCOMPONENTS_H
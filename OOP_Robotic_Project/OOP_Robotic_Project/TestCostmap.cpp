@@ -0,0 +1,154 @@
+#include "TestCostmap.h"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <cstdlib>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * @file   TestCostmap.cpp
+ * @author Emirhan Kalkan
+ * @date   December, 2024
+ * @brief  Implementation of the test methods for the Costmap class.
+ */
+
+/**
+ * @brief Runs all the tests for the Costmap class.
+ */
+void TestCostmap::runAllTests() {
+    std::cout << "Running tests for Costmap...\n";
+    testCostProfile();
+    testFootprint();
+    testIncrementalUpdates();
+    testInvalidParameters();
+    std::cout << "All Costmap tests passed successfully!\n";
+}
+
+/**
+ * @brief Tests the cost profile around a single obstacle.
+ */
+void TestCostmap::testCostProfile() {
+    Map map(40, 40);
+    map.setGrid(20, 20, 1);
+    Costmap costmap(map, 2.0, 6.0, 0.5);
+
+    assert(costmap.getCost(20, 20) == Costmap::LETHAL_COST);
+    assert(costmap.getCost(22, 20) == Costmap::INSCRIBED_COST);
+    assert(costmap.getCost(21, 21) == Costmap::INSCRIBED_COST);
+    assert(costmap.getCost(23, 20) == static_cast<int>(std::lround(252 * std::exp(-0.5))));
+    assert(costmap.getCost(26, 20) == static_cast<int>(std::lround(252 * std::exp(-2.0))));
+    assert(costmap.getCost(27, 20) == Costmap::FREE_COST);
+    assert(costmap.getCost(25, 24) == Costmap::FREE_COST);
+    assert(costmap.getCost(40, 20) == -1);
+
+    // Costs decrease with distance inside the band
+    for (int x = 23; x < 26; ++x) {
+        assert(costmap.getCost(x, 20) > costmap.getCost(x + 1, 20));
+        assert(costmap.getCost(x + 1, 20) > 0);
+    }
+    std::cout << "testCostProfile: Passed\n";
+}
+
+/**
+ * @brief Tests that isFree matches a sweep of the robot footprint.
+ */
+void TestCostmap::testFootprint() {
+    Map map(60, 50);
+    std::srand(17);
+    for (int i = 0; i < 40; ++i) {
+        map.setGrid(std::rand() % 60, std::rand() % 50, 1);
+    }
+    const double radius = 3.5;
+    Costmap costmap(map, radius, 8.0);
+
+    for (int y = 0; y < 50; ++y) {
+        for (int x = 0; x < 60; ++x) {
+            bool touches = false;
+            for (int oy = 0; oy < 50 && !touches; ++oy) {
+                for (int ox = 0; ox < 60 && !touches; ++ox) {
+                    touches = map.getGrid(ox, oy) > 0 && std::hypot(ox - x, oy - y) <= radius;
+                }
+            }
+            assert(costmap.isFree(x, y) == !touches);
+        }
+    }
+    assert(!costmap.isFree(-1, 0));
+    std::cout << "testFootprint: Passed\n";
+}
+
+/**
+ * @brief Tests that incremental updates match a costmap built from scratch.
+ */
+void TestCostmap::testIncrementalUpdates() {
+    Map map(512, 512);
+    std::srand(8);
+    for (int i = 0; i < 1500; ++i) {
+        map.setGrid(std::rand() % 512, std::rand() % 512, 1);
+    }
+    Costmap costmap(map, 4.0, 12.0, 0.4);
+
+    for (int round = 0; round < 10; ++round) {
+        for (int i = 0; i < 100; ++i) {
+            const int x = 200 + std::rand() % 60;
+            const int y = 300 + std::rand() % 60;
+            map.setGrid(x, y, map.getGrid(x, y) > 0 ? 0 : 1);
+        }
+        costmap.update();
+
+        Costmap fresh(map, 4.0, 12.0, 0.4);
+        for (int y = 0; y < 512; ++y) {
+            for (int x = 0; x < 512; ++x) {
+                assert(costmap.costAt(x, y) == fresh.costAt(x, y));
+            }
+        }
+    }
+
+    // Only the tiles around the changed cell change in the cost grid
+    const Map& costs = costmap.getCosts();
+    const unsigned long long version = costs.getVersion();
+    map.setGrid(100, 100, map.getGrid(100, 100) > 0 ? 0 : 1);
+    costmap.update();
+    assert(costs.getVersion() > version);
+    const int tiles = 512 / Map::DIRTY_TILE_SIZE;
+    for (int ty = 0; ty < tiles; ++ty) {
+        for (int tx = 0; tx < tiles; ++tx) {
+            if (costs.getTileVersion(tx, ty) > version) {
+                assert((tx + 1) * Map::DIRTY_TILE_SIZE > 100 - 12 && tx * Map::DIRTY_TILE_SIZE <= 100 + 12);
+                assert((ty + 1) * Map::DIRTY_TILE_SIZE > 100 - 12 && ty * Map::DIRTY_TILE_SIZE <= 100 + 12);
+            }
+        }
+    }
+    std::cout << "testIncrementalUpdates: Passed\n";
+}
+
+/**
+ * @brief Tests the parameter checks.
+ */
+void TestCostmap::testInvalidParameters() {
+    Map map(10, 10);
+    bool thrown = false;
+    try {
+        Costmap costmap(map, 3.0, 2.0);
+    }
+    catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    thrown = false;
+    try {
+        Costmap costmap(map, -1.0, 2.0);
+    }
+    catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    // No inflation: only obstacles cost anything
+    map.setGrid(5, 5, 1);
+    Costmap costmap(map, 0.0, 0.0);
+    assert(costmap.getCost(5, 5) == Costmap::LETHAL_COST);
+    assert(costmap.getCost(5, 6) == Costmap::FREE_COST);
+    std::cout << "testInvalidParameters: Passed\n";
+}
@@ -0,0 +1,41 @@
+#ifndef TESTCOSTMAP_H
+#define TESTCOSTMAP_H
+
+#include "Costmap.h"
+
+/**
+ * @file   TestCostmap.h
+ * @author Emirhan Kalkan
+ * @date   December, 2024
+ * @brief  Header file for the TestCostmap class, which contains methods to test the Costmap class.
+ */
+class TestCostmap {
+public:
+    /**
+     * @brief Runs all the tests for the Costmap class.
+     */
+    static void runAllTests();
+
+private:
+    /**
+     * @brief Tests the cost profile around a single obstacle.
+     */
+    static void testCostProfile();
+
+    /**
+     * @brief Tests that isFree matches a sweep of the robot footprint.
+     */
+    static void testFootprint();
+
+    /**
+     * @brief Tests that incremental updates match a costmap built from scratch.
+     */
+    static void testIncrementalUpdates();
+
+    /**
+     * @brief Tests the parameter checks.
+     */
+    static void testInvalidParameters();
+};
+
+#endif // TESTCOSTMAP_H
@@ -0,0 +1,187 @@
+#include "TestDistanceField.h"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+/**
+ * @file   TestDistanceField.cpp
+ * @author Emirhan Kalkan
+ * @date   December, 2024
+ * @brief  Implementation of the test methods for the DistanceField class.
+ */
+
+namespace {
+    /**
+     * @brief Exact squared distance to the nearest occupied cell, by brute force.
+     */
+    int bruteSquared(const Map& map, int x, int y) {
+        int best = DistanceField::NO_OBSTACLE;
+        for (int oy = 0; oy < map.getNumberY(); ++oy) {
+            for (int ox = 0; ox < map.getNumberX(); ++ox) {
+                if (map.getGrid(ox, oy) > 0) {
+                    const int squared = (ox - x) * (ox - x) + (oy - y) * (oy - y);
+                    best = squared < best ? squared : best;
+                }
+            }
+        }
+        return best;
+    }
+
+    /**
+     * @brief Checks a field against brute force. The wavefront may settle on an
+     *        obstacle slightly farther than the nearest one; it must never be closer.
+     */
+    void checkAgainstBruteForce(const Map& map, const DistanceField& field, double tolerance) {
+        for (int y = 0; y < map.getNumberY(); ++y) {
+            for (int x = 0; x < map.getNumberX(); ++x) {
+                const int exact = bruteSquared(map, x, y);
+                const int squared = field.getSquaredDistance(x, y);
+                if (exact == DistanceField::NO_OBSTACLE) {
+                    assert(squared == DistanceField::NO_OBSTACLE);
+                    continue;
+                }
+                assert(squared >= exact);
+                assert(std::sqrt(static_cast<double>(squared)) - std::sqrt(static_cast<double>(exact)) <= tolerance);
+                int ox, oy;
+                assert(field.getNearestObstacle(x, y, ox, oy));
+                assert(map.getGrid(ox, oy) > 0);
+                assert((ox - x) * (ox - x) + (oy - y) * (oy - y) == squared);
+            }
+        }
+    }
+
+    void fillRandom(Map& map, int percent) {
+        for (int y = 0; y < map.getNumberY(); ++y) {
+            for (int x = 0; x < map.getNumberX(); ++x) {
+                map.setGrid(x, y, std::rand() % 100 < percent ? 1 : 0);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Runs all the tests for the DistanceField class.
+ */
+void TestDistanceField::runAllTests() {
+    std::cout << "Running tests for DistanceField...\n";
+    testStaticField();
+    testIncrementalUpdates();
+    testGradient();
+    testMaxDistanceAndResize();
+    std::cout << "All DistanceField tests passed successfully!\n";
+}
+
+/**
+ * @brief Tests a field built from scratch against a brute-force search.
+ */
+void TestDistanceField::testStaticField() {
+    Map empty(20, 10);
+    DistanceField emptyField(empty);
+    assert(emptyField.getDistance(5, 5) == std::numeric_limits<double>::infinity());
+    assert(emptyField.getDistance(20, 5) == -1.0);
+
+    Map map(60, 45);
+    std::srand(21);
+    fillRandom(map, 2);
+    DistanceField field(map);
+    checkAgainstBruteForce(map, field, 0.5);
+
+    map.clearMap();
+    map.setGrid(10, 10, 1);
+    field.update();
+    assert(field.getDistance(10, 10) == 0.0);
+    assert(field.getDistance(13, 14) == 5.0);
+    assert(field.getDistance(59, 44) == std::sqrt(49.0 * 49.0 + 34.0 * 34.0));
+    std::cout << "testStaticField: Passed\n";
+}
+
+/**
+ * @brief Tests that incremental updates match a field built from scratch.
+ */
+void TestDistanceField::testIncrementalUpdates() {
+    Map map(80, 60);
+    std::srand(5);
+    fillRandom(map, 3);
+    DistanceField field(map);
+
+    for (int round = 0; round < 30; ++round) {
+        // Flip a few cells, and sometimes add or remove a whole wall
+        for (int i = 0; i < 15; ++i) {
+            const int x = std::rand() % 80;
+            const int y = std::rand() % 60;
+            map.setGrid(x, y, map.getGrid(x, y) > 0 ? 0 : 1);
+        }
+        if (round % 5 == 0) {
+            const int wallY = std::rand() % 60;
+            for (int x = 10; x < 70; ++x) {
+                map.setGrid(x, wallY, round % 10 == 0 ? 1 : 0);
+            }
+        }
+        field.update();
+
+        DistanceField fresh(map);
+        for (int y = 0; y < 60; ++y) {
+            for (int x = 0; x < 80; ++x) {
+                assert(field.getSquaredDistance(x, y) == fresh.getSquaredDistance(x, y));
+            }
+        }
+    }
+    checkAgainstBruteForce(map, field, 0.5);
+
+    // Removing every obstacle raises the whole field
+    map.clearMap();
+    field.update();
+    assert(field.getDistance(40, 30) == std::numeric_limits<double>::infinity());
+    std::cout << "testIncrementalUpdates: Passed\n";
+}
+
+/**
+ * @brief Tests the nearest obstacle and gradient queries.
+ */
+void TestDistanceField::testGradient() {
+    Map map(30, 30);
+    for (int y = 0; y < 30; ++y) {
+        map.setGrid(5, y, 1);
+    }
+    DistanceField field(map);
+
+    double gx, gy;
+    assert(field.getGradient(12, 17, gx, gy));
+    assert(gx == 1.0 && gy == 0.0);
+    assert(!field.getGradient(5, 17, gx, gy));
+    assert(gx == 0.0 && gy == 0.0);
+    assert(!field.getGradient(-1, 17, gx, gy));
+
+    map.setGrid(20, 20, 1);
+    field.update();
+    assert(field.getGradient(23, 24, gx, gy));
+    assert(std::fabs(gx - 0.6) < 1e-12 && std::fabs(gy - 0.8) < 1e-12);
+    int ox, oy;
+    assert(field.getNearestObstacle(23, 24, ox, oy));
+    assert(ox == 20 && oy == 20);
+    std::cout << "testGradient: Passed\n";
+}
+
+/**
+ * @brief Tests the maximum distance and map resizes.
+ */
+void TestDistanceField::testMaxDistanceAndResize() {
+    Map map(50, 50);
+    map.setGrid(10, 10, 1);
+    DistanceField field(map, 5.0);
+    assert(field.getDistance(13, 14) == 5.0);
+    assert(field.getDistance(14, 14) == std::numeric_limits<double>::infinity());
+    assert(field.getDistance(40, 40) == std::numeric_limits<double>::infinity());
+
+    map.setGrid(40, 42, 1);
+    field.update();
+    assert(field.getDistance(40, 40) == 2.0);
+
+    map.setGridSize(30, 20);
+    field.update();
+    assert(field.getDistance(40, 40) == -1.0);
+    assert(field.getDistance(10, 13) == 3.0);
+    std::cout << "testMaxDistanceAndResize: Passed\n";
+}
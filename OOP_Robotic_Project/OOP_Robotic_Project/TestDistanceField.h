@@ -0,0 +1,41 @@
+#ifndef TESTDISTANCEFIELD_H
+#define TESTDISTANCEFIELD_H
+
+#include "DistanceField.h"
+
+/**
+ * @file   TestDistanceField.h
+ * @author Emirhan Kalkan
+ * @date   December, 2024
+ * @brief  Header file for the TestDistanceField class, which contains methods to test the DistanceField class.
+ */
+class TestDistanceField {
+public:
+    /**
+     * @brief Runs all the tests for the DistanceField class.
+     */
+    static void runAllTests();
+
+private:
+    /**
+     * @brief Tests a field built from scratch against a brute-force search.
+     */
+    static void testStaticField();
+
+    /**
+     * @brief Tests that incremental updates match a field built from scratch.
+     */
+    static void testIncrementalUpdates();
+
+    /**
+     * @brief Tests the nearest obstacle and gradient queries.
+     */
+    static void testGradient();
+
+    /**
+     * @brief Tests the maximum distance and map resizes.
+     */
+    static void testMaxDistanceAndResize();
+};
+
+#endif // TESTDISTANCEFIELD_H
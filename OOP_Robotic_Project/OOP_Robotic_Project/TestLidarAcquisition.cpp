@@ -0,0 +1,117 @@
+/**
+ * @file   TestLidarAcquisition.cpp
+ * @author Furkan Gemici
+ * @date   December, 2024
+ * @brief  Source file for testing the LidarAcquisition class.
+ */
+
+#include "TestLidarAcquisition.h"
+#include "LidarSensor.h"
+#include <iostream>
+#include <cassert>
+#include <chrono>
+#include <thread>
+
+/**
+ * @brief Constructor for LidarAcquisitionTest.
+ */
+LidarAcquisitionTest::LidarAcquisitionTest() {
+    api = new FestoRobotAPI();
+}
+
+/**
+ * @brief Destructor for LidarAcquisitionTest.
+ */
+LidarAcquisitionTest::~LidarAcquisitionTest() {
+    delete api;
+}
+
+/**
+ * @brief Waits until the acquisition has published at least the given number of scans.
+ */
+void LidarAcquisitionTest::waitForScans(const LidarAcquisition& acquisition, unsigned long long count) {
+    for (int i = 0; i < 2000 && acquisition.getScanCount() < count; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    assert(acquisition.getScanCount() >= count);
+}
+
+/**
+ * @brief Runs all test cases for the LidarAcquisition class.
+ */
+void LidarAcquisitionTest::runTests() {
+    std::cout << "Running LidarAcquisition tests..." << std::endl;
+    api->connect();
+
+    testStartStop();
+    testScanAccess();
+    testSensorAcquisitionMode();
+
+    api->disconnect();
+    std::cout << "All tests passed successfully!" << std::endl;
+}
+
+/**
+ * @brief Tests starting and stopping the acquisition thread.
+ */
+void LidarAcquisitionTest::testStartStop() {
+    std::cout << "Testing start/stop... ";
+    LidarAcquisition acquisition(api, 4);
+    ScanView view;
+    assert(!acquisition.getLatest(view));
+
+    assert(acquisition.start(200.0));
+    assert(!acquisition.start(200.0));
+    assert(acquisition.isRunning());
+    waitForScans(acquisition, 3);
+    acquisition.stop();
+    assert(!acquisition.isRunning());
+    assert(acquisition.getMeasuredRate() > 0.0);
+    std::cout << "Passed!" << std::endl;
+}
+
+/**
+ * @brief Tests access to the latest scan and to scans by number.
+ */
+void LidarAcquisitionTest::testScanAccess() {
+    std::cout << "Testing scan access... ";
+    LidarAcquisition acquisition(api, 4);
+    acquisition.start(0.0);
+    waitForScans(acquisition, 10);
+    acquisition.stop();
+
+    ScanView latest;
+    assert(acquisition.getLatest(latest));
+    assert(latest.scanNumber == acquisition.getScanCount());
+    assert(latest.count == acquisition.getBeamCount());
+    assert(acquisition.isCurrent(latest));
+
+    ScanView previous;
+    assert(acquisition.getScan(latest.scanNumber - 1, previous));
+    assert(previous.timestamp <= latest.timestamp);
+    assert(!acquisition.getScan(latest.scanNumber - 4, previous)); // Overwritten
+    assert(!acquisition.getScan(latest.scanNumber + 1, previous)); // Not yet published
+    std::cout << "Passed!" << std::endl;
+}
+
+/**
+ * @brief Tests the acquisition mode of LidarSensor.
+ */
+void LidarAcquisitionTest::testSensorAcquisitionMode() {
+    std::cout << "Testing LidarSensor acquisition mode... ";
+    LidarSensor sensor(api, 5);
+    sensor.startAcquisition(200.0);
+    assert(sensor.getAcquisition() != nullptr);
+    waitForScans(*sensor.getAcquisition(), 2);
+
+    sensor.update();
+    ScanView latest;
+    assert(sensor.getAcquisition()->getLatest(latest));
+    int minIndex;
+    assert(sensor.getMin(minIndex) > 0.0 && minIndex >= 0);
+
+    sensor.stopAcquisition();
+    assert(sensor.getAcquisition() == nullptr);
+    sensor.update();
+    std::cout << "Passed!" << std::endl;
+}
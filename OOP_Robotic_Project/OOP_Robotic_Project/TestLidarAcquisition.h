@@ -0,0 +1,53 @@
+/**
+ * @file   TestLidarAcquisition.h
+ * @author Furkan Gemici
+ * @date   December, 2024
+ * @brief  Header file for testing the LidarAcquisition class.
+ */
+
+#pragma once
+#include "../../oop_project/Project_Packet/FestoRobotAPI.h"
+#include "LidarAcquisition.h"
+
+ /**
+  * @class LidarAcquisitionTest
+  * @brief A test class to validate the background Lidar acquisition.
+  */
+class LidarAcquisitionTest {
+private:
+    FestoRobotAPI* api; /*!< Pointer to a FestoRobotAPI object for testing. */
+
+    //! Waits until the acquisition has published at least the given number of scans
+    void waitForScans(const LidarAcquisition& acquisition, unsigned long long count);
+
+public:
+    /**
+     * @brief Constructor for LidarAcquisitionTest.
+     */
+    LidarAcquisitionTest();
+
+    /**
+     * @brief Destructor for LidarAcquisitionTest.
+     */
+    ~LidarAcquisitionTest();
+
+    /**
+     * @brief Runs all test cases for the LidarAcquisition class.
+     */
+    void runTests();
+
+    /**
+     * @brief Tests starting and stopping the acquisition thread.
+     */
+    void testStartStop();
+
+    /**
+     * @brief Tests access to the latest scan and to scans by number.
+     */
+    void testScanAccess();
+
+    /**
+     * @brief Tests the acquisition mode of LidarSensor.
+     */
+    void testSensorAcquisitionMode();
+};
@@ -14,6 +14,10 @@
 #include <cstdlib>
 #include <ctime>
 #include <stdexcept>
+#include <cmath>
+#include <atomic>
+#include <thread>
+#include <vector>
 #include "LidarSensor.h"
 #include "../../oop_project/Project_Packet/FestoRobotAPI.h"
 
@@ -51,6 +55,10 @@ void LidarSensorTest::runTests() {
     testGetMax();
     testOperatorOverloading();
     testGetAngle();
+    testDoubleBuffering();
+    testAngularLayout();
+    testSectors();
+    testStorageTypes();
 
     api->disconnect(); // Robottan balanty kesme
     std::cout << "All tests passed successfully!" << std::endl;
@@ -61,6 +69,7 @@ void LidarSensorTest::runTests() {
  */
 void LidarSensorTest::testConstructor() {
     std::cout << "Testing constructor... ";
+    assert(lidarSensor->getRangeNumber() == 5);
     for (int i = 0; i < 5; ++i) {
         assert(lidarSensor->getRange(i) == 0.0); // Balang deerleri 0.0 olmal
     }
@@ -73,7 +82,9 @@ void LidarSensorTest::testConstructor() {
 void LidarSensorTest::testUpdate() {
     std::cout << "Testing update function... ";
     lidarSensor->update();
-    for (int i = 0; i < 5; ++i) {
+    // The sensor adopts the number of ranges the API delivers
+    assert(lidarSensor->getRangeNumber() == api->getLidarRangeNumber());
+    for (int i = 0; i < lidarSensor->getRangeNumber(); ++i) {
         assert(lidarSensor->getRange(i) >= 0.0); // Gncellenmi deerler geerli olmal
     }
     std::cout << "Passed!" << std::endl;
@@ -85,7 +96,7 @@ void LidarSensorTest::testUpdate() {
 void LidarSensorTest::testGetRange() {
     std::cout << "Testing getRange function... ";
     lidarSensor->update();
-    for (int i = 0; i < 5; ++i) {
+    for (int i = 0; i < lidarSensor->getRangeNumber(); ++i) {
         assert(lidarSensor->getRange(i) >= 0.0);
     }
     try {
@@ -94,7 +105,7 @@ void LidarSensorTest::testGetRange() {
     }
     catch (const std::out_of_range&) {}
     try {
-        lidarSensor->getRange(5); // Geersiz indeks
+        lidarSensor->getRange(lidarSensor->getRangeNumber()); // Geersiz indeks
         assert(false);
     }
     catch (const std::out_of_range&) {}
@@ -110,7 +121,7 @@ void LidarSensorTest::testGetMin() {
     lidarSensor->update();
     int minIndex;
     double minValue = lidarSensor->getMin(minIndex);
-    assert(minValue >= 0.0 && minIndex >= 0 && minIndex < 5);
+    assert(minValue >= 0.0 && minIndex >= 0 && minIndex < lidarSensor->getRangeNumber());
     std::cout << "Passed!" << std::endl;
 }
 
@@ -122,7 +133,7 @@ void LidarSensorTest::testGetMax() {
     lidarSensor->update();
     int maxIndex;
     double maxValue = lidarSensor->getMax(maxIndex);
-    assert(maxValue >= 0.0 && maxIndex >= 0 && maxIndex < 5);
+    assert(maxValue >= 0.0 && maxIndex >= 0 && maxIndex < lidarSensor->getRangeNumber());
     std::cout << "Passed!" << std::endl;
 }
 
@@ -132,7 +143,7 @@ void LidarSensorTest::testGetMax() {
 void LidarSensorTest::testOperatorOverloading() {
     std::cout << "Testing operator[] overloading... ";
     lidarSensor->update();
-    for (int i = 0; i < 5; ++i) {
+    for (int i = 0; i < lidarSensor->getRangeNumber(); ++i) {
         assert((*lidarSensor)[i] >= 0.0);
     }
     std::cout << "Passed!" << std::endl;
@@ -143,11 +154,169 @@ void LidarSensorTest::testOperatorOverloading() {
  */
 void LidarSensorTest::testGetAngle() {
     std::cout << "Testing getAngle function... ";
-    for (int i = 0; i < 5; ++i) {
-        double expectedAngle = i * (360.0 / 5);
+    const int count = lidarSensor->getRangeNumber();
+    for (int i = 0; i < count; ++i) {
+        double expectedAngle = i * (360.0 / count);
         assert(lidarSensor->getAngle(i) == expectedAngle);
     }
     assert(lidarSensor->getAngle(-1) == -1.0); // Geersiz indeks
-    assert(lidarSensor->getAngle(5) == -1.0);
+    assert(lidarSensor->getAngle(count) == -1.0);
+    std::cout << "Passed!" << std::endl;
+}
+
+/**
+ * @brief Tests that consecutive `update` calls always expose a complete scan.
+ */
+void LidarSensorTest::testDoubleBuffering() {
+    std::cout << "Testing double buffering... ";
+    lidarSensor->update();
+    const int count = lidarSensor->getRangeNumber();
+
+    // A reader thread checks that every copy and its statistics come from one complete scan
+    std::atomic<bool> done(false);
+    std::atomic<int> reads(0);
+    std::thread reader([&]() {
+        std::vector<float> ranges;
+        ScanStatistics stats, expected;
+        while (!done.load() || reads.load() == 0) {
+            lidarSensor->copyScan(ranges, stats);
+            assert(static_cast<int>(ranges.size()) == count);
+            ScanAnalyzer::computeStatistics(ranges.data(), count, expected);
+            assert(stats.minIndex == expected.minIndex && stats.maxIndex == expected.maxIndex);
+            assert(stats.min == expected.min && stats.max == expected.max);
+            assert(stats.validCount == expected.validCount);
+
+            int minIndex, maxIndex;
+            lidarSensor->getMin(minIndex);
+            lidarSensor->getMax(maxIndex);
+            assert(minIndex >= -1 && minIndex < count && maxIndex >= -1 && maxIndex < count);
+            assert(lidarSensor->getRangeNumber() == count);
+            reads.fetch_add(1);
+        }
+    });
+    for (int scan = 0; scan < 200; ++scan) {
+        lidarSensor->update();
+    }
+    done.store(true);
+    reader.join();
+    assert(reads.load() > 0);
+
+    // Between updates, the same scan is seen through every query
+    std::vector<float> ranges;
+    ScanStatistics stats;
+    lidarSensor->copyScan(ranges, stats);
+    for (int i = 0; i < count; ++i) {
+        assert(lidarSensor->getRange(i) == ranges[i] && (*lidarSensor)[i] == ranges[i]);
+        assert(lidarSensor->getRangeData()[i] == ranges[i]);
+    }
+    int minIndex;
+    assert(lidarSensor->getMin(minIndex) == stats.min && minIndex == stats.minIndex);
+    std::cout << "Passed!" << std::endl;
+}
+
+/**
+ * @brief Tests the configurable angular layout and the angle tables.
+ */
+void LidarSensorTest::testAngularLayout() {
+    std::cout << "Testing angular layout... ";
+    lidarSensor->setAngularLayout(180.0, -90.0);
+    assert(lidarSensor->getAngle(0) == -90.0);
+    assert(lidarSensor->getAngle(1) == -90.0 + 180.0 / lidarSensor->getRangeNumber());
+    assert(std::fabs(lidarSensor->getSinTable()[0] + 1.0f) < 1e-6);
+
+    lidarSensor->update();
+    PointBatch points;
+    lidarSensor->projectScan(points);
+    assert(points.size() == lidarSensor->getRangeNumber());
+    for (int i = 0; i < lidarSensor->getRangeNumber(); ++i) {
+        double expectedX = lidarSensor->getRange(i) * std::cos(lidarSensor->getAngle(i) * 3.14159265358979323846 / 180.0);
+        assert(std::fabs(points.getX()[i] - expectedX) < 1e-4);
+    }
+
+    lidarSensor->setAngularLayout(360.0, 0.0);
+    std::cout << "Passed!" << std::endl;
+}
+
+/**
+ * @brief Tests the cached scan statistics and sector queries.
+ */
+void LidarSensorTest::testSectors() {
+    std::cout << "Testing sectors... ";
+    lidarSensor->update();
+    assert(lidarSensor->getSectorCount() == 4);
+
+    // A sector minimum is the smallest range among the beams inside the sector
+    auto inSector = [this](int beam, double start, double end) {
+        double offset = std::fmod(lidarSensor->getAngle(beam) - start, 360.0);
+        return (offset < 0.0 ? offset + 360.0 : offset) < end - start;
+    };
+    auto checkSector = [&](int sector, double start, double end) {
+        int index;
+        double value = lidarSensor->getSectorMin(sector, index);
+        double expected = INFINITY;
+        for (int i = 0; i < lidarSensor->getRangeNumber(); ++i) {
+            if (inSector(i, start, end) && lidarSensor->getRange(i) < expected) {
+                expected = lidarSensor->getRange(i);
+            }
+        }
+        assert(value == expected);
+        assert(index >= 0 && inSector(index, start, end) && lidarSensor->getRange(index) == value);
+    };
+    checkSector(SECTOR_FRONT, -45.0, 45.0);
+    checkSector(SECTOR_LEFT, 45.0, 135.0);
+    checkSector(SECTOR_RIGHT, 225.0, 315.0);
+
+    lidarSensor->setEqualSectors(5);
+    assert(lidarSensor->getSectorCount() == 5);
+    for (int k = 0; k < 5; ++k) {
+        checkSector(k, k * 72.0, (k + 1) * 72.0);
+    }
+    int index;
+    try {
+        lidarSensor->getSectorMin(5, index);
+        assert(false);
+    }
+    catch (const std::out_of_range&) {}
+
+    int minIndex;
+    double minValue = lidarSensor->getMin(minIndex);
+    assert(lidarSensor->getStatistics().validCount == lidarSensor->getRangeNumber());
+    assert(minValue == lidarSensor->getStatistics().min);
+
+    lidarSensor->setStandardSectors();
+    std::cout << "Passed!" << std::endl;
+}
+
+/**
+ * @brief Tests the double and millimetre storage types against the same query API.
+ */
+void LidarSensorTest::testStorageTypes() {
+    std::cout << "Testing storage types... ";
+    DoubleLidarSensor doubleSensor(api, 5);
+    MillimetreLidarSensor compactSensor(api, 5);
+    doubleSensor.update();
+    compactSensor.update();
+
+    for (int i = 0; i < compactSensor.getRangeNumber(); ++i) {
+        assert(doubleSensor.getRange(i) == doubleSensor.getRawData()[i]);
+        assert(doubleSensor.getRange(i) == doubleSensor.getRangeData()[i]);
+
+        // Millimetre storage: whole millimetres, identical through every accessor
+        double range = compactSensor.getRange(i);
+        assert(std::fabs(range * 1000.0 - std::floor(range * 1000.0 + 0.5)) < 1e-3);
+        assert(range == compactSensor[i]);
+        assert(static_cast<float>(range) == compactSensor.getRangeData()[i]);
+        assert(compactSensor.getRawData()[i] == RangeCodec<unsigned short>::fromMetres(static_cast<float>(range)));
+    }
+
+    int minIndex;
+    double minValue = compactSensor.getMin(minIndex);
+    assert(minValue == compactSensor.getRange(minIndex));
+    assert(compactSensor.getStatistics().validCount == compactSensor.getRangeNumber());
+
+    PointBatch points;
+    compactSensor.projectScan(points);
+    assert(points.size() == compactSensor.getRangeNumber());
+    assert(std::fabs(points.getX()[0] - compactSensor.getRange(0)) < 1e-6);
     std::cout << "Passed!" << std::endl;
 }
@@ -77,4 +77,24 @@ public:
      * @brief Tests the `getAngle` function of LidarSensor.
      */
     void testGetAngle();
+
+    /**
+     * @brief Tests that readers on another thread always see a complete scan while `update` runs.
+     */
+    void testDoubleBuffering();
+
+    /**
+     * @brief Tests the configurable angular layout and the angle tables.
+     */
+    void testAngularLayout();
+
+    /**
+     * @brief Tests the cached scan statistics and sector queries.
+     */
+    void testSectors();
+
+    /**
+     * @brief Tests the double and millimetre storage types against the same query API.
+     */
+    void testStorageTypes();
 };
@@ -0,0 +1,120 @@
+/**
+ * @file   TestLineExtractor.cpp
+ * @author Furkan Gemici
+ * @date   December, 2024
+ * @brief  Source file for testing the LineExtractor class.
+ */
+
+#include "TestLineExtractor.h"
+#include "ScanProjector.h"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace {
+    const int BEAMS = 360;
+
+    /**
+     * @brief Simulates a full-circle scan of an 8 m x 5 m room centred on the origin.
+     *
+     * @param noise Amplitude of a deterministic pseudo-random range error (meters).
+     */
+    void simulateRoom(double x, double y, double noise, PointBatch& out) {
+        std::vector<float> ranges(BEAMS), cosTable(BEAMS), sinTable(BEAMS);
+        unsigned int seed = 12345;
+        for (int i = 0; i < BEAMS; ++i) {
+            double angle = i * M_PI / 180.0;
+            double c = std::cos(angle), s = std::sin(angle);
+            double tx = c > 0 ? (4.0 - x) / c : c < 0 ? (-4.0 - x) / c : INFINITY;
+            double ty = s > 0 ? (2.5 - y) / s : s < 0 ? (-2.5 - y) / s : INFINITY;
+            seed = seed * 1103515245u + 12345u;
+            double error = noise * (((seed >> 16) & 0x7FFF) / 16383.5 - 1.0);
+            ranges[i] = static_cast<float>(std::fmin(tx, ty) + error);
+            cosTable[i] = static_cast<float>(c);
+            sinTable[i] = static_cast<float>(s);
+        }
+        ScanProjector::project(ranges.data(), cosTable.data(), sinTable.data(), BEAMS, out);
+    }
+}
+
+/**
+ * @brief Runs all test cases for the LineExtractor class.
+ */
+void TestLineExtractor::runAllTests() {
+    std::cout << "Running LineExtractor tests...\n";
+    testRoom();
+    testNoiseAndInvalidBeams();
+    testBufferReuse();
+    std::cout << "All LineExtractor tests passed successfully!\n";
+}
+
+/**
+ * @brief Tests that the four walls and corners of a room are found.
+ */
+void TestLineExtractor::testRoom() {
+    PointBatch scan;
+    simulateRoom(0.5, 0.3, 0.0, scan);
+    LineExtractor extractor;
+    assert(extractor.extract(scan, true) == 4);
+    for (const LineSegment& segment : extractor.getSegments()) {
+        // Walls are at x = 4 - 0.5, x = -4 - 0.5, y = 2.5 - 0.3, y = -2.5 - 0.3
+        double d = segment.distance;
+        assert(std::fabs(d - 3.5) < 0.01 || std::fabs(d - 4.5) < 0.01 ||
+            std::fabs(d - 2.2) < 0.01 || std::fabs(d - 2.8) < 0.01);
+        assert(segment.varAlpha >= 0.0f && segment.varDistance >= 0.0f);
+    }
+
+    const std::vector<CornerFeature>& corners = extractor.getCorners();
+    assert(corners.size() == 4);
+    for (const CornerFeature& corner : corners) {
+        // Beams near a corner are within the deviation gate of both walls
+        assert(std::fabs(std::fabs(corner.x) - (corner.x > 0 ? 3.5 : 4.5)) < 0.01);
+        assert(std::fabs(std::fabs(corner.y) - (corner.y > 0 ? 2.2 : 2.8)) < 0.01);
+        assert(std::fabs(corner.angle - 90.0f) < 0.5f);
+    }
+    std::cout << "testRoom: Passed\n";
+}
+
+/**
+ * @brief Tests extraction from noisy ranges with invalid beams.
+ */
+void TestLineExtractor::testNoiseAndInvalidBeams() {
+    PointBatch scan;
+    simulateRoom(-1.0, 0.5, 0.005, scan);
+    for (int i = 100; i < 103; ++i) {
+        scan.getX()[i] = NAN;
+        scan.getY()[i] = NAN;
+    }
+    LineExtractor extractor;
+    assert(extractor.extract(scan, true) == 4);
+    for (const LineSegment& segment : extractor.getSegments()) {
+        assert(segment.varDistance > 0.0f);
+        assert(std::sqrt(segment.varDistance) < 0.01f);
+    }
+    assert(extractor.getCorners().size() == 4);
+    std::cout << "testNoiseAndInvalidBeams: Passed\n";
+}
+
+/**
+ * @brief Tests that repeated extraction reuses the output buffers.
+ */
+void TestLineExtractor::testBufferReuse() {
+    PointBatch scan;
+    LineExtractor extractor;
+    simulateRoom(0.0, 0.0, 0.0, scan);
+    extractor.extract(scan, true);
+    const LineSegment* segments = extractor.getSegments().data();
+    const CornerFeature* corners = extractor.getCorners().data();
+    for (int i = 1; i < 20; ++i) {
+        simulateRoom(0.05 * i, -0.02 * i, 0.0, scan);
+        assert(extractor.extract(scan, true) == 4);
+        assert(extractor.getSegments().data() == segments);
+        assert(extractor.getCorners().data() == corners);
+    }
+    std::cout << "testBufferReuse: Passed\n";
+}
@@ -0,0 +1,37 @@
+/**
+ * @file   TestLineExtractor.h
+ * @author Furkan Gemici
+ * @date   December, 2024
+ * @brief  Header file for testing the LineExtractor class.
+ */
+
+#pragma once
+#include "LineExtractor.h"
+
+ /**
+  * @class TestLineExtractor
+  * @brief A test class to validate line and corner extraction.
+  */
+class TestLineExtractor {
+public:
+    /**
+     * @brief Runs all test cases for the LineExtractor class.
+     */
+    static void runAllTests();
+
+private:
+    /**
+     * @brief Tests that the four walls and corners of a room are found.
+     */
+    static void testRoom();
+
+    /**
+     * @brief Tests extraction from noisy ranges with invalid beams.
+     */
+    static void testNoiseAndInvalidBeams();
+
+    /**
+     * @brief Tests that repeated extraction reuses the output buffers.
+     */
+    static void testBufferReuse();
+};
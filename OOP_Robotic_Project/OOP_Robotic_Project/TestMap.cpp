@@ -1,58 +1,327 @@
-#ifndef TESTMAP_H
-#define TESTMAP_H
-
-#include "Map.h"
+#include "TestMap.h"
 #include <iostream>
+#include <cassert>
+#include <cstdint>
+#include <sstream>
 
 /**
- * @file   TestMap.h
+ * @file   TestMap.cpp
  * @author Emirhan Kalkan
  * @date   December, 2024
- * @brief  Header file for the TestMap class, which contains methods to test the Map class.
+ * @brief  Implementation of the test methods for the Map class.
  *
- * This file contains the definition of the TestMap class, including methods for running tests
- * on the Map class, covering various functionalities like constructors, methods, and grid resizing.
- */
-class TestMap {
-public:
-    /**
-     * @brief Runs all the tests for the Map class.
-     *
-     * This method runs a series of tests to ensure that the Map class is functioning as expected.
-     */
-    void runAllTests();
-
-private:
-    /**
-     * @brief Tests the constructor of the Map class.
-     */
-    void testConstructor();
-
-    /**
-     * @brief Tests the clearMap method of the Map class.
-     */
-    void testClearMap();
-
-    /**
-     * @brief Tests the insertPoint method of the Map class.
-     */
-    void testInsertPoint();
-
-    /**
-     * @brief Tests the getGrid and setGrid methods of the Map class.
-     */
-    void testGetAndSetGrid();
-
-    /**
-     * @brief Tests the addGridSize method of the Map class to resize the grid.
-     */
-    void testResizeGrid();
-
-    /**
-     * @brief Tests the showMap method of the Map class.
-     */
-    void testShowMap();
-};
-
-#endif // TESTMAP_H
+ * This file contains the implementation of the TestMap class, which tests the functionality
+ * of the Map class: construction, clearing, point insertion, grid access, resizing, display,
+ * the contiguous cell layout, and change tracking.
+ */
+
+ /**
+  * @brief Runs all the tests for the Map class.
+  */
+void TestMap::runAllTests() {
+    std::cout << "Running tests for Map...\n";
+    testConstructor();
+    testClearMap();
+    testInsertPoint();
+    testGetAndSetGrid();
+    testResizeGrid();
+    testShowMap();
+    testRowLayout();
+    testCopy();
+    testDirtyRegions();
+    testDeltas();
+    testIncrementalClear();
+    std::cout << "All Map tests passed successfully!\n";
+}
+
+/**
+ * @brief Tests the constructor of the Map class.
+ */
+void TestMap::testConstructor() {
+    Map map(12, 7);
+    assert(map.getNumberX() == 12);
+    assert(map.getNumberY() == 7);
+    for (int y = 0; y < 7; ++y) {
+        for (int x = 0; x < 12; ++x) {
+            assert(map.getGrid(x, y) == 0);
+        }
+    }
+    std::cout << "testConstructor: Passed\n";
+}
+
+/**
+ * @brief Tests the clearMap method of the Map class.
+ */
+void TestMap::testClearMap() {
+    Map map(5, 5);
+    map.setGrid(1, 1, 1);
+    map.setGrid(4, 4, 1);
+    map.clearMap();
+    assert(map.getGrid(1, 1) == 0);
+    assert(map.getGrid(4, 4) == 0);
+    std::cout << "testClearMap: Passed\n";
+}
+
+/**
+ * @brief Tests the insertPoint method of the Map class.
+ */
+void TestMap::testInsertPoint() {
+    Map map(5, 5);
+    map.insertPoint(Point(2, 3));
+    map.insertPoint(Point(7, 1));  // Out of bounds, ignored
+    assert(map.getGrid(2, 3) == 1);
+    assert(map.getGrid(3, 2) == 0);
+    std::cout << "testInsertPoint: Passed\n";
+}
+
+/**
+ * @brief Tests the getGrid and setGrid methods of the Map class.
+ */
+void TestMap::testGetAndSetGrid() {
+    Map map(5, 5);
+    map.setGrid(0, 4, 2);
+    assert(map.getGrid(0, 4) == 2);
+    assert(map.getGrid(-1, 0) == -1);
+    assert(map.getGrid(0, 5) == -1);
+    map.setGrid(5, 0, 1);  // Out of bounds, ignored
+    std::cout << "testGetAndSetGrid: Passed\n";
+}
+
+/**
+ * @brief Tests the addGridSize and setGridSize methods of the Map class.
+ */
+void TestMap::testResizeGrid() {
+    Map map(3, 3);
+    map.setGrid(2, 2, 1);
+    map.addGridSize(70, 2);
+    assert(map.getNumberX() == 73 && map.getNumberY() == 5);
+    assert(map.getGrid(2, 2) == 1);
+    assert(map.getGrid(72, 4) == 0);
+
+    map.setGridSize(2, 2);
+    assert(map.getNumberX() == 2 && map.getNumberY() == 2);
+    assert(map.getGrid(2, 2) == -1);
+    map.setGridSize(4, 4);
+    assert(map.getGrid(2, 2) == 0);  // Cells cut off by the shrink are gone
+    std::cout << "testResizeGrid: Passed\n";
+}
+
+/**
+ * @brief Tests the showMap method of the Map class.
+ */
+void TestMap::testShowMap() {
+    Map map(3, 2);
+    map.setGrid(1, 0, 1);
+
+    std::stringstream buffer;
+    std::streambuf* old = std::cout.rdbuf(buffer.rdbuf());
+    map.showMap();
+    std::cout.rdbuf(old);
+    assert(buffer.str() == ". x . \n. . . \n");
+    std::cout << "testShowMap: Passed\n";
+}
+
+/**
+ * @brief Tests the aligned row layout and the unchecked accessors.
+ */
+void TestMap::testRowLayout() {
+    Map map(100, 3);
+    assert(map.getStride() >= 100 && map.getStride() % 64 == 0);
+    for (int y = 0; y < 3; ++y) {
+        assert(reinterpret_cast<std::uintptr_t>(map.getRow(y)) % 64 == 0);
+    }
+    map.cellAt(99, 2) = 1;
+    assert(map.getGrid(99, 2) == 1);
+    assert(map.getRow(2)[99] == 1);
+    assert(map.getRow(1) + map.getStride() == map.getRow(2));
+    std::cout << "testRowLayout: Passed\n";
+}
+
+/**
+ * @brief Tests that copies own their cells.
+ */
+void TestMap::testCopy() {
+    Map original(4, 4);
+    original.setGrid(1, 2, 1);
+    Map copy(original);
+    Map assigned;
+    assigned = original;
+    original.clearMap();
+    assert(copy.getGrid(1, 2) == 1);
+    assert(assigned.getGrid(1, 2) == 1);
+    assert(assigned.getNumberX() == 4);
+    std::cout << "testCopy: Passed\n";
+}
+
+/**
+ * @brief Tests the dirty tile tracking.
+ */
+void TestMap::testDirtyRegions() {
+    Map map(100, 70);
+    std::vector<MapRegion> regions;
+
+    // A new map is entirely dirty
+    map.getDirtyRegions(regions);
+    assert(regions.size() == 3);
+    assert(regions[0].x0 == 0 && regions[0].x1 == 99 && regions[0].y0 == 0 && regions[0].y1 == 31);
+    assert(regions[2].y0 == 64 && regions[2].y1 == 69);
+
+    map.clearDirty();
+    map.getDirtyRegions(regions);
+    assert(regions.empty());
+
+    // Writing a value a cell already has is not a change
+    const unsigned long long version = map.getVersion();
+    map.setGrid(5, 5, 0);
+    map.setGrid(-1, 5, 1);
+    assert(map.getVersion() == version);
+    map.getDirtyRegions(regions);
+    assert(regions.empty());
+
+    map.setGrid(40, 5, 1);
+    map.setGrid(70, 10, 1);
+    map.insertPoint(Point(99, 69));
+    map.getDirtyRegions(regions);
+    assert(regions.size() == 2);
+    assert(regions[0].x0 == 32 && regions[0].x1 == 95 && regions[0].y0 == 0 && regions[0].y1 == 31);
+    assert(regions[1].x0 == 96 && regions[1].x1 == 99 && regions[1].y0 == 64 && regions[1].y1 == 69);
+
+    // Direct writes are reported with markDirty
+    map.clearDirty();
+    map.cellAt(3, 40) = 1;
+    map.markDirty(3, 40);
+    map.markDirty(-10, -10, 5, 5);
+    map.getDirtyRegions(regions);
+    assert(regions.size() == 2);
+    assert(regions[0].x0 == 0 && regions[0].y0 == 0 && regions[0].x1 == 31);
+    assert(regions[1].x0 == 0 && regions[1].y0 == 32);
+    assert(map.getVersion() > version);
+    std::cout << "testDirtyRegions: Passed\n";
+}
+
+/**
+ * @brief Tests mirroring a map through deltas.
+ */
+void TestMap::testDeltas() {
+    Map source(150, 90);
+    Map mirror(1, 1);
+    std::vector<unsigned char> delta;
+
+    // The first delta carries the whole map
+    unsigned long long seen = source.exportDelta(0, delta);
+    assert(mirror.applyDelta(delta.data(), delta.size()));
+    assert(mirror.getNumberX() == 150 && mirror.getNumberY() == 90);
+
+    for (int cycle = 0; cycle < 20; ++cycle) {
+        for (int i = 0; i < 10; ++i) {
+            source.setGrid((cycle * 37 + i * 11) % 150, (cycle * 13 + i * 7) % 90, 1 + (cycle + i) % 3);
+        }
+        seen = source.exportDelta(seen, delta);
+        // At most 10 tiles of 32x32 cells, far less than the map
+        assert(delta.size() < 10 * (8 + 32 * 32) + 32);
+        assert(mirror.applyDelta(delta.data(), delta.size()));
+    }
+    for (int y = 0; y < 90; ++y) {
+        for (int x = 0; x < 150; ++x) {
+            assert(mirror.getGrid(x, y) == source.getGrid(x, y));
+        }
+    }
+
+    // Nothing changed: an empty delta
+    assert(source.exportDelta(seen, delta) == seen);
+    assert(delta.size() == 28);
+
+    // Malformed deltas leave the map unchanged
+    source.setGrid(0, 0, 9);
+    source.exportDelta(seen, delta);
+    assert(!mirror.applyDelta(delta.data(), delta.size() - 1));
+    assert(!mirror.applyDelta(delta.data(), 10));
+    assert(mirror.getGrid(0, 0) != 9);
+    assert(mirror.applyDelta(delta.data(), delta.size()));
+    assert(mirror.getGrid(0, 0) == 9);
+
+    // Resizes reach the mirror
+    source.setGridSize(40, 30);
+    source.exportDelta(seen, delta);
+    assert(mirror.applyDelta(delta.data(), delta.size()));
+    assert(mirror.getNumberX() == 40 && mirror.getNumberY() == 30);
+    assert(mirror.getGrid(0, 0) == 9);
+    std::cout << "testDeltas: Passed\n";
+}
+
+/**
+ * @brief Tests that clears only rewrite the tiles changed since the previous clear.
+ */
+void TestMap::testIncrementalClear() {
+    Map map(200, 100);
+    std::vector<MapRegion> regions;
+
+    // Clearing a fresh map changes nothing
+    map.clearDirty();
+    unsigned long long version = map.getVersion();
+    map.clearMap();
+    assert(map.getVersion() == version);
+    map.getDirtyRegions(regions);
+    assert(regions.empty());
+
+    // Only the written tiles are cleared and reported
+    map.setGrid(5, 5, 1);
+    map.setGrid(150, 80, 7);
+    map.clearDirty();
+    map.clearMap();
+    assert(map.getGrid(5, 5) == 0 && map.getGrid(150, 80) == 0);
+    map.getDirtyRegions(regions);
+    assert(regions.size() == 2);
+    assert(regions[0].x0 == 0 && regions[0].x1 == 31 && regions[0].y0 == 0);
+    assert(regions[1].x0 == 128 && regions[1].x1 == 159 && regions[1].y0 == 64);
+    assert(map.getTileVersion(0, 0) == map.getVersion());
+    assert(map.getTileVersion(1, 0) < map.getVersion());
+
+    // Cells written directly and reported with markDirty are cleared too
+    map.cellAt(199, 99) = 3;
+    map.markDirty(199, 99);
+    map.clearMap();
+    assert(map.getGrid(199, 99) == 0);
+
+#if defined(NDEBUG) && defined(ROBOT_MAP_VERIFY_CLEAR)
+    // The release safety net finds a write not reported with markDirty and sweeps the whole map
+    map.cellAt(40, 70) = 5;
+    map.clearMap();
+    assert(map.getGrid(40, 70) == 0);
+#endif
+
+    // Clearing to another value rewrites every cell, then clears are incremental again
+    map.setGrid(10, 10, 1);
+    map.clearMap(128);
+    for (int y = 0; y < 100; ++y) {
+        for (int x = 0; x < 200; ++x) {
+            assert(map.getGrid(x, y) == 128);
+        }
+    }
+    map.setGrid(100, 50, 1);
+    version = map.getVersion();
+    map.clearMap(128);
+    assert(map.getGrid(100, 50) == 128);
+    assert(map.getTileVersion(3, 1) == map.getVersion() && map.getVersion() == version + 1);
+
+    // Resized cells are not assumed cleared
+    map.setGridSize(260, 100);
+    map.setGrid(250, 0, 1);
+    map.clearMap(128);
+    assert(map.getGrid(250, 0) == 128 && map.getGrid(259, 99) == 128 && map.getGrid(0, 0) == 128);
 
+    // A local rebuild of a large map only clears the tiles it touched
+    Map large(1024, 1024);
+    large.clearMap(1);
+    large.clearMap(0);
+    for (int i = 0; i < 200; ++i) {
+        large.setGrid(500 + i, 500 + i % 40, 1);
+    }
+    version = large.getVersion();
+    large.clearMap();
+    assert(large.getGrid(500, 500) == 0 && large.getGrid(699, 539) == 0);
+    assert(large.getTileVersion(15, 15) == large.getVersion() && large.getTileVersion(21, 16) == large.getVersion());
+    assert(large.getTileVersion(14, 15) < version && large.getTileVersion(22, 16) < version);
+    assert(large.getTileVersion(0, 0) < version && large.getTileVersion(31, 31) < version);
+    std::cout << "testIncrementalClear: Passed\n";
+}
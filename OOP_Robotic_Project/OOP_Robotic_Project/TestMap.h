@@ -51,6 +51,31 @@ private:
      * @brief Tests the showMap method of the Map class.
      */
     static void testShowMap();
+
+    /**
+     * @brief Tests the aligned row layout and the unchecked accessors.
+     */
+    static void testRowLayout();
+
+    /**
+     * @brief Tests that copies own their cells.
+     */
+    static void testCopy();
+
+    /**
+     * @brief Tests the dirty tile tracking.
+     */
+    static void testDirtyRegions();
+
+    /**
+     * @brief Tests mirroring a map through deltas.
+     */
+    static void testDeltas();
+
+    /**
+     * @brief Tests that clears only rewrite the tiles changed since the previous clear.
+     */
+    static void testIncrementalClear();
 };
 
 #endif // TESTMAP_H
@@ -0,0 +1,188 @@
+#include "TestMapFile.h"
+#include <iostream>
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+/**
+ * @file   TestMapFile.cpp
+ * @author Emirhan Kalkan
+ * @date   December, 2024
+ * @brief  Implementation of the test methods for the binary map file format.
+ */
+
+namespace {
+    const char* MAP_FILE = "test_map_file.rmap";
+}
+
+/**
+ * @brief Runs all the tests for the MapFile class.
+ */
+void TestMapFile::runAllTests() {
+    std::cout << "Running tests for MapFile...\n";
+    testRoundTrip();
+    testInvalidFiles();
+    testLargeMap();
+    testReplaceFile();
+    std::remove(MAP_FILE);
+    std::cout << "All MapFile tests passed successfully!\n";
+}
+
+/**
+ * @brief Tests that a saved map reads back with the same header and cells.
+ */
+void TestMapFile::testRoundTrip() {
+    Map map(100, 37);
+    for (int y = 0; y < 37; ++y) {
+        for (int x = 0; x < 100; ++x) {
+            map.setGrid(x, y, (x * 31 + y * 17) % 256);
+        }
+    }
+    assert(MapFile::save(MAP_FILE, map, MAP_CELL_LOG_ODDS, 0.05, -2.5, 1.25));
+
+    MapFile file;
+    assert(!file.isOpen());
+    assert(file.open(MAP_FILE));
+    assert(file.isOpen());
+    const MapFileInfo& info = file.getInfo();
+    assert(info.sizeX == 100 && info.sizeY == 37);
+    assert(info.stride == map.getStride());
+    assert(info.cellType == MAP_CELL_LOG_ODDS);
+    assert(info.resolution == 0.05);
+    assert(info.originX == -2.5 && info.originY == 1.25);
+
+    // Cells are read in place, rows start on cache line boundaries
+    assert(reinterpret_cast<size_t>(file.getRow(1)) % 64 == 0);
+    for (int y = 0; y < 37; ++y) {
+        for (int x = 0; x < 100; ++x) {
+            assert(file.cellAt(x, y) == map.getGrid(x, y));
+        }
+    }
+    assert(file.verifyChecksum());
+
+    Map copy(3, 3);
+    assert(file.copyTo(copy));
+    assert(copy.getNumberX() == 100 && copy.getNumberY() == 37);
+    for (int y = 0; y < 37; ++y) {
+        for (int x = 0; x < 100; ++x) {
+            assert(copy.getGrid(x, y) == map.getGrid(x, y));
+        }
+    }
+
+    file.close();
+    assert(!file.isOpen());
+    assert(!file.copyTo(copy));
+
+    // An empty map is a valid file
+    Map empty(0, 0);
+    assert(MapFile::save(MAP_FILE, empty));
+    assert(file.open(MAP_FILE));
+    assert(file.getInfo().sizeX == 0 && file.verifyChecksum());
+    file.close();
+    std::cout << "testRoundTrip: Passed\n";
+}
+
+/**
+ * @brief Tests that missing, foreign and truncated files are rejected.
+ */
+void TestMapFile::testInvalidFiles() {
+    MapFile file;
+    assert(!file.open("missing_map_file.rmap"));
+
+    Map map(64, 64);
+    map.setGrid(10, 10, 1);
+    assert(MapFile::save(MAP_FILE, map));
+    std::vector<char> bytes;
+    {
+        std::ifstream in(MAP_FILE, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    assert(bytes.size() == 64 + 64 * 64);
+
+    // Wrong magic
+    bytes[0] = 'X';
+    std::ofstream(MAP_FILE, std::ios::binary).write(bytes.data(), bytes.size());
+    assert(!file.open(MAP_FILE));
+    bytes[0] = 'R';
+
+    // Truncated cell data
+    std::ofstream(MAP_FILE, std::ios::binary).write(bytes.data(), bytes.size() - 1);
+    assert(!file.open(MAP_FILE));
+
+    // Corrupted cell: opens, but the checksum fails
+    bytes[64 + 10 * 64 + 10] = 0;
+    std::ofstream(MAP_FILE, std::ios::binary).write(bytes.data(), bytes.size());
+    assert(file.open(MAP_FILE));
+    assert(!file.verifyChecksum());
+    Map copy(0, 0);
+    assert(!file.copyTo(copy));
+    file.close();
+    std::cout << "testInvalidFiles: Passed\n";
+}
+
+/**
+ * @brief Tests saving, opening in place and copying a large map.
+ */
+void TestMapFile::testLargeMap() {
+    Map map(1024, 768);
+    for (int y = 0; y < 768; y += 7) {
+        map.setGrid((y * 3) % 1024, y, 1);
+    }
+    assert(MapFile::save(MAP_FILE, map));
+
+    MapFile file;
+    assert(file.open(MAP_FILE));
+    assert(file.getInfo().sizeX == 1024 && file.getInfo().sizeY == 768);
+    assert(file.verifyChecksum());
+    for (int y = 0; y < 768; ++y) {
+        for (int x = 0; x < 1024; ++x) {
+            assert(file.cellAt(x, y) == map.getGrid(x, y));
+        }
+    }
+
+    Map copy(0, 0);
+    assert(file.copyTo(copy));
+    assert(copy.getNumberX() == 1024 && copy.getNumberY() == 768);
+    for (int y = 0; y < 768; ++y) {
+        for (int x = 0; x < 1024; ++x) {
+            assert(copy.getGrid(x, y) == map.getGrid(x, y));
+        }
+    }
+    file.close();
+    std::cout << "testLargeMap: Passed\n";
+}
+
+/**
+ * @brief Tests that saving never leaves a partly written file behind.
+ */
+void TestMapFile::testReplaceFile() {
+    Map first(40, 30), second(50, 20);
+    first.setGrid(3, 4, 1);
+    second.setGrid(7, 8, 1);
+    assert(MapFile::save(MAP_FILE, first));
+
+    // A failed save leaves no temporary file
+    assert(!MapFile::save("missing_directory/map.rmap", first));
+    assert(!std::ifstream("missing_directory/map.rmap.tmp"));
+
+    // Saving over an open file does not touch its mapping
+    MapFile file;
+    assert(file.open(MAP_FILE));
+    const bool replaced = MapFile::save(MAP_FILE, second);
+    assert(file.getInfo().sizeX == 40 && file.cellAt(3, 4) == 1);
+    assert(file.verifyChecksum());
+    file.close();
+    assert(!std::ifstream(std::string(MAP_FILE) + ".tmp"));
+
+    // Windows does not rename over an open file; the previous file then stays
+    assert(file.open(MAP_FILE));
+    assert(file.verifyChecksum());
+    if (replaced) {
+        assert(file.getInfo().sizeX == 50 && file.cellAt(7, 8) == 1);
+    } else {
+        assert(file.getInfo().sizeX == 40 && file.cellAt(3, 4) == 1);
+    }
+    file.close();
+    std::cout << "testReplaceFile: Passed\n";
+}
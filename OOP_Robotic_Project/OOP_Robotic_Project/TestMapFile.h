@@ -0,0 +1,41 @@
+#ifndef TESTMAPFILE_H
+#define TESTMAPFILE_H
+
+#include "MapFile.h"
+
+/**
+ * @file   TestMapFile.h
+ * @author Emirhan Kalkan
+ * @date   December, 2024
+ * @brief  Header file for the TestMapFile class, which contains methods to test the binary map file format.
+ */
+class TestMapFile {
+public:
+    /**
+     * @brief Runs all the tests for the MapFile class.
+     */
+    static void runAllTests();
+
+private:
+    /**
+     * @brief Tests that a saved map reads back with the same header and cells.
+     */
+    static void testRoundTrip();
+
+    /**
+     * @brief Tests that missing, foreign and truncated files are rejected.
+     */
+    static void testInvalidFiles();
+
+    /**
+     * @brief Tests saving, opening in place and copying a large map.
+     */
+    static void testLargeMap();
+
+    /**
+     * @brief Tests that saving never leaves a partly written file behind.
+     */
+    static void testReplaceFile();
+};
+
+#endif // TESTMAPFILE_H
@@ -0,0 +1,291 @@
+#include "TestMapPyramid.h"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <stdexcept>
+
+/**
+ * @file   TestMapPyramid.cpp
+ * @author Emirhan Kalkan
+ * @date   December, 2024
+ * @brief  Implementation of the test methods for the MapPyramid class.
+ */
+
+namespace {
+    /**
+     * @brief Fills a map with a sparse, reproducible pattern of occupied cells.
+     */
+    void fillRandom(Map& map, unsigned int seed, int percent) {
+        std::srand(seed);
+        for (int y = 0; y < map.getNumberY(); ++y) {
+            for (int x = 0; x < map.getNumberX(); ++x) {
+                map.setGrid(x, y, std::rand() % 100 < percent ? 1 : 0);
+            }
+        }
+    }
+
+    /**
+     * @brief Counts occupied cells in a box one cell at a time.
+     */
+    int bruteCount(const Map& map, int x0, int y0, int x1, int y1) {
+        int total = 0;
+        for (int y = y0; y <= y1; ++y) {
+            for (int x = x0; x <= x1; ++x) {
+                if (map.getGrid(x, y) > 0) {
+                    ++total;
+                }
+            }
+        }
+        return total;
+    }
+
+    /**
+     * @brief Checks that every level count equals the sum of the map cells under it.
+     */
+    void checkLevels(const Map& map, const MapPyramid& pyramid) {
+        for (int level = 1; level < pyramid.getLevelCount(); ++level) {
+            const int size = 1 << level;
+            for (int by = 0; by * size < map.getNumberY(); ++by) {
+                for (int bx = 0; bx * size < map.getNumberX(); ++bx) {
+                    assert(pyramid.getBlockCount(level, bx, by) ==
+                        bruteCount(map, bx * size, by * size, bx * size + size - 1, by * size + size - 1));
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Cell-by-cell (Amanatides-Woo) traversal used as the reference for castRay.
+     */
+    bool walkRay(const Map& map, double sx, double sy, double ex, double ey, int& hitX, int& hitY) {
+        const double dx = ex - sx;
+        const double dy = ey - sy;
+        int x = static_cast<int>(std::floor(sx));
+        int y = static_cast<int>(std::floor(sy));
+        const int endX = static_cast<int>(std::floor(ex));
+        const int endY = static_cast<int>(std::floor(ey));
+        const int stepX = dx > 0 ? 1 : -1;
+        const int stepY = dy > 0 ? 1 : -1;
+        const double inf = std::numeric_limits<double>::infinity();
+        const double deltaX = dx != 0 ? std::fabs(1.0 / dx) : inf;
+        const double deltaY = dy != 0 ? std::fabs(1.0 / dy) : inf;
+        double tMaxX = dx > 0 ? (x + 1 - sx) / dx : dx < 0 ? (x - sx) / dx : inf;
+        double tMaxY = dy > 0 ? (y + 1 - sy) / dy : dy < 0 ? (y - sy) / dy : inf;
+        while (true) {
+            if (map.getGrid(x, y) > 0) {
+                hitX = x;
+                hitY = y;
+                return true;
+            }
+            if (x == endX && y == endY) {
+                return false;
+            }
+            if (tMaxX < tMaxY) {
+                x += stepX;
+                tMaxX += deltaX;
+            }
+            else {
+                y += stepY;
+                tMaxY += deltaY;
+            }
+            if (std::min(tMaxX - deltaX, tMaxY - deltaY) > 1.0) {
+                return false;
+            }
+        }
+    }
+
+    /**
+     * @brief Returns a random coordinate in [0, size) that is never a cell boundary.
+     */
+    double randomCoordinate(int size) {
+        return (std::rand() % (size * 100)) / 100.0 + 0.003;
+    }
+}
+
+/**
+ * @brief Runs all the tests for the MapPyramid class.
+ */
+void TestMapPyramid::runAllTests() {
+    std::cout << "Running tests for MapPyramid...\n";
+    testLevels();
+    testIncrementalUpdates();
+    testMapUpdates();
+    testBoxQueries();
+    testCastRay();
+    std::cout << "All MapPyramid tests passed successfully!\n";
+}
+
+/**
+ * @brief Tests the level sizes and counts of a small map.
+ */
+void TestMapPyramid::testLevels() {
+    Map map(5, 3);
+    map.setGrid(0, 0, 1);
+    map.setGrid(4, 2, 1);
+    map.setGrid(3, 2, 1);
+    MapPyramid pyramid(map);
+
+    // 5x3 -> 3x2 -> 2x1 -> 1x1
+    assert(pyramid.getLevelCount() == 4);
+    assert(pyramid.getBlockCount(1, 0, 0) == 1);
+    assert(pyramid.getBlockCount(1, 2, 1) == 1);
+    assert(pyramid.getBlockCount(1, 1, 1) == 1);
+    assert(pyramid.getBlockCount(2, 0, 0) == 2);
+    assert(pyramid.getBlockCount(2, 1, 0) == 1);
+    assert(pyramid.getBlockCount(3, 0, 0) == 3);
+    assert(pyramid.getBlockCount(3, 1, 0) == -1);
+    assert(pyramid.getBlockCount(0, 4, 2) == 1);
+    checkLevels(map, pyramid);
+
+    Map empty(0, 0);
+    MapPyramid emptyPyramid(empty);
+    int hx, hy;
+    assert(!emptyPyramid.anyOccupied(0, 0, 10, 10));
+    assert(!emptyPyramid.castRay(0.5, 0.5, 3.5, 3.5, hx, hy));
+    std::cout << "testLevels: Passed\n";
+}
+
+/**
+ * @brief Tests that setGrid and refreshRegion keep the levels consistent.
+ */
+void TestMapPyramid::testIncrementalUpdates() {
+    Map map(37, 29);
+    fillRandom(map, 7, 10);
+    MapPyramid pyramid(map);
+    checkLevels(map, pyramid);
+
+    std::srand(11);
+    for (int i = 0; i < 500; ++i) {
+        pyramid.setGrid(std::rand() % 37, std::rand() % 29, std::rand() % 3);
+    }
+    pyramid.setGrid(-1, 5, 1);
+    pyramid.setGrid(37, 5, 1);
+    checkLevels(map, pyramid);
+
+    // Direct map writes, then a local refresh
+    for (int y = 10; y <= 14; ++y) {
+        for (int x = 20; x <= 30; ++x) {
+            map.setGrid(x, y, (x + y) % 2);
+        }
+    }
+    pyramid.refreshRegion(20, 10, 30, 14);
+    checkLevels(map, pyramid);
+
+    map.setGridSize(70, 40);
+    map.setGrid(69, 39, 1);
+    pyramid.rebuild();
+    assert(pyramid.getLevelCount() == 8);
+    checkLevels(map, pyramid);
+    std::cout << "testIncrementalUpdates: Passed\n";
+}
+
+/**
+ * @brief Tests that update() picks up direct map writes, clears and resizes.
+ */
+void TestMapPyramid::testMapUpdates() {
+    Map map(100, 70);
+    fillRandom(map, 13, 5);
+    MapPyramid pyramid(map);
+
+    // Writes through the map, on both sides of a tile seam and in a far corner
+    std::srand(17);
+    for (int i = 0; i < 300; ++i) {
+        map.setGrid(20 + std::rand() % 30, 10 + std::rand() % 40, std::rand() % 2);
+    }
+    map.setGrid(99, 69, 1);
+    pyramid.update();
+    checkLevels(map, pyramid);
+
+    // Mixed pyramid and map writes, then a clear
+    pyramid.setGrid(5, 5, 1);
+    map.setGrid(60, 60, 1);
+    pyramid.update();
+    checkLevels(map, pyramid);
+    map.clearMap();
+    pyramid.update();
+    assert(!pyramid.anyOccupied(0, 0, 99, 69));
+
+    // Queries refuse a resized map until the next update
+    map.setGridSize(40, 30);
+    map.setGrid(39, 29, 1);
+    bool thrown = false;
+    try {
+        int hitX, hitY;
+        pyramid.castRay(0.5, 0.5, 99.5, 69.5, hitX, hitY);
+    }
+    catch (const std::logic_error&) {
+        thrown = true;
+    }
+    assert(thrown);
+    pyramid.update();
+    checkLevels(map, pyramid);
+    int hitX = -1, hitY = -1;
+    assert(pyramid.castRay(0.5, 0.5, 99.5, 74.5, hitX, hitY) && hitX == 39 && hitY == 29);
+    std::cout << "testMapUpdates: Passed\n";
+}
+
+/**
+ * @brief Tests box queries against a brute-force scan.
+ */
+void TestMapPyramid::testBoxQueries() {
+    Map map(100, 80);
+    fillRandom(map, 3, 1);
+    MapPyramid pyramid(map);
+
+    std::srand(5);
+    for (int i = 0; i < 2000; ++i) {
+        const int x0 = std::rand() % 110 - 5;
+        const int y0 = std::rand() % 90 - 5;
+        const int x1 = x0 + std::rand() % 30;
+        const int y1 = y0 + std::rand() % 30;
+        const int expected = bruteCount(map, std::max(x0, 0), std::max(y0, 0), std::min(x1, 99), std::min(y1, 79));
+        assert(pyramid.countOccupied(x0, y0, x1, y1) == expected);
+        assert(pyramid.anyOccupied(x0, y0, x1, y1) == (expected > 0));
+    }
+    assert(pyramid.countOccupied(0, 0, 99, 79) == bruteCount(map, 0, 0, 99, 79));
+    assert(!pyramid.anyOccupied(50, 90, 60, 100));
+    std::cout << "testBoxQueries: Passed\n";
+}
+
+/**
+ * @brief Tests ray queries against a cell-by-cell traversal.
+ */
+void TestMapPyramid::testCastRay() {
+    Map map(128, 96);
+    fillRandom(map, 9, 1);
+    MapPyramid pyramid(map);
+
+    std::srand(13);
+    int hits = 0;
+    for (int i = 0; i < 5000; ++i) {
+        const double sx = randomCoordinate(128);
+        const double sy = randomCoordinate(96);
+        const double ex = randomCoordinate(128);
+        const double ey = randomCoordinate(96);
+        int hx = -1, hy = -1, rx = -1, ry = -1;
+        const bool hit = pyramid.castRay(sx, sy, ex, ey, hx, hy);
+        assert(hit == walkRay(map, sx, sy, ex, ey, rx, ry));
+        if (hit) {
+            assert(hx == rx && hy == ry);
+            ++hits;
+        }
+    }
+    assert(hits > 1000);
+
+    // Segments starting or ending outside the map are clipped
+    Map wall(64, 64);
+    for (int y = 0; y < 64; ++y) {
+        wall.setGrid(40, y, 1);
+    }
+    MapPyramid wallPyramid(wall);
+    int hx, hy;
+    assert(wallPyramid.castRay(-20.5, 10.5, 100.5, 10.5, hx, hy));
+    assert(hx == 40 && hy == 10);
+    assert(wallPyramid.castRay(100.5, 30.5, -20.5, 30.5, hx, hy));
+    assert(hx == 40 && hy == 30);
+    assert(!wallPyramid.castRay(-20.5, 10.5, 39.5, 10.5, hx, hy));
+    assert(!wallPyramid.castRay(-20.5, -1.5, 100.5, -1.5, hx, hy));
+    std::cout << "testCastRay: Passed\n";
+}
@@ -0,0 +1,46 @@
+#ifndef TESTMAPPYRAMID_H
+#define TESTMAPPYRAMID_H
+
+#include "MapPyramid.h"
+
+/**
+ * @file   TestMapPyramid.h
+ * @author Emirhan Kalkan
+ * @date   December, 2024
+ * @brief  Header file for the TestMapPyramid class, which contains methods to test the MapPyramid class.
+ */
+class TestMapPyramid {
+public:
+    /**
+     * @brief Runs all the tests for the MapPyramid class.
+     */
+    static void runAllTests();
+
+private:
+    /**
+     * @brief Tests the level sizes and counts of a small map.
+     */
+    static void testLevels();
+
+    /**
+     * @brief Tests that setGrid and refreshRegion keep the levels consistent.
+     */
+    static void testIncrementalUpdates();
+
+    /**
+     * @brief Tests that update() picks up direct map writes, clears and resizes.
+     */
+    static void testMapUpdates();
+
+    /**
+     * @brief Tests box queries against a brute-force scan.
+     */
+    static void testBoxQueries();
+
+    /**
+     * @brief Tests ray queries against a cell-by-cell traversal.
+     */
+    static void testCastRay();
+};
+
+#endif // TESTMAPPYRAMID_H
@@ -0,0 +1,270 @@
+#include "TestMapRenderer.h"
+#include <algorithm>
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * @file   TestMapRenderer.cpp
+ * @author Emirhan Kalkan
+ * @date   December, 2024
+ * @brief  Implementation of the test methods for the MapRenderer class.
+ */
+
+namespace {
+    const char* PGM_FILE = "test_map_renderer.pgm";
+    const char* PPM_FILE = "test_map_renderer.ppm";
+
+    /**
+     * @brief Reads a whole file as bytes.
+     */
+    std::string readFile(const char* filename) {
+        std::ifstream file(filename, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+}
+
+/**
+ * @brief Runs all the tests for the MapRenderer class.
+ */
+void TestMapRenderer::runAllTests() {
+    std::cout << "Running tests for MapRenderer...\n";
+    testFrameLayout();
+    testViewportAndZoom();
+    testOverlay();
+    testSnapshots();
+    testLargeMap();
+    std::remove(PGM_FILE);
+    std::remove(PPM_FILE);
+    std::cout << "All MapRenderer tests passed successfully!\n";
+}
+
+/**
+ * @brief Tests the frame layout and the cell characters at zoom 1.
+ */
+void TestMapRenderer::testFrameLayout() {
+    Map map(4, 3);
+    map.setGrid(1, 0, 1);
+    map.setGrid(3, 2, 1);
+
+    MapRenderer plain(5, 3, false);
+    assert(plain.render(map) == ".#.. \n.... \n...# \n");
+
+    MapRenderer ansi(5, 3);
+    std::ostringstream out;
+    ansi.draw(map, out);
+    assert(out.str() == std::string(MapRenderer::ANSI_HOME) + plain.getFrame());
+    assert(ansi.charAt(1, 0) == '#');
+    assert(ansi.charAt(4, 2) == ' ');
+
+    // Frames are overwritten in place
+    map.setGrid(1, 0, 0);
+    assert(plain.render(map) == ".... \n.... \n...# \n");
+
+    bool thrown = false;
+    try {
+        MapRenderer invalid(0, 10);
+    }
+    catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    assert(thrown);
+    std::cout << "testFrameLayout: Passed\n";
+}
+
+/**
+ * @brief Tests viewport placement and downsampling of zoomed frames.
+ */
+void TestMapRenderer::testViewportAndZoom() {
+    Map map(8, 8);
+    map.setGrid(0, 0, 1);                 // 1 of 4 cells in block (0, 0)
+    map.setGrid(2, 0, 1);                 // 2 of 4 cells in block (1, 0)
+    map.setGrid(3, 1, 1);
+    for (int y = 4; y < 8; ++y) {         // 4 of 4 cells in blocks (2, 2) and (3, 2)
+        map.setGrid(4 + y % 2, y, 1);
+        map.setGrid(6 + y % 2, y, 1);
+        map.setGrid(5 - y % 2, y, 1);
+        map.setGrid(7 - y % 2, y, 1);
+    }
+
+    MapRenderer renderer(4, 4, false);
+    renderer.setViewport(0, 0, 2);
+    assert(renderer.render(map) == "+#..\n....\n..##\n..##\n");
+
+    // A viewport partly outside the map leaves the outside blank
+    renderer.setViewport(-2, -2, 2);
+    assert(renderer.render(map) == "    \n +#.\n ...\n ..#\n");
+
+    renderer.fitMap(map);
+    assert(renderer.render(map) == "+#..\n....\n..##\n..##\n");
+    MapRenderer small(3, 3, false);
+    small.fitMap(map);
+    assert(small.render(map) == "++.\n.+#\n.##\n");
+
+    renderer.setViewport(0, 0, 1);
+    renderer.centerOn(5, 5);
+    assert(renderer.render(map) == "....\n.###\n.###\n.###\n");
+    std::cout << "testViewportAndZoom: Passed\n";
+}
+
+/**
+ * @brief Tests the robot and path overlay.
+ */
+void TestMapRenderer::testOverlay() {
+    Map map(10, 5);
+    MapRenderer renderer(10, 5, false);
+
+    std::vector<Point> path = { Point(0.5, 0.5), Point(6.5, 0.5), Point(6.5, 3.5) };
+    renderer.setPath(path);
+    renderer.setRobotPose(Pose(6.5, 3.5, 90.0));
+    assert(renderer.render(map) ==
+        "*******...\n"
+        "......*...\n"
+        "......*...\n"
+        "......v...\n"
+        "..........\n");
+
+    const double headings[] = { 0.0, 80.0, 180.0, 270.0, -90.0, 350.0, 720.0 };
+    const char arrows[] = { '>', 'v', '<', '^', '^', '>', '>' };
+    for (int i = 0; i < 7; ++i) {
+        renderer.setRobotPose(Pose(2.0, 4.0, headings[i]));
+        renderer.render(map);
+        assert(renderer.charAt(2, 4) == arrows[i]);
+    }
+
+    // Overlay outside the viewport is clipped; zoomed paths stay connected
+    renderer.setViewport(0, 0, 2);
+    renderer.setRobotPose(Pose(40.0, 2.0, 0.0));
+    renderer.setPath({ Point(-10.0, 1.0), Point(19.0, 9.0) });
+    renderer.render(map);
+    int pathChars = 0;
+    for (int row = 0; row < 5; ++row) {
+        for (int column = 0; column < 10; ++column) {
+            pathChars += renderer.charAt(column, row) == '*';
+        }
+    }
+    assert(pathChars == 10);
+
+    // Far and non-finite points: only the visible parts of finite segments are drawn
+    renderer.setViewport(0, 0, 1);
+    renderer.setRobotPose(Pose(NAN, 1e300, 0.0));
+    renderer.setPath({ Point(-1e12, 2.5), Point(1e12, 2.5), Point(NAN, 0.0), Point(4.5, 0.5), Point(4.5, -1e300) });
+    assert(renderer.render(map) ==
+        "....*.....\n"
+        "..........\n"
+        "**********\n"
+        "..........\n"
+        "..........\n");
+    renderer.setPath({ Point(4.5, 4.5), Point(4.5, 1e300), Point(INFINITY, 1.0) });
+    assert(renderer.render(map) ==
+        "..........\n"
+        "..........\n"
+        "..........\n"
+        "..........\n"
+        "....*.....\n");
+
+    renderer.clearOverlay();
+    assert(renderer.render(map).find('*') == std::string::npos);
+    std::cout << "testOverlay: Passed\n";
+}
+
+/**
+ * @brief Tests the PGM and PPM snapshots.
+ */
+void TestMapRenderer::testSnapshots() {
+    Map map(5, 4);
+    map.setGrid(0, 0, 1);
+    map.setGrid(4, 3, 200);
+
+    assert(MapRenderer::savePGM(map, PGM_FILE));
+    std::string pgm = readFile(PGM_FILE);
+    const std::string pgmHeader = "P5\n5 4\n255\n";
+    assert(pgm.size() == pgmHeader.size() + 20);
+    assert(pgm.compare(0, pgmHeader.size(), pgmHeader) == 0);
+    assert(static_cast<unsigned char>(pgm[pgmHeader.size()]) == 0);
+    assert(static_cast<unsigned char>(pgm[pgmHeader.size() + 1]) == 255);
+    assert(static_cast<unsigned char>(pgm.back()) == 0);
+
+    assert(MapRenderer::savePGM(map, PGM_FILE, true));
+    pgm = readFile(PGM_FILE);
+    assert(static_cast<unsigned char>(pgm[pgmHeader.size()]) == 254);
+    assert(static_cast<unsigned char>(pgm.back()) == 55);
+
+    MapRenderer renderer;
+    renderer.setRobotPose(Pose(2.0, 2.0, 0.0));
+    renderer.setPath({ Point(0.0, 3.0), Point(4.0, 3.0) });
+    assert(renderer.savePPM(map, PPM_FILE));
+    std::string ppm = readFile(PPM_FILE);
+    const std::string ppmHeader = "P6\n5 4\n255\n";
+    assert(ppm.size() == ppmHeader.size() + 60);
+    auto pixel = [&](int x, int y) {
+        size_t offset = ppmHeader.size() + (static_cast<size_t>(y) * 5 + x) * 3;
+        return std::string(ppm, offset, 3);
+    };
+    assert(pixel(0, 0) == std::string(3, '\0'));
+    assert(pixel(4, 0) == std::string(3, '\xff'));
+    assert(pixel(0, 3) == std::string("\0\0\xff", 3));
+    assert(pixel(1, 1) == std::string("\xff\0\0", 3));
+    assert(pixel(3, 2) == std::string("\xff\xff\0", 3));
+    assert(pixel(2, 3) == std::string("\xff\0\0", 3));
+
+    // Far and non-finite overlays are clipped or skipped
+    renderer.setRobotPose(Pose(NAN, 1e300, 0.0));
+    renderer.setPath({ Point(-1e12, 1.5), Point(1e12, 1.5), Point(NAN, 0.0), Point(4.5, 0.5), Point(4.5, -1e300) });
+    assert(renderer.savePPM(map, PPM_FILE));
+    ppm = readFile(PPM_FILE);
+    for (int x = 0; x < 5; ++x) {
+        assert(pixel(x, 1) == std::string("\0\0\xff", 3));
+    }
+    assert(pixel(4, 0) == std::string("\0\0\xff", 3));
+    assert(pixel(0, 0) == std::string(3, '\0') && pixel(2, 2) == std::string(3, '\xff'));
+    renderer.setRobotPose(Pose(-1e300, 1e300, NAN));
+    renderer.setPath({ Point(1e300, 1e300) });
+    assert(renderer.savePPM(map, PPM_FILE));
+    ppm = readFile(PPM_FILE);
+    assert(pixel(0, 3) == std::string(3, '\xff') && pixel(3, 3) == std::string(3, '\xff'));
+
+    assert(!MapRenderer::savePGM(map, "missing_directory/map.pgm"));
+    std::cout << "testSnapshots: Passed\n";
+}
+
+/**
+ * @brief Tests drawing a map much larger than the viewport.
+ */
+void TestMapRenderer::testLargeMap() {
+    Map map(400, 400);
+    for (int i = 0; i < 400; ++i) {
+        map.setGrid(i, i, 1);
+        map.setGrid(i, 200, 1);
+    }
+    MapRenderer renderer(80, 25, false);
+    std::ostringstream out;
+
+    // The whole map at zoom 16: 25 columns of map, the rest blank
+    renderer.fitMap(map);
+    renderer.draw(map, out);
+    for (int column = 0; column < 25; ++column) {
+        assert(renderer.charAt(column, 12) == '+');
+        assert(renderer.charAt(column, column) == '+');
+    }
+    assert(renderer.charAt(25, 0) == ' ' && renderer.charAt(79, 24) == ' ');
+
+    // Following the robot at zoom 1: the wall crosses the whole viewport
+    renderer.setViewport(0, 0, 1);
+    const int frames = 4;
+    for (int i = 0; i < frames; ++i) {
+        renderer.centerOn(100.0 + 50 * i, 200.0);
+        renderer.draw(map, out);
+        const std::string& frame = renderer.getFrame();
+        assert(std::count(frame.begin(), frame.end(), '#') >= 80);
+    }
+    assert(out.str().size() == renderer.getFrame().size() * (frames + 1));
+    std::cout << "testLargeMap: Passed\n";
+}
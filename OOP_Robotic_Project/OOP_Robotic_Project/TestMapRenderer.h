@@ -0,0 +1,46 @@
+#ifndef TESTMAPRENDERER_H
+#define TESTMAPRENDERER_H
+
+#include "MapRenderer.h"
+
+/**
+ * @file   TestMapRenderer.h
+ * @author Emirhan Kalkan
+ * @date   December, 2024
+ * @brief  Header file for the TestMapRenderer class, which contains methods to test the MapRenderer class.
+ */
+class TestMapRenderer {
+public:
+    /**
+     * @brief Runs all the tests for the MapRenderer class.
+     */
+    static void runAllTests();
+
+private:
+    /**
+     * @brief Tests the frame layout and the cell characters at zoom 1.
+     */
+    static void testFrameLayout();
+
+    /**
+     * @brief Tests viewport placement and downsampling of zoomed frames.
+     */
+    static void testViewportAndZoom();
+
+    /**
+     * @brief Tests the robot and path overlay.
+     */
+    static void testOverlay();
+
+    /**
+     * @brief Tests the PGM and PPM snapshots.
+     */
+    static void testSnapshots();
+
+    /**
+     * @brief Tests drawing a map much larger than the viewport.
+     */
+    static void testLargeMap();
+};
+
+#endif // TESTMAPRENDERER_H
@@ -0,0 +1,143 @@
+#include "TestMapSnapshot.h"
+#include <iostream>
+#include <cassert>
+#include <cstdlib>
+#include <thread>
+
+/**
+ * @file   TestMapSnapshot.cpp
+ * @author Emirhan Kalkan
+ * @date   December, 2024
+ * @brief  Implementation of the test methods for the MapSnapshot class.
+ */
+
+/**
+ * @brief Runs all the tests for the MapSnapshot class.
+ */
+void TestMapSnapshot::runAllTests() {
+    std::cout << "Running tests for MapSnapshot...\n";
+    testIsolation();
+    testTileSharing();
+    testConcurrentReaders();
+    std::cout << "All MapSnapshot tests passed successfully!\n";
+}
+
+/**
+ * @brief Tests that a snapshot keeps its cells while the map changes.
+ */
+void TestMapSnapshot::testIsolation() {
+    Map map(70, 40);
+    std::srand(3);
+    for (int i = 0; i < 300; ++i) {
+        map.setGrid(std::rand() % 70, std::rand() % 40, 1 + std::rand() % 200);
+    }
+    Map expected(map);
+    MapSnapshot snapshot = map.snapshot();
+    assert(snapshot.getNumberX() == 70 && snapshot.getNumberY() == 40);
+    assert(snapshot.getVersion() == map.getVersion());
+
+    // Later writes, clears and resizes do not reach the snapshot
+    map.setGrid(0, 0, 99);
+    map.clearMap();
+    map.setGridSize(10, 10);
+    for (int y = 0; y < 40; ++y) {
+        for (int x = 0; x < 70; ++x) {
+            assert(snapshot.getGrid(x, y) == expected.getGrid(x, y));
+        }
+    }
+    assert(snapshot.getGrid(70, 0) == -1 && snapshot.getGrid(0, -1) == -1);
+
+    // Copies share the snapshot; copyTo restores the map
+    MapSnapshot copy = snapshot;
+    assert(copy.getTile(1, 1) == snapshot.getTile(1, 1));
+    Map restored(1, 1);
+    copy.copyTo(restored);
+    assert(restored.getNumberX() == 70 && restored.getNumberY() == 40);
+    for (int y = 0; y < 40; ++y) {
+        for (int x = 0; x < 70; ++x) {
+            assert(restored.getGrid(x, y) == expected.getGrid(x, y));
+        }
+    }
+
+    MapSnapshot empty;
+    assert(empty.getNumberX() == 0 && empty.getGrid(0, 0) == -1);
+    std::cout << "testIsolation: Passed\n";
+}
+
+/**
+ * @brief Tests that snapshots share unchanged and cleared tiles.
+ */
+void TestMapSnapshot::testTileSharing() {
+    Map map(128, 64);
+    map.setGrid(5, 5, 1);
+    MapSnapshot first = map.snapshot();
+
+    // Untouched tiles of a fresh map share one buffer
+    assert(first.getTile(1, 0) == first.getTile(3, 1));
+    assert(first.getTile(0, 0) != first.getTile(1, 0));
+
+    // A second snapshot only replaces the changed tile
+    map.setGrid(40, 40, 2);
+    MapSnapshot second = map.snapshot();
+    assert(second.getTile(0, 0) == first.getTile(0, 0));
+    assert(second.getTile(1, 1) != first.getTile(1, 1));
+    assert(second.getTile(2, 1) == first.getTile(2, 1));
+    assert(first.getGrid(40, 40) == 0 && second.getGrid(40, 40) == 2);
+
+    // After a clear the rewritten tiles hold the cleared value and are shared again
+    map.clearMap();
+    MapSnapshot third = map.snapshot();
+    assert(third.getGrid(5, 5) == 0 && third.getGrid(40, 40) == 0);
+    assert(third.getTile(0, 0) == third.getTile(1, 1));
+    assert(second.getGrid(5, 5) == 1 && second.getGrid(40, 40) == 2);
+
+    // Nothing changed: every tile is shared
+    MapSnapshot fourth = map.snapshot();
+    for (int ty = 0; ty < 2; ++ty) {
+        for (int tx = 0; tx < 4; ++tx) {
+            assert(fourth.getTile(tx, ty) == third.getTile(tx, ty));
+        }
+    }
+    std::cout << "testTileSharing: Passed\n";
+}
+
+/**
+ * @brief Tests reading a snapshot on another thread while the map is written.
+ *
+ * The reader checks that every snapshot is internally consistent: the writer
+ * fills whole rows with one value per step, so a row of a snapshot must never
+ * mix values of two steps.
+ */
+void TestMapSnapshot::testConcurrentReaders() {
+    Map map(96, 96);
+    const int steps = 200;
+    MapSnapshot snapshots[steps];
+    for (int step = 0; step < steps; ++step) {
+        const int y = step % 96;
+        for (int x = 0; x < 96; ++x) {
+            map.setGrid(x, y, step % 250 + 1);
+        }
+        snapshots[step] = map.snapshot();
+    }
+
+    bool consistent = true;
+    std::thread reader([&]() {
+        for (int step = 0; step < steps; ++step) {
+            const MapSnapshot& snapshot = snapshots[step];
+            for (int y = 0; y < 96; ++y) {
+                for (int x = 1; x < 96; ++x) {
+                    consistent &= snapshot.cellAt(x, y) == snapshot.cellAt(0, y);
+                }
+            }
+            consistent &= snapshot.cellAt(0, step % 96) == step % 250 + 1;
+        }
+    });
+    for (int i = 0; i < 5000; ++i) {
+        map.setGrid(i % 96, (i / 96) % 96, 255);
+    }
+    MapSnapshot latest = map.snapshot();
+    reader.join();
+    assert(consistent);
+    assert(latest.getGrid(0, 0) == 255);
+    std::cout << "testConcurrentReaders: Passed\n";
+}
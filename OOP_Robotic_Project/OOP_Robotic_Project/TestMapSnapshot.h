@@ -0,0 +1,36 @@
+#ifndef TESTMAPSNAPSHOT_H
+#define TESTMAPSNAPSHOT_H
+
+#include "MapSnapshot.h"
+
+/**
+ * @file   TestMapSnapshot.h
+ * @author Emirhan Kalkan
+ * @date   December, 2024
+ * @brief  Header file for the TestMapSnapshot class, which contains methods to test the MapSnapshot class.
+ */
+class TestMapSnapshot {
+public:
+    /**
+     * @brief Runs all the tests for the MapSnapshot class.
+     */
+    static void runAllTests();
+
+private:
+    /**
+     * @brief Tests that a snapshot keeps its cells while the map changes.
+     */
+    static void testIsolation();
+
+    /**
+     * @brief Tests that snapshots share unchanged and cleared tiles.
+     */
+    static void testTileSharing();
+
+    /**
+     * @brief Tests reading a snapshot on another thread while the map is written.
+     */
+    static void testConcurrentReaders();
+};
+
+#endif // TESTMAPSNAPSHOT_H
@@ -1,7 +1,13 @@
 #include "TestMapper.h"
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <thread>
 
 /**
  * @file   TestMapper.cpp
@@ -24,9 +30,23 @@ void TestMapper::runAllTests() {
     testUpdateMap();
     testRecordMap();
     testShowMap();
+    testLogOddsMapping();
+    testModeReset();
+    testBeamClipping();
+    testSaveAndLoadMap();
+    testParallelUpdate();
+    testParallelDeterminism();
     std::cout << "All tests passed successfully!\n";
 }
 
+/**
+ * @brief Runs the benchmarks for the Mapper class.
+ */
+void TestMapper::runBenchmarks() {
+    std::cout << "Running benchmarks for Mapper...\n";
+    benchmarkParallelScaling();
+}
+
 /**
  * @brief Tests the constructor of the Mapper class.
  *
@@ -108,3 +128,345 @@ void TestMapper::testShowMap() {
     mapper.showMap();
     std::cout << "testShowMap: Passed\n";
 }
+
+/**
+ * @brief Tests log-odds mapping with free-space ray tracing.
+ *
+ * This test checks that beams clear the cells they cross, mark their endpoints,
+ * saturate at the configured limit and remove obstacles that have moved away.
+ */
+void TestMapper::testLogOddsMapping() {
+    Mapper mapper(20, 20, 10, 10);
+    mapper.setMappingMode(MAPPING_LOG_ODDS);
+    assert(mapper.getOccupancy(15, 10) == CELL_UNKNOWN);
+
+    // An obstacle 5 cells ahead (angle 0) and one 4 cells up and to the right.
+    std::vector<std::pair<int, int>> lidarData = { {5, 0} };
+    PointBatch diagonal(1);
+    diagonal.resize(1);
+    diagonal.getX()[0] = 14.5f;
+    diagonal.getY()[0] = 13.5f;
+    for (int scan = 0; scan < 3; ++scan) {
+        mapper.updateMap(lidarData);
+        mapper.updateMap(diagonal);
+    }
+    assert(mapper.getOccupancy(15, 10) == CELL_OCCUPIED);
+    assert(mapper.getOccupancy(12, 10) == CELL_FREE);
+    assert(mapper.getOccupancy(10, 10) == CELL_FREE);
+    assert(mapper.getOccupancy(14, 13) == CELL_OCCUPIED);
+    assert(mapper.getOccupancy(12, 12) == CELL_FREE);
+    assert(mapper.getOccupancy(10, 15) == CELL_UNKNOWN);
+
+    // Evidence saturates at the limit.
+    for (int scan = 0; scan < 20; ++scan) {
+        mapper.updateMap(lidarData);
+    }
+    assert(mapper.getLogOdds(15, 10) == 100);
+
+    // The obstacle moves 3 cells further away: its old cell is cleared.
+    lidarData[0].first = 8;
+    for (int scan = 0; scan < 60; ++scan) {
+        mapper.updateMap(lidarData);
+    }
+    assert(mapper.getOccupancy(15, 10) == CELL_FREE);
+    assert(mapper.getOccupancy(18, 10) == CELL_OCCUPIED);
+    assert(mapper.getLogOdds(15, 10) == -100);
+
+    // Beams leaving the map still clear the cells inside it.
+    lidarData[0].first = 50;
+    mapper.updateMap(lidarData);
+    assert(mapper.getLogOdds(19, 10) == -4);
+
+    std::ostringstream oss;
+    std::streambuf* oldCoutBuf = std::cout.rdbuf(oss.rdbuf());
+    mapper.showMap();
+    std::cout.rdbuf(oldCoutBuf);
+    assert(oss.str().find('x') != std::string::npos);
+
+    try {
+        mapper.setLogOddsParameters(0, 4, 100, 10);
+        assert(false);
+    }
+    catch (const std::invalid_argument&) {}
+    std::cout << "testLogOddsMapping: Passed\n";
+}
+
+/**
+ * @brief Tests that selecting the log-odds mode again discards all evidence.
+ */
+void TestMapper::testModeReset() {
+    for (int threads = 1; threads <= 2; ++threads) {
+        Mapper mapper(100, 100, 50, 50);
+        mapper.setMappingMode(MAPPING_LOG_ODDS);
+        mapper.setThreadCount(threads);
+        PointBatch points(64);
+        points.resize(64);
+        for (int i = 0; i < 64; ++i) {
+            points.getX()[i] = 60.5f;
+            points.getY()[i] = 50.5f;
+        }
+        for (int scan = 0; scan < 20; ++scan) {
+            if (threads == 1) {
+                mapper.updateMap(std::vector<std::pair<int, int>>{ {10, 0} });
+            }
+            else {
+                mapper.updateMap(points);
+            }
+        }
+        assert(mapper.getLogOdds(60, 50) == 100 && mapper.getLogOdds(55, 50) < 0);
+
+        mapper.setMappingMode(MAPPING_LOG_ODDS);
+        for (int x = 50; x <= 60; ++x) {
+            assert(mapper.getLogOdds(x, 50) == 0);
+            assert(mapper.getOccupancy(x, 50) == CELL_UNKNOWN);
+        }
+
+        // A single new reading does not bring the old obstacle back
+        mapper.updateMap(std::vector<std::pair<int, int>>{ {5, 90} });
+        assert(mapper.getOccupancy(60, 50) == CELL_UNKNOWN && mapper.getLogOdds(60, 50) == 0);
+    }
+    std::cout << "testModeReset: Passed\n";
+}
+
+/**
+ * @brief Tests that beams are clipped to the map.
+ */
+void TestMapper::testBeamClipping() {
+    Mapper mapper(20, 20, 10, 10);
+    mapper.setMappingMode(MAPPING_LOG_ODDS);
+    PointBatch beam(1);
+    beam.resize(1);
+
+    // A robot millions of cells to the left: the beam crosses row 10 of the map
+    mapper.setRobotPosition(-4000000, 10);
+    beam.getX()[0] = 4000000.5f;
+    beam.getY()[0] = 10.5f;
+    mapper.updateMap(beam);
+    for (int x = 0; x < 20; ++x) {
+        assert(mapper.getLogOdds(x, 10) == -4);
+        assert(mapper.getOccupancy(x, 9) == CELL_UNKNOWN && mapper.getOccupancy(x, 11) == CELL_UNKNOWN);
+    }
+
+    // A beam passing beside the map updates nothing
+    beam.getY()[0] = -3.5f;
+    mapper.setRobotPosition(-4000000, -3);
+    mapper.updateMap(beam);
+    assert(mapper.getLogOdds(0, 0) == 0);
+
+    // A beam entering from below ends on its endpoint inside the map
+    mapper.setRobotPosition(5, -4000000);
+    beam.getX()[0] = 5.5f;
+    beam.getY()[0] = 7.5f;
+    mapper.updateMap(beam);
+    assert(mapper.getLogOdds(5, 0) == -4 && mapper.getLogOdds(5, 6) == -4);
+    assert(mapper.getLogOdds(5, 7) > 0);
+    assert(mapper.getLogOdds(5, 8) == 0);
+
+    // A robot inside the map with a far endpoint clears up to the border only
+    mapper.setRobotPosition(15, 15);
+    beam.getX()[0] = 15.5f;
+    beam.getY()[0] = 4000000.5f;
+    mapper.updateMap(beam);
+    assert(mapper.getLogOdds(15, 15) == -4 && mapper.getLogOdds(15, 19) == -4);
+    assert(mapper.getLogOdds(15, 14) == 0);
+    std::cout << "testBeamClipping: Passed\n";
+}
+
+/**
+ * @brief Tests saving and loading maps in the binary map file format.
+ */
+void TestMapper::testSaveAndLoadMap() {
+    const char* fileName = "test_map.rmap";
+    std::vector<std::pair<int, int>> lidarData = {
+        {3, 0}, {4, 90}, {2, 180}, {5, 270}
+    };
+
+    // Binary mode: the loaded map prints the same
+    Mapper mapper(70, 10, 5, 5);
+    mapper.updateMap(lidarData);
+    assert(mapper.saveMap(fileName, 0.05));
+
+    Mapper loaded(1, 1);
+    loaded.setMappingMode(MAPPING_LOG_ODDS);
+    assert(loaded.loadMap(fileName));
+    assert(loaded.getMappingMode() == MAPPING_BINARY);
+
+    std::ostringstream expected, actual;
+    std::streambuf* oldCoutBuf = std::cout.rdbuf(expected.rdbuf());
+    mapper.showMap();
+    std::cout.rdbuf(actual.rdbuf());
+    loaded.showMap();
+    std::cout.rdbuf(oldCoutBuf);
+    assert(!expected.str().empty());
+    assert(expected.str() == actual.str());
+
+    // Log-odds mode: the evidence is restored
+    Mapper logOdds(20, 20, 10, 10);
+    logOdds.setMappingMode(MAPPING_LOG_ODDS);
+    std::vector<std::pair<int, int>> beam = { {5, 0} };
+    for (int scan = 0; scan < 3; ++scan) {
+        logOdds.updateMap(beam);
+    }
+    assert(logOdds.saveMap(fileName));
+    assert(loaded.loadMap(fileName));
+    assert(loaded.getMappingMode() == MAPPING_LOG_ODDS);
+    for (int y = 0; y < 20; ++y) {
+        for (int x = 0; x < 20; ++x) {
+            assert(loaded.getLogOdds(x, y) == logOdds.getLogOdds(x, y));
+        }
+    }
+    assert(loaded.getOccupancy(15, 10) == CELL_OCCUPIED);
+
+    // Mapping resumes from the loaded evidence
+    loaded.setRobotPosition(10, 10);
+    loaded.updateMap(beam);
+    logOdds.updateMap(beam);
+    assert(loaded.getLogOdds(15, 10) == logOdds.getLogOdds(15, 10));
+
+    // A flipped cell byte fails the checksum
+    {
+        std::fstream file(fileName, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(64 + 3);
+        file.put('\x55');
+    }
+    assert(!loaded.loadMap(fileName));
+    assert(!loaded.loadMap("missing_map.rmap"));
+
+    std::remove(fileName);
+    std::cout << "testSaveAndLoadMap: Passed\n";
+}
+
+namespace {
+    /**
+     * @brief Builds a batch of beam endpoints around a robot cell, with some
+     *        beams leaving the map and some invalid ones.
+     */
+    void makeScan(PointBatch& points, int beams, double centerX, double centerY, double maxRange, unsigned int seed) {
+        points.resize(beams);
+        for (int i = 0; i < beams; ++i) {
+            const double angle = 2.0 * M_PI * i / beams;
+            seed = seed * 1103515245u + 12345u;
+            const double range = maxRange * (0.2 + 0.8 * ((seed >> 8) % 1000) / 1000.0);
+            points.getX()[i] = static_cast<float>(centerX + range * std::cos(angle));
+            points.getY()[i] = static_cast<float>(centerY + range * std::sin(angle));
+        }
+        points.getX()[beams / 3] = NAN;
+    }
+}
+
+/**
+ * @brief Tests that parallel updates give the same map as serial updates.
+ */
+void TestMapper::testParallelUpdate() {
+    for (int modeIndex = 0; modeIndex < 2; ++modeIndex) {
+        const MAPPING_MODE mode = modeIndex == 0 ? MAPPING_BINARY : MAPPING_LOG_ODDS;
+        Mapper serial(150, 110, 70, 50);
+        serial.setMappingMode(mode);
+        Mapper two(150, 110, 70, 50), three(150, 110, 70, 50), eight(150, 110, 70, 50);
+        Mapper* parallel[3] = { &two, &three, &eight };
+        const int threadCounts[3] = { 2, 3, 8 };
+        for (int k = 0; k < 3; ++k) {
+            parallel[k]->setMappingMode(mode);
+            parallel[k]->setThreadCount(threadCounts[k]);
+            assert(parallel[k]->getThreadCount() == threadCounts[k]);
+        }
+        PointBatch points(720);
+
+        for (int scan = 0; scan < 12; ++scan) {
+            makeScan(points, 720, 70.5 + scan, 50.5 - scan, 90.0, 7 + scan);
+            serial.setRobotPosition(70 + scan, 50 - scan);
+            serial.updateMap(points);
+            for (Mapper* mapper : parallel) {
+                mapper->setRobotPosition(70 + scan, 50 - scan);
+                mapper->updateMap(points);
+            }
+        }
+
+        std::ostringstream expected;
+        std::streambuf* oldCoutBuf = std::cout.rdbuf(expected.rdbuf());
+        serial.showMap();
+        for (Mapper* mapper : parallel) {
+            std::ostringstream actual;
+            std::cout.rdbuf(actual.rdbuf());
+            mapper->showMap();
+            assert(actual.str() == expected.str());
+            for (int y = 0; y < 110; ++y) {
+                for (int x = 0; x < 150; ++x) {
+                    assert(mapper->getLogOdds(x, y) == serial.getLogOdds(x, y));
+                }
+            }
+        }
+        std::cout.rdbuf(oldCoutBuf);
+    }
+
+    Mapper mapper(10, 10);
+    mapper.setThreadCount(4);
+    mapper.setThreadCount(0);
+    assert(mapper.getThreadCount() == 1);
+    std::cout << "testParallelUpdate: Passed\n";
+}
+
+/**
+ * @brief Tests that parallel updates do not depend on the thread count or the run.
+ */
+void TestMapper::testParallelDeterminism() {
+    const int cores = std::max(2u, std::thread::hardware_concurrency());
+    PointBatch points(2048);
+    Mapper serial(256, 256, 128, 128);
+    serial.setMappingMode(MAPPING_LOG_ODDS);
+    for (int threads = 2; threads <= cores; threads = threads < cores && threads * 2 > cores ? cores : threads * 2) {
+        Mapper first(256, 256, 128, 128), second(256, 256, 128, 128);
+        Mapper* parallel[2] = { &first, &second };
+        for (Mapper* mapper : parallel) {
+            mapper->setMappingMode(MAPPING_LOG_ODDS);
+            mapper->setThreadCount(threads);
+        }
+        for (int scan = 0; scan < 4; ++scan) {
+            makeScan(points, 2048, 128.5 + 3 * scan, 128.5, 160.0, 11 + scan);
+            for (Mapper* mapper : parallel) {
+                mapper->setRobotPosition(128 + 3 * scan, 128);
+                mapper->updateMap(points);
+            }
+            if (threads == 2) {
+                serial.setRobotPosition(128 + 3 * scan, 128);
+                serial.updateMap(points);
+            }
+        }
+        for (int y = 0; y < 256; ++y) {
+            for (int x = 0; x < 256; ++x) {
+                assert(first.getLogOdds(x, y) == serial.getLogOdds(x, y));
+                assert(second.getLogOdds(x, y) == first.getLogOdds(x, y));
+            }
+        }
+        if (threads == cores) {
+            break;
+        }
+    }
+    std::cout << "testParallelDeterminism: Passed\n";
+}
+
+/**
+ * @brief Reports the update throughput for every thread count from 1 to the number of cores.
+ */
+void TestMapper::benchmarkParallelScaling() {
+    const int cores = std::max(1u, std::thread::hardware_concurrency());
+    PointBatch points(8192);
+    makeScan(points, 8192, 1024.5, 1024.5, 900.0, 1);
+    double serialRate = 0.0;
+    for (int threads = 1; threads <= cores; ++threads) {
+        Mapper mapper(2048, 2048, 1024, 1024);
+        mapper.setMappingMode(MAPPING_LOG_ODDS);
+        mapper.setThreadCount(threads);
+        mapper.updateMap(points);  // Warm-up: buffers and page faults
+
+        const int runs = 5;
+        auto start = std::chrono::steady_clock::now();
+        for (int run = 0; run < runs; ++run) {
+            mapper.updateMap(points);
+        }
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        const double rate = runs * points.size() / seconds;
+        serialRate = threads == 1 ? rate : serialRate;
+        std::cout << "  " << threads << " thread(s): " << rate << " beams/s (x" << rate / serialRate << ")\n";
+    }
+}
@@ -22,6 +22,13 @@ public:
      */
     static void runAllTests();
 
+    /**
+     * @brief Runs the benchmarks for the Mapper class.
+     *
+     * The benchmarks only print their measurements; they are not part of runAllTests().
+     */
+    static void runBenchmarks();
+
 private:
     /**
      * @brief Tests the constructor of the Mapper class.
@@ -50,6 +57,51 @@ private:
      * This test checks if the showMap method correctly outputs the map to the console.
      */
     static void testShowMap();
+
+    /**
+     * @brief Tests log-odds mapping with free-space ray tracing.
+     *
+     * This test checks that beams clear the cells they cross, mark their endpoints,
+     * saturate at the configured limit and remove obstacles that have moved away.
+     */
+    static void testLogOddsMapping();
+
+    /**
+     * @brief Tests that selecting the log-odds mode again discards all evidence.
+     *
+     * This test covers both the serial and the parallel update paths.
+     */
+    static void testModeReset();
+
+    /**
+     * @brief Tests that beams are clipped to the map.
+     *
+     * This test traces beams from a robot far outside the map and to far
+     * endpoints, and checks that only the cells inside the map are updated.
+     */
+    static void testBeamClipping();
+
+    /**
+     * @brief Tests saving and loading maps in the binary map file format.
+     *
+     * This test checks both mapping modes and that a corrupted file is rejected.
+     */
+    static void testSaveAndLoadMap();
+
+    /**
+     * @brief Tests that parallel updates give the same map as serial updates.
+     */
+    static void testParallelUpdate();
+
+    /**
+     * @brief Tests that parallel updates do not depend on the thread count or the run.
+     */
+    static void testParallelDeterminism();
+
+    /**
+     * @brief Reports the update throughput for every thread count from 1 to the number of cores.
+     */
+    static void benchmarkParallelScaling();
 };
 
 #endif // TESTMAPPER_H
@@ -0,0 +1,271 @@
+#include "TestOccupancyBitmap.h"
+#include <algorithm>
+#include <iostream>
+#include <cassert>
+#include <cstdlib>
+#include <vector>
+
+/**
+ * @file   TestOccupancyBitmap.cpp
+ * @author Emirhan Kalkan
+ * @date   December, 2024
+ * @brief  Implementation of the test methods for the OccupancyBitmap class.
+ */
+
+namespace {
+    /**
+     * @brief Fills a bitmap with random occupied cells.
+     */
+    void fillRandom(OccupancyBitmap& bitmap, int cells) {
+        for (int i = 0; i < cells; ++i) {
+            bitmap.set(std::rand() % bitmap.getNumberX(), std::rand() % bitmap.getNumberY(), true);
+        }
+    }
+
+    /**
+     * @brief Checks that a bitmap matches the non-zero cells of a map.
+     */
+    bool matches(const OccupancyBitmap& bitmap, const Map& map) {
+        if (bitmap.getNumberX() != map.getNumberX() || bitmap.getNumberY() != map.getNumberY()) {
+            return false;
+        }
+        for (int y = 0; y < map.getNumberY(); ++y) {
+            for (int x = 0; x < map.getNumberX(); ++x) {
+                if (bitmap.get(x, y) != (map.getGrid(x, y) != 0)) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Dilates or erodes a bitmap one cell at a time; cells outside are free.
+     */
+    OccupancyBitmap bruteMorph(const OccupancyBitmap& bitmap, int rx, int ry, bool dilation) {
+        OccupancyBitmap result(bitmap.getNumberX(), bitmap.getNumberY());
+        for (int y = 0; y < bitmap.getNumberY(); ++y) {
+            for (int x = 0; x < bitmap.getNumberX(); ++x) {
+                bool value = !dilation;
+                for (int dy = -ry; dy <= ry; ++dy) {
+                    for (int dx = -rx; dx <= rx; ++dx) {
+                        bool cell = bitmap.get(x + dx, y + dy);
+                        value = dilation ? value || cell : value && cell;
+                    }
+                }
+                result.set(x, y, value);
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief Checks that two bitmaps hold the same cells.
+     */
+    bool equal(const OccupancyBitmap& a, const OccupancyBitmap& b) {
+        if (a.getNumberX() != b.getNumberX() || a.getNumberY() != b.getNumberY()) {
+            return false;
+        }
+        for (int y = 0; y < a.getNumberY(); ++y) {
+            for (int x = 0; x < a.getNumberX(); ++x) {
+                if (a.get(x, y) != b.get(x, y)) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+}
+
+/**
+ * @brief Runs all the tests for the OccupancyBitmap class.
+ */
+void TestOccupancyBitmap::runAllTests() {
+    std::cout << "Running tests for OccupancyBitmap...\n";
+    testSyncAndCopy();
+    testMorphology();
+    testOpenClose();
+    testCollisions();
+    testPackedMap();
+    std::cout << "All OccupancyBitmap tests passed successfully!\n";
+}
+
+/**
+ * @brief Tests packing a map, incremental syncs and writing back.
+ */
+void TestOccupancyBitmap::testSyncAndCopy() {
+    std::srand(5);
+    Map map(203, 77);
+    for (int i = 0; i < 2000; ++i) {
+        map.setGrid(std::rand() % 203, std::rand() % 77, std::rand() % 4);
+    }
+    OccupancyBitmap bitmap(map);
+    assert(matches(bitmap, map));
+    assert(bitmap.getStride() % 4 == 0);
+    assert(!bitmap.get(-1, 0) && !bitmap.get(203, 0));
+
+    // Incremental syncs only repack changed tiles
+    unsigned long long version = map.getVersion();
+    for (int round = 0; round < 10; ++round) {
+        for (int i = 0; i < 50; ++i) {
+            map.setGrid((round * 41) % 203 + std::rand() % 10, (round * 23) % 77 + std::rand() % 10, std::rand() % 2);
+        }
+        version = bitmap.syncFrom(map, version);
+        assert(version == map.getVersion());
+        assert(matches(bitmap, map));
+    }
+    map.clearMap();
+    version = bitmap.syncFrom(map, version);
+    assert(bitmap.count() == 0);
+    map.setGridSize(64, 130);
+    map.setGrid(63, 129, 9);
+    version = bitmap.syncFrom(map, version);
+    assert(matches(bitmap, map) && bitmap.count() == 1);
+
+    // Writing back only touches cells whose occupancy changes
+    OccupancyBitmap edited(map);
+    edited.set(0, 0, true);
+    edited.set(63, 129, false);
+    edited.set(10, 100, true);
+    map.setGrid(5, 5, 0);
+    unsigned long long before = map.getVersion();
+    edited.copyTo(map, 7);
+    assert(map.getVersion() > before);
+    assert(map.getGrid(0, 0) == 7 && map.getGrid(10, 100) == 7 && map.getGrid(63, 129) == 0);
+    assert(matches(edited, map));
+    before = map.getVersion();
+    edited.copyTo(map, 7);
+    assert(map.getVersion() == before);
+
+    Map resized(3, 3);
+    edited.copyTo(resized);
+    assert(matches(edited, resized) && resized.getGrid(0, 0) == 1);
+    std::cout << "testSyncAndCopy: Passed\n";
+}
+
+/**
+ * @brief Tests dilation and erosion against a cell-by-cell reference.
+ */
+void TestOccupancyBitmap::testMorphology() {
+    std::srand(12);
+    const int sizes[][2] = { { 1, 1 }, { 64, 5 }, { 65, 40 }, { 150, 70 }, { 300, 20 } };
+    const int radii[][2] = { { 0, 0 }, { 1, 1 }, { 2, 5 }, { 7, 3 }, { 70, 2 }, { 3, 30 } };
+    for (const auto& size : sizes) {
+        for (const auto& radius : radii) {
+            OccupancyBitmap bitmap(size[0], size[1]);
+            fillRandom(bitmap, size[0] * size[1] / 20 + 1);
+            OccupancyBitmap dilated(bitmap);
+            dilated.dilate(radius[0], radius[1]);
+            assert(equal(dilated, bruteMorph(bitmap, radius[0], radius[1], true)));
+
+            // Erode a dense map so that something survives
+            OccupancyBitmap dense(size[0], size[1]);
+            fillRandom(dense, size[0] * size[1]);
+            OccupancyBitmap eroded(dense);
+            eroded.erode(radius[0], radius[1]);
+            assert(equal(eroded, bruteMorph(dense, radius[0], radius[1], false)));
+        }
+    }
+
+    // Obstacles touching the border are eroded, and nothing grows past the last column
+    OccupancyBitmap full(70, 10);
+    for (int y = 0; y < 10; ++y) {
+        for (int x = 0; x < 70; ++x) {
+            full.set(x, y, true);
+        }
+    }
+    full.dilate(5);
+    assert(full.count() == 700);
+    full.erode(2);
+    assert(full.count() == 66 * 6 && full.get(2, 2) && !full.get(1, 2) && !full.get(68, 5));
+    std::cout << "testMorphology: Passed\n";
+}
+
+/**
+ * @brief Tests that opening removes speckles and closing fills holes.
+ */
+void TestOccupancyBitmap::testOpenClose() {
+    OccupancyBitmap bitmap(100, 100);
+    for (int y = 20; y < 60; ++y) {
+        for (int x = 20; x < 60; ++x) {
+            bitmap.set(x, y, true);
+        }
+    }
+    bitmap.set(40, 40, false);
+    bitmap.set(41, 40, false);
+    bitmap.set(80, 80, true);
+    bitmap.set(5, 90, true);
+
+    OccupancyBitmap opened(bitmap);
+    opened.open(1);
+    assert(!opened.get(80, 80) && !opened.get(5, 90));
+    assert(opened.get(20, 20) && opened.get(59, 59));
+
+    OccupancyBitmap closed(bitmap);
+    closed.close(1);
+    assert(closed.get(40, 40) && closed.get(41, 40));
+    assert(closed.get(80, 80) && !closed.get(19, 20));
+    std::cout << "testOpenClose: Passed\n";
+}
+
+/**
+ * @brief Tests footprint collisions against a cell-by-cell reference.
+ */
+void TestOccupancyBitmap::testCollisions() {
+    std::srand(3);
+    OccupancyBitmap bitmap(260, 90);
+    fillRandom(bitmap, 150);
+    const int footprintRadii[] = { 0, 2, 9, 40 };
+    for (int radius : footprintRadii) {
+        OccupancyBitmap footprint = OccupancyBitmap::disk(radius);
+        assert(footprint.getNumberX() == 2 * radius + 1 && footprint.get(radius, radius));
+        assert(radius == 0 || !footprint.get(0, 0));
+        for (int i = 0; i < 400; ++i) {
+            int x = std::rand() % 280 - 10;
+            int y = std::rand() % 110 - 10;
+            bool expected = x < 0 || y < 0 || x + footprint.getNumberX() > 260 || y + footprint.getNumberY() > 90;
+            for (int fy = 0; fy < footprint.getNumberY() && !expected; ++fy) {
+                for (int fx = 0; fx < footprint.getNumberX() && !expected; ++fx) {
+                    expected = footprint.get(fx, fy) && bitmap.get(x + fx, y + fy);
+                }
+            }
+            assert(bitmap.collides(footprint, x, y) == expected);
+        }
+    }
+    OccupancyBitmap empty(260, 90);
+    assert(!empty.collides(OccupancyBitmap::disk(20), 219, 49));
+    assert(empty.collides(OccupancyBitmap::disk(20), 220, 49));
+    std::cout << "testCollisions: Passed\n";
+}
+
+/**
+ * @brief Tests a bitmap packed from a map: its footprint and its dilation against the byte map.
+ */
+void TestOccupancyBitmap::testPackedMap() {
+    std::srand(9);
+    const int sizeX = 300;
+    const int sizeY = 200;
+    const int radius = 5;
+    Map map(sizeX, sizeY);
+    for (int i = 0; i < 600; ++i) {
+        map.setGrid(std::rand() % sizeX, std::rand() % sizeY, 1);
+    }
+    OccupancyBitmap bitmap(map);
+    // A row holds one bit per cell, padded by less than a cache line
+    assert(bitmap.getMemoryUsage() < static_cast<size_t>(sizeX / 8 + 64) * sizeY);
+    bitmap.dilate(radius);
+
+    // Square dilation on the bytes
+    for (int y = 0; y < sizeY; ++y) {
+        for (int x = 0; x < sizeX; ++x) {
+            bool occupied = false;
+            for (int dy = std::max(0, y - radius); dy <= std::min(sizeY - 1, y + radius) && !occupied; ++dy) {
+                for (int dx = std::max(0, x - radius); dx <= std::min(sizeX - 1, x + radius) && !occupied; ++dx) {
+                    occupied = map.getGrid(dx, dy) > 0;
+                }
+            }
+            assert(bitmap.get(x, y) == occupied);
+        }
+    }
+    std::cout << "testPackedMap: Passed\n";
+}
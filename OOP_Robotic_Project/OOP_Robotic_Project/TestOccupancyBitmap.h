@@ -0,0 +1,46 @@
+#ifndef TESTOCCUPANCYBITMAP_H
+#define TESTOCCUPANCYBITMAP_H
+
+#include "OccupancyBitmap.h"
+
+/**
+ * @file   TestOccupancyBitmap.h
+ * @author Emirhan Kalkan
+ * @date   December, 2024
+ * @brief  Header file for the TestOccupancyBitmap class, which contains methods to test the OccupancyBitmap class.
+ */
+class TestOccupancyBitmap {
+public:
+    /**
+     * @brief Runs all the tests for the OccupancyBitmap class.
+     */
+    static void runAllTests();
+
+private:
+    /**
+     * @brief Tests packing a map, incremental syncs and writing back.
+     */
+    static void testSyncAndCopy();
+
+    /**
+     * @brief Tests dilation and erosion against a cell-by-cell reference.
+     */
+    static void testMorphology();
+
+    /**
+     * @brief Tests that opening removes speckles and closing fills holes.
+     */
+    static void testOpenClose();
+
+    /**
+     * @brief Tests footprint collisions against a cell-by-cell reference.
+     */
+    static void testCollisions();
+
+    /**
+     * @brief Tests a bitmap packed from a map: its footprint and its dilation against the byte map.
+     */
+    static void testPackedMap();
+};
+
+#endif // TESTOCCUPANCYBITMAP_H
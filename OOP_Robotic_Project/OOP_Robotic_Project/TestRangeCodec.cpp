@@ -0,0 +1,99 @@
+/**
+ * @file   TestRangeCodec.cpp
+ * @author Furkan Gemici
+ * @date   December, 2024
+ * @brief  Source file for testing the RangeCodec conversions.
+ */
+
+#include "TestRangeCodec.h"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+namespace {
+    typedef RangeCodec<unsigned short> MillimetreCodec;
+}
+
+/**
+ * @brief Runs all test cases for RangeCodec.
+ */
+void TestRangeCodec::runAllTests() {
+    std::cout << "Running RangeCodec tests...\n";
+    testFloatAndDouble();
+    testMillimetres();
+    testBulkMatchesScalar();
+    std::cout << "All RangeCodec tests passed successfully!\n";
+}
+
+/**
+ * @brief Tests the float and double conversions.
+ */
+void TestRangeCodec::testFloatAndDouble() {
+    const float in[3] = { 1.25f, NAN, INFINITY };
+    float copy[3];
+    double wide[3];
+    RangeCodec<float>::encode(in, copy, 3);
+    RangeCodec<double>::encode(in, wide, 3);
+    assert(copy[0] == 1.25f && std::isnan(copy[1]) && std::isinf(copy[2]));
+    assert(wide[0] == 1.25 && std::isnan(wide[1]) && std::isinf(wide[2]));
+
+    float back[3];
+    RangeCodec<double>::decode(wide, back, 3);
+    assert(back[0] == 1.25f && std::isnan(back[1]) && std::isinf(back[2]));
+    std::cout << "testFloatAndDouble: Passed\n";
+}
+
+/**
+ * @brief Tests millimetre rounding and the invalid/out-of-range codes.
+ */
+void TestRangeCodec::testMillimetres() {
+    assert(MillimetreCodec::fromMetres(1.2344f) == 1234);
+    assert(MillimetreCodec::fromMetres(1.2346f) == 1235);
+    assert(MillimetreCodec::fromMetres(0.0001f) == 1);
+    assert(MillimetreCodec::fromMetres(0.0f) == MillimetreCodec::INVALID);
+    assert(MillimetreCodec::fromMetres(-1.0f) == MillimetreCodec::INVALID);
+    assert(MillimetreCodec::fromMetres(NAN) == MillimetreCodec::INVALID);
+    assert(MillimetreCodec::fromMetres(70.0f) == MillimetreCodec::OUT_OF_RANGE);
+    assert(MillimetreCodec::fromMetres(INFINITY) == MillimetreCodec::OUT_OF_RANGE);
+    assert(MillimetreCodec::fromMetres(65.534f) == 65534);
+
+    assert(std::fabs(MillimetreCodec::toMetres(1234) - 1.234) < 1e-6);
+    assert(std::isnan(MillimetreCodec::toMetres(MillimetreCodec::INVALID)));
+    assert(std::isinf(MillimetreCodec::toMetres(MillimetreCodec::OUT_OF_RANGE)));
+    std::cout << "testMillimetres: Passed\n";
+}
+
+/**
+ * @brief Tests that the bulk (SIMD) conversions match the scalar ones.
+ */
+void TestRangeCodec::testBulkMatchesScalar() {
+    // 37 values exercise the 8-wide loop and the scalar tail
+    const int count = 37;
+    std::vector<float> ranges(count);
+    for (int i = 0; i < count; ++i) {
+        ranges[i] = 0.0004f + i * 1.7777f;
+    }
+    ranges[3] = NAN;
+    ranges[5] = -2.0f;
+    ranges[9] = INFINITY;
+    ranges[12] = 0.0f;
+
+    std::vector<unsigned short> stored(count);
+    MillimetreCodec::encode(ranges.data(), stored.data(), count);
+    for (int i = 0; i < count; ++i) {
+        assert(stored[i] == MillimetreCodec::fromMetres(ranges[i]));
+    }
+
+    std::vector<float> decoded(count);
+    MillimetreCodec::decode(stored.data(), decoded.data(), count);
+    for (int i = 0; i < count; ++i) {
+        float expected = static_cast<float>(MillimetreCodec::toMetres(stored[i]));
+        assert(decoded[i] == expected || (std::isnan(decoded[i]) && std::isnan(expected)));
+        // Ranges below 1 mm are raised to 1 mm
+        if (ranges[i] >= 0.001f && ranges[i] < 65.0f) {
+            assert(std::fabs(decoded[i] - ranges[i]) <= 0.0005f + 2e-5f);
+        }
+    }
+    std::cout << "testBulkMatchesScalar: Passed\n";
+}
@@ -0,0 +1,37 @@
+/**
+ * @file   TestRangeCodec.h
+ * @author Furkan Gemici
+ * @date   December, 2024
+ * @brief  Header file for testing the RangeCodec conversions.
+ */
+
+#pragma once
+#include "RangeCodec.h"
+
+ /**
+  * @class TestRangeCodec
+  * @brief A test class to validate the range storage conversions.
+  */
+class TestRangeCodec {
+public:
+    /**
+     * @brief Runs all test cases for RangeCodec.
+     */
+    static void runAllTests();
+
+private:
+    /**
+     * @brief Tests the float and double conversions.
+     */
+    static void testFloatAndDouble();
+
+    /**
+     * @brief Tests millimetre rounding and the invalid/out-of-range codes.
+     */
+    static void testMillimetres();
+
+    /**
+     * @brief Tests that the bulk (SIMD) conversions match the scalar ones.
+     */
+    static void testBulkMatchesScalar();
+};
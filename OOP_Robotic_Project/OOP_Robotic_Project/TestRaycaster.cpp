@@ -0,0 +1,285 @@
+#include "TestRaycaster.h"
+#include <iostream>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdlib>
+#include <stdexcept>
+#include <thread>
+
+/**
+ * @file   TestRaycaster.cpp
+ * @author Emirhan Kalkan
+ * @date   December, 2024
+ * @brief  Implementation of the test methods for the Raycaster class.
+ */
+
+namespace {
+    /**
+     * @brief Fills a map with random rectangular obstacles.
+     */
+    void addObstacles(Map& map, int count, int maxSize) {
+        for (int i = 0; i < count; ++i) {
+            int x0 = std::rand() % map.getNumberX();
+            int y0 = std::rand() % map.getNumberY();
+            int w = 1 + std::rand() % maxSize;
+            int h = 1 + std::rand() % maxSize;
+            for (int y = y0; y < std::min(map.getNumberY(), y0 + h); ++y) {
+                for (int x = x0; x < std::min(map.getNumberX(), x0 + w); ++x) {
+                    map.setGrid(x, y, 1);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Returns whether two batches hold the same results.
+     */
+    bool sameResults(const RayBatch& a, const RayBatch& b) {
+        for (int i = 0; i < a.size(); ++i) {
+            if (a.getRanges()[i] != b.getRanges()[i] || a.getHitX()[i] != b.getHitX()[i] ||
+                a.getHitY()[i] != b.getHitY()[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+/**
+ * @brief Runs all the tests for the Raycaster class.
+ */
+void TestRaycaster::runAllTests() {
+    std::cout << "Running tests for Raycaster...\n";
+    testSimpleRays();
+    testRangeAndClipping();
+    testAgainstReference();
+    testIncrementalUpdate();
+    testParallelCasts();
+    std::cout << "All Raycaster tests passed successfully!\n";
+}
+
+/**
+ * @brief Tests rays with known hits along the axes and diagonals.
+ */
+void TestRaycaster::testSimpleRays() {
+    Map map(40, 40);
+    for (int y = 0; y < 40; ++y) {
+        map.setGrid(30, y, 1);
+    }
+    map.setGrid(10, 10, 1);
+    Raycaster raycaster(map, 100.0);
+
+    double range = 0;
+    int hitX = 0, hitY = 0;
+    assert(raycaster.castRay(5.5, 5.5, 0.0, range, hitX, hitY));
+    assert(hitX == 30 && hitY == 5 && std::fabs(range - 24.5) < 1e-3);
+
+    // Leaving the map is a miss
+    assert(!raycaster.castRay(5.5, 5.5, 180.0, range, hitX, hitY));
+    assert(hitX == -1 && hitY == -1 && range == 100.0);
+    assert(!raycaster.castRay(5.5, 5.5, 90.0, range, hitX, hitY));
+
+    // Diagonal through cell corners
+    assert(raycaster.castRay(0.5, 0.5, 45.0, range, hitX, hitY));
+    assert(hitX == 10 && hitY == 10 && std::fabs(range - 9.5 * std::sqrt(2.0)) < 1e-3);
+    assert(raycaster.castRay(20.5, 20.5, 225.0, range, hitX, hitY));
+    assert(hitX == 10 && hitY == 10 && std::fabs(range - 9.5 * std::sqrt(2.0)) < 1e-3);
+
+    // Occupied origin
+    assert(raycaster.castRay(10.2, 10.7, 123.0, range, hitX, hitY));
+    assert(hitX == 10 && hitY == 10 && range == 0.0);
+
+    // Shallow ray
+    assert(raycaster.castRay(1.5, 12.5, -std::atan(2.0 / 9.0) * 180.0 / 3.14159265358979323846, range, hitX, hitY));
+    assert(hitX == 10 && hitY == 10 && std::fabs(range - 8.5 * std::sqrt(85.0) / 9.0) < 1e-3);
+    std::cout << "testSimpleRays: Passed\n";
+}
+
+/**
+ * @brief Tests the maximum range, rays leaving the map and origins outside it.
+ */
+void TestRaycaster::testRangeAndClipping() {
+    Map map(50, 20);
+    map.setGrid(20, 5, 1);
+    Raycaster shortRange(map, 10.0);
+    Raycaster longRange(map, 100.0);
+
+    double range = 0;
+    int hitX = 0, hitY = 0;
+    assert(!shortRange.castRay(5.5, 5.5, 0.0, range, hitX, hitY));
+    assert(range == 10.0);
+    assert(shortRange.castRay(10.5, 5.5, 0.0, range, hitX, hitY));
+    assert(hitX == 20 && std::fabs(range - 9.5) < 1e-3);
+
+    // Origins outside the map start where the ray enters it
+    assert(longRange.castRay(-10.0, 5.5, 0.0, range, hitX, hitY));
+    assert(hitX == 20 && hitY == 5 && std::fabs(range - 30.0) < 1e-3);
+    assert(longRange.castRay(70.0, 5.5, 180.0, range, hitX, hitY));
+    assert(hitX == 20 && hitY == 5 && std::fabs(range - 49.0) < 1e-3);
+    assert(!longRange.castRay(-10.0, 5.5, 180.0, range, hitX, hitY));
+    assert(!longRange.castRay(-10.0, 50.0, 0.0, range, hitX, hitY));
+    assert(!shortRange.castRay(-20.0, 5.5, 0.0, range, hitX, hitY));
+    assert(!longRange.castRay(25.0, -5.0, 90.0, range, hitX, hitY));
+    assert(longRange.castRay(20.5, -5.0, 90.0, range, hitX, hitY));
+    assert(hitX == 20 && hitY == 5 && std::fabs(range - 10.0) < 1e-3);
+
+    bool thrown = false;
+    try {
+        Raycaster invalid(map, 0.0);
+    }
+    catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    assert(thrown);
+    std::cout << "testRangeAndClipping: Passed\n";
+}
+
+/**
+ * @brief Tests random rays against a fine-stepping reference.
+ *
+ * The reference marches along each ray in small steps, so it can miss a cell
+ * the ray only clips near a corner; a few such disagreements are allowed.
+ */
+void TestRaycaster::testAgainstReference() {
+    std::srand(31);
+    Map map(300, 200);
+    addObstacles(map, 150, 6);
+    const double maxRange = 150.0;
+    Raycaster raycaster(map, maxRange);
+
+    const int count = 5000;
+    RayBatch rays;
+    for (int i = 0; i < count; ++i) {
+        rays.addRay(std::rand() % 3200 / 10.0 - 10.0, std::rand() % 2200 / 10.0 - 10.0, std::rand() % 3600 / 10.0);
+    }
+    raycaster.castRays(rays);
+
+    const double step = 0.002;
+    int mismatches = 0;
+    int hits = 0;
+    for (int i = 0; i < count; ++i) {
+        const double ox = rays.getOriginX()[i];
+        const double oy = rays.getOriginY()[i];
+        const double dx = rays.getDirX()[i];
+        const double dy = rays.getDirY()[i];
+        int refX = -1, refY = -1;
+        double refRange = maxRange;
+        for (double t = 0; t <= maxRange; t += step) {
+            double x = ox + t * dx;
+            double y = oy + t * dy;
+            int cx = static_cast<int>(std::floor(x));
+            int cy = static_cast<int>(std::floor(y));
+            if (cx >= 0 && cx < 300 && cy >= 0 && cy < 200 && map.getGrid(cx, cy) != 0) {
+                refX = cx;
+                refY = cy;
+                refRange = t;
+                break;
+            }
+        }
+        hits += refX >= 0;
+        if (refX != rays.getHitX()[i] || refY != rays.getHitY()[i]) {
+            ++mismatches;
+        }
+        else if (refX >= 0) {
+            assert(std::fabs(refRange - rays.getRanges()[i]) < 2 * step + 1e-3);
+        }
+        else {
+            assert(rays.getRanges()[i] == static_cast<float>(maxRange));
+        }
+    }
+    assert(hits > count / 4);
+    assert(mismatches < count / 200);
+    std::cout << "testAgainstReference: Passed\n";
+}
+
+/**
+ * @brief Tests that updates follow map changes and match a fresh raycaster.
+ */
+void TestRaycaster::testIncrementalUpdate() {
+    std::srand(5);
+    Map map(256, 256);
+    addObstacles(map, 60, 8);
+    Raycaster raycaster(map, 300.0);
+
+    RayBatch rays;
+    for (int i = 0; i < 2000; ++i) {
+        rays.addRay(std::rand() % 256 + 0.5, std::rand() % 256 + 0.5, std::rand() % 360);
+    }
+
+    double range = 0;
+    int hitX = 0, hitY = 0;
+    for (int round = 0; round < 5; ++round) {
+        // Clear some obstacles and add new ones
+        for (int i = 0; i < 300; ++i) {
+            map.setGrid(std::rand() % 256, std::rand() % 256, 0);
+        }
+        addObstacles(map, 10, 4);
+        map.setGrid(200, 3, 1);
+        raycaster.update();
+
+        assert(raycaster.castRay(3.5, 3.5, 0.0, range, hitX, hitY));
+        assert(hitX <= 200 && hitY == 3);
+
+        Raycaster fresh(map, 300.0);
+        RayBatch expected;
+        for (int i = 0; i < rays.size(); ++i) {
+            expected.addRay(0, 0, 0);
+            expected.getOriginX()[i] = rays.getOriginX()[i];
+            expected.getOriginY()[i] = rays.getOriginY()[i];
+            expected.getDirX()[i] = rays.getDirX()[i];
+            expected.getDirY()[i] = rays.getDirY()[i];
+        }
+        raycaster.castRays(rays);
+        fresh.castRays(expected);
+        assert(sameResults(rays, expected));
+    }
+
+    // Growing the map rebuilds the blocks
+    map.setGridSize(300, 300);
+    map.setGrid(290, 290, 1);
+    raycaster.update();
+    assert(raycaster.castRay(298.5, 290.5, 180.0, range, hitX, hitY));
+    assert(hitX == 290 && hitY == 290 && std::fabs(range - 7.5) < 1e-3);
+    std::cout << "testIncrementalUpdate: Passed\n";
+}
+
+/**
+ * @brief Tests that threaded casts match serial casts.
+ */
+void TestRaycaster::testParallelCasts() {
+    std::srand(11);
+    Map map(256, 256);
+    for (int i = 0; i < 256; ++i) {
+        // Rooms with doorways on a 64-cell grid
+        if (i % 64 < 50 || i % 64 > 55) {
+            for (int wall = 0; wall < 256; wall += 64) {
+                map.setGrid(wall, i, 1);
+                map.setGrid(i, wall, 1);
+            }
+        }
+    }
+    addObstacles(map, 100, 5);
+    Raycaster raycaster(map, 200.0);
+
+    const int poses = 40;
+    const int beams = 90;
+    RayBatch rays(poses * beams);
+    for (int i = 0; i < poses; ++i) {
+        rays.addFan(1 + std::rand() % 254 + 0.25, 1 + std::rand() % 254 + 0.75, std::rand() % 360, 4.0, beams);
+    }
+    RayBatch serial(poses * beams);
+    serial.resize(rays.size());
+    std::copy(rays.getOriginX(), rays.getOriginX() + rays.size(), serial.getOriginX());
+    std::copy(rays.getOriginY(), rays.getOriginY() + rays.size(), serial.getOriginY());
+    std::copy(rays.getDirX(), rays.getDirX() + rays.size(), serial.getDirX());
+    std::copy(rays.getDirY(), rays.getDirY() + rays.size(), serial.getDirY());
+    raycaster.castRays(serial);
+
+    const int cores = std::max(2u, std::thread::hardware_concurrency());
+    raycaster.setThreadCount(cores);
+    assert(raycaster.getThreadCount() == cores);
+    raycaster.castRays(rays);
+    assert(sameResults(rays, serial));
+    std::cout << "testParallelCasts: Passed\n";
+}
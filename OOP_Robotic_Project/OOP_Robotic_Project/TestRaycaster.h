@@ -0,0 +1,46 @@
+#ifndef TESTRAYCASTER_H
+#define TESTRAYCASTER_H
+
+#include "Raycaster.h"
+
+/**
+ * @file   TestRaycaster.h
+ * @author Emirhan Kalkan
+ * @date   December, 2024
+ * @brief  Header file for the TestRaycaster class, which contains methods to test the Raycaster class.
+ */
+class TestRaycaster {
+public:
+    /**
+     * @brief Runs all the tests for the Raycaster class.
+     */
+    static void runAllTests();
+
+private:
+    /**
+     * @brief Tests rays with known hits along the axes and diagonals.
+     */
+    static void testSimpleRays();
+
+    /**
+     * @brief Tests the maximum range, rays leaving the map and origins outside it.
+     */
+    static void testRangeAndClipping();
+
+    /**
+     * @brief Tests random rays against a fine-stepping reference.
+     */
+    static void testAgainstReference();
+
+    /**
+     * @brief Tests that updates follow map changes and match a fresh raycaster.
+     */
+    static void testIncrementalUpdate();
+
+    /**
+     * @brief Tests that threaded casts match serial casts.
+     */
+    static void testParallelCasts();
+};
+
+#endif // TESTRAYCASTER_H
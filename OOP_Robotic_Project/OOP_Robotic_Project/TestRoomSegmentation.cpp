@@ -0,0 +1,203 @@
+#include "TestRoomSegmentation.h"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <stdexcept>
+
+/**
+ * @file   TestRoomSegmentation.cpp
+ * @author Emirhan Kalkan
+ * @date   December, 2024
+ * @brief  Implementation of the test methods for the RoomSegmentation class.
+ */
+
+namespace {
+    /**
+     * @brief Draws a wall segment from (x0, y0) to (x1, y1) (horizontal or vertical).
+     */
+    void drawWall(Map& map, int x0, int y0, int x1, int y1) {
+        for (int y = y0; y <= y1; ++y) {
+            for (int x = x0; x <= x1; ++x) {
+                map.setGrid(x, y, 1);
+            }
+        }
+    }
+
+    /**
+     * @brief Builds a row of square rooms of a side, with doors of a width between them.
+     */
+    Map buildRooms(int rooms, int side, int door) {
+        Map map(rooms * side + 1, side + 1);
+        drawWall(map, 0, 0, rooms * side, 0);
+        drawWall(map, 0, side, rooms * side, side);
+        for (int room = 0; room <= rooms; ++room) {
+            drawWall(map, room * side, 0, room * side, side);
+            if (room > 0 && room < rooms) {
+                for (int y = side / 2; y < side / 2 + door; ++y) {
+                    map.setGrid(room * side, y, 0);
+                }
+            }
+        }
+        return map;
+    }
+
+    /**
+     * @brief Returns the link from one region to another, or null.
+     */
+    const RoomSegmentation::RegionLink* findLink(const RoomSegmentation& segmentation, int from, int to) {
+        for (const RoomSegmentation::RegionLink& link : segmentation.getNeighbours(from)) {
+            if (link.region == to) {
+                return &link;
+            }
+        }
+        return nullptr;
+    }
+}
+
+/**
+ * @brief Runs all the tests for the RoomSegmentation class.
+ */
+void TestRoomSegmentation::runAllTests() {
+    std::cout << "Running tests for RoomSegmentation...\n";
+    testRooms();
+    testUnreachableSpace();
+    testRegionPaths();
+    testBuilding();
+    std::cout << "All RoomSegmentation tests passed successfully!\n";
+}
+
+/**
+ * @brief Tests that rooms joined by doors become linked regions.
+ */
+void TestRoomSegmentation::testRooms() {
+    Map map = buildRooms(2, 30, 3);
+    RoomSegmentation segmentation(map, 6.0);
+    assert(segmentation.getRegionCount() == 2);
+    const int left = segmentation.getRegion(10, 10);
+    const int right = segmentation.getRegion(50, 10);
+    assert(left != RoomSegmentation::NO_REGION && right != RoomSegmentation::NO_REGION && left != right);
+    assert(segmentation.getRegion(30, 5) == RoomSegmentation::NO_REGION);
+    assert(segmentation.getRegion(-1, 5) == RoomSegmentation::NO_REGION);
+
+    // Every free cell belongs to a region, and each room is one region
+    for (int y = 0; y < map.getNumberY(); ++y) {
+        for (int x = 0; x < map.getNumberX(); ++x) {
+            assert((segmentation.getRegion(x, y) == RoomSegmentation::NO_REGION) == (map.getGrid(x, y) != 0));
+            if (x > 0 && x < 29 && y > 0 && y < 30) {
+                assert(segmentation.getRegion(x, y) == left);
+            }
+            if (x > 31 && x < 60 && y > 0 && y < 30) {
+                assert(segmentation.getRegion(x, y) == right);
+            }
+        }
+    }
+    const int area = segmentation.getRegionInfo(left).area + segmentation.getRegionInfo(right).area;
+    assert(area == 2 * 29 * 29 + 3);
+    assert(segmentation.getRegionInfo(left).clearance > 10.0);
+    assert(std::abs(segmentation.getRegionInfo(left).centroidX - 15.0) < 1.0);
+
+    // The rooms are linked through the door
+    const RoomSegmentation::RegionLink* link = findLink(segmentation, left, right);
+    assert(link && findLink(segmentation, right, left));
+    assert(link->borderLength == 3);
+    assert(link->doorX >= 29 && link->doorX <= 31 && link->doorY >= 15 && link->doorY <= 17);
+    assert(link->doorClearance < 3.0);
+
+    bool thrown = false;
+    try {
+        segmentation.getRegionInfo(2);
+    }
+    catch (const std::out_of_range&) {
+        thrown = true;
+    }
+    assert(thrown);
+    thrown = false;
+    try {
+        RoomSegmentation invalid(map, 0.0);
+    }
+    catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    assert(thrown);
+    std::cout << "testRooms: Passed\n";
+}
+
+/**
+ * @brief Tests that enclosed pockets become unlinked regions.
+ */
+void TestRoomSegmentation::testUnreachableSpace() {
+    Map map = buildRooms(1, 30, 0);
+    drawWall(map, 0, 6, 6, 6);
+    drawWall(map, 6, 0, 6, 6);
+    RoomSegmentation segmentation(map, 6.0);
+    assert(segmentation.getRegionCount() == 2);
+    const int room = segmentation.getRegion(20, 20);
+    const int pocket = segmentation.getRegion(3, 3);
+    assert(pocket != room && pocket != RoomSegmentation::NO_REGION);
+    assert(segmentation.getRegionInfo(pocket).area == 25);
+    assert(segmentation.getNeighbours(pocket).empty() && segmentation.getNeighbours(room).empty());
+    assert(segmentation.findRegionPath(room, pocket).empty());
+    assert(segmentation.findRegionPath(room, room) == std::vector<int>(1, room));
+    std::cout << "testUnreachableSpace: Passed\n";
+}
+
+/**
+ * @brief Tests region paths and re-segmentation after a change.
+ */
+void TestRoomSegmentation::testRegionPaths() {
+    Map map = buildRooms(4, 25, 3);
+    RoomSegmentation segmentation(map, 6.0);
+    segmentation.setThreadCount(2);
+    assert(segmentation.getRegionCount() == 4);
+    std::vector<int> expected;
+    for (int room = 0; room < 4; ++room) {
+        expected.push_back(segmentation.getRegion(room * 25 + 12, 12));
+    }
+    assert(segmentation.findRegionPath(expected[0], expected[3]) == expected);
+    assert(segmentation.findRegionPath(-1, 0).empty());
+
+    // Closing a door cuts the chain; removing a wall merges two rooms
+    for (int y = 12; y < 15; ++y) {
+        map.setGrid(50, y, 1);
+    }
+    segmentation.update();
+    const int first = segmentation.getRegion(12, 12);
+    const int last = segmentation.getRegion(87, 12);
+    assert(segmentation.getRegionCount() == 4 && segmentation.findRegionPath(first, last).empty());
+    for (int y = 1; y < 25; ++y) {
+        map.setGrid(25, y, 0);
+    }
+    segmentation.update();
+    assert(segmentation.getRegionCount() == 3);
+    assert(segmentation.getRegion(12, 12) == segmentation.getRegion(37, 12));
+    std::cout << "testRegionPaths: Passed\n";
+}
+
+/**
+ * @brief Tests segmentation of a building with a grid of rooms.
+ */
+void TestRoomSegmentation::testBuilding() {
+    // 4 x 4 rooms of 64 cells with 4-cell doors in every wall
+    const int rooms = 4;
+    const int side = 64;
+    Map map(rooms * side + 1, rooms * side + 1);
+    for (int i = 0; i <= rooms; ++i) {
+        drawWall(map, i * side, 0, i * side, rooms * side);
+        drawWall(map, 0, i * side, rooms * side, i * side);
+    }
+    for (int i = 1; i < rooms; ++i) {
+        for (int j = 0; j < rooms; ++j) {
+            for (int k = 30; k < 34; ++k) {
+                map.setGrid(i * side, j * side + k, 0);
+                map.setGrid(j * side + k, i * side, 0);
+            }
+        }
+    }
+    RoomSegmentation segmentation(map, 8.0);
+    assert(segmentation.getRegionCount() == rooms * rooms);
+    assert(segmentation.getNeighbours(segmentation.getRegion(100, 100)).size() == 4);
+
+    std::vector<int> path = segmentation.findRegionPath(segmentation.getRegion(10, 10), segmentation.getRegion(250, 250));
+    assert(path.size() == 2 * rooms - 1);
+    std::cout << "testBuilding: Passed\n";
+}
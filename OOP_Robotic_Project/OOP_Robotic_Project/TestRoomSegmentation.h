@@ -0,0 +1,41 @@
+#ifndef TESTROOMSEGMENTATION_H
+#define TESTROOMSEGMENTATION_H
+
+#include "RoomSegmentation.h"
+
+/**
+ * @file   TestRoomSegmentation.h
+ * @author Emirhan Kalkan
+ * @date   December, 2024
+ * @brief  Header file for the TestRoomSegmentation class, which contains methods to test the RoomSegmentation class.
+ */
+class TestRoomSegmentation {
+public:
+    /**
+     * @brief Runs all the tests for the RoomSegmentation class.
+     */
+    static void runAllTests();
+
+private:
+    /**
+     * @brief Tests that rooms joined by doors become linked regions.
+     */
+    static void testRooms();
+
+    /**
+     * @brief Tests that enclosed pockets become unlinked regions.
+     */
+    static void testUnreachableSpace();
+
+    /**
+     * @brief Tests region paths and re-segmentation after a change.
+     */
+    static void testRegionPaths();
+
+    /**
+     * @brief Tests segmentation of a building with a grid of rooms.
+     */
+    static void testBuilding();
+};
+
+#endif // TESTROOMSEGMENTATION_H
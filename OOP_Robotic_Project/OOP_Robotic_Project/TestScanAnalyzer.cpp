@@ -0,0 +1,93 @@
+/**
+ * @file   TestScanAnalyzer.cpp
+ * @author Furkan Gemici
+ * @date   December, 2024
+ * @brief  Source file for testing the ScanAnalyzer class.
+ */
+
+#include "TestScanAnalyzer.h"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+/**
+ * @brief Runs all test cases for the ScanAnalyzer class.
+ */
+void TestScanAnalyzer::runAllTests() {
+    std::cout << "Running ScanAnalyzer tests...\n";
+    testStatistics();
+    testNoValidBeams();
+    testMinimumInRange();
+    std::cout << "All ScanAnalyzer tests passed successfully!\n";
+}
+
+/**
+ * @brief Compares computeStatistics against a sequential reference.
+ *
+ * The scan contains zeros, infinities, NaNs and repeated extremes so that
+ * masking and tie breaking are exercised in every lane.
+ */
+void TestScanAnalyzer::testStatistics() {
+    const int beams = 45;
+    std::vector<float> ranges(beams);
+    for (int i = 0; i < beams; ++i) {
+        ranges[i] = 2.0f + static_cast<float>((i * 7) % 11) * 0.25f;
+    }
+    ranges[3] = 0.0f;
+    ranges[9] = std::numeric_limits<float>::infinity();
+    ranges[17] = std::numeric_limits<float>::quiet_NaN();
+    ranges[20] = 0.5f;
+    ranges[41] = 0.5f;
+    ranges[30] = 9.0f;
+    ranges[44] = 9.0f;
+
+    ScanStatistics stats;
+    ScanAnalyzer::computeStatistics(ranges.data(), beams, stats);
+
+    double sum = 0.0;
+    int valid = 0;
+    for (int i = 0; i < beams; ++i) {
+        if (ranges[i] > 0.0f && std::isfinite(ranges[i])) {
+            sum += ranges[i];
+            ++valid;
+        }
+    }
+    assert(stats.min == 0.5f && stats.minIndex == 20);
+    assert(stats.max == 9.0f && stats.maxIndex == 30);
+    assert(stats.validCount == valid);
+    assert(std::fabs(stats.mean - sum / valid) < 1e-4);
+    std::cout << "testStatistics: Passed\n";
+}
+
+/**
+ * @brief Tests a scan without any valid beam.
+ */
+void TestScanAnalyzer::testNoValidBeams() {
+    std::vector<float> ranges(10, 0.0f);
+    ScanStatistics stats;
+    ScanAnalyzer::computeStatistics(ranges.data(), 10, stats);
+    assert(stats.minIndex == -1 && stats.maxIndex == -1);
+    assert(stats.validCount == 0 && stats.mean == 0.0f);
+    std::cout << "testNoValidBeams: Passed\n";
+}
+
+/**
+ * @brief Tests minimumInRange on partial ranges.
+ */
+void TestScanAnalyzer::testMinimumInRange() {
+    std::vector<float> ranges(20);
+    for (int i = 0; i < 20; ++i) {
+        ranges[i] = 5.0f - 0.1f * i;
+    }
+    ranges[19] = 0.0f;
+    int index;
+    float value = ScanAnalyzer::minimumInRange(ranges.data(), 2, 11, index);
+    assert(index == 10 && value == ranges[10]);
+    value = ScanAnalyzer::minimumInRange(ranges.data(), 12, 20, index);
+    assert(index == 18 && value == ranges[18]);
+    value = ScanAnalyzer::minimumInRange(ranges.data(), 19, 20, index);
+    assert(index == -1 && std::isinf(value));
+    std::cout << "testMinimumInRange: Passed\n";
+}
@@ -0,0 +1,37 @@
+/**
+ * @file   TestScanAnalyzer.h
+ * @author Furkan Gemici
+ * @date   December, 2024
+ * @brief  Header file for testing the ScanAnalyzer class.
+ */
+
+#pragma once
+#include "ScanAnalyzer.h"
+
+ /**
+  * @class TestScanAnalyzer
+  * @brief A test class to validate the vectorized scan statistics.
+  */
+class TestScanAnalyzer {
+public:
+    /**
+     * @brief Runs all test cases for the ScanAnalyzer class.
+     */
+    static void runAllTests();
+
+private:
+    /**
+     * @brief Compares computeStatistics against a sequential reference.
+     */
+    static void testStatistics();
+
+    /**
+     * @brief Tests a scan without any valid beam.
+     */
+    static void testNoValidBeams();
+
+    /**
+     * @brief Tests minimumInRange on partial ranges.
+     */
+    static void testMinimumInRange();
+};
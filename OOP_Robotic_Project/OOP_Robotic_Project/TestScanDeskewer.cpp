@@ -0,0 +1,110 @@
+/**
+ * @file   TestScanDeskewer.cpp
+ * @author Furkan Gemici
+ * @date   December, 2024
+ * @brief  Source file for testing the ScanDeskewer class.
+ */
+
+#include "TestScanDeskewer.h"
+#include "ScanProjector.h"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace {
+    const int BEAMS = 90;
+
+    void makeScan(std::vector<float>& ranges, std::vector<float>& cosTable, std::vector<float>& sinTable) {
+        ranges.resize(BEAMS);
+        cosTable.resize(BEAMS);
+        sinTable.resize(BEAMS);
+        for (int i = 0; i < BEAMS; ++i) {
+            double angle = i * (360.0 / BEAMS) * M_PI / 180.0;
+            ranges[i] = 2.0f + 0.03f * i;
+            cosTable[i] = static_cast<float>(std::cos(angle));
+            sinTable[i] = static_cast<float>(std::sin(angle));
+        }
+    }
+
+    /**
+     * @brief Checks a deskewed batch against an exact per-beam transformation.
+     */
+    void checkAgainstReference(const std::vector<float>& ranges, const PointBatch& batch,
+        double x0, double y0, double th0, double x1, double y1, double dthDeg) {
+        for (int i = 0; i < BEAMS; ++i) {
+            double t = static_cast<double>(i) / (BEAMS - 1);
+            double heading = (th0 + t * dthDeg) * M_PI / 180.0;
+            double beam = i * (360.0 / BEAMS) * M_PI / 180.0;
+            double x = x0 + t * (x1 - x0) + ranges[i] * std::cos(beam + heading);
+            double y = y0 + t * (y1 - y0) + ranges[i] * std::sin(beam + heading);
+            assert(std::fabs(batch.getX()[i] - x) < 1e-3);
+            assert(std::fabs(batch.getY()[i] - y) < 1e-3);
+        }
+    }
+}
+
+/**
+ * @brief Runs all test cases for the ScanDeskewer class.
+ */
+void TestScanDeskewer::runAllTests() {
+    std::cout << "Running ScanDeskewer tests...\n";
+    testStaticRobot();
+    testMovingRobot();
+    testHeadingWrap();
+    std::cout << "All ScanDeskewer tests passed successfully!\n";
+}
+
+/**
+ * @brief Tests that a static robot gives the same result as ScanProjector.
+ */
+void TestScanDeskewer::testStaticRobot() {
+    std::vector<float> ranges, cosTable, sinTable;
+    makeScan(ranges, cosTable, sinTable);
+    PointBatch deskewed, projected;
+    Pose pose(1.0, 2.0, 30.0);
+    ScanDeskewer::deskew(ranges.data(), cosTable.data(), sinTable.data(), BEAMS, pose, pose, deskewed);
+    ScanProjector::project(ranges.data(), cosTable.data(), sinTable.data(), BEAMS, 1.0, 2.0, 30.0, projected);
+    for (int i = 0; i < BEAMS; ++i) {
+        assert(std::fabs(deskewed.getX()[i] - projected.getX()[i]) < 1e-4);
+        assert(std::fabs(deskewed.getY()[i] - projected.getY()[i]) < 1e-4);
+    }
+    std::cout << "testStaticRobot: Passed\n";
+}
+
+/**
+ * @brief Tests translation and rotation against an exact per-beam reference.
+ */
+void TestScanDeskewer::testMovingRobot() {
+    std::vector<float> ranges, cosTable, sinTable;
+    makeScan(ranges, cosTable, sinTable);
+    PointBatch batch;
+
+    // Small turn: polynomial path.
+    ScanDeskewer::deskew(ranges.data(), cosTable.data(), sinTable.data(), BEAMS,
+        Pose(0.0, 0.0, 10.0), Pose(0.4, -0.2, 25.0), batch);
+    checkAgainstReference(ranges, batch, 0.0, 0.0, 10.0, 0.4, -0.2, 15.0);
+
+    // Large turn: exact path.
+    ScanDeskewer::deskew(ranges.data(), cosTable.data(), sinTable.data(), BEAMS,
+        Pose(1.0, 1.0, 0.0), Pose(1.5, 1.0, 90.0), batch);
+    checkAgainstReference(ranges, batch, 1.0, 1.0, 0.0, 1.5, 1.0, 90.0);
+    std::cout << "testMovingRobot: Passed\n";
+}
+
+/**
+ * @brief Tests heading interpolation across the 0/360 degree boundary.
+ */
+void TestScanDeskewer::testHeadingWrap() {
+    std::vector<float> ranges, cosTable, sinTable;
+    makeScan(ranges, cosTable, sinTable);
+    PointBatch batch;
+    ScanDeskewer::deskew(ranges.data(), cosTable.data(), sinTable.data(), BEAMS,
+        Pose(0.0, 0.0, 355.0), Pose(0.0, 0.0, 5.0), batch);
+    checkAgainstReference(ranges, batch, 0.0, 0.0, 355.0, 0.0, 0.0, 10.0);
+    std::cout << "testHeadingWrap: Passed\n";
+}
@@ -0,0 +1,37 @@
+/**
+ * @file   TestScanDeskewer.h
+ * @author Furkan Gemici
+ * @date   December, 2024
+ * @brief  Header file for testing the ScanDeskewer class.
+ */
+
+#pragma once
+#include "ScanDeskewer.h"
+
+ /**
+  * @class TestScanDeskewer
+  * @brief A test class to validate motion-compensated scan projection.
+  */
+class TestScanDeskewer {
+public:
+    /**
+     * @brief Runs all test cases for the ScanDeskewer class.
+     */
+    static void runAllTests();
+
+private:
+    /**
+     * @brief Tests that a static robot gives the same result as ScanProjector.
+     */
+    static void testStaticRobot();
+
+    /**
+     * @brief Tests translation and rotation against an exact per-beam reference.
+     */
+    static void testMovingRobot();
+
+    /**
+     * @brief Tests heading interpolation across the 0/360 degree boundary.
+     */
+    static void testHeadingWrap();
+};
@@ -0,0 +1,113 @@
+/**
+ * @file   TestScanFilter.cpp
+ * @author Furkan Gemici
+ * @date   December, 2024
+ * @brief  Source file for testing the scan filters and ScanFilterChain.
+ */
+
+#include "TestScanFilter.h"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+/**
+ * @brief Runs all test cases for the scan filters.
+ */
+void TestScanFilter::runAllTests() {
+    std::cout << "Running ScanFilter tests...\n";
+    testRangeClamp();
+    testMedian();
+    testDownsample();
+    testTemporalAverage();
+    testChain();
+    std::cout << "All ScanFilter tests passed successfully!\n";
+}
+
+/**
+ * @brief Tests RangeClampFilter.
+ */
+void TestScanFilter::testRangeClamp() {
+    std::vector<float> ranges = { 0.0f, 0.5f, 1.0f, 2.0f, 10.0f, 3.0f, INFINITY, 0.05f, 4.0f };
+    RangeClampFilter filter(0.1f, 5.0f);
+    assert(filter.apply(ranges.data(), 9) == 9);
+    assert(std::isnan(ranges[0]) && std::isnan(ranges[4]) && std::isnan(ranges[6]) && std::isnan(ranges[7]));
+    assert(ranges[1] == 0.5f && ranges[3] == 2.0f && ranges[8] == 4.0f);
+    std::cout << "testRangeClamp: Passed\n";
+}
+
+/**
+ * @brief Tests MedianFilter spike removal.
+ */
+void TestScanFilter::testMedian() {
+    std::vector<float> ranges(11, 2.0f);
+    ranges[5] = 9.0f;           // Spike
+    ranges[8] = INVALID_RANGE;  // Invalid beam keeps its neighbours unchanged
+    ranges[9] = 7.0f;
+    MedianFilter filter;
+    filter.apply(ranges.data(), 11);
+    assert(ranges[5] == 2.0f);
+    assert(std::isnan(ranges[8]) && ranges[9] == 7.0f);
+    std::cout << "testMedian: Passed\n";
+}
+
+/**
+ * @brief Tests DownsampleFilter.
+ */
+void TestScanFilter::testDownsample() {
+    std::vector<float> ranges = { 3.0f, 1.0f, 2.0f, INVALID_RANGE, INVALID_RANGE, INVALID_RANGE, 5.0f, INVALID_RANGE, 4.0f, 8.0f };
+    DownsampleFilter filter(3);
+    assert(filter.apply(ranges.data(), 10) == 3);
+    assert(ranges[0] == 1.0f && std::isnan(ranges[1]) && ranges[2] == 4.0f);
+    std::cout << "testDownsample: Passed\n";
+}
+
+/**
+ * @brief Tests TemporalAverageFilter.
+ */
+void TestScanFilter::testTemporalAverage() {
+    TemporalAverageFilter filter(0.5f);
+    std::vector<float> first(6, 2.0f);
+    std::vector<float> second(6, 4.0f);
+    second[2] = INVALID_RANGE;
+    filter.apply(first.data(), 6);
+    filter.apply(second.data(), 6);
+    assert(second[0] == 3.0f && second[5] == 3.0f);
+    assert(std::isnan(second[2]));
+
+    filter.reset();
+    std::vector<float> third(6, 6.0f);
+    filter.apply(third.data(), 6);
+    assert(third[0] == 6.0f);
+    std::cout << "testTemporalAverage: Passed\n";
+}
+
+/**
+ * @brief Tests a chain of filters including the decimated angle tables.
+ */
+void TestScanFilter::testChain() {
+    const int beams = 12;
+    std::vector<float> ranges(beams), cosTable(beams), sinTable(beams);
+    for (int i = 0; i < beams; ++i) {
+        ranges[i] = 1.0f + i;
+        cosTable[i] = static_cast<float>(i);
+        sinTable[i] = static_cast<float>(-i);
+    }
+    ranges[0] = 0.0f;
+
+    RangeClampFilter clamp(0.1f, 100.0f);
+    DownsampleFilter downsample(4);
+    ScanFilterChain chain;
+    chain.addFilter(&clamp).addFilter(&downsample);
+
+    assert(chain.process(ranges.data(), cosTable.data(), sinTable.data(), beams) == 3);
+    assert(chain.getDecimation() == 4);
+    assert(chain.getRanges()[0] == 2.0f && chain.getRanges()[1] == 5.0f);
+    assert(chain.getCosTable()[1] == 6.0f && chain.getSinTable()[2] == -10.0f);
+    assert(ranges[0] == 0.0f); // Input is not modified
+
+    PointBatch points;
+    chain.projectScan(points);
+    assert(points.size() == 3);
+    std::cout << "testChain: Passed\n";
+}
@@ -0,0 +1,47 @@
+/**
+ * @file   TestScanFilter.h
+ * @author Furkan Gemici
+ * @date   December, 2024
+ * @brief  Header file for testing the scan filters and ScanFilterChain.
+ */
+
+#pragma once
+#include "ScanFilterChain.h"
+
+ /**
+  * @class TestScanFilter
+  * @brief A test class to validate the scan filter pipeline.
+  */
+class TestScanFilter {
+public:
+    /**
+     * @brief Runs all test cases for the scan filters.
+     */
+    static void runAllTests();
+
+private:
+    /**
+     * @brief Tests RangeClampFilter.
+     */
+    static void testRangeClamp();
+
+    /**
+     * @brief Tests MedianFilter spike removal.
+     */
+    static void testMedian();
+
+    /**
+     * @brief Tests DownsampleFilter.
+     */
+    static void testDownsample();
+
+    /**
+     * @brief Tests TemporalAverageFilter.
+     */
+    static void testTemporalAverage();
+
+    /**
+     * @brief Tests a chain of filters including the decimated angle tables.
+     */
+    static void testChain();
+};
@@ -0,0 +1,188 @@
+/**
+ * @file   TestScanLog.cpp
+ * @author Furkan Gemici
+ * @date   December, 2024
+ * @brief  Source file for testing the ScanLogWriter and ScanLogReader classes.
+ */
+
+#include "TestScanLog.h"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+    const int BEAMS = 360;
+    const char* LOG_FILE = "test_scan_log.bin";
+
+    /**
+     * @brief Fills a slowly changing scan, with one invalid and one out-of-range beam.
+     */
+    void makeScan(std::vector<float>& ranges, int scan) {
+        ranges.resize(BEAMS);
+        for (int i = 0; i < BEAMS; ++i) {
+            ranges[i] = static_cast<float>(3.0 + std::sin(i * 0.05) + 0.002 * scan);
+        }
+        ranges[10] = std::nanf("");
+        ranges[20] = INFINITY;
+    }
+
+    /**
+     * @brief Writes `scans` scans, 0.1 s apart, and returns the file size.
+     */
+    unsigned long long writeLog(int scans, int chunkSize) {
+        ScanLogWriter writer;
+        assert(writer.open(LOG_FILE, BEAMS, 360.0, 0.0, chunkSize));
+        std::vector<float> ranges;
+        for (int s = 0; s < scans; ++s) {
+            makeScan(ranges, s);
+            writer.writeScan(ranges.data(), 0.1 * s);
+        }
+        assert(writer.close());
+        return writer.getBytesWritten();
+    }
+}
+
+/**
+ * @brief Runs all test cases for the scan log.
+ */
+void TestScanLog::runAllTests() {
+    std::cout << "Running ScanLog tests...\n";
+    testRoundTrip();
+    testCompression();
+    testCorruptedChunk();
+    testInvalidHeader();
+    testWriteFailure();
+    std::remove(LOG_FILE);
+    std::cout << "All ScanLog tests passed successfully!\n";
+}
+
+/**
+ * @brief Tests that scans survive a write/read round trip within quantization error.
+ */
+void TestScanLog::testRoundTrip() {
+    writeLog(25, 10);
+
+    ScanLogReader reader;
+    assert(reader.open(LOG_FILE));
+    assert(reader.getBeamCount() == BEAMS);
+    assert(reader.getFieldOfView() == 360.0);
+
+    std::vector<float> expected, ranges(BEAMS);
+    double timestamp;
+    int scans = 0;
+    while (reader.readScan(ranges.data(), timestamp)) {
+        makeScan(expected, scans);
+        assert(std::fabs(timestamp - 0.1 * scans) < 1e-6);
+        for (int i = 0; i < BEAMS; ++i) {
+            if (i == 10) {
+                assert(std::isnan(ranges[i]));
+            }
+            else if (i == 20) {
+                assert(std::isinf(ranges[i]));
+            }
+            else {
+                assert(std::fabs(ranges[i] - expected[i]) <= 0.0005f + 1e-6f);
+            }
+        }
+        ++scans;
+    }
+    assert(scans == 25);
+    assert(!reader.hasChecksumError());
+    std::cout << "testRoundTrip: Passed\n";
+}
+
+/**
+ * @brief Tests that the delta encoding is much smaller than raw floats.
+ */
+void TestScanLog::testCompression() {
+    const int scans = 100;
+    unsigned long long bytes = writeLog(scans, 50);
+    unsigned long long raw = static_cast<unsigned long long>(scans) * BEAMS * sizeof(float);
+    assert(bytes * 3 < raw);
+    std::cout << "testCompression: Passed\n";
+}
+
+/**
+ * @brief Tests that a corrupted chunk is skipped and the other chunks are still read.
+ */
+void TestScanLog::testCorruptedChunk() {
+    writeLog(30, 10);
+
+    // Flip a byte inside the first chunk's payload (file header 20 + chunk header 12)
+    {
+        std::fstream file(LOG_FILE, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(40);
+        file.put('\x55');
+    }
+
+    ScanLogReader reader;
+    assert(reader.open(LOG_FILE));
+    std::vector<float> expected, ranges(BEAMS);
+    double timestamp;
+    int scans = 0;
+    while (reader.readScan(ranges.data(), timestamp)) {
+        makeScan(expected, scans + 10);
+        assert(std::fabs(timestamp - 0.1 * (scans + 10)) < 1e-6);
+        assert(std::fabs(ranges[0] - expected[0]) <= 0.0005f + 1e-6f);
+        ++scans;
+    }
+    assert(scans == 20);
+    assert(reader.hasChecksumError());
+    std::cout << "testCorruptedChunk: Passed\n";
+}
+
+/**
+ * @brief Tests that a header with an impossible beam count is rejected.
+ */
+void TestScanLog::testInvalidHeader() {
+    const unsigned int counts[3] = { 0u, ScanLogWriter::MAX_BEAM_COUNT + 1u, 0xFFFFFFFFu };
+    for (unsigned int count : counts) {
+        writeLog(5, 10);
+        {
+            // The beam count is the u32 at offset 8 of the file header
+            std::fstream file(LOG_FILE, std::ios::in | std::ios::out | std::ios::binary);
+            file.seekp(8);
+            for (int i = 0; i < 4; ++i) {
+                file.put(static_cast<char>(count >> (8 * i)));
+            }
+        }
+        ScanLogReader reader;
+        assert(!reader.open(LOG_FILE));
+    }
+
+    ScanLogWriter writer;
+    assert(!writer.open(LOG_FILE, 0, 360.0, 0.0));
+    assert(!writer.open(LOG_FILE, ScanLogWriter::MAX_BEAM_COUNT + 1, 360.0, 0.0));
+    assert(writer.close());
+    std::cout << "testInvalidHeader: Passed\n";
+}
+
+/**
+ * @brief Tests that a failed write is reported by isOpen() and close().
+ */
+void TestScanLog::testWriteFailure() {
+#ifdef __linux__
+    // Every write to /dev/full fails with ENOSPC, like a full disk
+    ScanLogWriter writer;
+    if (writer.open("/dev/full", BEAMS, 360.0, 0.0, 2)) {
+        std::vector<float> ranges;
+        bool thrown = false;
+        try {
+            for (int s = 0; s < 100; ++s) {
+                makeScan(ranges, s);
+                writer.writeScan(ranges.data(), 0.1 * s);
+            }
+        }
+        catch (const std::runtime_error&) {
+            thrown = true;
+        }
+        assert(thrown && !writer.isOpen());
+        assert(!writer.close());
+    }
+#endif
+    std::cout << "testWriteFailure: Passed\n";
+}
@@ -0,0 +1,47 @@
+/**
+ * @file   TestScanLog.h
+ * @author Furkan Gemici
+ * @date   December, 2024
+ * @brief  Header file for testing the ScanLogWriter and ScanLogReader classes.
+ */
+
+#pragma once
+#include "ScanLog.h"
+
+ /**
+  * @class TestScanLog
+  * @brief A test class to validate the binary Lidar scan log.
+  */
+class TestScanLog {
+public:
+    /**
+     * @brief Runs all test cases for the scan log.
+     */
+    static void runAllTests();
+
+private:
+    /**
+     * @brief Tests that scans survive a write/read round trip within quantization error.
+     */
+    static void testRoundTrip();
+
+    /**
+     * @brief Tests that the delta encoding is much smaller than raw floats.
+     */
+    static void testCompression();
+
+    /**
+     * @brief Tests that a corrupted chunk is skipped and the other chunks are still read.
+     */
+    static void testCorruptedChunk();
+
+    /**
+     * @brief Tests that a header with an impossible beam count is rejected.
+     */
+    static void testInvalidHeader();
+
+    /**
+     * @brief Tests that a failed write is reported by isOpen() and close().
+     */
+    static void testWriteFailure();
+};
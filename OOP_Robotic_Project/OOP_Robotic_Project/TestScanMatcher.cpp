@@ -0,0 +1,217 @@
+/**
+ * @file   TestScanMatcher.cpp
+ * @author Furkan Gemici
+ * @date   December, 2024
+ * @brief  Source file for testing the ScanMatcher class.
+ */
+
+#include "TestScanMatcher.h"
+#include "ScanProjector.h"
+#include <iostream>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace {
+    const int BEAMS = 360;
+
+    /*! Walls of a 10 m x 6 m room and of a 1 m x 1 m pillar, as x0, y0, x1, y1. */
+    const double SEGMENTS[][4] = {
+        { -4.0, -3.0, 6.0, -3.0 }, { 6.0, -3.0, 6.0, 3.0 }, { 6.0, 3.0, -4.0, 3.0 }, { -4.0, 3.0, -4.0, -3.0 },
+        { 1.0, 0.5, 2.0, 0.5 }, { 2.0, 0.5, 2.0, 1.5 }, { 2.0, 1.5, 1.0, 1.5 }, { 1.0, 1.5, 1.0, 0.5 },
+    };
+
+    /**
+     * @brief Simulates a scan of the room and projects it into the sensor frame.
+     */
+    void simulateScan(double x, double y, double thDeg, PointBatch& out) {
+        std::vector<float> ranges(BEAMS), cosTable(BEAMS), sinTable(BEAMS);
+        for (int i = 0; i < BEAMS; ++i) {
+            double beam = i * M_PI / 180.0;
+            double angle = beam + thDeg * M_PI / 180.0;
+            double dx = std::cos(angle), dy = std::sin(angle);
+            double nearest = INFINITY;
+            for (const auto& s : SEGMENTS) {
+                double ex = s[2] - s[0], ey = s[3] - s[1];
+                double denom = dx * ey - dy * ex;
+                if (std::fabs(denom) < 1e-12) {
+                    continue;
+                }
+                double t = ((s[0] - x) * ey - (s[1] - y) * ex) / denom;
+                double u = ((s[0] - x) * dy - (s[1] - y) * dx) / denom;
+                if (t > 0.0 && u >= 0.0 && u <= 1.0 && t < nearest) {
+                    nearest = t;
+                }
+            }
+            ranges[i] = static_cast<float>(nearest);
+            cosTable[i] = static_cast<float>(std::cos(beam));
+            sinTable[i] = static_cast<float>(std::sin(beam));
+        }
+        ScanProjector::project(ranges.data(), cosTable.data(), sinTable.data(), BEAMS, out);
+    }
+}
+
+/**
+ * @brief Runs all test cases for the ScanMatcher class.
+ */
+void TestScanMatcher::runAllTests() {
+    std::cout << "Running ScanMatcher tests...\n";
+    testIdentity();
+    testKnownMotion();
+    testTracking();
+    testGateChange();
+    testRepeatedMatches();
+    std::cout << "All ScanMatcher tests passed successfully!\n";
+}
+
+/**
+ * @brief Runs the ScanMatcher benchmarks.
+ */
+void TestScanMatcher::runBenchmarks() {
+    std::cout << "Running ScanMatcher benchmarks...\n";
+    benchmarkLatency();
+}
+
+/**
+ * @brief Tests that a scan matched against itself gives the identity.
+ */
+void TestScanMatcher::testIdentity() {
+    PointBatch scan;
+    simulateScan(0.0, 0.0, 0.0, scan);
+    ScanMatcher matcher;
+    matcher.setReference(scan);
+    ScanMatch result = matcher.match(scan);
+    assert(result.converged);
+    assert(result.correspondences == BEAMS);
+    assert(std::fabs(result.x) < 1e-4 && std::fabs(result.y) < 1e-4 && std::fabs(result.th) < 1e-3);
+    std::cout << "testIdentity: Passed\n";
+}
+
+/**
+ * @brief Tests that a known motion is recovered from a zero initial guess.
+ */
+void TestScanMatcher::testKnownMotion() {
+    PointBatch reference, current;
+    simulateScan(0.0, 0.0, 0.0, reference);
+    simulateScan(0.12, -0.06, 4.0, current);
+    ScanMatcher matcher;
+    matcher.setReference(reference);
+    ScanMatch result = matcher.match(current);
+    assert(result.converged);
+    assert(std::fabs(result.x - 0.12) < 0.01);
+    assert(std::fabs(result.y + 0.06) < 0.01);
+    assert(std::fabs(result.th - 4.0) < 0.2);
+
+    // relativeMotion() and compose() are inverses
+    Pose from(1.0, 2.0, 170.0), to(1.5, 1.8, -175.0);
+    Pose back = ScanMatcher::compose(from, ScanMatcher::relativeMotion(from, to));
+    assert(std::fabs(back.getX() - 1.5) < 1e-9 && std::fabs(back.getY() - 1.8) < 1e-9);
+    assert(std::fabs(back.getTh() - 185.0) < 1e-9);
+    std::cout << "testKnownMotion: Passed\n";
+}
+
+/**
+ * @brief Tests that tracking removes a systematic odometry drift.
+ */
+void TestScanMatcher::testTracking() {
+    ScanMatcher matcher;
+    PointBatch scan;
+    double x = -2.0, y = -1.0, th = 0.0;
+    double odomX = x, odomY = y, odomTh = th;
+    Pose corrected;
+    for (int step = 0; step < 40; ++step) {
+        simulateScan(x, y, th, scan);
+        corrected = matcher.track(scan, Pose(odomX, odomY, odomTh));
+        // True motion: 5 cm forward and 1 degree left; odometry over-reports both
+        double heading = th * M_PI / 180.0;
+        x += 0.05 * std::cos(heading);
+        y += 0.05 * std::sin(heading);
+        th += 1.0;
+        double odomHeading = odomTh * M_PI / 180.0;
+        odomX += 0.055 * std::cos(odomHeading);
+        odomY += 0.055 * std::sin(odomHeading);
+        odomTh += 1.3;
+    }
+    double lastX = x - 0.05 * std::cos((th - 1.0) * M_PI / 180.0);
+    double lastY = y - 0.05 * std::sin((th - 1.0) * M_PI / 180.0);
+    assert(std::fabs(corrected.getX() - lastX) < 0.05);
+    assert(std::fabs(corrected.getY() - lastY) < 0.05);
+    assert(std::fabs(corrected.getTh() - (th - 1.0)) < 1.0);
+    std::cout << "testTracking: Passed\n";
+}
+
+/**
+ * @brief Tests that changing the gate between setReference() and match() keeps matching.
+ */
+void TestScanMatcher::testGateChange() {
+    PointBatch reference, current;
+    simulateScan(0.0, 0.0, 0.0, reference);
+    simulateScan(0.12, -0.06, 4.0, current);
+    ScanMatcher matcher(0.5);
+    matcher.setReference(reference);
+    const double gates[] = { 0.1, 1.2, 40.0 };
+    for (double gate : gates) {
+        matcher.setMaxCorrespondenceDistance(gate);
+        ScanMatch result = matcher.match(reference);
+        assert(result.converged && result.correspondences == BEAMS);
+        assert(std::fabs(result.x) < 1e-4 && std::fabs(result.y) < 1e-4);
+    }
+    // A wider gate still finds the nearest point, not just any point in the 3x3 cells
+    matcher.setMaxCorrespondenceDistance(1.2);
+    ScanMatch result = matcher.match(current);
+    assert(result.converged);
+    assert(std::fabs(result.x - 0.12) < 0.01 && std::fabs(result.y + 0.06) < 0.01);
+    std::cout << "testGateChange: Passed\n";
+}
+
+/**
+ * @brief Tests that a reused matcher gives the same result on every call.
+ */
+void TestScanMatcher::testRepeatedMatches() {
+    PointBatch reference, current, other;
+    simulateScan(0.0, 0.0, 0.0, reference);
+    simulateScan(0.05, 0.02, 1.5, current);
+    simulateScan(-0.03, 0.04, -2.0, other);
+    ScanMatcher matcher;
+
+    matcher.setReference(reference);
+    const ScanMatch first = matcher.match(current);
+    assert(first.converged);
+    for (int i = 0; i < 20; ++i) {
+        // A different match in between must not leave state behind
+        matcher.setReference(current);
+        assert(matcher.match(other).converged);
+        matcher.setReference(reference);
+        ScanMatch result = matcher.match(current);
+        assert(result.converged);
+        assert(result.x == first.x && result.y == first.y && result.th == first.th);
+        assert(result.iterations == first.iterations && result.correspondences == first.correspondences);
+    }
+    std::cout << "testRepeatedMatches: Passed\n";
+}
+
+/**
+ * @brief Reports the per-scan matching latency on synthetic 360-beam scans.
+ */
+void TestScanMatcher::benchmarkLatency() {
+    const int runs = 200;
+    PointBatch reference, current;
+    simulateScan(0.0, 0.0, 0.0, reference);
+    simulateScan(0.05, 0.02, 1.5, current);
+    ScanMatcher matcher;
+
+    int converged = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < runs; ++i) {
+        matcher.setReference(reference);
+        converged += matcher.match(current).converged ? 1 : 0;
+    }
+    double perScan = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / runs;
+    // A 10 Hz Lidar leaves 100 ms per scan
+    std::cout << "  point-to-line ICP: " << perScan << " ms per scan (" << converged << "/" << runs << " converged)\n";
+}
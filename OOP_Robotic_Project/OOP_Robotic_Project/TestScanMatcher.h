@@ -0,0 +1,57 @@
+/**
+ * @file   TestScanMatcher.h
+ * @author Furkan Gemici
+ * @date   December, 2024
+ * @brief  Header file for testing the ScanMatcher class.
+ */
+
+#pragma once
+#include "ScanMatcher.h"
+
+ /**
+  * @class TestScanMatcher
+  * @brief A test class to validate scan-to-scan ICP odometry.
+  */
+class TestScanMatcher {
+public:
+    /**
+     * @brief Runs all test cases for the ScanMatcher class.
+     */
+    static void runAllTests();
+
+    /**
+     * @brief Runs the ScanMatcher benchmarks. They only print, and are not part of runAllTests().
+     */
+    static void runBenchmarks();
+
+private:
+    /**
+     * @brief Tests that a scan matched against itself gives the identity.
+     */
+    static void testIdentity();
+
+    /**
+     * @brief Tests that a known motion is recovered from a zero initial guess.
+     */
+    static void testKnownMotion();
+
+    /**
+     * @brief Tests that tracking removes a systematic odometry drift.
+     */
+    static void testTracking();
+
+    /**
+     * @brief Tests that changing the gate between setReference() and match() keeps matching.
+     */
+    static void testGateChange();
+
+    /**
+     * @brief Tests that a reused matcher gives the same result on every call.
+     */
+    static void testRepeatedMatches();
+
+    /**
+     * @brief Reports the per-scan matching latency on synthetic 360-beam scans.
+     */
+    static void benchmarkLatency();
+};
@@ -0,0 +1,96 @@
+/**
+ * @file   TestScanProjector.cpp
+ * @author Furkan Gemici
+ * @date   December, 2024
+ * @brief  Source file for testing the ScanProjector and PointBatch classes.
+ */
+
+#include "TestScanProjector.h"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace {
+    const int BEAMS = 37;
+
+    void makeScan(std::vector<float>& ranges, std::vector<float>& cosTable, std::vector<float>& sinTable) {
+        ranges.resize(BEAMS);
+        cosTable.resize(BEAMS);
+        sinTable.resize(BEAMS);
+        for (int i = 0; i < BEAMS; ++i) {
+            double angle = i * (360.0 / BEAMS) * M_PI / 180.0;
+            ranges[i] = 1.0f + 0.1f * i;
+            cosTable[i] = static_cast<float>(std::cos(angle));
+            sinTable[i] = static_cast<float>(std::sin(angle));
+        }
+    }
+}
+
+/**
+ * @brief Runs all test cases for the ScanProjector class.
+ */
+void TestScanProjector::runAllTests() {
+    std::cout << "Running ScanProjector tests...\n";
+    testRobotFrame();
+    testWorldFrame();
+    testBatchReuse();
+    std::cout << "All ScanProjector tests passed successfully!\n";
+}
+
+/**
+ * @brief Tests projection into the sensor frame.
+ */
+void TestScanProjector::testRobotFrame() {
+    std::vector<float> ranges, cosTable, sinTable;
+    makeScan(ranges, cosTable, sinTable);
+
+    PointBatch batch;
+    ScanProjector::project(ranges.data(), cosTable.data(), sinTable.data(), BEAMS, batch);
+    assert(batch.size() == BEAMS);
+    for (int i = 0; i < BEAMS; ++i) {
+        double angle = i * (360.0 / BEAMS) * M_PI / 180.0;
+        assert(std::fabs(batch.getX()[i] - ranges[i] * std::cos(angle)) < 1e-4);
+        assert(std::fabs(batch.getY()[i] - ranges[i] * std::sin(angle)) < 1e-4);
+    }
+    std::cout << "testRobotFrame: Passed\n";
+}
+
+/**
+ * @brief Tests projection into the world frame with a translated and rotated origin.
+ */
+void TestScanProjector::testWorldFrame() {
+    std::vector<float> ranges, cosTable, sinTable;
+    makeScan(ranges, cosTable, sinTable);
+
+    PointBatch batch;
+    ScanProjector::project(ranges.data(), cosTable.data(), sinTable.data(), BEAMS, 2.0, -1.0, 90.0, batch);
+    for (int i = 0; i < BEAMS; ++i) {
+        double angle = (i * (360.0 / BEAMS) + 90.0) * M_PI / 180.0;
+        assert(std::fabs(batch.getX()[i] - (2.0 + ranges[i] * std::cos(angle))) < 1e-4);
+        assert(std::fabs(batch.getY()[i] - (-1.0 + ranges[i] * std::sin(angle))) < 1e-4);
+    }
+    std::cout << "testWorldFrame: Passed\n";
+}
+
+/**
+ * @brief Tests that a reused PointBatch does not reallocate.
+ */
+void TestScanProjector::testBatchReuse() {
+    std::vector<float> ranges, cosTable, sinTable;
+    makeScan(ranges, cosTable, sinTable);
+
+    PointBatch batch(BEAMS);
+    const float* storage = batch.getX();
+    for (int scan = 0; scan < 3; ++scan) {
+        ScanProjector::project(ranges.data(), cosTable.data(), sinTable.data(), BEAMS, batch);
+    }
+    assert(batch.getX() == storage);
+    assert(batch.getCapacity() == BEAMS);
+    assert(batch.getPoint(0).getX() == batch.getX()[0]);
+    std::cout << "testBatchReuse: Passed\n";
+}
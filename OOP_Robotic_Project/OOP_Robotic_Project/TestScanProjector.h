@@ -0,0 +1,40 @@
+/**
+ * @file   TestScanProjector.h
+ * @author Furkan Gemici
+ * @date   December, 2024
+ * @brief  Header file for testing the ScanProjector and PointBatch classes.
+ */
+
+#pragma once
+#include "ScanProjector.h"
+
+ /**
+  * @class TestScanProjector
+  * @brief A test class to validate the vectorized scan projection.
+  *
+  * The SIMD results are compared against a double precision reference using
+  * beam counts that are not a multiple of the vector width.
+  */
+class TestScanProjector {
+public:
+    /**
+     * @brief Runs all test cases for the ScanProjector class.
+     */
+    static void runAllTests();
+
+private:
+    /**
+     * @brief Tests projection into the sensor frame.
+     */
+    static void testRobotFrame();
+
+    /**
+     * @brief Tests projection into the world frame with a translated and rotated origin.
+     */
+    static void testWorldFrame();
+
+    /**
+     * @brief Tests that a reused PointBatch does not reallocate.
+     */
+    static void testBatchReuse();
+};
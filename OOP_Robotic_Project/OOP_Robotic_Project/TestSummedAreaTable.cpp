@@ -0,0 +1,168 @@
+#include "TestSummedAreaTable.h"
+#include <iostream>
+#include <cassert>
+#include <cstdlib>
+#include <stdexcept>
+
+/**
+ * @file   TestSummedAreaTable.cpp
+ * @author Emirhan Kalkan
+ * @date   December, 2024
+ * @brief  Implementation of the test methods for the SummedAreaTable class.
+ */
+
+namespace {
+    /**
+     * @brief Counts the occupied cells of a rectangle one cell at a time.
+     */
+    int bruteCount(const Map& map, int x0, int y0, int x1, int y1) {
+        int count = 0;
+        for (int y = y0; y <= y1; ++y) {
+            for (int x = x0; x <= x1; ++x) {
+                count += map.getGrid(x, y) > 0;
+            }
+        }
+        return count;
+    }
+
+    /**
+     * @brief Compares the counts of random rectangles with a cell-by-cell count.
+     */
+    void checkRandomRectangles(const Map& map, const SummedAreaTable& table, int rectangles) {
+        for (int i = 0; i < rectangles; ++i) {
+            int x0 = std::rand() % (map.getNumberX() + 10) - 5;
+            int y0 = std::rand() % (map.getNumberY() + 10) - 5;
+            int x1 = x0 + std::rand() % 40 - 5;
+            int y1 = y0 + std::rand() % 40 - 5;
+            assert(table.countOccupied(x0, y0, x1, y1) == bruteCount(map, x0, y0, x1, y1));
+        }
+    }
+}
+
+/**
+ * @brief Runs all the tests for the SummedAreaTable class.
+ */
+void TestSummedAreaTable::runAllTests() {
+    std::cout << "Running tests for SummedAreaTable...\n";
+    testRectangleCounts();
+    testIncrementalUpdates();
+    testWorldBoxes();
+    testFootprintChecks();
+    std::cout << "All SummedAreaTable tests passed successfully!\n";
+}
+
+/**
+ * @brief Tests rectangle counts against a cell-by-cell count.
+ */
+void TestSummedAreaTable::testRectangleCounts() {
+    std::srand(8);
+    Map map(97, 61);
+    for (int i = 0; i < 900; ++i) {
+        map.setGrid(std::rand() % 97, std::rand() % 61, 1 + std::rand() % 3);
+    }
+    SummedAreaTable table(map);
+    checkRandomRectangles(map, table, 2000);
+    assert(table.getTotalOccupied() == bruteCount(map, 0, 0, 96, 60));
+    assert(table.countOccupied(-100, -100, 200, 200) == table.getTotalOccupied());
+    assert(table.countOccupied(10, 10, 9, 20) == 0);
+
+    map.setGrid(3, 4, 1);
+    assert(table.isFree(0, 0, 0, 0) == (map.getGrid(0, 0) == 0));
+    assert(!table.isFree(-1, 0, 2, 2));
+    assert(!table.isFree(90, 50, 97, 60));
+
+    Map empty(0, 0);
+    SummedAreaTable emptyTable(empty);
+    assert(emptyTable.countOccupied(0, 0, 10, 10) == 0 && emptyTable.getTotalOccupied() == 0);
+    std::cout << "testRectangleCounts: Passed\n";
+}
+
+/**
+ * @brief Tests that incremental updates match a table built from scratch.
+ */
+void TestSummedAreaTable::testIncrementalUpdates() {
+    std::srand(21);
+    Map map(150, 110);
+    SummedAreaTable table(map);
+    for (int round = 0; round < 20; ++round) {
+        for (int i = 0; i < 30; ++i) {
+            // Changes cluster in one part of the map per round
+            int x = (round * 37) % 150 + std::rand() % 20;
+            int y = (round * 53) % 110 + std::rand() % 20;
+            map.setGrid(x, y, std::rand() % 2);
+        }
+        if (round == 10) {
+            map.clearMap();
+        }
+        table.update();
+        SummedAreaTable fresh(map);
+        assert(table.getTotalOccupied() == fresh.getTotalOccupied());
+        checkRandomRectangles(map, table, 200);
+    }
+
+    // Resizes rebuild the table
+    map.setGridSize(170, 90);
+    map.setGrid(169, 89, 1);
+    table.update();
+    assert(table.countOccupied(169, 89, 169, 89) == 1);
+    checkRandomRectangles(map, table, 200);
+    std::cout << "testIncrementalUpdates: Passed\n";
+}
+
+/**
+ * @brief Tests the world-space box queries.
+ */
+void TestSummedAreaTable::testWorldBoxes() {
+    Map map(100, 100);
+    map.setGrid(20, 30, 1);
+    map.setGrid(21, 30, 1);
+    SummedAreaTable table(map);
+    table.setWorldFrame(0.05, -2.0, -1.0);
+
+    // Cell (20, 30) spans x in [-1.0, -0.95) and y in [0.5, 0.55)
+    assert(table.countOccupiedInBox(-1.0, 0.5, -0.96, 0.54) == 1);
+    assert(table.countOccupiedInBox(-1.2, 0.4, -0.9, 0.6) == 2);
+    assert(table.countOccupiedInBox(-0.89, 0.5, 0.0, 0.54) == 0);
+    assert(table.isBoxFree(-1.5, -0.5, -1.1, 0.4));
+    assert(!table.isBoxFree(-1.2, 0.4, -0.9, 0.6));
+    assert(!table.isBoxFree(-2.1, -0.5, -1.1, 0.4));
+    assert(table.countOccupiedInBox(-1e30, -1e30, 1e30, 1e30) == 2);
+
+    bool thrown = false;
+    try {
+        table.setWorldFrame(0.0, 0.0, 0.0);
+    }
+    catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    assert(thrown);
+    std::cout << "testWorldBoxes: Passed\n";
+}
+
+/**
+ * @brief Tests footprint checks along a path against a cell-by-cell loop.
+ */
+void TestSummedAreaTable::testFootprintChecks() {
+    std::srand(4);
+    Map map(256, 256);
+    for (int i = 0; i < 300; ++i) {
+        map.setGrid(std::rand() % 256, std::rand() % 256, 1);
+    }
+    SummedAreaTable table(map);
+
+    // 20x20 cell footprint at every cell of a diagonal path, before and after a central change
+    const int half = 10;
+    for (int round = 0; round < 2; ++round) {
+        int tableFree = 0;
+        for (int i = half; i < 256 - half; ++i) {
+            const bool free = table.isFree(i - half, i - half, i + half - 1, i + half - 1);
+            assert(free == (bruteCount(map, i - half, i - half, i + half - 1, i + half - 1) == 0));
+            tableFree += free;
+        }
+        assert(tableFree > 0 && tableFree < 256 - 2 * half);
+        map.setGrid(128, 128, 1);
+        map.setGrid(129, 129, 0);
+        table.update();
+    }
+    std::cout << "testFootprintChecks: Passed\n";
+}
@@ -0,0 +1,41 @@
+#ifndef TESTSUMMEDAREATABLE_H
+#define TESTSUMMEDAREATABLE_H
+
+#include "SummedAreaTable.h"
+
+/**
+ * @file   TestSummedAreaTable.h
+ * @author Emirhan Kalkan
+ * @date   December, 2024
+ * @brief  Header file for the TestSummedAreaTable class, which contains methods to test the SummedAreaTable class.
+ */
+class TestSummedAreaTable {
+public:
+    /**
+     * @brief Runs all the tests for the SummedAreaTable class.
+     */
+    static void runAllTests();
+
+private:
+    /**
+     * @brief Tests rectangle counts against a cell-by-cell count.
+     */
+    static void testRectangleCounts();
+
+    /**
+     * @brief Tests that incremental updates match a table built from scratch.
+     */
+    static void testIncrementalUpdates();
+
+    /**
+     * @brief Tests the world-space box queries.
+     */
+    static void testWorldBoxes();
+
+    /**
+     * @brief Tests footprint checks along a path against a cell-by-cell loop.
+     */
+    static void testFootprintChecks();
+};
+
+#endif // TESTSUMMEDAREATABLE_H
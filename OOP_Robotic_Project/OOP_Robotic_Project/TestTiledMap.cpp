@@ -0,0 +1,206 @@
+#include "TestTiledMap.h"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+/**
+ * @file   TestTiledMap.cpp
+ * @author Emirhan Kalkan
+ * @date   December, 2024
+ * @brief  Implementation of the test methods for the TiledMap class.
+ */
+
+ /**
+  * @brief Runs all the tests for the TiledMap class.
+  */
+void TestTiledMap::runAllTests() {
+    std::cout << "Running tests for TiledMap...\n";
+    testSignedCoordinates();
+    testSparseAllocation();
+    testGrowthKeepsTiles();
+    testClearAndBounds();
+    testCopyToMap();
+    testConcurrentReads();
+    std::cout << "All TiledMap tests passed successfully!\n";
+}
+
+/**
+ * @brief Tests cell access with negative and tile-boundary coordinates.
+ */
+void TestTiledMap::testSignedCoordinates() {
+    assert(TiledMap::tileOf(0) == 0);
+    assert(TiledMap::tileOf(63) == 0);
+    assert(TiledMap::tileOf(64) == 1);
+    assert(TiledMap::tileOf(-1) == -1);
+    assert(TiledMap::tileOf(-64) == -1);
+    assert(TiledMap::tileOf(-65) == -2);
+
+    TiledMap map;
+    const int coords[] = { -129, -65, -64, -1, 0, 1, 63, 64, 1000 };
+    for (int y : coords) {
+        for (int x : coords) {
+            map.setGrid(x, y, ((x * 7 + y * 13) & 0xFF) | 1);
+        }
+    }
+    for (int y : coords) {
+        for (int x : coords) {
+            assert(map.getGrid(x, y) == (((x * 7 + y * 13) & 0xFF) | 1));
+        }
+    }
+    // Neighbours of written cells stay empty
+    assert(map.getGrid(-2, -1) == 0);
+    assert(map.getGrid(2, 0) == 0);
+
+    map.insertPoint(Point(-0.5, -3.2));
+    assert(map.getGrid(-1, -4) == 1);
+
+    // Points without an int cell are ignored
+    const int tiles = map.getTileCount();
+    map.insertPoint(Point(NAN, 0.0));
+    map.insertPoint(Point(0.0, -INFINITY));
+    map.insertPoint(Point(1e300, 1e300));
+    map.insertPoint(Point(2147483648.0, 0.0));
+    assert(map.getTileCount() == tiles);
+    map.insertPoint(Point(-2147483648.0, 2147483647.5));
+    assert(map.getGrid(-2147483647 - 1, 2147483647) == 1);
+    std::cout << "testSignedCoordinates: Passed\n";
+}
+
+/**
+ * @brief Tests that tiles are only allocated for written areas.
+ */
+void TestTiledMap::testSparseAllocation() {
+    TiledMap map;
+    assert(map.getTileCount() == 0);
+
+    // Reads and zero writes never allocate
+    assert(map.getGrid(5, 5) == 0);
+    map.setGrid(5, 5, 0);
+    assert(map.getTileCount() == 0);
+
+    // Two cells a million cells apart cost two tiles, not the bounding box
+    map.setGrid(-1000000, -1000000, 1);
+    map.setGrid(1000000, 1000000, 1);
+    map.setGrid(1000001, 1000000, 1);
+    assert(map.getTileCount() == 2);
+    assert(map.getMemoryUsage() < 3 * TiledMap::TILE_CELLS + 4096);
+    assert(map.getTile(TiledMap::tileOf(1000000), TiledMap::tileOf(1000000)) != nullptr);
+    assert(map.getTile(0, 0) == nullptr);
+    std::cout << "testSparseAllocation: Passed\n";
+}
+
+/**
+ * @brief Tests that growing the directory never moves tile data.
+ */
+void TestTiledMap::testGrowthKeepsTiles() {
+    TiledMap map;
+    map.setGrid(3, 4, 9);
+    const MapCell* first = map.getTile(0, 0);
+    assert(first != nullptr);
+
+    // Enough tiles to grow the directory several times
+    for (int i = 0; i < 2000; ++i) {
+        map.setGrid((i % 50 - 25) * TiledMap::TILE_SIZE, (i / 50 - 20) * TiledMap::TILE_SIZE, 1);
+    }
+    assert(map.getTileCount() == 2000);
+    assert(map.getTile(0, 0) == first);
+    assert(first[4 * TiledMap::TILE_SIZE + 3] == 9);
+    for (int i = 0; i < 2000; ++i) {
+        assert(map.getGrid((i % 50 - 25) * TiledMap::TILE_SIZE, (i / 50 - 20) * TiledMap::TILE_SIZE) == 1);
+    }
+    std::cout << "testGrowthKeepsTiles: Passed\n";
+}
+
+/**
+ * @brief Tests clearMap and getBounds.
+ */
+void TestTiledMap::testClearAndBounds() {
+    TiledMap map;
+    int minX, minY, maxX, maxY;
+    assert(!map.getBounds(minX, minY, maxX, maxY));
+
+    map.setGrid(-10, 5, 1);
+    map.setGrid(70, -3, 1);
+    assert(map.getBounds(minX, minY, maxX, maxY));
+    assert(minX == -64 && maxX == 127);
+    assert(minY == -64 && maxY == 63);
+
+    map.clearMap();
+    assert(map.getTileCount() == 0);
+    assert(map.getGrid(-10, 5) == 0);
+    assert(!map.getBounds(minX, minY, maxX, maxY));
+
+    // The tile cache must not return freed tiles
+    map.setGrid(-10, 6, 2);
+    assert(map.getGrid(-10, 5) == 0);
+    assert(map.getGrid(-10, 6) == 2);
+    std::cout << "testClearAndBounds: Passed\n";
+}
+
+/**
+ * @brief Tests copying a window into a dense Map.
+ */
+void TestTiledMap::testCopyToMap() {
+    TiledMap map;
+    for (int y = -70; y < 70; y += 3) {
+        for (int x = -100; x < 100; x += 5) {
+            map.setGrid(x, y, 1 + ((x + y) & 3));
+        }
+    }
+
+    Map window(150, 90);
+    window.setGrid(0, 0, 7);
+    map.copyToMap(-80, -45, window);
+    for (int y = 0; y < 90; ++y) {
+        for (int x = 0; x < 150; ++x) {
+            assert(window.getGrid(x, y) == map.getGrid(x - 80, y - 45));
+        }
+    }
+    std::cout << "testCopyToMap: Passed\n";
+}
+
+/**
+ * @brief Tests reading one map from several threads and several maps from one thread.
+ */
+void TestTiledMap::testConcurrentReads() {
+    TiledMap first, second;
+    for (int y = -100; y < 100; ++y) {
+        for (int x = -100; x < 100; x += 7) {
+            first.setGrid(x, y, 1 + ((x ^ y) & 7));
+            second.setGrid(x, y, 9 + ((x ^ y) & 7));
+        }
+    }
+
+    // Each thread caches tiles on its own, so const reads do not race
+    bool consistent[4] = { true, true, true, true };
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t) {
+        readers.emplace_back([&, t]() {
+            const TiledMap& map = first;
+            for (int pass = 0; pass < 10; ++pass) {
+                for (int y = -100 + t; y < 100; y += 4) {
+                    for (int x = -100; x < 100; x += 7) {
+                        consistent[t] = consistent[t] && map.getGrid(x, y) == 1 + ((x ^ y) & 7);
+                    }
+                }
+            }
+        });
+    }
+    for (std::thread& reader : readers) {
+        reader.join();
+    }
+    for (bool ok : consistent) {
+        assert(ok);
+    }
+
+    // Two maps share the thread's cache entries but never each other's tiles
+    for (int y = -100; y < 100; ++y) {
+        for (int x = -100; x < 100; x += 7) {
+            assert(first.getGrid(x, y) == 1 + ((x ^ y) & 7));
+            assert(second.getGrid(x, y) == 9 + ((x ^ y) & 7));
+        }
+    }
+    std::cout << "testConcurrentReads: Passed\n";
+}
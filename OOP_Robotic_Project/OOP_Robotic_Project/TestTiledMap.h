@@ -0,0 +1,51 @@
+#ifndef TESTTILEDMAP_H
+#define TESTTILEDMAP_H
+
+#include "TiledMap.h"
+
+/**
+ * @file   TestTiledMap.h
+ * @author Emirhan Kalkan
+ * @date   December, 2024
+ * @brief  Header file for the TestTiledMap class, which contains methods to test the TiledMap class.
+ */
+class TestTiledMap {
+public:
+    /**
+     * @brief Runs all the tests for the TiledMap class.
+     */
+    static void runAllTests();
+
+private:
+    /**
+     * @brief Tests cell access with negative and tile-boundary coordinates.
+     */
+    static void testSignedCoordinates();
+
+    /**
+     * @brief Tests that tiles are only allocated for written areas.
+     */
+    static void testSparseAllocation();
+
+    /**
+     * @brief Tests that growing the directory never moves tile data.
+     */
+    static void testGrowthKeepsTiles();
+
+    /**
+     * @brief Tests clearMap and getBounds.
+     */
+    static void testClearAndBounds();
+
+    /**
+     * @brief Tests copying a window into a dense Map.
+     */
+    static void testCopyToMap();
+
+    /**
+     * @brief Tests reading one map from several threads and several maps from one thread.
+     */
+    static void testConcurrentReads();
+};
+
+#endif // TESTTILEDMAP_H
@@ -0,0 +1,87 @@
+/**
+ * @file   ThreadPool.cpp
+ * @author Furkan Gemici
+ * @date   December, 2024
+ * @brief  Implementation file for the ThreadPool class.
+ */
+
+#include "ThreadPool.h"
+
+ThreadPool::ThreadPool(int threadCount)
+    : job(nullptr), jobSize(0), nextTask(0), busyWorkers(0), generation(0), stopping(false) {
+    for (int i = 1; i < threadCount; ++i) {
+        workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+int ThreadPool::getThreadCount() const {
+    return static_cast<int>(workers.size()) + 1;
+}
+
+void ThreadPool::drain(const std::function<void(int)>& task, int count) {
+    for (int index = nextTask.fetch_add(1); index < count; index = nextTask.fetch_add(1)) {
+        task(index);
+    }
+}
+
+void ThreadPool::workerLoop() {
+    unsigned long long seen = 0;
+    while (true) {
+        const std::function<void(int)>* task;
+        int count;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&] { return stopping || generation != seen; });
+            if (stopping) {
+                return;
+            }
+            seen = generation;
+            task = job;
+            count = jobSize;
+        }
+
+        drain(*task, count);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--busyWorkers == 0) {
+            finished.notify_one();
+        }
+    }
+}
+
+void ThreadPool::run(int count, const std::function<void(int)>& task) {
+    if (workers.empty() || count <= 1) {
+        for (int index = 0; index < count; ++index) {
+            task(index);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job = &task;
+        jobSize = count;
+        nextTask.store(0);
+        busyWorkers = static_cast<int>(workers.size());
+        ++generation;
+    }
+    wake.notify_all();
+
+    drain(task, count);
+
+    // The workers hold a pointer to `task` until they have all left the loop
+    std::unique_lock<std::mutex> lock(mutex);
+    finished.wait(lock, [&] { return busyWorkers == 0; });
+    job = nullptr;
+}
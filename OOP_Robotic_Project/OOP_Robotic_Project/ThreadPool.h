@@ -0,0 +1,74 @@
+/**
+ * @file   ThreadPool.h
+ * @author Furkan Gemici
+ * @date   December, 2024
+ * @brief  Header file for the ThreadPool class.
+ *
+ * This file contains the definition of the ThreadPool class, a fixed set of
+ * worker threads that run the iterations of a parallel loop.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class ThreadPool
+ * @brief Persistent worker threads for fork-join parallel loops.
+ *
+ * run() hands a loop of independent tasks to the workers and the calling
+ * thread, which all take task indices from a shared counter until none are
+ * left, and returns when every task has finished. The threads are created
+ * once, so a loop costs a wake-up instead of a thread start.
+ */
+class ThreadPool {
+private:
+    std::vector<std::thread> workers;                   /*!< Worker threads (thread count - 1). */
+    std::mutex mutex;                                   /*!< Protects the job fields below. */
+    std::condition_variable wake;                       /*!< Signals a new job or shutdown to the workers. */
+    std::condition_variable finished;                   /*!< Signals that the last worker left the job. */
+    const std::function<void(int)>* job;                /*!< Task of the current loop. */
+    int jobSize;                                        /*!< Number of tasks in the current loop. */
+    std::atomic<int> nextTask;                          /*!< Next task index to take. */
+    int busyWorkers;                                    /*!< Workers still running the current loop. */
+    unsigned long long generation;                      /*!< Number of loops started, wakes the workers. */
+    bool stopping;                                      /*!< Tells the workers to exit. */
+
+    //! Body of a worker thread
+    void workerLoop();
+
+    //! Runs tasks of the current loop until none are left
+    void drain(const std::function<void(int)>& task, int count);
+
+public:
+    //! Starts the worker threads
+    /*!
+     * @param threadCount Total number of threads running a loop, including the
+     *                    caller of run(). Values below 1 are treated as 1.
+     */
+    explicit ThreadPool(int threadCount);
+
+    //! Stops and joins the worker threads
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    //! Returns the number of threads running a loop, including the caller
+    int getThreadCount() const;
+
+    //! Runs task(0) ... task(count - 1) in parallel and waits for all of them
+    /*!
+     * Tasks may run in any order and on any thread. run() must not be called
+     * from a task or from two threads at once.
+     *
+     * @param count Number of tasks.
+     * @param task Function called with each task index.
+     */
+    void run(int count, const std::function<void(int)>& task);
+};
@@ -0,0 +1,282 @@
+/**
+ * @file   TiledMap.cpp
+ * @author Emirhan Kalkan
+ * @date   December, 2024
+ * @brief  Implementation of the TiledMap class.
+ *
+ * This file contains the tile directory (open-addressing hash table with
+ * linear probing), the tile cache and the cell access methods of TiledMap.
+ */
+#include "TiledMap.h"
+#include "AlignedMemory.h"
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cmath>
+#include <cstring>
+
+namespace {
+    /** Initial number of directory slots (power of two). */
+    const int INITIAL_SLOTS = 64;
+
+    /** Number of entries in the tile cache. */
+    const int CACHE_SIZE = 8;
+
+    /**
+     * @brief A tile cache entry: the map it belongs to, tile coordinates and the tile.
+     */
+    struct CachedTile {
+        unsigned long long owner;
+        int tileX;
+        int tileY;
+        MapCell* cells;
+    };
+
+    /** Recently used tiles of the calling thread, shared by all maps (owner 0 is never used). */
+    thread_local CachedTile tileCache[CACHE_SIZE];
+
+    /** Source of TiledMap cache keys. */
+    std::atomic<unsigned long long> nextCacheKey(1);
+
+    /**
+     * @brief Mixes tile coordinates into a hash value.
+     */
+    unsigned int hashTile(int tileX, int tileY) {
+        unsigned long long key = (static_cast<unsigned long long>(static_cast<unsigned int>(tileX)) << 32) |
+            static_cast<unsigned int>(tileY);
+        key *= 0x9E3779B97F4A7C15ull;
+        return static_cast<unsigned int>(key >> 32);
+    }
+
+    /**
+     * @brief Returns the tile cache entry used for a tile.
+     */
+    int cacheIndex(int tileX, int tileY) {
+        return (tileX & 3) | ((tileY & 1) << 2);
+    }
+}
+
+/**
+ * @brief Constructs an empty map.
+ */
+TiledMap::TiledMap() : directory(INITIAL_SLOTS), tileCount(0),
+    minTileX(INT_MAX), minTileY(INT_MAX), maxTileX(INT_MIN), maxTileY(INT_MIN), cacheKey(nextCacheKey++) {
+    for (TileSlot& slot : directory) {
+        slot.cells = nullptr;
+    }
+}
+
+/**
+ * @brief Frees all tiles.
+ */
+TiledMap::~TiledMap() {
+    clearMap();
+}
+
+/**
+ * @brief Returns the directory slot index of a tile, or of the empty slot where it would go.
+ */
+int TiledMap::findSlot(int tileX, int tileY) const {
+    const unsigned int mask = static_cast<unsigned int>(directory.size()) - 1;
+    unsigned int index = hashTile(tileX, tileY) & mask;
+    // The directory is never more than half full, so probing always ends on an empty slot
+    while (directory[index].cells && (directory[index].tileX != tileX || directory[index].tileY != tileY)) {
+        index = (index + 1) & mask;
+    }
+    return static_cast<int>(index);
+}
+
+/**
+ * @brief Returns a tile, or nullptr if it is not allocated.
+ */
+MapCell* TiledMap::lookupTile(int tileX, int tileY) const {
+    CachedTile& entry = tileCache[cacheIndex(tileX, tileY)];
+    if (entry.owner == cacheKey && entry.tileX == tileX && entry.tileY == tileY) {
+        return entry.cells;
+    }
+    const TileSlot& slot = directory[findSlot(tileX, tileY)];
+    if (slot.cells) {
+        entry = { cacheKey, tileX, tileY, slot.cells };
+    }
+    return slot.cells;
+}
+
+/**
+ * @brief Returns a tile, allocating a zeroed one if needed.
+ */
+MapCell* TiledMap::acquireTile(int tileX, int tileY) {
+    MapCell* tile = lookupTile(tileX, tileY);
+    if (tile) {
+        return tile;
+    }
+
+    if ((tileCount + 1) * 2 > static_cast<int>(directory.size())) {
+        growDirectory();
+    }
+
+    tile = alignedAllocate<MapCell>(TILE_CELLS);
+    std::memset(tile, 0, TILE_CELLS);
+
+    TileSlot& slot = directory[findSlot(tileX, tileY)];
+    slot.tileX = tileX;
+    slot.tileY = tileY;
+    slot.cells = tile;
+    tileCache[cacheIndex(tileX, tileY)] = { cacheKey, tileX, tileY, tile };
+    ++tileCount;
+
+    minTileX = std::min(minTileX, tileX);
+    minTileY = std::min(minTileY, tileY);
+    maxTileX = std::max(maxTileX, tileX);
+    maxTileY = std::max(maxTileY, tileY);
+    return tile;
+}
+
+/**
+ * @brief Doubles the directory and re-inserts the tile pointers.
+ */
+void TiledMap::growDirectory() {
+    std::vector<TileSlot> old(directory.size() * 2);
+    old.swap(directory);
+    for (TileSlot& slot : directory) {
+        slot.cells = nullptr;
+    }
+    for (const TileSlot& slot : old) {
+        if (slot.cells) {
+            directory[findSlot(slot.tileX, slot.tileY)] = slot;
+        }
+    }
+}
+
+/**
+ * @brief Releases all tiles. Every cell reads as 0 afterwards.
+ */
+void TiledMap::clearMap() {
+    for (TileSlot& slot : directory) {
+        alignedFree(slot.cells);
+        slot.cells = nullptr;
+    }
+    // Cache entries of every thread still point to the freed tiles
+    cacheKey = nextCacheKey++;
+    tileCount = 0;
+    minTileX = minTileY = INT_MAX;
+    maxTileX = maxTileY = INT_MIN;
+}
+
+/**
+ * @brief Marks the cell of the given point with a 1.
+ *
+ * @param point The point whose cell is marked.
+ */
+void TiledMap::insertPoint(const Point& point) {
+    // Floor rather than truncate, so that -0.5 lands in cell -1 and not in cell 0
+    const double x = std::floor(point.getX());
+    const double y = std::floor(point.getY());
+    // Also false for NaN, whose conversion to int is undefined like that of out-of-range values
+    if (x >= INT_MIN && x <= INT_MAX && y >= INT_MIN && y <= INT_MAX) {
+        setGrid(static_cast<int>(x), static_cast<int>(y), 1);
+    }
+}
+
+/**
+ * @brief Returns the value of a cell.
+ *
+ * @param x The x-coordinate of the cell (may be negative).
+ * @param y The y-coordinate of the cell (may be negative).
+ * @return The cell value, 0 for cells that were never written.
+ */
+int TiledMap::getGrid(int x, int y) const {
+    const MapCell* tile = lookupTile(tileOf(x), tileOf(y));
+    if (!tile) {
+        return 0;
+    }
+    return tile[((y & (TILE_SIZE - 1)) << TILE_SHIFT) | (x & (TILE_SIZE - 1))];
+}
+
+/**
+ * @brief Sets the value of a cell, allocating its tile on the first non-zero write.
+ *
+ * @param x The x-coordinate of the cell (may be negative).
+ * @param y The y-coordinate of the cell (may be negative).
+ * @param value The value to set (stored as a MapCell, 0-255).
+ */
+void TiledMap::setGrid(int x, int y, int value) {
+    MapCell* tile;
+    if (value == 0) {
+        // Unallocated tiles already read as 0
+        tile = lookupTile(tileOf(x), tileOf(y));
+        if (!tile) {
+            return;
+        }
+    }
+    else {
+        tile = acquireTile(tileOf(x), tileOf(y));
+    }
+    tile[((y & (TILE_SIZE - 1)) << TILE_SHIFT) | (x & (TILE_SIZE - 1))] = static_cast<MapCell>(value);
+}
+
+/**
+ * @brief Returns the cells of a tile, or nullptr if the tile is not allocated.
+ */
+const MapCell* TiledMap::getTile(int tileX, int tileY) const {
+    return lookupTile(tileX, tileY);
+}
+
+/**
+ * @brief Returns the number of allocated tiles.
+ */
+int TiledMap::getTileCount() const {
+    return tileCount;
+}
+
+/**
+ * @brief Returns the number of bytes used by the tiles and the directory.
+ */
+size_t TiledMap::getMemoryUsage() const {
+    return static_cast<size_t>(tileCount) * TILE_CELLS + directory.size() * sizeof(TileSlot);
+}
+
+/**
+ * @brief Returns the cell bounds of the allocated tiles.
+ */
+bool TiledMap::getBounds(int& minX, int& minY, int& maxX, int& maxY) const {
+    if (tileCount == 0) {
+        return false;
+    }
+    minX = minTileX * TILE_SIZE;
+    minY = minTileY * TILE_SIZE;
+    maxX = maxTileX * TILE_SIZE + TILE_SIZE - 1;
+    maxY = maxTileY * TILE_SIZE + TILE_SIZE - 1;
+    return true;
+}
+
+/**
+ * @brief Copies a window of the map into a dense Map.
+ *
+ * The window is copied one tile row span at a time, so each allocated tile is
+ * looked up once per row and unallocated spans are filled with memset.
+ */
+void TiledMap::copyToMap(int originX, int originY, Map& out) const {
+    const int width = out.getNumberX();
+    const int height = out.getNumberY();
+    for (int row = 0; row < height; ++row) {
+        const int y = originY + row;
+        const int tileY = tileOf(y);
+        const int localY = (y & (TILE_SIZE - 1)) << TILE_SHIFT;
+        MapCell* dst = out.getRow(row);
+        int column = 0;
+        while (column < width) {
+            const int x = originX + column;
+            const int localX = x & (TILE_SIZE - 1);
+            const int span = std::min(TILE_SIZE - localX, width - column);
+            const MapCell* tile = lookupTile(tileOf(x), tileY);
+            if (tile) {
+                std::memcpy(dst + column, tile + localY + localX, span);
+            }
+            else {
+                std::memset(dst + column, 0, span);
+            }
+            column += span;
+        }
+    }
+    out.markDirty(0, 0, width - 1, height - 1);
+}
@@ -0,0 +1,170 @@
+#ifndef TILEDMAP_H
+#define TILEDMAP_H
+
+#include "Map.h"
+#include <vector>
+
+/**
+ * @file   TiledMap.h
+ * @author Emirhan Kalkan
+ * @date   December, 2024
+ * @brief  Header file for the TiledMap class.
+ *
+ * This file defines the TiledMap class, an unbounded grid map with signed
+ * coordinates whose cells are stored in fixed-size tiles allocated on demand.
+ */
+
+ /**
+  * @class TiledMap
+  * @brief A sparse, unbounded grid map made of 64x64 tiles.
+  *
+  * Cells are grouped in tiles of TILE_SIZE x TILE_SIZE cells. Each tile is one
+  * 4 KB, 64-byte aligned block with one cache line per tile row. Tiles are
+  * allocated on the first non-zero write and found through an open-addressing
+  * hash directory keyed by tile coordinates; cells of tiles that were never
+  * written read as 0. Memory therefore grows with the explored area, not with
+  * the bounding box, and growing the directory only moves tile pointers: cell
+  * data is never copied.
+  *
+  * A small direct-mapped cache of recently used tiles makes repeated accesses
+  * to nearby cells O(1) without hashing. Each thread has its own cache, so as
+  * with Map, const methods may be called from several threads at once; writes
+  * still need exclusive access.
+  */
+class TiledMap {
+public:
+    static const int TILE_SHIFT = 6;                 /**< log2 of the tile size. */
+    static const int TILE_SIZE = 1 << TILE_SHIFT;    /**< Number of cells along a tile side. */
+    static const int TILE_CELLS = TILE_SIZE * TILE_SIZE; /**< Number of cells in a tile. */
+
+private:
+    /**
+     * @brief A directory slot: tile coordinates and the tile, or nullptr if the slot is empty.
+     */
+    struct TileSlot {
+        int tileX;
+        int tileY;
+        MapCell* cells;
+    };
+
+    std::vector<TileSlot> directory;                 /**< Hash directory (size is a power of two). */
+    int tileCount;                                   /**< Number of allocated tiles. */
+    int minTileX, minTileY, maxTileX, maxTileY;      /**< Tile coordinate bounds of the allocated tiles. */
+    unsigned long long cacheKey;                     /**< Tags this map's tiles in the per-thread caches; renewed when tiles are freed. */
+
+    /**
+     * @brief Returns the directory slot index of a tile, or of the empty slot where it would go.
+     */
+    int findSlot(int tileX, int tileY) const;
+
+    /**
+     * @brief Returns a tile, or nullptr if it is not allocated.
+     */
+    MapCell* lookupTile(int tileX, int tileY) const;
+
+    /**
+     * @brief Returns a tile, allocating a zeroed one if needed.
+     */
+    MapCell* acquireTile(int tileX, int tileY);
+
+    /**
+     * @brief Doubles the directory and re-inserts the tile pointers.
+     */
+    void growDirectory();
+
+public:
+    /**
+     * @brief Constructs an empty map.
+     */
+    TiledMap();
+
+    /**
+     * @brief Frees all tiles.
+     */
+    ~TiledMap();
+
+    TiledMap(const TiledMap&) = delete;
+    TiledMap& operator=(const TiledMap&) = delete;
+
+    /**
+     * @brief Returns the tile coordinate containing a cell coordinate (floor division).
+     */
+    static int tileOf(int cell) { return cell >= 0 ? cell >> TILE_SHIFT : ~(~cell >> TILE_SHIFT); }
+
+    /**
+     * @brief Releases all tiles. Every cell reads as 0 afterwards.
+     */
+    void clearMap();
+
+    /**
+     * @brief Marks the cell of the given point with a 1.
+     *
+     * Points that are not finite or whose cell is outside the int range are ignored.
+     *
+     * @param point The point whose cell is marked.
+     */
+    void insertPoint(const Point& point);
+
+    /**
+     * @brief Returns the value of a cell.
+     *
+     * @param x The x-coordinate of the cell (may be negative).
+     * @param y The y-coordinate of the cell (may be negative).
+     * @return The cell value, 0 for cells that were never written.
+     */
+    int getGrid(int x, int y) const;
+
+    /**
+     * @brief Sets the value of a cell, allocating its tile on the first non-zero write.
+     *
+     * @param x The x-coordinate of the cell (may be negative).
+     * @param y The y-coordinate of the cell (may be negative).
+     * @param value The value to set (stored as a MapCell, 0-255).
+     */
+    void setGrid(int x, int y, int value);
+
+    /**
+     * @brief Returns the cells of a tile, or nullptr if the tile is not allocated.
+     *
+     * The tile is TILE_SIZE rows of TILE_SIZE cells, row-major.
+     *
+     * @param tileX The x-coordinate of the tile.
+     * @param tileY The y-coordinate of the tile.
+     */
+    const MapCell* getTile(int tileX, int tileY) const;
+
+    /**
+     * @brief Returns the number of allocated tiles.
+     */
+    int getTileCount() const;
+
+    /**
+     * @brief Returns the number of bytes used by the tiles and the directory.
+     */
+    size_t getMemoryUsage() const;
+
+    /**
+     * @brief Returns the cell bounds of the allocated tiles.
+     *
+     * @param minX Receives the smallest x-coordinate.
+     * @param minY Receives the smallest y-coordinate.
+     * @param maxX Receives the largest x-coordinate.
+     * @param maxY Receives the largest y-coordinate.
+     * @return false if no tile is allocated.
+     */
+    bool getBounds(int& minX, int& minY, int& maxX, int& maxY) const;
+
+    /**
+     * @brief Copies a window of the map into a dense Map.
+     *
+     * Cell (originX + i, originY + j) is copied to cell (i, j) of `out`, for the
+     * whole size of `out`. Unallocated tiles are copied as 0.
+     *
+     * @param originX The x-coordinate of the window's first cell.
+     * @param originY The y-coordinate of the window's first cell.
+     * @param out The map receiving the window.
+     */
+    void copyToMap(int originX, int originY, Map& out) const;
+};
+
+#endif // TILEDMAP_H